@@ -0,0 +1,237 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/cpu_elementwise.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include "backend/kernel_compiler/cpu/cpu_elementwise_internal.h"
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
+#include "utils/log_adapter.h"
+
+#define CPU_ELEMENTWISE_ISA elementwise_scalar
+#include "backend/kernel_compiler/cpu/cpu_elementwise_impl.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// The vectorized kernels go through a few times more elements than the scalar ones in the time of a task
+constexpr size_t kElementwiseGrainSize = 1024;
+
+std::atomic<SimdIsa> g_isa_limit{SimdIsa::kAvx512};
+
+SimdIsa DetectIsa() {
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if (Avx512RowFuncs() != nullptr && __builtin_cpu_supports("avx512f")) {
+    return SimdIsa::kAvx512;
+  }
+  if (Avx2RowFuncs() != nullptr && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdIsa::kAvx2;
+  }
+#endif
+  return SimdIsa::kScalar;
+}
+
+const ElementwiseRowFuncs *RowFuncs() {
+  switch (ElementwiseIsa()) {
+    case SimdIsa::kAvx512:
+      return Avx512RowFuncs();
+    case SimdIsa::kAvx2:
+      return Avx2RowFuncs();
+    default:
+      return nullptr;
+  }
+}
+
+template <typename T>
+UnaryRowFunc<T> GetUnaryRow() {
+  return elementwise_scalar::UnaryRow<elementwise_scalar::ScalarVec<T>>;
+}
+
+template <>
+UnaryRowFunc<float> GetUnaryRow() {
+  auto funcs = RowFuncs();
+  return funcs == nullptr ? elementwise_scalar::UnaryRow<elementwise_scalar::ScalarVec<float>> : funcs->unary_float;
+}
+}  // namespace
+
+template <typename T>
+BinaryRowFunc<T> ElementwiseBinaryRow() {
+  return elementwise_scalar::BinaryRow<elementwise_scalar::ScalarVec<T>>;
+}
+
+template <>
+BinaryRowFunc<float> ElementwiseBinaryRow() {
+  auto funcs = RowFuncs();
+  return funcs == nullptr ? elementwise_scalar::BinaryRow<elementwise_scalar::ScalarVec<float>> : funcs->binary_float;
+}
+
+template <>
+BinaryRowFunc<int> ElementwiseBinaryRow() {
+  auto funcs = RowFuncs();
+  return funcs == nullptr ? elementwise_scalar::BinaryRow<elementwise_scalar::ScalarVec<int>> : funcs->binary_int;
+}
+
+SimdIsa SupportedElementwiseIsa() {
+  static const SimdIsa isa = [] {
+    SimdIsa detected = DetectIsa();
+    MS_LOG(INFO) << "CPU elementwise kernels instruction set: " << static_cast<int>(detected);
+    return detected;
+  }();
+  return isa;
+}
+
+SimdIsa ElementwiseIsa() { return std::min(SupportedElementwiseIsa(), g_isa_limit.load()); }
+
+void SetElementwiseIsa(SimdIsa isa) { g_isa_limit.store(isa); }
+
+void BinaryBroadcast::Init(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1,
+                           const std::vector<size_t> &out_shape) {
+  size_t rank = out_shape.size();
+  if (shape0.size() > rank || shape1.size() > rank) {
+    MS_LOG(EXCEPTION) << "The inputs of rank " << shape0.size() << " and " << shape1.size()
+                      << " cannot be broadcast to an output of rank " << rank;
+  }
+  dims_.clear();
+  std::vector<bool> broadcast0;
+  std::vector<bool> broadcast1;
+  for (size_t i = 0; i < rank; ++i) {
+    size_t dim = out_shape[i];
+    size_t dim0 = i + shape0.size() < rank ? 1 : shape0[i + shape0.size() - rank];
+    size_t dim1 = i + shape1.size() < rank ? 1 : shape1[i + shape1.size() - rank];
+    if ((dim0 != dim && dim0 != 1) || (dim1 != dim && dim1 != 1)) {
+      MS_LOG(EXCEPTION) << "The dimension " << i << " of the inputs: " << dim0 << " and " << dim1
+                        << " cannot be broadcast to the output: " << dim;
+    }
+    if (dim == 1) {
+      continue;
+    }
+    bool is_broadcast0 = dim0 != dim;
+    bool is_broadcast1 = dim1 != dim;
+    if (!dims_.empty() && broadcast0.back() == is_broadcast0 && broadcast1.back() == is_broadcast1) {
+      dims_.back() *= dim;
+      continue;
+    }
+    dims_.push_back(dim);
+    broadcast0.push_back(is_broadcast0);
+    broadcast1.push_back(is_broadcast1);
+  }
+  if (dims_.empty()) {
+    dims_.push_back(1);
+    broadcast0.push_back(true);
+    broadcast1.push_back(true);
+  }
+
+  size_t num_dims = dims_.size();
+  strides0_.assign(num_dims, 0);
+  strides1_.assign(num_dims, 0);
+  size_t size0 = 1;
+  size_t size1 = 1;
+  num_elements_ = 1;
+  for (size_t i = num_dims; i > 0; --i) {
+    if (!broadcast0[i - 1]) {
+      strides0_[i - 1] = size0;
+      size0 *= dims_[i - 1];
+    }
+    if (!broadcast1[i - 1]) {
+      strides1_[i - 1] = size1;
+      size1 *= dims_[i - 1];
+    }
+    num_elements_ *= dims_[i - 1];
+  }
+}
+
+template <typename T>
+void ElementwiseBinary(OperateType op, const BinaryBroadcast &broadcast, const T *in0, const T *in1, T *out) {
+  if (op != ADD && op != SUB && op != MUL && op != DIV) {
+    MS_LOG(EXCEPTION) << "Unsupported binary elementwise op " << op;
+  }
+  if (broadcast.num_elements() == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(in0);
+  MS_EXCEPTION_IF_NULL(in1);
+  MS_EXCEPTION_IF_NULL(out);
+  auto row_func = ElementwiseBinaryRow<T>();
+  const auto &dims = broadcast.dims();
+  const auto &strides0 = broadcast.strides0();
+  const auto &strides1 = broadcast.strides1();
+  size_t num_outer = dims.size() - 1;
+  size_t row_size = dims.back();
+  size_t step0 = strides0.back();
+  size_t step1 = strides1.back();
+  auto task = [&](size_t start, size_t end) {
+    // The position of the first row of the range in the outer dimensions
+    std::vector<size_t> pos(num_outer, 0);
+    size_t row = start / row_size;
+    size_t offset0 = 0;
+    size_t offset1 = 0;
+    for (size_t i = num_outer; i > 0; --i) {
+      pos[i - 1] = row % dims[i - 1];
+      row /= dims[i - 1];
+      offset0 += pos[i - 1] * strides0[i - 1];
+      offset1 += pos[i - 1] * strides1[i - 1];
+    }
+    size_t col = start % row_size;
+    for (size_t index = start; index < end;) {
+      size_t num = std::min(row_size - col, end - index);
+      if (!row_func(op, in0 + offset0 + col * step0, step0, in1 + offset1 + col * step1, step1, out + index, num)) {
+        MS_LOG(EXCEPTION) << "Cannot divided by 0!";
+      }
+      index += num;
+      col = 0;
+      for (size_t i = num_outer; i > 0; --i) {
+        offset0 += strides0[i - 1];
+        offset1 += strides1[i - 1];
+        if (++pos[i - 1] < dims[i - 1]) {
+          break;
+        }
+        offset0 -= dims[i - 1] * strides0[i - 1];
+        offset1 -= dims[i - 1] * strides1[i - 1];
+        pos[i - 1] = 0;
+      }
+    }
+  };
+  CPUThreadPool::GetInstance().ParallelFor(broadcast.num_elements(), task, kElementwiseGrainSize);
+}
+
+template <typename T>
+void ElementwiseUnary(const std::vector<OperateType> &ops, const T *in, T *out, size_t num) {
+  for (auto op : ops) {
+    if (op != SQUARE && op != SQRT) {
+      MS_LOG(EXCEPTION) << "Unsupported unary elementwise op " << op;
+    }
+  }
+  if (num == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(in);
+  MS_EXCEPTION_IF_NULL(out);
+  auto row_func = GetUnaryRow<T>();
+  auto task = [&](size_t start, size_t end) { row_func(ops.data(), ops.size(), in + start, out + start, end - start); };
+  CPUThreadPool::GetInstance().ParallelFor(num, task, kElementwiseGrainSize);
+}
+
+template void ElementwiseBinary<float>(OperateType op, const BinaryBroadcast &broadcast, const float *in0,
+                                       const float *in1, float *out);
+template void ElementwiseBinary<int>(OperateType op, const BinaryBroadcast &broadcast, const int *in0, const int *in1,
+                                     int *out);
+template void ElementwiseBinary<int64_t>(OperateType op, const BinaryBroadcast &broadcast, const int64_t *in0,
+                                         const int64_t *in1, int64_t *out);
+template void ElementwiseUnary<float>(const std::vector<OperateType> &ops, const float *in, float *out, size_t num);
+template void ElementwiseUnary<int>(const std::vector<OperateType> &ops, const int *in, int *out, size_t num);
+}  // namespace kernel
+}  // namespace mindspore
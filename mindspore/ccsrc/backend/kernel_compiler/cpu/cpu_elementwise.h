@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_H_
+
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+// Instruction sets of the elementwise kernels, from the least to the most capable
+enum class SimdIsa { kScalar = 0, kAvx2, kAvx512 };
+
+// @return SimdIsa - the best instruction set both the CPU and the build support, found once per process
+SimdIsa SupportedElementwiseIsa();
+// @return SimdIsa - the instruction set the elementwise kernels use
+SimdIsa ElementwiseIsa();
+
+// The broadcast of the inputs of a binary elementwise op to its output.
+// The adjacent dimensions broadcast the same way are merged, so that the common cases come down to few dimensions:
+// inputs of the same shape or a scalar input to one, a row or a column broadcast over a matrix to two. The kernels
+// then run along the last dimension, where each input either moves on with the output or stays on one element.
+class BinaryBroadcast {
+ public:
+  BinaryBroadcast() = default;
+  ~BinaryBroadcast() = default;
+
+  // @param shape0, shape1 - the shapes of the inputs, aligned to the last dimension of the output
+  // @param out_shape - the shape of the output
+  void Init(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1, const std::vector<size_t> &out_shape);
+
+  size_t num_elements() const { return num_elements_; }
+  // The merged dimensions, never empty
+  const std::vector<size_t> &dims() const { return dims_; }
+  // The element strides of the inputs along the merged dimensions, 0 when broadcast
+  const std::vector<size_t> &strides0() const { return strides0_; }
+  const std::vector<size_t> &strides1() const { return strides1_; }
+
+ private:
+  std::vector<size_t> dims_{1};
+  std::vector<size_t> strides0_{0};
+  std::vector<size_t> strides1_{0};
+  size_t num_elements_{1};
+};
+
+// out = in0 op in1 for op in ADD, SUB, MUL, DIV, in parallel on the CPU thread pool.
+// T is float, int or int64_t. A division by 0 throws, whatever the type.
+template <typename T>
+void ElementwiseBinary(OperateType op, const BinaryBroadcast &broadcast, const T *in0, const T *in1, T *out);
+
+// Apply the chain of unary ops (SQUARE, SQRT) one after the other to num elements, in one pass over the memory: the
+// intermediate values stay in registers. out may be in. T is float or int.
+template <typename T>
+void ElementwiseUnary(const std::vector<OperateType> &ops, const T *in, T *out, size_t num);
+
+// Kernels along a row of the output, the elements of an input at in[0], in[step], ... with step 0 or 1
+// @return bool - false when dividing by 0
+template <typename T>
+using BinaryRowFunc = bool (*)(OperateType op, const T *in0, size_t step0, const T *in1, size_t step1, T *out,
+                               size_t num);
+template <typename T>
+using UnaryRowFunc = void (*)(const OperateType *ops, size_t num_ops, const T *in, T *out, size_t num);
+
+// @return BinaryRowFunc<T> - the row kernel of the instruction set in use, for the kernels running their own loops
+template <typename T>
+BinaryRowFunc<T> ElementwiseBinaryRow();
+template <>
+BinaryRowFunc<float> ElementwiseBinaryRow();
+template <>
+BinaryRowFunc<int> ElementwiseBinaryRow();
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_H_
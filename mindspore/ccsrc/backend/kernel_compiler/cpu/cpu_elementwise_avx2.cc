@@ -0,0 +1,107 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstddef>
+#include "backend/kernel_compiler/cpu/cpu_elementwise_internal.h"
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CPU_ELEMENTWISE_AVX2
+#endif
+
+#ifdef CPU_ELEMENTWISE_AVX2
+// Only the code below is built for AVX2, the CPU is checked before calling it
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#define CPU_ELEMENTWISE_ISA elementwise_avx2
+#include "backend/kernel_compiler/cpu/cpu_elementwise_impl.h"
+
+namespace mindspore {
+namespace kernel {
+namespace elementwise_avx2 {
+constexpr size_t kLanes = 8;
+
+struct FloatVec {
+  using Scalar = float;
+  using Reg = __m256;
+  static constexpr size_t kWidth = kLanes;
+  static Reg Load(const float *p) { return _mm256_loadu_ps(p); }
+  static void Store(float *p, Reg v) { _mm256_storeu_ps(p, v); }
+  static Reg Broadcast(float v) { return _mm256_set1_ps(v); }
+  static Reg Add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+  static Reg Sqrt(Reg a) { return _mm256_sqrt_ps(a); }
+  static bool AnyZero(Reg a) { return _mm256_movemask_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_EQ_OQ)) != 0; }
+};
+
+struct IntVec {
+  using Scalar = int;
+  using Reg = __m256i;
+  static constexpr size_t kWidth = kLanes;
+  static Reg Load(const int *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+  static void Store(int *p, Reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+  static Reg Broadcast(int v) { return _mm256_set1_epi32(v); }
+  static Reg Add(Reg a, Reg b) { return _mm256_add_epi32(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm256_sub_epi32(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm256_mullo_epi32(a, b); }
+  // No integer division instruction, one lane at a time
+  static Reg Div(Reg a, Reg b) {
+    int x[kLanes];
+    int y[kLanes];
+    Store(x, a);
+    Store(y, b);
+    for (size_t i = 0; i < kLanes; ++i) {
+      x[i] /= y[i];
+    }
+    return Load(x);
+  }
+  static bool AnyZero(Reg a) { return _mm256_movemask_epi8(_mm256_cmpeq_epi32(a, _mm256_setzero_si256())) != 0; }
+};
+
+bool BinaryRowFloat(OperateType op, const float *in0, size_t step0, const float *in1, size_t step1, float *out,
+                    size_t num) {
+  return BinaryRow<FloatVec>(op, in0, step0, in1, step1, out, num);
+}
+
+bool BinaryRowInt(OperateType op, const int *in0, size_t step0, const int *in1, size_t step1, int *out, size_t num) {
+  return BinaryRow<IntVec>(op, in0, step0, in1, step1, out, num);
+}
+
+void UnaryRowFloat(const OperateType *ops, size_t num_ops, const float *in, float *out, size_t num) {
+  UnaryRow<FloatVec>(ops, num_ops, in, out, num);
+}
+}  // namespace elementwise_avx2
+}  // namespace kernel
+}  // namespace mindspore
+
+#pragma GCC pop_options
+#endif  // CPU_ELEMENTWISE_AVX2
+
+namespace mindspore {
+namespace kernel {
+const ElementwiseRowFuncs *Avx2RowFuncs() {
+#ifdef CPU_ELEMENTWISE_AVX2
+  static const ElementwiseRowFuncs funcs = {elementwise_avx2::BinaryRowFloat, elementwise_avx2::BinaryRowInt,
+                                            elementwise_avx2::UnaryRowFloat};
+  return &funcs;
+#else
+  return nullptr;
+#endif
+}
+}  // namespace kernel
+}  // namespace mindspore
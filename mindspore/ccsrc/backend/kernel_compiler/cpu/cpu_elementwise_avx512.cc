@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstddef>
+#include "backend/kernel_compiler/cpu/cpu_elementwise_internal.h"
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CPU_ELEMENTWISE_AVX512
+#endif
+
+#ifdef CPU_ELEMENTWISE_AVX512
+// Only the code below is built for AVX-512, the CPU is checked before calling it
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#define CPU_ELEMENTWISE_ISA elementwise_avx512
+#include "backend/kernel_compiler/cpu/cpu_elementwise_impl.h"
+
+namespace mindspore {
+namespace kernel {
+namespace elementwise_avx512 {
+constexpr size_t kLanes = 16;
+
+struct FloatVec {
+  using Scalar = float;
+  using Reg = __m512;
+  static constexpr size_t kWidth = kLanes;
+  static Reg Load(const float *p) { return _mm512_loadu_ps(p); }
+  static void Store(float *p, Reg v) { _mm512_storeu_ps(p, v); }
+  static Reg Broadcast(float v) { return _mm512_set1_ps(v); }
+  static Reg Add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm512_div_ps(a, b); }
+  // Not _mm512_sqrt_ps, whose undefined source lanes trip -Wmaybe-uninitialized
+  static Reg Sqrt(Reg a) { return _mm512_maskz_sqrt_ps(static_cast<__mmask16>(-1), a); }
+  static bool AnyZero(Reg a) { return _mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_EQ_OQ) != 0; }
+};
+
+struct IntVec {
+  using Scalar = int;
+  using Reg = __m512i;
+  static constexpr size_t kWidth = kLanes;
+  static Reg Load(const int *p) { return _mm512_loadu_si512(p); }
+  static void Store(int *p, Reg v) { _mm512_storeu_si512(p, v); }
+  static Reg Broadcast(int v) { return _mm512_set1_epi32(v); }
+  static Reg Add(Reg a, Reg b) { return _mm512_add_epi32(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm512_sub_epi32(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm512_mullo_epi32(a, b); }
+  // No integer division instruction, one lane at a time
+  static Reg Div(Reg a, Reg b) {
+    int x[kLanes];
+    int y[kLanes];
+    Store(x, a);
+    Store(y, b);
+    for (size_t i = 0; i < kLanes; ++i) {
+      x[i] /= y[i];
+    }
+    return Load(x);
+  }
+  static bool AnyZero(Reg a) { return _mm512_cmpeq_epi32_mask(a, _mm512_setzero_si512()) != 0; }
+};
+
+bool BinaryRowFloat(OperateType op, const float *in0, size_t step0, const float *in1, size_t step1, float *out,
+                    size_t num) {
+  return BinaryRow<FloatVec>(op, in0, step0, in1, step1, out, num);
+}
+
+bool BinaryRowInt(OperateType op, const int *in0, size_t step0, const int *in1, size_t step1, int *out, size_t num) {
+  return BinaryRow<IntVec>(op, in0, step0, in1, step1, out, num);
+}
+
+void UnaryRowFloat(const OperateType *ops, size_t num_ops, const float *in, float *out, size_t num) {
+  UnaryRow<FloatVec>(ops, num_ops, in, out, num);
+}
+}  // namespace elementwise_avx512
+}  // namespace kernel
+}  // namespace mindspore
+
+#pragma GCC pop_options
+#endif  // CPU_ELEMENTWISE_AVX512
+
+namespace mindspore {
+namespace kernel {
+const ElementwiseRowFuncs *Avx512RowFuncs() {
+#ifdef CPU_ELEMENTWISE_AVX512
+  static const ElementwiseRowFuncs funcs = {elementwise_avx512::BinaryRowFloat, elementwise_avx512::BinaryRowInt,
+                                            elementwise_avx512::UnaryRowFloat};
+  return &funcs;
+#else
+  return nullptr;
+#endif
+}
+}  // namespace kernel
+}  // namespace mindspore
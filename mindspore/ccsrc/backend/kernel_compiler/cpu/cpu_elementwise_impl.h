@@ -0,0 +1,196 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_IMPL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_IMPL_H_
+
+// The row kernels of the elementwise ops, written once over a vector type V:
+//   V::Scalar, V::Reg, V::kWidth, V::Load, V::Store, V::Broadcast, V::Add, V::Sub, V::Mul, V::Div, V::Sqrt and
+//   V::AnyZero (whether a lane is 0).
+// Each translation unit of an instruction set includes it once, after switching the compiler to the instruction set,
+// with CPU_ELEMENTWISE_ISA naming a namespace of its own. Nothing defined here may then be shared between the
+// translation units, or the linker could pick code the CPU does not support.
+// All the standard headers needed must be included before switching the instruction set.
+#ifndef CPU_ELEMENTWISE_ISA
+#error "CPU_ELEMENTWISE_ISA must name the namespace of the kernels"
+#endif
+
+namespace mindspore {
+namespace kernel {
+namespace CPU_ELEMENTWISE_ISA {
+// One element at a time, for the tails of the rows
+template <typename T>
+struct ScalarVec {
+  using Scalar = T;
+  using Reg = T;
+  static constexpr size_t kWidth = 1;
+  static Reg Load(const T *p) { return *p; }
+  static void Store(T *p, Reg v) { *p = v; }
+  static Reg Broadcast(T v) { return v; }
+  static Reg Add(Reg a, Reg b) { return a + b; }
+  static Reg Sub(Reg a, Reg b) { return a - b; }
+  static Reg Mul(Reg a, Reg b) { return a * b; }
+  static Reg Div(Reg a, Reg b) { return a / b; }
+  static Reg Sqrt(Reg a) { return static_cast<T>(std::sqrt(static_cast<float>(a))); }
+  static bool AnyZero(Reg a) { return a == 0; }
+};
+
+struct AddOp {
+  static constexpr bool kDivision = false;
+  template <typename V>
+  static typename V::Reg Apply(typename V::Reg a, typename V::Reg b) {
+    return V::Add(a, b);
+  }
+};
+
+struct SubOp {
+  static constexpr bool kDivision = false;
+  template <typename V>
+  static typename V::Reg Apply(typename V::Reg a, typename V::Reg b) {
+    return V::Sub(a, b);
+  }
+};
+
+struct MulOp {
+  static constexpr bool kDivision = false;
+  template <typename V>
+  static typename V::Reg Apply(typename V::Reg a, typename V::Reg b) {
+    return V::Mul(a, b);
+  }
+};
+
+struct DivOp {
+  static constexpr bool kDivision = true;
+  template <typename V>
+  static typename V::Reg Apply(typename V::Reg a, typename V::Reg b) {
+    return V::Div(a, b);
+  }
+};
+
+// The loops for each broadcast of a row: both inputs moving on, one of them fixed, or both fixed
+template <typename V, typename Op>
+bool BinaryRowOf(const typename V::Scalar *in0, size_t step0, const typename V::Scalar *in1, size_t step1,
+                 typename V::Scalar *out, size_t num) {
+  using T = typename V::Scalar;
+  using S = ScalarVec<T>;
+  constexpr size_t kWidth = V::kWidth;
+  size_t i = 0;
+  if (step0 == 0 && step1 == 0) {
+    if (Op::kDivision && S::AnyZero(*in1)) {
+      return false;
+    }
+    T value = Op::template Apply<S>(*in0, *in1);
+    for (; i < num; ++i) {
+      out[i] = value;
+    }
+  } else if (step1 == 0) {
+    if (Op::kDivision && S::AnyZero(*in1)) {
+      return false;
+    }
+    auto b = V::Broadcast(*in1);
+    for (; i + kWidth <= num; i += kWidth) {
+      V::Store(out + i, Op::template Apply<V>(V::Load(in0 + i), b));
+    }
+    for (; i < num; ++i) {
+      out[i] = Op::template Apply<S>(in0[i], *in1);
+    }
+  } else if (step0 == 0) {
+    auto a = V::Broadcast(*in0);
+    for (; i + kWidth <= num; i += kWidth) {
+      auto b = V::Load(in1 + i);
+      if (Op::kDivision && V::AnyZero(b)) {
+        return false;
+      }
+      V::Store(out + i, Op::template Apply<V>(a, b));
+    }
+    for (; i < num; ++i) {
+      if (Op::kDivision && S::AnyZero(in1[i])) {
+        return false;
+      }
+      out[i] = Op::template Apply<S>(*in0, in1[i]);
+    }
+  } else {
+    for (; i + kWidth <= num; i += kWidth) {
+      auto b = V::Load(in1 + i);
+      if (Op::kDivision && V::AnyZero(b)) {
+        return false;
+      }
+      V::Store(out + i, Op::template Apply<V>(V::Load(in0 + i), b));
+    }
+    for (; i < num; ++i) {
+      if (Op::kDivision && S::AnyZero(in1[i])) {
+        return false;
+      }
+      out[i] = Op::template Apply<S>(in0[i], in1[i]);
+    }
+  }
+  return true;
+}
+
+template <typename V>
+bool BinaryRow(OperateType op, const typename V::Scalar *in0, size_t step0, const typename V::Scalar *in1,
+               size_t step1, typename V::Scalar *out, size_t num) {
+  switch (op) {
+    case ADD:
+      return BinaryRowOf<V, AddOp>(in0, step0, in1, step1, out, num);
+    case SUB:
+      return BinaryRowOf<V, SubOp>(in0, step0, in1, step1, out, num);
+    case MUL:
+      return BinaryRowOf<V, MulOp>(in0, step0, in1, step1, out, num);
+    case DIV:
+      return BinaryRowOf<V, DivOp>(in0, step0, in1, step1, out, num);
+    default:
+      return true;
+  }
+}
+
+template <typename V>
+typename V::Reg ApplyUnary(OperateType op, typename V::Reg x) {
+  switch (op) {
+    case SQUARE:
+      return V::Mul(x, x);
+    case SQRT:
+      return V::Sqrt(x);
+    default:
+      return x;
+  }
+}
+
+template <typename V>
+void UnaryRow(const OperateType *ops, size_t num_ops, const typename V::Scalar *in, typename V::Scalar *out,
+              size_t num) {
+  using S = ScalarVec<typename V::Scalar>;
+  constexpr size_t kWidth = V::kWidth;
+  size_t i = 0;
+  for (; i + kWidth <= num; i += kWidth) {
+    auto x = V::Load(in + i);
+    for (size_t k = 0; k < num_ops; ++k) {
+      x = ApplyUnary<V>(ops[k], x);
+    }
+    V::Store(out + i, x);
+  }
+  for (; i < num; ++i) {
+    auto x = in[i];
+    for (size_t k = 0; k < num_ops; ++k) {
+      x = ApplyUnary<S>(ops[k], x);
+    }
+    out[i] = x;
+  }
+}
+}  // namespace CPU_ELEMENTWISE_ISA
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_IMPL_H_
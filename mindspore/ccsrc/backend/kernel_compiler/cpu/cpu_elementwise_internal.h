@@ -0,0 +1,41 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_INTERNAL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_INTERNAL_H_
+
+#include "backend/kernel_compiler/cpu/cpu_elementwise.h"
+
+// Shared by the translation units of the elementwise kernels and their tests only
+namespace mindspore {
+namespace kernel {
+// Use at most the given instruction set, so that the kernels of each one can be compared
+void SetElementwiseIsa(SimdIsa isa);
+
+// The row kernels of an instruction set
+struct ElementwiseRowFuncs {
+  BinaryRowFunc<float> binary_float;
+  BinaryRowFunc<int> binary_int;
+  UnaryRowFunc<float> unary_float;
+};
+
+// @return const ElementwiseRowFuncs * - the kernels of the instruction set, nullptr when the compiler cannot build
+//     them for the target
+const ElementwiseRowFuncs *Avx2RowFuncs();
+const ElementwiseRowFuncs *Avx512RowFuncs();
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_ELEMENTWISE_INTERNAL_H_
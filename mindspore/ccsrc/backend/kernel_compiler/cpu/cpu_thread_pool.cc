@@ -0,0 +1,293 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Number of times an idle worker looks for a task again before it sleeps
+constexpr size_t kIdleYieldCount = 64;
+
+// The pool and the index of the worker running on this thread, if any
+thread_local const CPUThreadPool *tls_pool = nullptr;
+thread_local size_t tls_worker = 0;
+
+#if defined(__linux__)
+// Number of CPUs allowed by the cgroup CPU quota, 0 if there is no quota
+size_t CgroupCpuQuota() {
+  double quota = -1;
+  double period = 0;
+  // cgroup v2: "<quota> <period>", the quota being "max" if there is none
+  std::ifstream cpu_max("/sys/fs/cgroup/cpu.max");
+  std::string quota_str;
+  if (cpu_max >> quota_str >> period) {
+    if (quota_str != "max") {
+      quota = std::stod(quota_str);
+    }
+  } else {
+    // cgroup v1, the quota being -1 if there is none
+    std::ifstream quota_file("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+    std::ifstream period_file("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+    if (!(quota_file >> quota) || !(period_file >> period)) {
+      return 0;
+    }
+  }
+  if (quota <= 0 || period <= 0) {
+    return 0;
+  }
+  return std::max(static_cast<size_t>(1), static_cast<size_t>((quota + period - 1) / period));
+}
+#endif
+}  // namespace
+
+CPUThreadPool &CPUThreadPool::GetInstance() {
+  static CPUThreadPool instance(AvailableCpuNum() - 1);
+  return instance;
+}
+
+size_t CPUThreadPool::AvailableCpuNum() {
+  size_t cpu_num = std::max(std::thread::hardware_concurrency(), 1U);
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    cpu_num = std::min(cpu_num, static_cast<size_t>(std::max(CPU_COUNT(&cpu_set), 1)));
+  }
+  size_t quota = CgroupCpuQuota();
+  if (quota > 0) {
+    cpu_num = std::min(cpu_num, quota);
+  }
+#endif
+  return cpu_num;
+}
+
+CPUThreadPool::CPUThreadPool(size_t num_workers) {
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back(std::make_unique<Worker>());
+  }
+  for (size_t i = 0; i < num_workers; ++i) {
+    threads_.emplace_back(&CPUThreadPool::WorkerLoop, this, i);
+  }
+  MS_LOG(INFO) << "CPU kernel thread pool started with " << num_workers << " workers";
+}
+
+CPUThreadPool::~CPUThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    exit_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void CPUThreadPool::ParallelFor(size_t total, const RangeTask &func, size_t min_grain) {
+  min_grain = std::max(min_grain, static_cast<size_t>(1));
+  size_t threads = intra_op_threads_.load();
+  threads = threads == 0 ? num_threads() : std::min(threads, num_threads());
+  size_t max_ranges = threads == 1 ? 1 : threads * kRangesPerThread;
+  RunRanges(total, func, std::min((total + min_grain - 1) / min_grain, max_ranges));
+}
+
+void CPUThreadPool::RunAll(size_t num_tasks, const std::function<void(size_t)> &task) {
+  RangeTask func = [&task](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      task(i);
+    }
+  };
+  if (num_tasks <= 1 || workers_.empty()) {
+    func(0, num_tasks);
+    return;
+  }
+  Batch batch;
+  batch.func = &func;
+  batch.pending.store(num_tasks);
+  {
+    std::lock_guard<std::mutex> lock(blocking_mutex_);
+    for (size_t i = 1; i < num_tasks; ++i) {
+      blocking_tasks_.push_back({&batch, i, i + 1});
+    }
+  }
+  (void)queued_.fetch_add(num_tasks - 1);
+  if (sleepers_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.notify_all();
+  }
+  Run({&batch, 0, 1});
+  size_t self = tls_pool == this ? tls_worker : workers_.size();
+  while (batch.pending.load(std::memory_order_acquire) > 0) {
+    Task other;
+    // The tasks of this call no worker started yet run here
+    if (TakeBlockingTask(&batch, &other) || TakeTask(self, &other)) {
+      Run(other);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  if (batch.error != nullptr) {
+    std::rethrow_exception(batch.error);
+  }
+}
+
+void CPUThreadPool::RunRanges(size_t total, const RangeTask &func, size_t num_ranges) {
+  if (total == 0) {
+    return;
+  }
+  if (num_ranges <= 1 || workers_.empty()) {
+    func(0, total);
+    return;
+  }
+  size_t range_size = (total + num_ranges - 1) / num_ranges;
+  num_ranges = (total + range_size - 1) / range_size;
+
+  Batch batch;
+  batch.func = &func;
+  batch.pending.store(num_ranges);
+  size_t self = tls_pool == this ? tls_worker : workers_.size();
+  // The calling thread keeps the first range, a worker keeps the others in its own deque for the idle workers to
+  // steal, any other thread deals them out
+  size_t target = self < workers_.size() ? self : next_worker_.fetch_add(1) % workers_.size();
+  for (size_t start = range_size; start < total; start += range_size) {
+    Push(target, {&batch, start, std::min(start + range_size, total)});
+    if (self == workers_.size()) {
+      target = (target + 1) % workers_.size();
+    }
+  }
+  if (sleepers_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.notify_all();
+  }
+  Run({&batch, 0, range_size});
+  // Help with any task while the ranges of this call are running elsewhere
+  while (batch.pending.load(std::memory_order_acquire) > 0) {
+    Task task;
+    if (TakeTask(self, &task)) {
+      Run(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  if (batch.error != nullptr) {
+    std::rethrow_exception(batch.error);
+  }
+}
+
+void CPUThreadPool::Push(size_t index, const Task &task) {
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(task);
+  }
+  (void)queued_.fetch_add(1);
+}
+
+bool CPUThreadPool::TakeTask(size_t index, Task *task) {
+  if (queued_.load() == 0) {
+    return false;
+  }
+  size_t num_workers = workers_.size();
+  if (index < num_workers) {
+    Worker &own = *workers_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      *task = own.tasks.back();
+      own.tasks.pop_back();
+      (void)queued_.fetch_sub(1);
+      return true;
+    }
+  }
+  for (size_t i = 1; i <= num_workers; ++i) {
+    Worker &victim = *workers_[(index + i) % num_workers];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      *task = victim.tasks.front();
+      victim.tasks.pop_front();
+      (void)queued_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CPUThreadPool::TakeBlockingTask(const Batch *batch, Task *task) {
+  if (queued_.load() == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(blocking_mutex_);
+  for (auto iter = blocking_tasks_.begin(); iter != blocking_tasks_.end(); ++iter) {
+    if (batch == nullptr || iter->batch == batch) {
+      *task = *iter;
+      (void)blocking_tasks_.erase(iter);
+      (void)queued_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void CPUThreadPool::Run(const Task &task) {
+  Batch *batch = task.batch;
+  try {
+    (*batch->func)(task.start, task.end);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(batch->error_mutex);
+    if (batch->error == nullptr) {
+      batch->error = std::current_exception();
+    }
+  }
+  // The caller may return as soon as the count drops to 0, the batch is not touched afterwards
+  (void)batch->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void CPUThreadPool::WorkerLoop(size_t index) {
+  tls_pool = this;
+  tls_worker = index;
+  size_t idle = 0;
+  while (true) {
+    Task task;
+    // Blocking tasks are only started here, never while waiting inside another task
+    if (TakeTask(index, &task) || TakeBlockingTask(nullptr, &task)) {
+      Run(task);
+      idle = 0;
+      continue;
+    }
+    if (++idle < kIdleYieldCount) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    // Pairs with the check of sleepers_ after a push: either the pusher sees this worker sleeping, or the worker sees
+    // the pushed task
+    (void)sleepers_.fetch_add(1);
+    sleep_cv_.wait(lock, [this] { return exit_ || queued_.load() > 0; });
+    (void)sleepers_.fetch_sub(1);
+    if (exit_) {
+      return;
+    }
+    idle = 0;
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+// A range task: func(start, end) processes the elements [start, end)
+using RangeTask = std::function<void(size_t, size_t)>;
+
+// Fewest elements worth a task of their own for elementwise kernels
+constexpr size_t kMinGrainSize = 128;
+
+// The thread pool shared by all the CPU kernels of the process. Its threads live as long as the process, so a
+// kernel launch only pays for handing out its tasks, not for creating threads.
+// Each worker owns a deque of tasks: it takes its own tasks from the back, and when it runs out it steals from the
+// front of the others, so the load evens out when the tasks take uneven time or several kernels run at once.
+// The thread calling ParallelFor runs tasks too while it waits, which also makes nested calls safe.
+// The pool is sized from the CPUs the process may use: its affinity mask and its cgroup CPU quota.
+class CPUThreadPool {
+ public:
+  static CPUThreadPool &GetInstance();
+
+  ~CPUThreadPool();
+  CPUThreadPool(const CPUThreadPool &) = delete;
+  CPUThreadPool &operator=(const CPUThreadPool &) = delete;
+
+  // Split [0, total) into ranges of at least min_grain elements and run func on them in parallel.
+  // It returns once all the ranges are done, and rethrows the first exception a range threw.
+  void ParallelFor(size_t total, const RangeTask &func, size_t min_grain = 1);
+
+  // Run task(0), ..., task(num_tasks - 1) at once on threads of their own, whatever the limit of
+  // set_intra_op_threads. Unlike the ranges of ParallelFor, the tasks may block: they are only started by idle
+  // workers, never by a thread waiting inside another task. Each one must be able to finish without the others
+  // running, as the calling thread runs the tasks no worker started.
+  // It returns once all of them are done, and rethrows the first exception one threw.
+  void RunAll(size_t num_tasks, const std::function<void(size_t)> &task);
+
+  // Number of threads running tasks, the calling thread included
+  size_t num_threads() const { return workers_.size() + 1; }
+
+  // Limit the number of threads sharing the ranges of one ParallelFor call, 0 for all the threads. When several
+  // kernels run at once, this keeps one kernel from taking the whole pool.
+  void set_intra_op_threads(size_t threads) { intra_op_threads_.store(threads); }
+
+  // Number of CPUs the process may use
+  static size_t AvailableCpuNum();
+
+ private:
+  // Ranges handed out per thread, more than one so that idle threads have something to steal
+  static constexpr size_t kRangesPerThread = 4;
+
+  // The tasks of one ParallelFor call
+  struct Batch {
+    const RangeTask *func;
+    std::atomic<size_t> pending;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  struct Task {
+    Batch *batch;
+    size_t start;
+    size_t end;
+  };
+
+  struct alignas(64) Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  explicit CPUThreadPool(size_t num_workers);
+
+  // Split [0, total) into num_ranges ranges of the same size and run func on them in parallel
+  void RunRanges(size_t total, const RangeTask &func, size_t num_ranges);
+
+  void WorkerLoop(size_t index);
+
+  // Take a task of the worker, or steal one from another worker
+  // @param index - the worker taking the task, or workers_.size() for a thread of the caller
+  bool TakeTask(size_t index, Task *task);
+
+  // Take a task of RunAll
+  // @param batch - the RunAll call to take a task of, nullptr for any
+  bool TakeBlockingTask(const Batch *batch, Task *task);
+
+  void Push(size_t index, const Task &task);
+
+  static void Run(const Task &task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::mutex blocking_mutex_;
+  std::deque<Task> blocking_tasks_;  // Tasks of RunAll
+  std::atomic<size_t> queued_{0};    // Tasks waiting in the deques and in blocking_tasks_
+  std::atomic<size_t> next_worker_{0};
+  std::atomic<size_t> intra_op_threads_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  std::atomic<size_t> sleepers_{0};
+  bool exit_{false};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_THREAD_POOL_H_
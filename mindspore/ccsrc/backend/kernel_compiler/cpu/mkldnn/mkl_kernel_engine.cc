@@ -19,11 +19,17 @@
 
 namespace mindspore {
 namespace kernel {
+dnnl::stream &MKLKernelEngine::stream() {
+  thread_local dnnl::stream stream(engine_);
+  return stream;
+}
+
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  auto &stream = this->stream();
+  primitive->execute(stream, arguments);
+  (void)stream.wait();
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -34,7 +40,7 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
   }
 }
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
-  dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
+  dnnl::reorder(*src_mem, *dst_mem).execute(stream(), *src_mem, *dst_mem);
 }
 }  // namespace kernel
 }  // namespace mindspore
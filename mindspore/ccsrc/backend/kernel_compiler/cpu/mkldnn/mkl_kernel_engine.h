@@ -44,10 +44,11 @@ class MKLKernelEngine {
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0) {}
   ~MKLKernelEngine() = default;
+  // The stream of the calling thread, a stream must not be used by several threads at once
+  dnnl::stream &stream();
   dnnl::engine engine_;
-  dnnl::stream stream_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -18,15 +18,21 @@
 
 #include <vector>
 #include <memory>
-#include <thread>
-#include <unordered_map>
 #include <algorithm>
 #include <utility>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/cpu_elementwise.h"
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
+// Number of partitions of the indices to reduce, fixed so that the order of the reduced indices does not depend on
+// the machine. A prime, so that indices with a power of two stride still spread over all the partitions.
+constexpr size_t kReducePartitionNum = 61;
+// Fewest indices worth a segment of their own when partitioning
+constexpr size_t kReduceSegmentMinSize = 4096;
+
 template <typename T>
 struct SparseGradient {
   float *value_{nullptr};
@@ -67,23 +73,19 @@ struct MultiThreadComputeParams {
 template <typename T>
 using MultiThreadComputeFunc = std::function<void(MultiThreadComputeParams<T> *param, size_t start, size_t end)>;
 
+// The buffers of a thread for reducing sparse gradients. They are kept from one reduce to the next, so that a reduce
+// does not allocate once they are big enough. A thread only runs one reduce at a time: the tasks of a reduce never
+// start another one.
 template <typename T>
-struct BucketSparseGradient {
-  float *value_;
-  T *indices_;
-  T *global_indices_;
-  size_t indices_size_;
-};
-
-template <typename T>
-struct MultiThreadReduceSparseGradientParam {
-  SparseGradient<T> *input_grad_{nullptr};
-  SparseGradient<T> *workspace_grad_{nullptr};
-  SparseGradient<T> *output_grad_{nullptr};
-  size_t max_index_{0};
-  size_t value_stride_{0};
-  size_t thread_num_{0};
-  bool use_sort_reduce_{false};
+struct SparseReduceBuffer {
+  // Number of indices of each partition in each segment, then where they go
+  std::vector<size_t> segment_offsets;
+  // Where the indices of each partition start, before and after reducing them
+  std::vector<size_t> partition_offsets;
+  std::vector<size_t> output_offsets;
+  std::vector<size_t> unique_sizes;
+  // Open addressing table of a partition (index, reduced row), or the (index, position) pairs to sort
+  std::vector<std::pair<T, size_t>> entries;
 };
 
 class SparseOptimizerCPUKernel : public CPUKernel {
@@ -91,28 +93,36 @@ class SparseOptimizerCPUKernel : public CPUKernel {
   SparseOptimizerCPUKernel() = default;
   ~SparseOptimizerCPUKernel() override = default;
 
+  // Reduce the rows of the gradient with the same index, dropping the indices out of [0, max_index).
+  // The indices are partitioned by their value, each partition is reduced on its own with an open addressing table
+  // (or by sorting, with use_sort_reduce), and the reduced partitions are packed into the output. The indices come out
+  // partition after partition, in the order they first appear in a partition (sorted with use_sort_reduce), whatever
+  // the number of threads, and so do the sums.
+  // The workspace holds the partitioned indices and rows while reducing, the output has to be as big as the input.
   template <typename T>
   static void BucketReduceSparseGradient(const ReduceSparseGradientParam<T> &param) {
     MS_LOG(DEBUG) << "Start";
     MS_EXCEPTION_IF_NULL(param.input_grad_);
-    size_t thread_num = 23;
-    if (param.input_grad_->indices_size_ < thread_num) {
-      thread_num = param.input_grad_->indices_size_;
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_);
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_->value_);
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
+    MS_EXCEPTION_IF_NULL(param.output_grad_);
+    MS_EXCEPTION_IF_NULL(param.output_grad_->value_);
+    MS_EXCEPTION_IF_NULL(param.output_grad_->indices_);
+    size_t indices_size = param.input_grad_->indices_size_;
+    if (indices_size == 0) {
+      param.output_grad_->indices_size_ = 0;
+      return;
     }
-    MultiThreadReduceSparseGradientParam<T> multi_thread_param(
-      {param.input_grad_, param.workspace_grad_, param.output_grad_, param.max_index_, param.value_stride_, thread_num,
-       param.use_sort_reduce_});
-    std::vector<std::shared_ptr<SparseGradient<T>>> segments;
-    std::vector<std::shared_ptr<std::vector<size_t>>> segment_bucket_sizes;
-    SplitAndCalculateSegmentBucketSize(multi_thread_param, &segments, &segment_bucket_sizes);
-
-    std::vector<std::shared_ptr<BucketSparseGradient<T>>> buckets;
-    GatherSegmentIndicesToOutputBucket(multi_thread_param, segments, segment_bucket_sizes, &buckets);
-
-    std::vector<std::shared_ptr<SparseGradient<T>>> reduced_buckets;
-    ReduceBucketSparseGradientToWorkspace(multi_thread_param, buckets, &reduced_buckets);
-
-    MergeReduceSparseGradient(multi_thread_param, reduced_buckets);
+    MS_EXCEPTION_IF_NULL(param.input_grad_->value_);
+    MS_EXCEPTION_IF_NULL(param.input_grad_->indices_);
+    if (param.workspace_grad_->indices_size_ < indices_size || param.output_grad_->indices_size_ < indices_size) {
+      MS_LOG(EXCEPTION) << "The workspace and the output must hold " << indices_size << " indices";
+    }
+    auto &buffer = ThreadReduceBuffer<T>();
+    PartitionIndices(param, &buffer);
+    ReducePartitions(param, &buffer);
+    MergePartitions(param, &buffer);
     MS_LOG(DEBUG) << "End";
   }
 
@@ -120,313 +130,221 @@ class SparseOptimizerCPUKernel : public CPUKernel {
   template <typename T>
   void MultiThreadCompute(const MultiThreadComputeFunc<T> &func, MultiThreadComputeParams<T> *params,
                           size_t total_compute_size) const {
-    const size_t kThreadNum = 24;
-    std::vector<std::thread> threads;
-    threads.reserve(kThreadNum);
-    size_t start = 0;
-    size_t once_compute_size = (total_compute_size + kThreadNum - 1) / kThreadNum;
-    while (start < total_compute_size) {
-      size_t end = (start + once_compute_size) > total_compute_size ? total_compute_size : (start + once_compute_size);
-      threads.emplace_back(std::thread(func, params, start, end));
-      start += once_compute_size;
-    }
-    for (size_t i = 0; i < threads.size(); ++i) {
-      threads[i].join();
-    }
+    CPUThreadPool::GetInstance().ParallelFor(
+      total_compute_size, [&func, params](size_t start, size_t end) { func(params, start, end); });
   }
 
  private:
   template <typename T>
-  static void CalculateEachBucketSize(const std::shared_ptr<SparseGradient<T>> &sparse_grad, size_t max_index,
-                                      std::vector<size_t> *each_bucket_size) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(sparse_grad);
-    MS_EXCEPTION_IF_NULL(sparse_grad->indices_);
-    MS_EXCEPTION_IF_NULL(each_bucket_size);
-    size_t bucket_num = each_bucket_size->size();
-    for (size_t i = 0; i < sparse_grad->indices_size_; ++i) {
-      T index = sparse_grad->indices_[i];
-      if (index >= 0 && LongToSize(index) < max_index) {
-        auto bucket_id = index % bucket_num;
-        each_bucket_size->at(bucket_id)++;
-      }
-    }
-    MS_LOG(DEBUG) << "End";
+  static SparseReduceBuffer<T> &ThreadReduceBuffer() {
+    static thread_local SparseReduceBuffer<T> buffer;
+    return buffer;
   }
 
   template <typename T>
-  static void SplitAndCalculateSegmentBucketSize(
-    const MultiThreadReduceSparseGradientParam<T> &param, std::vector<std::shared_ptr<SparseGradient<T>>> *segments_ptr,
-    std::vector<std::shared_ptr<std::vector<size_t>>> *segment_bucket_sizes_ptr) {
-    MS_EXCEPTION_IF_NULL(param.input_grad_);
-    MS_EXCEPTION_IF_NULL(segment_bucket_sizes_ptr);
-    MS_EXCEPTION_IF_NULL(segments_ptr);
-    auto &segments = *segments_ptr;
-    auto &segment_bucket_sizes = *segment_bucket_sizes_ptr;
-    auto input_grad = param.input_grad_;
-    if (param.thread_num_ < 1) {
-      MS_EXCEPTION(ArgumentError) << "Input param thread num must > 0!";
-    }
-    size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
-    size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-    std::vector<std::thread> threads;
-    threads.reserve(param.thread_num_);
-    segments.reserve(param.thread_num_);
-
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < param.thread_num_; ++i) {
-      segment_bucket_sizes.emplace_back(std::make_shared<std::vector<size_t>>(param.thread_num_, 0));
-      size_t indices_size = thread_indices_size;
-      if (i < left_indices_size) {
-        indices_size += 1;
-      }
-      segments.emplace_back(std::make_shared<SparseGradient<T>>());
-      segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
-      segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
-      segments[i]->indices_size_ = indices_size;
-      threads.emplace_back(
-        std::thread(CalculateEachBucketSize<T>, segments[i], param.max_index_, segment_bucket_sizes[i].get()));
-      current_indices_offset += indices_size;
-    }
-
-    for (size_t i = 0; i < param.thread_num_; ++i) {
-      threads[i].join();
-    }
+  static size_t PartitionOf(T index) {
+    return static_cast<size_t>(index) % kReducePartitionNum;
   }
 
   template <typename T>
-  static void CopySegmentIndicesToBucket(const MultiThreadReduceSparseGradientParam<T> &param,
-                                         const std::shared_ptr<SparseGradient<T>> &segment, size_t bucket_offset,
-                                         const std::vector<std::shared_ptr<BucketSparseGradient<T>>> &buckets) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(segment);
-    MS_EXCEPTION_IF_NULL(segment->indices_);
-    std::vector<size_t> bucket_data_num(param.thread_num_, 0);
-    for (size_t i = 0; i < segment->indices_size_; ++i) {
-      T index = segment->indices_[i];
-      if (index >= 0 && LongToSize(index) < param.max_index_) {
-        auto bucket_id = index % param.thread_num_;
-        auto bucket_index = bucket_data_num[bucket_id];
-        buckets[bucket_id]->indices_[bucket_index] = index;
-        buckets[bucket_id]->global_indices_[bucket_index] = bucket_offset + i;
-        bucket_data_num[bucket_id]++;
-      }
-    }
-    MS_LOG(DEBUG) << "End";
+  static bool IsValidIndex(T index, size_t max_index) {
+    return index >= 0 && static_cast<size_t>(index) < max_index;
   }
 
+  // Scatter the valid indices to the output indices, partition after partition and in their order within a partition,
+  // and their positions in the input to the workspace indices
   template <typename T>
-  static void GatherSegmentIndicesToOutputBucket(
-    const MultiThreadReduceSparseGradientParam<T> &param,
-    const std::vector<std::shared_ptr<SparseGradient<T>>> &segments,
-    const std::vector<std::shared_ptr<std::vector<size_t>>> &segment_bucket_sizes,
-    std::vector<std::shared_ptr<BucketSparseGradient<T>>> *buckets_ptr) {
-    MS_EXCEPTION_IF_NULL(param.output_grad_);
-    MS_EXCEPTION_IF_NULL(param.output_grad_->value_);
-    MS_EXCEPTION_IF_NULL(param.output_grad_->indices_);
-    MS_EXCEPTION_IF_NULL(buckets_ptr);
-    auto &buckets = *buckets_ptr;
-    size_t thread_num = param.thread_num_;
-    if (thread_num != segment_bucket_sizes.size()) {
-      MS_EXCEPTION(ArgumentError) << "Input param thread num not equal to segment size!";
-    }
-    std::vector<size_t> bucket_data_size(thread_num, 0);
-    for (size_t i = 0; i < thread_num; ++i) {
-      for (size_t j = 0; j < thread_num; ++j) {
-        bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
+  static void PartitionIndices(const ReduceSparseGradientParam<T> &param, SparseReduceBuffer<T> *buffer) {
+    const T *indices = param.input_grad_->indices_;
+    size_t indices_size = param.input_grad_->indices_size_;
+    auto &pool = CPUThreadPool::GetInstance();
+    size_t segment_num =
+      std::max(static_cast<size_t>(1), std::min(indices_size / kReduceSegmentMinSize, pool.num_threads()));
+    size_t segment_size = (indices_size + segment_num - 1) / segment_num;
+    auto &offsets = buffer->segment_offsets;
+    offsets.assign(segment_num * kReducePartitionNum, 0);
+    pool.ParallelFor(segment_num, [&](size_t start, size_t end) {
+      for (size_t segment = start; segment < end; ++segment) {
+        size_t *counts = offsets.data() + segment * kReducePartitionNum;
+        size_t segment_end = std::min(indices_size, (segment + 1) * segment_size);
+        for (size_t i = segment * segment_size; i < segment_end; ++i) {
+          if (IsValidIndex(indices[i], param.max_index_)) {
+            counts[PartitionOf(indices[i])]++;
+          }
+        }
       }
-    }
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      buckets.emplace_back(std::make_shared<BucketSparseGradient<T>>());
-      buckets[i]->value_ = param.output_grad_->value_ + current_indices_offset * param.value_stride_;
-      buckets[i]->indices_ = param.output_grad_->indices_ + current_indices_offset;
-      buckets[i]->global_indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-      buckets[i]->indices_size_ = bucket_data_size[i];
-      current_indices_offset += bucket_data_size[i];
-    }
-    std::vector<size_t> tmp_bucket_data_size(thread_num, 0);
-    std::vector<std::vector<std::shared_ptr<BucketSparseGradient<T>>>> each_thread_buckets;
-    for (size_t i = 0; i < thread_num; ++i) {
-      std::vector<std::shared_ptr<BucketSparseGradient<T>>> thread_buckets;
-      for (size_t j = 0; j < thread_num; ++j) {
-        thread_buckets.emplace_back(std::make_shared<BucketSparseGradient<T>>());
-        thread_buckets[j]->indices_ = buckets[j]->indices_ + tmp_bucket_data_size[j];
-        thread_buckets[j]->global_indices_ = buckets[j]->global_indices_ + tmp_bucket_data_size[j];
-        thread_buckets[j]->value_ = buckets[j]->value_ + tmp_bucket_data_size[j] * param.value_stride_;
-        thread_buckets[j]->indices_size_ = segment_bucket_sizes[i]->at(j);
-        tmp_bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
+    });
+
+    // The indices of a partition follow each other, those of a segment after those of the segments before
+    auto &partition_offsets = buffer->partition_offsets;
+    partition_offsets.assign(kReducePartitionNum + 1, 0);
+    size_t offset = 0;
+    for (size_t partition = 0; partition < kReducePartitionNum; ++partition) {
+      partition_offsets[partition] = offset;
+      for (size_t segment = 0; segment < segment_num; ++segment) {
+        size_t count = offsets[segment * kReducePartitionNum + partition];
+        offsets[segment * kReducePartitionNum + partition] = offset;
+        offset += count;
       }
-      each_thread_buckets.emplace_back(thread_buckets);
-    }
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
-    current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads.emplace_back(
-        std::thread(CopySegmentIndicesToBucket<T>, param, segments[i], current_indices_offset, each_thread_buckets[i]));
-      current_indices_offset += segments[i]->indices_size_;
-    }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
     }
+    partition_offsets[kReducePartitionNum] = offset;
+
+    T *partitioned_indices = param.output_grad_->indices_;
+    T *positions = param.workspace_grad_->indices_;
+    pool.ParallelFor(segment_num, [&](size_t start, size_t end) {
+      for (size_t segment = start; segment < end; ++segment) {
+        size_t *next = offsets.data() + segment * kReducePartitionNum;
+        size_t segment_end = std::min(indices_size, (segment + 1) * segment_size);
+        for (size_t i = segment * segment_size; i < segment_end; ++i) {
+          T index = indices[i];
+          if (IsValidIndex(index, param.max_index_)) {
+            size_t pos = next[PartitionOf(index)]++;
+            partitioned_indices[pos] = index;
+            positions[pos] = static_cast<T>(i);
+          }
+        }
+      }
+    });
   }
 
   template <typename T>
-  static void SortAndReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                                const std::shared_ptr<BucketSparseGradient<T>> &bucket,
-                                                const std::shared_ptr<SparseGradient<T>> &reduced_bucket) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(bucket);
-    MS_EXCEPTION_IF_NULL(bucket->value_);
-    MS_EXCEPTION_IF_NULL(bucket->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
-    std::vector<std::pair<T, T>> sorted_indices;
-    sorted_indices.reserve(bucket->indices_size_);
-    for (size_t i = 0; i < bucket->indices_size_; ++i) {
-      T index = bucket->indices_[i];
-      T global_index = bucket->global_indices_[i];
-      sorted_indices.emplace_back(std::pair<T, T>(index, global_index));
-    }
-    std::sort(sorted_indices.begin(), sorted_indices.end());
-
-    float *global_value = param.input_grad_->value_;
-    size_t unique_indices_size = 0;
-    size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-    T last_index{0};
-    size_t value_offset{0};
-    for (size_t i = 0; i < sorted_indices.size(); ++i) {
-      T index = sorted_indices[i].first;
-      T global_index = sorted_indices[i].second;
-      T global_value_offset = global_index * param.value_stride_;
-      if (i == 0 || index != last_index) {
-        if (i != 0) {
-          unique_indices_size++;
+  static void ReducePartitions(const ReduceSparseGradientParam<T> &param, SparseReduceBuffer<T> *buffer) {
+    auto &unique_sizes = buffer->unique_sizes;
+    unique_sizes.assign(kReducePartitionNum, 0);
+    const auto &partition_offsets = buffer->partition_offsets;
+    auto add_row = ElementwiseBinaryRow<float>();
+    CPUThreadPool::GetInstance().ParallelFor(kReducePartitionNum, [&](size_t start, size_t end) {
+      for (size_t partition = start; partition < end; ++partition) {
+        size_t begin = partition_offsets[partition];
+        size_t size = partition_offsets[partition + 1] - begin;
+        if (size == 0) {
+          continue;
         }
-        reduced_bucket->indices_[unique_indices_size] = index;
-        value_offset = unique_indices_size * param.value_stride_;
-        auto ret_code = memcpy_s(reduced_bucket->value_ + value_offset, (max_length - value_offset) * sizeof(float),
-                                 global_value + global_value_offset, param.value_stride_ * sizeof(float));
-        if (ret_code != EOK) {
-          MS_LOG(EXCEPTION) << "Failed to copy data!";
-        }
-      } else {
-        for (size_t j = 0; j < param.value_stride_; ++j) {
-          reduced_bucket->value_[value_offset + j] += global_value[global_value_offset + j];
+        if (param.use_sort_reduce_) {
+          unique_sizes[partition] = SortAndReducePartition(param, begin, size, add_row);
+        } else {
+          unique_sizes[partition] = HashReducePartition(param, begin, size, add_row);
         }
       }
-      last_index = index;
+    });
+  }
+
+  // Copy the first row of an index, or add the next ones to it
+  static void AccumulateRow(const float *row, size_t stride, bool first, float *reduced_row,
+                            BinaryRowFunc<float> add_row) {
+    if (first) {
+      auto ret_code = memcpy_s(reduced_row, stride * sizeof(float), row, stride * sizeof(float));
+      if (ret_code != EOK) {
+        MS_LOG(EXCEPTION) << "Failed to copy data!";
+      }
+      return;
     }
-    reduced_bucket->indices_size_ = unique_indices_size;
-    MS_LOG(DEBUG) << "End";
+    (void)add_row(ADD, reduced_row, 1, row, 1, reduced_row, stride);
   }
 
+  // Reduce the partition at [begin, begin + size) to the workspace, from the same place: the reduced indices overwrite
+  // the positions already read.
+  // @return size_t - the number of unique indices of the partition
   template <typename T>
-  static void ReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                         const std::shared_ptr<BucketSparseGradient<T>> &bucket,
-                                         const std::shared_ptr<SparseGradient<T>> &reduced_bucket) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(bucket);
-    MS_EXCEPTION_IF_NULL(bucket->value_);
-    MS_EXCEPTION_IF_NULL(bucket->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
+  static size_t HashReducePartition(const ReduceSparseGradientParam<T> &param, size_t begin, size_t size,
+                                    BinaryRowFunc<float> add_row) {
+    const T *indices = param.output_grad_->indices_ + begin;
+    T *positions = param.workspace_grad_->indices_ + begin;
+    float *reduced_values = param.workspace_grad_->value_ + begin * param.value_stride_;
+    const float *values = param.input_grad_->value_;
+    size_t stride = param.value_stride_;
 
-    float *global_value = param.input_grad_->value_;
-    std::unordered_map<T, size_t> index_map;
-    size_t unique_indices_size = 0;
-    size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-    for (size_t i = 0; i < bucket->indices_size_; ++i) {
-      T index = bucket->indices_[i];
-      T global_index = bucket->global_indices_[i];
-      auto iter = index_map.find(index);
-      if (iter == index_map.end()) {
-        reduced_bucket->indices_[unique_indices_size] = index;
-        size_t start_index = unique_indices_size * param.value_stride_;
-        index_map[index] = start_index;
-        auto ret_code =
-          memcpy_s(reduced_bucket->value_ + start_index, (max_length - start_index) * sizeof(float),
-                   global_value + global_index * param.value_stride_, param.value_stride_ * sizeof(float));
-        if (ret_code != EOK) {
-          MS_LOG(EXCEPTION) << "Failed to copy data!";
-        }
-        unique_indices_size++;
-      } else {
-        size_t start_index = iter->second;
-        size_t end_index = start_index + param.value_stride_;
-        for (size_t j = start_index, k = global_index * param.value_stride_; j < end_index; ++j, ++k) {
-          reduced_bucket->value_[j] += global_value[k];
-        }
+    // At most half full, the indices of a partition share their remainder so the table hashes the whole index
+    size_t bits = 4;
+    while ((static_cast<size_t>(1) << bits) < size * 2) {
+      bits++;
+    }
+    size_t mask = (static_cast<size_t>(1) << bits) - 1;
+    auto &table = ThreadReduceBuffer<T>().entries;
+    table.assign(mask + 1, std::make_pair(static_cast<T>(-1), static_cast<size_t>(0)));
+    size_t unique_size = 0;
+    for (size_t i = 0; i < size; ++i) {
+      T index = indices[i];
+      size_t position = static_cast<size_t>(positions[i]);
+      size_t slot = static_cast<size_t>((static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+      while (table[slot].first != index && table[slot].first != static_cast<T>(-1)) {
+        slot = (slot + 1) & mask;
+      }
+      bool first = table[slot].first != index;
+      if (first) {
+        table[slot] = std::make_pair(index, unique_size);
+        positions[unique_size] = index;
+        unique_size++;
       }
+      AccumulateRow(values + position * stride, stride, first, reduced_values + table[slot].second * stride, add_row);
     }
-    reduced_bucket->indices_size_ = unique_indices_size;
-    MS_LOG(DEBUG) << "End";
+    return unique_size;
   }
 
   template <typename T>
-  static void ReduceBucketSparseGradientToWorkspace(
-    const MultiThreadReduceSparseGradientParam<T> &param,
-    const std::vector<std::shared_ptr<BucketSparseGradient<T>>> &buckets,
-    std::vector<std::shared_ptr<SparseGradient<T>>> *reduced_buckets_ptr) {
-    MS_EXCEPTION_IF_NULL(param.workspace_grad_);
-    MS_EXCEPTION_IF_NULL(param.workspace_grad_->value_);
-    MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
-    auto &reduced_buckets = *reduced_buckets_ptr;
-    size_t thread_num = buckets.size();
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
+  static size_t SortAndReducePartition(const ReduceSparseGradientParam<T> &param, size_t begin, size_t size,
+                                       BinaryRowFunc<float> add_row) {
+    const T *indices = param.output_grad_->indices_ + begin;
+    T *reduced_indices = param.workspace_grad_->indices_ + begin;
+    float *reduced_values = param.workspace_grad_->value_ + begin * param.value_stride_;
+    const float *values = param.input_grad_->value_;
+    size_t stride = param.value_stride_;
 
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      reduced_buckets.emplace_back(std::make_shared<SparseGradient<T>>());
-      reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
-      reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-      reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-      if (param.use_sort_reduce_) {
-        threads.emplace_back(std::thread(SortAndReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      } else {
-        threads.emplace_back(std::thread(ReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      }
-      current_indices_offset += buckets[i]->indices_size_;
+    auto &sorted = ThreadReduceBuffer<T>().entries;
+    sorted.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      sorted[i] = std::make_pair(indices[i], static_cast<size_t>(reduced_indices[i]));
     }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
+    std::sort(sorted.begin(), sorted.end());
+    size_t unique_size = 0;
+    for (size_t i = 0; i < size; ++i) {
+      bool first = i == 0 || sorted[i].first != sorted[i - 1].first;
+      if (first) {
+        reduced_indices[unique_size] = sorted[i].first;
+        unique_size++;
+      }
+      AccumulateRow(values + sorted[i].second * stride, stride, first, reduced_values + (unique_size - 1) * stride,
+                    add_row);
     }
+    return unique_size;
   }
 
+  // Pack the reduced partitions from the workspace to the output
   template <typename T>
-  static void MergeReduceSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                        const std::vector<std::shared_ptr<SparseGradient<T>>> &reduced_buckets) {
-    MS_EXCEPTION_IF_NULL(param.output_grad_);
-    auto output_grad = param.output_grad_;
-    MS_EXCEPTION_IF_NULL(output_grad->value_);
-    MS_EXCEPTION_IF_NULL(output_grad->indices_);
-    size_t stride_data_size = param.value_stride_ * sizeof(float);
+  static void MergePartitions(const ReduceSparseGradientParam<T> &param, SparseReduceBuffer<T> *buffer) {
+    const auto &partition_offsets = buffer->partition_offsets;
+    const auto &unique_sizes = buffer->unique_sizes;
+    auto &output_offsets = buffer->output_offsets;
+    output_offsets.assign(kReducePartitionNum, 0);
     size_t unique_indices_size = 0;
-    for (size_t i = 0; i < reduced_buckets.size(); ++i) {
-      auto &bucket = reduced_buckets[i];
-      MS_EXCEPTION_IF_NULL(bucket);
-      if (bucket->indices_size_ == 0) {
-        continue;
-      }
-      auto ret_code = memcpy_s(output_grad->value_ + unique_indices_size * param.value_stride_,
-                               (output_grad->indices_size_ - unique_indices_size) * stride_data_size, bucket->value_,
-                               bucket->indices_size_ * stride_data_size);
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "Failed to copy data!";
-      }
-      ret_code = memcpy_s(output_grad->indices_ + unique_indices_size,
-                          (output_grad->indices_size_ - unique_indices_size) * sizeof(T), bucket->indices_,
-                          bucket->indices_size_ * sizeof(T));
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "Failed to copy data!";
-      }
-      unique_indices_size += bucket->indices_size_;
+    for (size_t partition = 0; partition < kReducePartitionNum; ++partition) {
+      output_offsets[partition] = unique_indices_size;
+      unique_indices_size += unique_sizes[partition];
     }
+    auto output_grad = param.output_grad_;
+    auto workspace_grad = param.workspace_grad_;
+    size_t stride = param.value_stride_;
+    size_t output_size = output_grad->indices_size_;
+    CPUThreadPool::GetInstance().ParallelFor(kReducePartitionNum, [&](size_t start, size_t end) {
+      for (size_t partition = start; partition < end; ++partition) {
+        size_t size = unique_sizes[partition];
+        if (size == 0) {
+          continue;
+        }
+        size_t from = partition_offsets[partition];
+        size_t to = output_offsets[partition];
+        auto ret_code = memcpy_s(output_grad->value_ + to * stride, (output_size - to) * stride * sizeof(float),
+                                 workspace_grad->value_ + from * stride, size * stride * sizeof(float));
+        if (ret_code != EOK) {
+          MS_LOG(EXCEPTION) << "Failed to copy data!";
+        }
+        ret_code = memcpy_s(output_grad->indices_ + to, (output_size - to) * sizeof(T), workspace_grad->indices_ + from,
+                            size * sizeof(T));
+        if (ret_code != EOK) {
+          MS_LOG(EXCEPTION) << "Failed to copy data!";
+        }
+      }
+    });
     output_grad->indices_size_ = unique_indices_size;
   }
 
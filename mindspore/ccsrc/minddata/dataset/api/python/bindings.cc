@@ -64,6 +64,13 @@ PYBIND_REGISTER(
              THROW_IF_ERROR(de.GetNextAsList(&out));
              return out;
            })
+      .def("GetState",
+           [](DEPipeline &de) {
+             std::string state;
+             THROW_IF_ERROR(de.GetState(&state));
+             return state;
+           })
+      .def("Resume", [](DEPipeline &de, const std::string &state) { THROW_IF_ERROR(de.Resume(state)); })
       .def("GetOutputShapes",
            [](DEPipeline &de) {
              py::list out;
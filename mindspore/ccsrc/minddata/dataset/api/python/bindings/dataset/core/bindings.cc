@@ -47,6 +47,14 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
                     .def("get_callback_timeout", &ConfigManager::callback_timeout)
                     .def("set_callback_timeout", &ConfigManager::set_callback_timeout)
+                    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+                    .def("get_enable_autotune", &ConfigManager::enable_autotune)
+                    .def("set_enable_mindrecord_mmap", &ConfigManager::set_enable_mindrecord_mmap)
+                    .def("get_enable_mindrecord_mmap", &ConfigManager::enable_mindrecord_mmap)
+                    .def("set_mindrecord_prefetch_size", &ConfigManager::set_mindrecord_prefetch_size)
+                    .def("get_mindrecord_prefetch_size", &ConfigManager::mindrecord_prefetch_size)
+                    .def("set_numa_enable", &ConfigManager::set_numa_enable)
+                    .def("get_numa_enable", &ConfigManager::numa_enable)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
@@ -25,7 +25,9 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                   (void)py::class_<CacheClient, std::shared_ptr<CacheClient>>(*m, "CacheClient")
                     .def(py::init([](session_id_type id, uint64_t mem_sz, bool spill,
                                      std::optional<std::string> hostname, std::optional<int32_t> port,
-                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz) {
+                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz,
+                                     std::optional<std::vector<std::string>> image_columns,
+                                     std::optional<float> image_scale, std::optional<bool> chroma_subsampling) {
                       std::shared_ptr<CacheClient> cc;
                       CacheClient::Builder builder;
                       builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill);
@@ -33,6 +35,9 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                       if (port) builder.SetPort(port.value());
                       if (num_connections) builder.SetNumConnections(num_connections.value());
                       if (prefetch_sz) builder.SetPrefetchSize(prefetch_sz.value());
+                      if (image_columns) builder.SetImageColumns(image_columns.value());
+                      if (image_scale) builder.SetImageScale(image_scale.value());
+                      if (chroma_subsampling) builder.SetChromaSubsampling(chroma_subsampling.value());
                       THROW_IF_ERROR(builder.Build(&cc));
                       return cc;
                     }))
@@ -32,6 +32,7 @@
 #include "minddata/dataset/engine/datasetops/source/mindrecord_op.h"
 #include "minddata/dataset/engine/datasetops/source/mnist_op.h"
 #include "minddata/dataset/engine/datasetops/source/random_data_op.h"
+#include "minddata/dataset/engine/datasetops/source/shared_row_ring.h"
 #include "minddata/dataset/engine/datasetops/source/text_file_op.h"
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 #include "minddata/dataset/engine/datasetops/source/voc_op.h"
@@ -138,6 +139,74 @@ PYBIND_REGISTER(MnistOp, 1, ([](const py::module *m) {
                     });
                 }));
 
+PYBIND_REGISTER(SharedRowRing, 0, ([](const py::module *m) {
+                  (void)py::class_<SharedRowRing, std::shared_ptr<SharedRowRing>>(*m, "SharedRowRing")
+                    .def(py::init([](int32_t num_slots, int64_t slot_size) {
+                      std::shared_ptr<SharedRowRing> ring;
+                      THROW_IF_ERROR(SharedRowRing::CreateSharedRowRing(num_slots, slot_size, &ring));
+                      return ring;
+                    }))
+                    // Push a tuple of arrays, a row with a column that is not numeric is pickled.
+                    // Return False if the ring was closed while waiting for a free slot.
+                    .def("push_row",
+                         [](SharedRowRing &ring, const py::tuple &row) {
+                           std::vector<py::array> arrays;
+                           std::vector<SharedRowRing::ColumnView> columns;
+                           for (auto item : row) {
+                             py::array arr = py::array::ensure(item, py::array::c_style);
+                             DataType type = arr ? DataType::FromNpArray(arr) : DataType();
+                             if (type == DataType::DE_UNKNOWN || !type.IsNumeric()) {
+                               columns.clear();
+                               break;
+                             }
+                             SharedRowRing::ColumnView col;
+                             col.type = type;
+                             col.shape.assign(arr.shape(), arr.shape() + arr.ndim());
+                             col.data = arr.data();
+                             col.nbytes = arr.nbytes();
+                             columns.push_back(std::move(col));
+                             arrays.push_back(std::move(arr));
+                           }
+                           Status rc;
+                           if (columns.size() == row.size()) {
+                             py::gil_scoped_release gil_release;
+                             rc = ring.PushRow(columns);
+                           } else {
+                             auto payload = py::module::import("pickle").attr("dumps")(row, -1).cast<std::string>();
+                             py::gil_scoped_release gil_release;
+                             rc = ring.PushPayload(SharedRowRing::SlotKind::kPickledRow, payload);
+                           }
+                           if (rc.IsInterrupted()) {
+                             return false;
+                           }
+                           THROW_IF_ERROR(rc);
+                           return true;
+                         })
+                    .def("push_error",
+                         [](SharedRowRing &ring, const std::string &message) {
+                           py::gil_scoped_release gil_release;
+                           Status rc = ring.PushPayload(SharedRowRing::SlotKind::kError, message);
+                           if (rc.IsInterrupted()) {
+                             return false;
+                           }
+                           THROW_IF_ERROR(rc);
+                           return true;
+                         })
+                    .def("push_eoe",
+                         [](SharedRowRing &ring) {
+                           py::gil_scoped_release gil_release;
+                           Status rc = ring.PushEoe();
+                           if (rc.IsInterrupted()) {
+                             return false;
+                           }
+                           THROW_IF_ERROR(rc);
+                           return true;
+                         })
+                    // Set the worker process pushing into the ring, right after it is started
+                    .def("set_producer", &SharedRowRing::SetProducer)
+                    .def("close", &SharedRowRing::Close);
+                }));
+
 PYBIND_REGISTER(TextFileOp, 1, ([](const py::module *m) {
                   (void)py::class_<TextFileOp, DatasetOp, std::shared_ptr<TextFileOp>>(*m, "TextFileOp")
                     .def_static("get_num_rows", [](const py::list &files) {
@@ -81,7 +81,25 @@ PYBIND_REGISTER(SubsetRandomSampler, 1, ([](const py::module *m) {
 PYBIND_REGISTER(WeightedRandomSampler, 1, ([](const py::module *m) {
                   (void)py::class_<WeightedRandomSampler, Sampler, std::shared_ptr<WeightedRandomSampler>>(
                     *m, "WeightedRandomSampler")
-                    .def(py::init<int64_t, std::vector<double>, bool>());
+                    .def(py::init<int64_t, std::vector<double>, bool>())
+                    .def(py::init([](int64_t num_samples, std::vector<double> weights, bool replacement,
+                                     int64_t num_shards, int64_t shard_id) {
+                      return std::make_shared<WeightedRandomSampler>(num_samples, weights, replacement,
+                                                                     std::numeric_limits<int64_t>::max(), num_shards,
+                                                                     shard_id);
+                    }))
+                    .def("update_weights",
+                         [](WeightedRandomSampler &self, std::vector<int64_t> ids, std::vector<double> weights) {
+                           THROW_IF_ERROR(self.UpdateWeights(ids, weights));
+                         });
+                  (void)py::class_<WeightedRandomSamplerGroup, std::shared_ptr<WeightedRandomSamplerGroup>>(
+                    *m, "WeightedRandomSamplerGroup")
+                    .def(py::init<>())
+                    .def("add", &WeightedRandomSamplerGroup::Add)
+                    .def("update_weights",
+                         [](WeightedRandomSamplerGroup &self, std::vector<int64_t> ids, std::vector<double> weights) {
+                           THROW_IF_ERROR(self.UpdateWeights(ids, weights));
+                         });
                 }));
 
 }  // namespace dataset
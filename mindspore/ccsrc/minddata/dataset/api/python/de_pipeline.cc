@@ -93,7 +93,7 @@ static std::unordered_map<uint32_t, pFunction> g_parse_op_func_ = {
   {kCsv, &DEPipeline::ParseCsvOp},
   {kSentencePieceVocab, &DEPipeline::ParseBuildSentencePieceVocabOp}};
 
-DEPipeline::DEPipeline() : iterator_(nullptr) {
+DEPipeline::DEPipeline() : iterator_(nullptr), epochs_consumed_(0), rows_consumed_(0), rows_to_drop_(0) {
   try {
     // One time init
     (void)GlobalInit();
@@ -152,6 +152,14 @@ Status DEPipeline::AddNodeToTree(const OpName &op_name, const py::dict &args, py
     // then set top and bottom to be the same operator
     if (bottom == nullptr) bottom = top;
 
+    // The connectors are created when the tree is prepared, so their kind is chosen now for every node built
+    if (args.contains("lock_free_connector") && args["lock_free_connector"].cast<bool>()) {
+      for (DsOpPtr op = top; op != nullptr; op = op->Children().empty() ? nullptr : op->Children()[0]) {
+        op->SetLockFreeConnector(true);
+        if (op == bottom) break;
+      }
+    }
+
     // Pack these pointers into a py dict so that we can return both back to python.
     (*output)["top"] = top;
     (*output)["bottom"] = bottom;
@@ -180,9 +188,53 @@ Status DEPipeline::LaunchTreeExec() {
   RETURN_IF_NOT_OK(tree_->Launch());
   iterator_ = std::make_unique<DatasetIterator>(tree_);
   if (iterator_ == nullptr) RETURN_STATUS_UNEXPECTED("Cannot create an Iterator.");
+  if (rows_to_drop_ > 0) {
+    py::gil_scoped_release gil_release;
+    TensorRow row;
+    for (; rows_to_drop_ > 0; rows_to_drop_--) {
+      RETURN_IF_NOT_OK(iterator_->FetchNextTensorRow(&row));
+      CHECK_FAIL_RETURN_UNEXPECTED(!row.empty(), "The epoch to resume has fewer rows than consumed before.");
+    }
+  }
+  return Status::OK();
+}
+
+Status DEPipeline::GetState(std::string *state) {
+  nlohmann::json js;
+  js["epoch"] = epochs_consumed_;
+  js["row"] = rows_consumed_;
+  RETURN_IF_NOT_OK(tree_->SaveState(&js["ops"]));
+  *state = js.dump();
   return Status::OK();
 }
 
+Status DEPipeline::Resume(const std::string &state) {
+  nlohmann::json js;
+  try {
+    js = nlohmann::json::parse(state);
+    epochs_consumed_ = js.at("epoch").get<int64_t>();
+    rows_consumed_ = js.at("row").get<int64_t>();
+  } catch (const std::exception &err) {
+    RETURN_STATUS_UNEXPECTED("Invalid state to resume from: " + std::string(err.what()));
+  }
+  RETURN_IF_NOT_OK(tree_->Resume(js.value("ops", nlohmann::json::object()), epochs_consumed_, rows_consumed_,
+                                 &rows_to_drop_));
+  // Rows sent to a device cannot be dropped here
+  bool to_device = std::dynamic_pointer_cast<DeviceQueueOp>(tree_->root()) != nullptr;
+  CHECK_FAIL_RETURN_UNEXPECTED(rows_to_drop_ == 0 || !to_device,
+                               "The pipeline cannot skip the rows of an epoch, it cannot resume mid epoch on a device.");
+  return Status::OK();
+}
+
+void DEPipeline::CountRow(bool empty) {
+  if (!empty) {
+    rows_consumed_++;
+  } else if (!iterator_->eof_handled()) {
+    epochs_consumed_++;
+    rows_consumed_ = 0;
+  }
+}
+
 void DEPipeline::PrintTree() {
   for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
     std::stringstream ss;
@@ -218,6 +270,7 @@ Status DEPipeline::GetNextAsMap(py::dict *output) {
     s = iterator_->GetNextAsOrderedPair(&vec);
   }
   RETURN_IF_NOT_OK(s);
+  CountRow(vec.empty());
 
   // Generate Python dict, python dict maintains its insertion order
   for (const auto &pair : vec) {
@@ -234,6 +287,7 @@ Status DEPipeline::GetNextAsList(py::list *output) {
     s = iterator_->FetchNextTensorRow(&row);
   }
   RETURN_IF_NOT_OK(s);
+  CountRow(row.empty());
   // Generate Python list as return
   for (auto el : row) {
     output->append(el);
@@ -901,6 +955,9 @@ Status DEPipeline::ParseGeneratorOp(const py::dict &args, std::shared_ptr<Datase
         (void)builder->SetColumnNames(ToStringVector(value));
       } else if (key == "column_types") {
         (void)builder->SetColumnTypes(ToTypeVector(value));
+      } else if (key == "shared_rings") {
+        (void)builder->SetSharedRings(py::reinterpret_borrow<py::list>(value)
+                                        .cast<std::vector<std::shared_ptr<SharedRowRing>>>());
       }
     }
   }
@@ -107,6 +107,13 @@ class DEPipeline {
   // Get a row of data as list.
   Status GetNextAsList(py::list *output);
 
+  // Get what another run of the same pipeline needs to resume where this one is: the number of epochs and rows
+  // consumed and the state of the operators, as a json string.
+  Status GetState(std::string *state);
+
+  // Resume where the run that gave a state from GetState left off. Called after PrepareTree and before LaunchTreeExec.
+  Status Resume(const std::string &state);
+
   Status GetOutputShapes(py::list *output);
 
   Status GetOutputTypes(py::list *output);
@@ -219,6 +226,13 @@ class DEPipeline {
 
   std::unique_ptr<DatasetIterator> iterator_;
 
+  // Count a row fetched by the consumer, an empty one ends an epoch
+  void CountRow(bool empty);
+
+  int64_t epochs_consumed_;  // Number of epochs the consumer completed
+  int64_t rows_consumed_;    // Number of rows of the current epoch the consumer fetched
+  int64_t rows_to_drop_;     // Rows of a resumed epoch the tree could not skip, dropped at launch
+
   static Status ParsePadInfo(py::handle value, PadInfo *pad_info);
 
   /// \brief Helper function to inject a cache operator over top of the current operation being built.
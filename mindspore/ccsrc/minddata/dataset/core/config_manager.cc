@@ -37,6 +37,10 @@ ConfigManager::ConfigManager()
       seed_(kCfgDefaultSeed),
       monitor_sampling_interval_(kCfgMonitorSamplingInterval),
       callback_timout_(kCfgCallbackTimeout),
+      enable_autotune_(kCfgEnableAutoTune),
+      enable_mindrecord_mmap_(kCfgEnableMindRecordMmap),
+      mindrecord_prefetch_size_(kCfgMindRecordPrefetchSize),
+      numa_enable_(kCfgEnableNuma),
       cache_host_(kCfgDefaultCacheHost),
       cache_port_(kCfgDefaultCachePort),
       num_connections_(kDftNumConnections),
@@ -80,6 +84,10 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_cache_port(j.value("cachePort", cache_port_));
   set_num_connections(j.value("numConnections", num_connections_));
   set_prefetch_size(j.value("prefetchSize", prefetch_size_));
+  set_enable_autotune(j.value("enableAutoTune", enable_autotune_));
+  set_enable_mindrecord_mmap(j.value("enableMindRecordMmap", enable_mindrecord_mmap_));
+  set_mindrecord_prefetch_size(j.value("mindRecordPrefetchSize", mindrecord_prefetch_size_));
+  set_numa_enable(j.value("numaEnable", numa_enable_));
   return Status::OK();
 }
 
@@ -129,6 +137,14 @@ void ConfigManager::set_monitor_sampling_interval(uint32_t interval) { monitor_s
 
 void ConfigManager::set_callback_timeout(uint32_t timeout) { callback_timout_ = timeout; }
 
+void ConfigManager::set_enable_autotune(bool enable) { enable_autotune_ = enable; }
+
+void ConfigManager::set_enable_mindrecord_mmap(bool enable) { enable_mindrecord_mmap_ = enable; }
+
+void ConfigManager::set_mindrecord_prefetch_size(int32_t prefetch_size) { mindrecord_prefetch_size_ = prefetch_size; }
+
+void ConfigManager::set_numa_enable(bool numa_enable) { numa_enable_ = numa_enable; }
+
 void ConfigManager::set_cache_host(std::string cache_host) { cache_host_ = std::move(cache_host); }
 
 void ConfigManager::set_cache_port(int32_t cache_port) { cache_port_ = cache_port; }
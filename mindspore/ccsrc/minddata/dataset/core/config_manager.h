@@ -159,6 +159,38 @@ class ConfigManager {
   // @return The timeout DSWaitedCallback would wait for before raising an error
   int32_t callback_timeout() const { return callback_timout_; }
 
+  // setter function
+  // @param enable - If the pipeline should be tuned by AutoTune while it runs
+  void set_enable_autotune(bool enable);
+
+  // getter function
+  // @return If the pipeline is tuned by AutoTune while it runs
+  bool enable_autotune() const { return enable_autotune_; }
+
+  // setter function
+  // @param enable - If MindRecord files should be memory mapped and read without copying the blob data
+  void set_enable_mindrecord_mmap(bool enable);
+
+  // getter function
+  // @return If MindRecord files are memory mapped and read without copying the blob data
+  bool enable_mindrecord_mmap() const { return enable_mindrecord_mmap_; }
+
+  // setter function
+  // @param prefetch_size - The number of rows MindRecord io threads read ahead of the workers, 0 to disable
+  void set_mindrecord_prefetch_size(int32_t prefetch_size);
+
+  // getter function
+  // @return The number of rows MindRecord io threads read ahead of the workers
+  int32_t mindrecord_prefetch_size() const { return mindrecord_prefetch_size_; }
+
+  // setter function
+  // @param numa_enable - If the threads of each pipeline are bound to the NUMA node of its device
+  void set_numa_enable(bool numa_enable);
+
+  // getter function
+  // @return If the threads of each pipeline are bound to the NUMA node of its device
+  bool numa_enable() const { return numa_enable_; }
+
  private:
   int32_t rows_per_buffer_;
   int32_t num_parallel_workers_;
@@ -167,6 +199,10 @@ class ConfigManager {
   uint32_t seed_;
   uint32_t monitor_sampling_interval_;
   uint32_t callback_timout_;
+  bool enable_autotune_;
+  bool enable_mindrecord_mmap_;
+  int32_t mindrecord_prefetch_size_;
+  bool numa_enable_;
   std::string cache_host_;
   int32_t cache_port_;
   int32_t num_connections_;
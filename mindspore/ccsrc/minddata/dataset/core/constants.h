@@ -69,6 +69,10 @@ constexpr uint32_t kCfgOpConnectorSize = 16;
 constexpr uint32_t kCfgDefaultSeed = std::mt19937::default_seed;
 constexpr uint32_t kCfgMonitorSamplingInterval = 10;
 constexpr uint32_t kCfgCallbackTimeout = 60;  // timeout value for callback in seconds
+constexpr bool kCfgEnableAutoTune = false;
+constexpr bool kCfgEnableMindRecordMmap = false;
+constexpr int32_t kCfgMindRecordPrefetchSize = 0;
+constexpr bool kCfgEnableNuma = false;
 constexpr int32_t kCfgDefaultCachePort = 50052;
 constexpr char kCfgDefaultCacheHost[] = "127.0.0.1";
 constexpr int32_t kDftPrefetchSize = 20;
@@ -69,7 +69,8 @@ Tensor::Tensor(Tensor &&other) noexcept
       type_(other.type()),
       data_(other.GetMutableBuffer()),
       data_end_(other.data_end_),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_allocator_(std::move(other.data_allocator_)),
+      data_owner_(std::move(other.data_owner_)) {
   other.Invalidate();
 }
 
@@ -80,6 +81,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     data_ = other.GetMutableBuffer();
     data_end_ = other.data_end_;
     data_allocator_ = std::move(other.data_allocator_);
+    data_owner_ = std::move(other.data_owner_);
     other.Invalidate();
   }
   return *this;
@@ -137,6 +139,22 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateFromMemoryView(const TensorShape &shape, const DataType &type, uchar *src,
+                                    std::shared_ptr<void> owner, TensorPtr *out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(src != nullptr, "Pointer to source data is null.");
+  CHECK_FAIL_RETURN_UNEXPECTED(owner != nullptr, "Owner of source data is null.");
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.known(), "Invalid shape.");
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "Only numeric tensors can reference memory in place.");
+  CHECK_FAIL_RETURN_UNEXPECTED(reinterpret_cast<uintptr_t>(src) % type.SizeInBytes() == 0,
+                               "Source data is not aligned to the size of the data type.");
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  (*out)->data_ = src;
+  (*out)->data_end_ = src + (*out)->SizeInBytes();
+  (*out)->data_owner_ = std::move(owner);
+  return Status::OK();
+}
+
 #ifdef ENABLE_PYTHON
 Status Tensor::CreateFromNpString(py::array arr, std::shared_ptr<Tensor> *out) {
   std::vector<dsize_t> shape;
@@ -342,7 +360,11 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Description: Destructor
 Tensor::~Tensor() {
   if (data_ != nullptr) {
-    if (data_allocator_ != nullptr) {
+    if (data_owner_ != nullptr) {
+      // The data is borrowed, it is released with its owner
+      data_ = nullptr;
+      data_end_ = nullptr;
+    } else if (data_allocator_ != nullptr) {
       data_allocator_->deallocate(data_);
       data_ = nullptr;
       data_end_ = nullptr;
@@ -473,6 +495,7 @@ void Tensor::Invalidate() {
   data_ = nullptr;
   data_end_ = nullptr;
   data_allocator_ = nullptr;
+  data_owner_ = nullptr;
 }
 
 template <typename T>
@@ -115,6 +115,18 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor that references memory owned by another object instead of copying it. Length of the
+  /// data is determined from the shape and type. The memory is not freed by the tensor, `owner` is held as long as the
+  /// tensor lives to keep it valid. The memory may be written in place by later ops.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] src pointer to the data, it has to be aligned to the size of `type`
+  /// \param[in] owner object that keeps the data alive
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromMemoryView(const TensorShape &shape, const DataType &type, uchar *src,
+                                     std::shared_ptr<void> owner, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -684,6 +696,8 @@ class Tensor {
   CharAllocPtr data_allocator_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  /// owner of data_ when the tensor references memory it did not allocate, data_ is not freed if it is set
+  std::shared_ptr<void> data_owner_;
 
  private:
 #ifdef ENABLE_ANDROID
@@ -709,6 +723,11 @@ class Tensor {
   /// const of the size of the offset variable
   static constexpr uint8_t kOffsetSize = sizeof(offset_t);
 
+  /// Helper function to create a tensor of strings, the layout is described at its definition
+  /// \tparam S std::string or std::string_view
+  template <typename S>
+  static Status CreateFromStrings(const std::vector<S> &items, const TensorShape &shape, TensorPtr *out);
+
 #ifdef ENABLE_PYTHON
   /// Helper function to create a tensor from Numpy array of strings
   /// \param[in] arr Numpy array
@@ -739,9 +758,8 @@ inline Tensor::TensorIterator<std::string_view> Tensor::end<std::string_view>()
 /// \param[in] shape shape of the output tensor
 /// \param[out] out output argument to hold the created Tensor
 /// \return Status Code
-template <>
-inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::string> &items, const TensorShape &shape,
-                                                    TensorPtr *out) {
+template <typename S>
+inline Status Tensor::CreateFromStrings(const std::vector<S> &items, const TensorShape &shape, TensorPtr *out) {
   CHECK_FAIL_RETURN_UNEXPECTED(
     items.size() == shape.NumOfElements(),
     "Number of elements in the vector does not match the number of elements of the shape required");
@@ -753,7 +771,7 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
       return (*out)->Reshape(shape);
     }
   }
-  auto length_sum = [](dsize_t sum, const std::string &s) { return s.length() + sum; };
+  auto length_sum = [](dsize_t sum, const S &s) { return s.length() + sum; };
   dsize_t total_length = std::accumulate(items.begin(), items.end(), 0, length_sum);
 
   // total bytes needed = offset array + strings
@@ -772,9 +790,12 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
     offset_arr[i++] = offset;
     // total bytes are reduced by kOffsetSize
     num_bytes -= kOffsetSize;
-    // insert actual string
-    int ret_code = memcpy_s((*out)->data_ + offset, num_bytes, common::SafeCStr(str), str.length() + 1);
-    if (ret_code != 0) MS_LOG(ERROR) << "Cannot copy string into Tensor";
+    // insert actual string, a string_view is not null-terminated so the terminator is written separately
+    if (str.length() > 0) {
+      int ret_code = memcpy_s((*out)->data_ + offset, num_bytes, str.data(), str.length());
+      if (ret_code != 0) MS_LOG(ERROR) << "Cannot copy string into Tensor";
+    }
+    (*out)->data_[offset + str.length()] = '\0';
     //  next string will be stored right after the current one.
     offset = offset + str.length() + 1;
     // total bytes are reduced by the length of the string
@@ -792,6 +813,24 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
   }
   return Status::OK();
 }
+
+template <>
+inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::string> &items, const TensorShape &shape,
+                                                    TensorPtr *out) {
+  return CreateFromStrings(items, shape, out);
+}
+
+/// Create a Tensor of strings copied straight from the views, without going through std::string
+/// \param[in] items elements of the tensor
+/// \param[in] shape shape of the output tensor
+/// \param[out] out output argument to hold the created Tensor
+/// \return Status Code
+template <>
+inline Status Tensor::CreateFromVector<std::string_view>(const std::vector<std::string_view> &items,
+                                                         const TensorShape &shape, TensorPtr *out) {
+  return CreateFromStrings(items, shape, out);
+}
+
 /// Create a string scalar Tensor from the given value.
 /// \param[in] item value
 /// \param[out] out Created tensor
@@ -34,6 +34,7 @@ namespace dataset {
 
 const char CacheAdminArgHandler::kServerBinary[] = "cache_server";
 const char CacheAdminArgHandler::kDefaultSpillDir[] = "/tmp";
+const char CacheAdminArgHandler::kDefaultEvictionPolicy[] = "none";
 
 CacheAdminArgHandler::CacheAdminArgHandler()
     : port_(kCfgDefaultCachePort),
@@ -44,6 +45,7 @@ CacheAdminArgHandler::CacheAdminArgHandler()
       memory_cap_ratio_(kMemoryCapRatio),
       hostname_(kCfgDefaultCacheHost),
       spill_dir_(kDefaultSpillDir),
+      eviction_policy_(kDefaultEvictionPolicy),
       command_id_(CommandId::kCmdUnknown) {
   // Initialize the command mappings
   arg_map_["-h"] = ArgValue::kArgHost;
@@ -68,6 +70,8 @@ CacheAdminArgHandler::CacheAdminArgHandler()
   arg_map_["-r"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--memory_cap_ratio"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--list_sessions"] = ArgValue::kArgListSessions;
+  arg_map_["-e"] = ArgValue::kArgEvictionPolicy;
+  arg_map_["--eviction"] = ArgValue::kArgEvictionPolicy;
   // Initialize argument tracker with false values
   for (int16_t i = 0; i < static_cast<int16_t>(ArgValue::kArgNumArgs); ++i) {
     ArgValue currAV = static_cast<ArgValue>(i);
@@ -275,6 +279,10 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
         RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdListSessions));
         break;
       }
+      case ArgValue::kArgEvictionPolicy: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &eviction_policy_, arg_stream));
+        break;
+      }
       default: {
         // Save space delimited trailing arguments
         trailing_args_ += (" " + tok);
@@ -310,6 +318,8 @@ Status CacheAdminArgHandler::Validate() {
   if (memory_cap_ratio_ <= 0 || memory_cap_ratio_ > 1)
     return Status(StatusCode::kSyntaxError, "Memory cap ratio should be positive and no greater than 1");
   if (port_ < 1025 || port_ > 65535) return Status(StatusCode::kSyntaxError, "Port must be in range (1025..65535).");
+  if (eviction_policy_ != "none" && eviction_policy_ != "lru" && eviction_policy_ != "lfu")
+    return Status(StatusCode::kSyntaxError, "Eviction policy must be one of none, lru or lfu.");
 
   return Status::OK();
 }
@@ -467,7 +477,7 @@ Status CacheAdminArgHandler::StartStopServer(CommandId command_id) {
     std::string daemonize_string = "true";
     std::string memory_cap_ratio_string = std::to_string(memory_cap_ratio_);
 
-    char *argv[9];
+    char *argv[10];
     if (command_id == CommandId::kCmdStart) {
       argv[0] = cache_server_binary.data();
       argv[1] = spill_dir_.data();
@@ -477,7 +487,8 @@ Status CacheAdminArgHandler::StartStopServer(CommandId command_id) {
       argv[5] = minloglevel_string.data();
       argv[6] = daemonize_string.data();
       argv[7] = memory_cap_ratio_string.data();
-      argv[8] = nullptr;
+      argv[8] = eviction_policy_.data();
+      argv[9] = nullptr;
     } else {
       // We are doing a --stop. Change the name to '-' and we also need the port number.
       // The rest we don't need.
@@ -506,6 +517,7 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "               [ [-w | --workers] <number of workers> ]\n";
   std::cerr << "               [ [-s | --spilldir] <spilling directory> ]\n";
   std::cerr << "               [ [-l | --minloglevel] <log level> ]\n";
+  std::cerr << "               [ [-e | --eviction] <none | lru | lfu> ]\n";
   std::cerr << "               [ --list_sessions ]\n";
   // Do not expose these option to the user via help or documentation, but the options do exist to aid with
   // development and tuning.
@@ -35,6 +35,7 @@ class CacheAdminArgHandler {
   static constexpr float kMemoryCapRatio = 0.8;
   static const char kServerBinary[];
   static const char kDefaultSpillDir[];
+  static const char kDefaultEvictionPolicy[];
 
   // These are the actual command types to execute
   enum class CommandId : int16_t {
@@ -74,7 +75,8 @@ class CacheAdminArgHandler {
     kArgLogLevel = 11,
     kArgMemoryCapRatio = 12,
     kArgListSessions = 13,
-    kArgNumArgs = 14  // Must be the last position to provide a count
+    kArgEvictionPolicy = 14,
+    kArgNumArgs = 15  // Must be the last position to provide a count
   };
 
   Status StartStopServer(CommandId);
@@ -99,6 +101,7 @@ class CacheAdminArgHandler {
   session_id_type session_id_;
   std::string hostname_;
   std::string spill_dir_;
+  std::string eviction_policy_;
   std::string trailing_args_;
   std::map<std::string, ArgValue> arg_map_;
   std::map<ArgValue, bool> used_args_;
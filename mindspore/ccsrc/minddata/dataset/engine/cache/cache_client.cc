@@ -24,7 +24,15 @@
 namespace mindspore {
 namespace dataset {
 CacheClient::Builder::Builder()
-    : session_id_(0), cache_mem_sz_(0), spill_(false), hostname_(""), port_(0), num_connections_(0), prefetch_size_(0) {
+    : session_id_(0),
+      cache_mem_sz_(0),
+      spill_(false),
+      hostname_(""),
+      port_(0),
+      num_connections_(0),
+      prefetch_size_(0),
+      image_scale_(1.0f),
+      chroma_subsampling_(false) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   hostname_ = cfg->cache_host();
   port_ = cfg->cache_port();
@@ -36,7 +44,7 @@ Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   RETURN_IF_NOT_OK(SanityCheck());
   *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
-                                       prefetch_size_);
+                                       prefetch_size_, image_columns_, image_scale_, chroma_subsampling_);
   return Status::OK();
 }
 
@@ -48,6 +56,9 @@ Status CacheClient::Builder::SanityCheck() {
   CHECK_FAIL_RETURN_UNEXPECTED(!hostname_.empty(), "hostname must not be empty");
   CHECK_FAIL_RETURN_UNEXPECTED(port_ > 0, "port must be positive");
   CHECK_FAIL_RETURN_UNEXPECTED(port_ <= 65535, "illegal port number");
+  CHECK_FAIL_RETURN_UNEXPECTED(image_scale_ > 0 && image_scale_ <= 1, "image scale must be in (0, 1]");
+  CHECK_FAIL_RETURN_UNEXPECTED((image_scale_ == 1 && !chroma_subsampling_) || !image_columns_.empty(),
+                               "image columns must be given to cache compact images");
   CHECK_FAIL_RETURN_UNEXPECTED(hostname_ == "127.0.0.1",
                                "now cache client has to be on the same host with cache server");
   return Status::OK();
@@ -55,7 +66,8 @@ Status CacheClient::Builder::SanityCheck() {
 
 // Constructor
 CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname,
-                         int32_t port, int32_t num_connections, int32_t prefetch_size)
+                         int32_t port, int32_t num_connections, int32_t prefetch_size,
+                         std::vector<std::string> image_columns, float image_scale, bool chroma_subsampling)
     : server_connection_id_(0),
       cache_mem_sz_(cache_mem_sz),
       spill_(spill),
@@ -64,6 +76,7 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
       port_(port),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
+      image_codec_(std::move(image_columns), image_scale, chroma_subsampling),
       fetch_all_keys_(true) {
   cinfo_.set_session_id(session_id);
   comm_ = std::make_shared<CacheClientGreeter>(hostname_, port_, num_connections_);
@@ -81,12 +94,14 @@ void CacheClient::Print(std::ostream &out) const {
       << "\n  Spilling: " << std::boolalpha << isSpill() << "\n  Hostname: " << GetHostname()
       << "\n  Port: " << GetPort() << "\n  Number of rpc workers: " << GetNumConnections()
       << "\n  Prefetch size: " << GetPrefetchSize() << "\n  Local client support: " << std::boolalpha
-      << SupportLocalClient();
+      << SupportLocalClient() << "\n  Compact images: " << std::boolalpha << image_codec_.enabled();
 }
 
 Status CacheClient::WriteRow(const TensorRow &row, row_id_type *row_id_from_server) const {
   auto rq = std::make_shared<CacheRowRequest>(server_connection_id_, cookie(), SupportLocalClient());
-  RETURN_IF_NOT_OK(rq->SerializeCacheRowRequest(this, row));
+  TensorRow compact_row;
+  RETURN_IF_NOT_OK(image_codec_.Encode(row, &compact_row));
+  RETURN_IF_NOT_OK(rq->SerializeCacheRowRequest(this, compact_row));
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
   if (row_id_from_server != nullptr) {
@@ -104,8 +119,10 @@ Status CacheClient::WriteBuffer(std::unique_ptr<DataBuffer> &&in) const {
     for (auto i = 0; i < num_rows; ++i) {
       TensorRow row;
       RETURN_IF_NOT_OK(db_ptr->PopRow(&row));
+      TensorRow compact_row;
+      RETURN_IF_NOT_OK(image_codec_.Encode(row, &compact_row));
       arr[i] = std::make_shared<CacheRowRequest>(server_connection_id_, cookie(), SupportLocalClient());
-      RETURN_IF_NOT_OK(arr[i]->SerializeCacheRowRequest(this, row));
+      RETURN_IF_NOT_OK(arr[i]->SerializeCacheRowRequest(this, compact_row));
       RETURN_IF_NOT_OK(PushRequest(arr[i]));
     }
     // Now we wait for them to come back
@@ -121,18 +138,32 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   auto rq = std::make_shared<BatchFetchRequest>(server_connection_id_, row_id, SupportLocalClient());
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
-  int64_t mem_addr;
-  Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
-  // Free the memory by sending a request back to the server.
+  // Rows sent back in the shared memory are not copied out. The block is freed by sending a request back to the
+  // server once no tensor references it anymore.
+  std::shared_ptr<void> block_owner;
+  int64_t mem_addr = rq->GetSharedMemoryAddr();
   if (mem_addr != -1) {
-    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, mem_addr);
-    Status rc2 = PushRequest(mfree_req);
-    // But we won't wait for the result for the sake of performance.
-    if (rc.IsOk() && rc2.IsError()) {
-      rc = rc2;
-    }
+    block_owner = std::make_shared<SharedBlock>(comm_, server_connection_id_, mem_addr);
+  }
+  RETURN_IF_NOT_OK(rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), block_owner));
+  // Inflate the images of the selected columns, cached in a compact form
+  for (auto &row : *out) {
+    RETURN_IF_NOT_OK(image_codec_.Decode(&row));
+  }
+  return Status::OK();
+}
+
+CacheClient::SharedBlock::~SharedBlock() {
+  auto mfree_req = std::make_shared<FreeSharedBlockRequest>(connection_id_, addr_);
+  // We won't wait for the result for the sake of performance. A row may outlive its client though, whose replies
+  // are not received anymore, the block is then freed with a blocking call.
+  Status rc = comm_->HandleRequest(mfree_req);
+  if (rc.IsError() && comm_->IsStopped()) {
+    rc = comm_->HandleRequestSync(mfree_req);
+  }
+  if (rc.IsError()) {
+    MS_LOG(INFO) << "Push request for free memory failed: " << rc.ToString();
   }
-  return rc;
 }
 
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
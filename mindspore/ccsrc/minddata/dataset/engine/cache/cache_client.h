@@ -34,6 +34,7 @@
 #else
 #include "minddata/dataset/engine/cache/stub/cache_grpc_client.h"
 #endif
+#include "minddata/dataset/engine/cache/cache_image_codec.h"
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/util/lock.h"
 #include "minddata/dataset/util/cond_var.h"
@@ -111,6 +112,30 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to select the columns of decoded images to cache in a compact form
+    /// \param image_columns Names of the columns
+    /// \return Builder object itself
+    Builder &SetImageColumns(std::vector<std::string> image_columns) {
+      image_columns_ = std::move(image_columns);
+      return *this;
+    }
+
+    /// Setter function to scale down the decoded images before they are cached
+    /// \param image_scale Factor in (0, 1] applied to the height and the width
+    /// \return Builder object itself
+    Builder &SetImageScale(float image_scale) {
+      image_scale_ = image_scale;
+      return *this;
+    }
+
+    /// Setter function to cache the decoded RGB images as YUV 4:2:0
+    /// \param chroma_subsampling
+    /// \return Builder object itself
+    Builder &SetChromaSubsampling(bool chroma_subsampling) {
+      chroma_subsampling_ = chroma_subsampling;
+      return *this;
+    }
+
     /// Getter functions
     session_id_type GetSessionId() const { return session_id_; }
     uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
@@ -119,6 +144,9 @@ class CacheClient {
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
     int32_t GetPrefetchSize() const { return prefetch_size_; }
+    const std::vector<std::string> &GetImageColumns() const { return image_columns_; }
+    float GetImageScale() const { return image_scale_; }
+    bool GetChromaSubsampling() const { return chroma_subsampling_; }
 
     Status SanityCheck();
 
@@ -132,14 +160,21 @@ class CacheClient {
     int32_t port_;
     int32_t num_connections_;
     int32_t prefetch_size_;
+    std::vector<std::string> image_columns_;
+    float image_scale_;
+    bool chroma_subsampling_;
   };
 
   /// \brief Constructor
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
+  /// \param image_columns Columns of decoded images to cache in a compact form, see CacheImageCodec
+  /// \param image_scale Scale of the decoded images cached, see CacheImageCodec
+  /// \param chroma_subsampling Cache the decoded RGB images as YUV 4:2:0, see CacheImageCodec
   CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname, int32_t port,
-              int32_t num_connections, int32_t prefetch_size);
+              int32_t num_connections, int32_t prefetch_size, std::vector<std::string> image_columns = {},
+              float image_scale = 1.0f, bool chroma_subsampling = false);
 
   /// \brief Destructor
   ~CacheClient();
@@ -227,6 +262,14 @@ class CacheClient {
   int32_t GetPort() const { return port_; }
   int32_t GetNumConnections() const { return num_connections_; }
   int32_t GetPrefetchSize() const { return prefetch_size_; }
+  const CacheImageCodec &GetImageCodec() const { return image_codec_; }
+
+  /// \brief Find the columns of images to cache in the rows, before any row is written or fetched
+  /// \param column_map The index of every column of the rows by name
+  /// \return Status object
+  Status SelectImageColumns(const std::unordered_map<std::string, int32_t> &column_map) {
+    return image_codec_.SelectColumns(column_map);
+  }
 
   /// MergeOp will notify us when the server can't cache any more rows.
   /// We will stop any attempt to fetch any rows that are most likely
@@ -264,6 +307,7 @@ class CacheClient {
   int32_t port_;
   int32_t num_connections_;
   int32_t prefetch_size_;
+  CacheImageCodec image_codec_;
   mutable std::shared_ptr<CacheClientGreeter> comm_;
   std::atomic<bool> fetch_all_keys_;
   WaitPost cache_miss_keys_wp_;
@@ -283,6 +327,19 @@ class CacheClient {
     std::set<row_id_type> gap_;
   };
   std::unique_ptr<CacheMissKeys> cache_miss_keys_;
+  /// A shared memory block where the server has put the rows of a batch fetch. Tensors reference the rows in
+  /// place and hold the block, which is returned to the server when the last of them goes.
+  class SharedBlock {
+   public:
+    SharedBlock(std::shared_ptr<CacheClientGreeter> comm, connection_id_type connection_id, int64_t addr)
+        : comm_(std::move(comm)), connection_id_(connection_id), addr_(addr) {}
+    ~SharedBlock();
+
+   private:
+    std::shared_ptr<CacheClientGreeter> comm_;  // Also keeps the shared memory attached
+    connection_id_type connection_id_;
+    int64_t addr_;
+  };
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -47,6 +47,9 @@ constexpr static uint32_t kLocalClientSupport = 1;
 /// \brief A flag used by CacheRow request (client side) and BatchFetch (server side) reply to indicate if the data is
 /// inline in the protobuf. This also implies kLocalClientSupport is also true.
 constexpr static uint32_t kDataIsInSharedMemory = 2;
+/// \brief Each row sent back by BatchFetch starts at a multiple of this many bytes, so that the client can reference
+/// the tensors in shared memory in place.
+constexpr static int64_t kRowAlignment = 8;
 /// \brief Size of each message used in message queue.
 constexpr static int32_t kSharedMessageSize = 2048;
 
@@ -102,14 +102,17 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
   }
 }
 
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out) {
+/// A private function used by RestoreOneTensor to get back the shape and type of a tensor
+/// \note Not to be called by outside world
+/// \return Status object
+Status RestoreOneTensorMeta(const TensorMetaMsg *col_ts, TensorShape *shape, DataType *type) {
   RETURN_UNEXPECTED_IF_NULL(col_ts);
   auto shape_in = col_ts->dims();
   auto type_in = col_ts->type();
   std::vector<dsize_t> v;
   v.reserve(shape_in->size());
   v.assign(shape_in->begin(), shape_in->end());
-  TensorShape shape(v);
+  *shape = TensorShape(v);
   DataType::Type dest = DataType::DE_UNKNOWN;
 #define CASE(t)               \
   case TensorType_##t:        \
@@ -133,7 +136,15 @@ Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data,
   }
 #undef CASE
 
-  DataType type(dest);
+  *type = DataType(dest);
+  return Status::OK();
+}
+
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out) {
+  RETURN_UNEXPECTED_IF_NULL(col_ts);
+  TensorShape shape = TensorShape::CreateUnknownRankShape();
+  DataType type;
+  RETURN_IF_NOT_OK(RestoreOneTensorMeta(col_ts, &shape, &type));
   std::shared_ptr<Tensor> ts;
   RETURN_IF_NOT_OK(
     Tensor::CreateFromMemory(shape, type, static_cast<const unsigned char *>(data.GetPointer()), data.GetSize(), &ts));
@@ -147,5 +158,27 @@ Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data,
   *out = std::move(ts);
   return Status::OK();
 }
+
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const WritableSlice &data, const std::shared_ptr<void> &owner,
+                        std::shared_ptr<Tensor> *out) {
+  RETURN_UNEXPECTED_IF_NULL(col_ts);
+  TensorShape shape = TensorShape::CreateUnknownRankShape();
+  DataType type;
+  RETURN_IF_NOT_OK(RestoreOneTensorMeta(col_ts, &shape, &type));
+  WritableSlice view(data);
+  auto *src = static_cast<unsigned char *>(view.GetMutablePointer());
+  // Strings have their own layout and data out of alignment can't be referenced in place. Both are copied.
+  if (owner == nullptr || !type.IsNumeric() || reinterpret_cast<uintptr_t>(src) % type.SizeInBytes() != 0) {
+    return RestoreOneTensor(col_ts, data, out);
+  }
+  std::shared_ptr<Tensor> ts;
+  RETURN_IF_NOT_OK(Tensor::CreateFromMemoryView(shape, type, src, owner, &ts));
+  if (ts->SizeInBytes() != data.GetSize()) {
+    MS_LOG(ERROR) << "Unexpected length. Read " << data.GetSize() << ". Expected " << ts->SizeInBytes() << ".";
+    RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+  }
+  *out = std::move(ts);
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
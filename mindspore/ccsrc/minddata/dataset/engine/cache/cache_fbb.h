@@ -41,6 +41,15 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
 /// \param out Tensor
 /// \return Status object
 Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out);
+
+/// \brief Same as above, but a numeric tensor references the data in place instead of copying it.
+/// \param col_ts A serialized version of Tensor meta data
+/// \param data Tensor data wrapped in a slice
+/// \param owner Object that keeps the data alive as long as the tensor references it
+/// \param out Tensor
+/// \return Status object
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const WritableSlice &data, const std::shared_ptr<void> &owner,
+                        std::shared_ptr<Tensor> *out);
 }  // namespace dataset
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FBB_H_
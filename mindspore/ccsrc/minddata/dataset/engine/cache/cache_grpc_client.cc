@@ -20,7 +20,7 @@ namespace dataset {
 CacheClientGreeter::~CacheClientGreeter() { (void)ServiceStop(); }
 
 CacheClientGreeter::CacheClientGreeter(const std::string &hostname, int32_t port, int32_t num_connections)
-    : num_connections_(num_connections), request_cnt_(0) {
+    : num_connections_(num_connections), request_cnt_(0), stopped_(false) {
   grpc::ChannelArguments args;
   // We need to bump up the message size to unlimited. The default receiving
   // message limit is 4MB which is not big enough.
@@ -62,6 +62,10 @@ Status CacheClientGreeter::DoServiceStart() {
 
 Status CacheClientGreeter::DoServiceStop() {
   // Shutdown the queue. We don't accept any more new incomers.
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    stopped_ = true;
+  }
   cq_.Shutdown();
   // Shutdown the TaskGroup.
   vg_.interrupt_all();
@@ -86,22 +90,41 @@ Status CacheClientGreeter::HandleRequest(std::shared_ptr<BaseRequest> rq) {
   // One minute timeout
   auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(60);
   tag->ctx_.set_deadline(deadline);
+  // The queue can't be shut down while the request is added to it
+  std::unique_lock<std::mutex> lck(mux_);
+  CHECK_FAIL_RETURN_UNEXPECTED(!stopped_, "The cache client is stopped, no request can be sent.");
   tag->rpc_ = stub_->PrepareAsyncCacheServerRequest(&tag->ctx_, tag->base_rq_->rq_, &cq_);
   tag->rpc_->StartCall();
   auto ccReqTag = tag.get();
   // Insert it into the map.
-  {
-    std::unique_lock<std::mutex> lck(mux_);
-    auto r = req_.emplace(seqNo, std::move(tag));
-    if (!r.second) {
-      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__);
-    }
+  auto r = req_.emplace(seqNo, std::move(tag));
+  if (!r.second) {
+    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__);
   }
   // Last step is to tag the request.
   ccReqTag->rpc_->Finish(&ccReqTag->base_rq_->reply_, &ccReqTag->rc_, ccReqTag);
   return Status::OK();
 }
 
+Status CacheClientGreeter::HandleRequestSync(std::shared_ptr<BaseRequest> rq) {
+  RETURN_IF_NOT_OK(rq->Prepare());
+  grpc::ClientContext ctx;
+  // One minute timeout
+  ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(60));
+  grpc::Status rc = stub_->CacheServerRequest(&ctx, rq->rq_, &rq->reply_);
+  if (!rc.ok()) {
+    std::string err_msg = rc.error_message() + ". GRPC Code " + std::to_string(rc.error_code());
+    Status2CacheReply(Status(StatusCode::kNetWorkError, __LINE__, __FILE__, err_msg), &rq->reply_);
+  }
+  rq->wp_.Set();
+  return Status::OK();
+}
+
+bool CacheClientGreeter::IsStopped() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return stopped_;
+}
+
 Status CacheClientGreeter::WorkerEntry() {
   TaskManager::FindMe()->Post();
   do {
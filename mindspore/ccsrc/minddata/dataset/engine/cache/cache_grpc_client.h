@@ -70,6 +70,14 @@ class CacheClientGreeter : public Service {
   /// \return Status object
   Status HandleRequest(std::shared_ptr<BaseRequest> rq);
 
+  /// \brief Send the request to the server and wait for the reply on the calling thread. Unlike HandleRequest, it
+  /// doesn't need the completion queue, so it still works once the service is stopped.
+  /// \return Status object
+  Status HandleRequestSync(std::shared_ptr<BaseRequest> rq);
+
+  /// \brief Whether the service is stopped, HandleRequest then fails
+  bool IsStopped() const;
+
   /// \brief A handful of threads will be handling async reply from the server
   /// \return
   Status WorkerEntry();
@@ -94,6 +102,7 @@ class CacheClientGreeter : public Service {
   int32_t num_connections_;
   std::atomic<int64_t> request_cnt_;
   mutable std::mutex mux_;
+  bool stopped_;  // guarded by mux_, no request is added to cq_ once it is set
   std::map<int64_t, std::unique_ptr<CacheClientRequestTag>> req_;
   SharedMemory mem_;
 };
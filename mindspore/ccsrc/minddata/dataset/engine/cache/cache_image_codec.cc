@@ -0,0 +1,196 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_image_codec.h"
+#include <opencv2/imgproc/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "minddata/dataset/core/cv_tensor.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kYuvChannels = 3;
+
+int32_t RoundUpToEven(int32_t n) { return (n + 1) / 2 * 2; }
+}  // namespace
+
+bool CacheImageCodec::IsImage(const std::shared_ptr<Tensor> &tensor) {
+  if (tensor == nullptr || tensor->type() != DataType::DE_UINT8 || tensor->Size() == 0) {
+    return false;
+  }
+  const TensorShape &shape = tensor->shape();
+  return shape.Rank() == 2 || (shape.Rank() == 3 && (shape[2] == 1 || shape[2] == 3 || shape[2] == 4));
+}
+
+int64_t CacheImageCodec::PayloadSize(const Header &header) {
+  if (header.format == Format::kYuv420) {
+    return static_cast<int64_t>(RoundUpToEven(header.height)) * RoundUpToEven(header.width) * kYuvChannels / 2;
+  }
+  return static_cast<int64_t>(header.height) * header.width * header.channels;
+}
+
+bool CacheImageCodec::IsEncoded(const std::shared_ptr<Tensor> &tensor) {
+  if (tensor == nullptr || tensor->type() != DataType::DE_UINT8 || tensor->Rank() != 1 ||
+      tensor->SizeInBytes() < static_cast<dsize_t>(sizeof(Header))) {
+    return false;
+  }
+  Header header;
+  (void)std::memcpy(&header, tensor->GetBuffer(), sizeof(Header));
+  return header.magic == kMagic && header.height > 0 && header.width > 0 && header.channels > 0 &&
+         tensor->SizeInBytes() == static_cast<dsize_t>(sizeof(Header)) + PayloadSize(header);
+}
+
+Status CacheImageCodec::SelectColumns(const std::unordered_map<std::string, int32_t> &column_map) {
+  if (!enabled()) {
+    return Status::OK();
+  }
+  std::vector<int32_t> column_ids;
+  for (const auto &name : columns_) {
+    auto it = column_map.find(name);
+    CHECK_FAIL_RETURN_UNEXPECTED(it != column_map.end(),
+                                 "Invalid parameter, image column " + name + " to cache is not a column of the rows.");
+    column_ids.push_back(it->second);
+  }
+  column_ids_ = std::move(column_ids);
+  return Status::OK();
+}
+
+Status CacheImageCodec::Encode(const TensorRow &in, TensorRow *out) const {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  *out = in;
+  if (!enabled()) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(column_ids_.size() == columns_.size(), "The image columns to cache are not selected.");
+  for (size_t i = 0; i < column_ids_.size(); ++i) {
+    auto id = column_ids_[i];
+    CHECK_FAIL_RETURN_UNEXPECTED(id >= 0 && static_cast<size_t>(id) < out->size(),
+                                 "Image column " + columns_[i] + " to cache is missing from the row.");
+    auto &col = (*out)[id];
+    CHECK_FAIL_RETURN_UNEXPECTED(IsImage(col), "Image column " + columns_[i] +
+                                                 " to cache is not a decoded image: uint8 of shape <H,W> or "
+                                                 "<H,W,C> with C being 1, 3 or 4.");
+    std::shared_ptr<Tensor> encoded;
+    RETURN_IF_NOT_OK(EncodeImage(col, &encoded));
+    col = std::move(encoded);
+  }
+  return Status::OK();
+}
+
+Status CacheImageCodec::Decode(TensorRow *row) const {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  if (!enabled()) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(column_ids_.size() == columns_.size(), "The image columns to cache are not selected.");
+  for (size_t i = 0; i < column_ids_.size(); ++i) {
+    auto id = column_ids_[i];
+    CHECK_FAIL_RETURN_UNEXPECTED(id >= 0 && static_cast<size_t>(id) < row->size(),
+                                 "Cached image column " + columns_[i] + " is missing from the row.");
+    auto &col = (*row)[id];
+    CHECK_FAIL_RETURN_UNEXPECTED(IsEncoded(col), "Image column " + columns_[i] +
+                                                   " was not cached in a compact form, the cache was built with "
+                                                   "other image settings.");
+    std::shared_ptr<Tensor> decoded;
+    RETURN_IF_NOT_OK(DecodeImage(col, &decoded));
+    col = std::move(decoded);
+  }
+  return Status::OK();
+}
+
+Status CacheImageCodec::EncodeImage(const std::shared_ptr<Tensor> &in, std::shared_ptr<Tensor> *out) const {
+  const TensorShape &shape = in->shape();
+  Header header{kMagic, Format::kRaw, static_cast<int32_t>(shape.Rank()), static_cast<int32_t>(shape[0]),
+                static_cast<int32_t>(shape[1]), shape.Rank() == 3 ? static_cast<int32_t>(shape[2]) : 1};
+  try {
+    // The input is only read, it may still be passed on down the pipeline
+    cv::Mat img(header.height, header.width, CV_8UC(header.channels), const_cast<uchar *>(in->GetBuffer()));
+    if (scale_ < 1.0f) {
+      int32_t height = std::max(1, static_cast<int32_t>(std::lround(header.height * scale_)));
+      int32_t width = std::max(1, static_cast<int32_t>(std::lround(header.width * scale_)));
+      cv::Mat scaled;
+      cv::resize(img, scaled, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+      img = scaled;
+      header.height = height;
+      header.width = width;
+    }
+    if (chroma_subsampling_ && header.channels == kYuvChannels) {
+      // I420 needs an even height and width, the extra row or column is cropped when decoding
+      if (header.height % 2 != 0 || header.width % 2 != 0) {
+        cv::Mat padded;
+        cv::copyMakeBorder(img, padded, 0, header.height % 2, 0, header.width % 2, cv::BORDER_REPLICATE);
+        img = padded;
+      }
+      cv::Mat yuv;
+      cv::cvtColor(img, yuv, cv::COLOR_RGB2YUV_I420);
+      img = yuv;
+      header.format = Format::kYuv420;
+    }
+    if (!img.isContinuous()) {
+      img = img.clone();
+    }
+    int64_t payload_size = PayloadSize(header);
+    CHECK_FAIL_RETURN_UNEXPECTED(static_cast<int64_t>(img.total() * img.elemSize()) == payload_size,
+                                 "Unexpected size of an image to be cached.");
+    std::shared_ptr<CVTensor> encoded;
+    RETURN_IF_NOT_OK(CVTensor::CreateEmpty(TensorShape({static_cast<dsize_t>(sizeof(Header)) + payload_size}),
+                                           DataType(DataType::DE_UINT8), &encoded));
+    uchar *dst = encoded->mat().data;
+    (void)std::memcpy(dst, &header, sizeof(Header));
+    (void)std::memcpy(dst + sizeof(Header), img.data, payload_size);
+    *out = std::move(encoded);
+  } catch (const cv::Exception &e) {
+    RETURN_STATUS_UNEXPECTED("Failed to make an image compact for the cache: " + std::string(e.what()));
+  }
+  return Status::OK();
+}
+
+Status CacheImageCodec::DecodeImage(const std::shared_ptr<Tensor> &in, std::shared_ptr<Tensor> *out) {
+  Header header;
+  (void)std::memcpy(&header, in->GetBuffer(), sizeof(Header));
+  auto payload = const_cast<uchar *>(in->GetBuffer()) + sizeof(Header);
+  TensorShape shape = header.rank == 2 ? TensorShape({header.height, header.width})
+                                       : TensorShape({header.height, header.width, header.channels});
+  if (header.format == Format::kRaw) {
+    // The pixels are used in place, the fetched tensor is held to keep them valid
+    return Tensor::CreateFromMemoryView(shape, DataType(DataType::DE_UINT8), payload, in, out);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(header.format == Format::kYuv420 && header.channels == kYuvChannels,
+                               "Invalid format of a cached image.");
+  std::shared_ptr<CVTensor> decoded;
+  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(shape, DataType(DataType::DE_UINT8), &decoded));
+  try {
+    int32_t height = RoundUpToEven(header.height);
+    int32_t width = RoundUpToEven(header.width);
+    cv::Mat yuv(height * 3 / 2, width, CV_8UC1, payload);
+    cv::Mat &dst = decoded->mat();
+    if (height == header.height && width == header.width) {
+      // Convert straight into the output tensor
+      cv::cvtColor(yuv, dst, cv::COLOR_YUV2RGB_I420);
+    } else {
+      cv::Mat rgb;
+      cv::cvtColor(yuv, rgb, cv::COLOR_YUV2RGB_I420);
+      rgb(cv::Rect(0, 0, header.width, header.height)).copyTo(dst);
+    }
+  } catch (const cv::Exception &e) {
+    RETURN_STATUS_UNEXPECTED("Failed to inflate a cached image: " + std::string(e.what()));
+  }
+  *out = std::move(decoded);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
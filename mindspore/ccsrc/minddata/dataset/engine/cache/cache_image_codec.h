@@ -0,0 +1,109 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_IMAGE_CODEC_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_IMAGE_CODEC_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A CacheImageCodec makes the decoded images of a row compact before a cache client sends the row to the
+/// cache server, and inflates them when the row is fetched back, so that caching right after the decode fits in
+/// memory and later epochs skip the decode.
+/// Only the columns selected by name are handled, each must be a decoded image: a uint8 column of shape <H,W> or
+/// <H,W,C> with C being 1, 3 or 4. It can be
+///   - scaled down by a factor, the row comes back with the smaller image, which the resize ops of the
+///     augmentation bring to their target size anyway,
+///   - stored as YUV 4:2:0 if it has 3 channels, which takes half the memory and is turned back into RGB with a
+///     plain color conversion, far cheaper than a JPEG decode. The colors lose some chroma detail.
+/// An image is stored as a uint8 tensor of one dimension starting with a small header, which tells how to inflate
+/// it. Fetching a row inflates the selected columns, which must have been stored that way, and nothing else.
+class CacheImageCodec {
+ public:
+  /// \brief Format of the pixels of a stored image
+  enum class Format : int32_t { kRaw = 0, kYuv420 = 1 };
+
+  /// \brief Constructor
+  /// \param columns Names of the columns holding the decoded images
+  /// \param scale Factor in (0, 1] applied to the height and the width of the images
+  /// \param chroma_subsampling Store the images with 3 channels as YUV 4:2:0
+  CacheImageCodec(std::vector<std::string> columns, float scale, bool chroma_subsampling)
+      : columns_(std::move(columns)), scale_(scale), chroma_subsampling_(chroma_subsampling) {}
+
+  ~CacheImageCodec() = default;
+
+  /// \brief Whether the images are stored in another form than they come
+  bool enabled() const { return !columns_.empty() && (scale_ < 1.0f || chroma_subsampling_); }
+
+  /// \brief Find the selected columns in the rows, before any row is encoded or decoded
+  /// \param column_map The index of every column of the rows by name
+  /// \return Status object
+  Status SelectColumns(const std::unordered_map<std::string, int32_t> &column_map);
+
+  /// \brief Make the images of a row compact
+  /// \param[in] in The row to be cached
+  /// \param[out] out The same row with its images replaced by their stored form
+  /// \return Status object
+  Status Encode(const TensorRow &in, TensorRow *out) const;
+
+  /// \brief Inflate in place the images of a fetched row, stored by a CacheImageCodec of the same columns
+  /// \param[in,out] row The fetched row
+  /// \return Status object
+  Status Decode(TensorRow *row) const;
+
+  /// \brief Whether a tensor holds an image stored by a CacheImageCodec
+  static bool IsEncoded(const std::shared_ptr<Tensor> &tensor);
+
+ private:
+  /// Metadata in front of the pixels of a stored image
+  struct Header {
+    uint32_t magic;
+    Format format;
+    int32_t rank;
+    int32_t height;
+    int32_t width;
+    int32_t channels;
+  };
+
+  static constexpr uint32_t kMagic = 0x4344494d;  // "MIDC"
+
+  /// \brief Whether a column is a decoded image
+  static bool IsImage(const std::shared_ptr<Tensor> &tensor);
+
+  /// \brief Number of bytes of the pixels of a stored image
+  static int64_t PayloadSize(const Header &header);
+
+  Status EncodeImage(const std::shared_ptr<Tensor> &in, std::shared_ptr<Tensor> *out) const;
+
+  static Status DecodeImage(const std::shared_ptr<Tensor> &in, std::shared_ptr<Tensor> *out);
+
+  std::vector<std::string> columns_;
+  std::vector<int32_t> column_ids_;  // the index in the rows of each selected column
+  float scale_;
+  bool chroma_subsampling_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_IMAGE_CODEC_H_
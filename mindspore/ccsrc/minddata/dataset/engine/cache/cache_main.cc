@@ -141,7 +141,7 @@ ds::Status StopServer(int argc, char **argv) {
 ds::Status StartServer(int argc, char **argv) {
   ds::Status rc;
   ds::CacheServer::Builder builder;
-  if (argc != 8) {
+  if (argc != 9) {
     return ds::Status(ds::StatusCode::kSyntaxError);
   }
 
@@ -150,7 +150,8 @@ ds::Status StartServer(int argc, char **argv) {
     .SetNumWorkers(strtol(argv[2], nullptr, 10))
     .SetPort(port)
     .SetSharedMemorySizeInGB(strtol(argv[4], nullptr, 10))
-    .SetMemoryCapRatio(strtof(argv[7], nullptr));
+    .SetMemoryCapRatio(strtof(argv[7], nullptr))
+    .SetEvictionPolicy(argv[8]);
 
 #ifdef USE_GLOG
   FLAGS_minloglevel = strtol(argv[5], nullptr, 10);
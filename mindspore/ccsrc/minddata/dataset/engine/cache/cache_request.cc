@@ -133,36 +133,40 @@ BatchFetchRequest::BatchFetchRequest(connection_id_type connection_id, const std
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
 }
 
-Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr) {
-  RETURN_UNEXPECTED_IF_NULL(out);
-  auto num_elements = row_id_.size();
-  const char *ptr = nullptr;
-  int64_t sz = 0;
+int64_t BatchFetchRequest::GetSharedMemoryAddr() const {
   // Tap into the reply flag to see where we can find the data. Server may decide the amount is
   // so small that it doesn't use shared memory method.
   auto flag = reply_.flag();
   bool dataOnSharedMemory = support_local_bypass_ ? (BitTest(flag, kDataIsInSharedMemory)) : false;
-  if (dataOnSharedMemory) {
-    auto addr = strtoll(reply_.result().data(), nullptr, 10);
-    ptr = reinterpret_cast<const char *>(reinterpret_cast<int64_t>(baseAddr) + addr);
-    RETURN_UNEXPECTED_IF_NULL(out);
-    *out_addr = addr;
+  return dataOnSharedMemory ? strtoll(reply_.result().data(), nullptr, 10) : -1;
+}
+
+Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr,
+                                      const std::shared_ptr<void> &block_owner) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto num_elements = row_id_.size();
+  char *ptr = nullptr;
+  int64_t sz = 0;
+  auto addr = GetSharedMemoryAddr();
+  if (addr != -1) {
+    ptr = reinterpret_cast<char *>(reinterpret_cast<int64_t>(baseAddr) + addr);
   } else {
-    ptr = reply_.result().data();
-    *out_addr = -1;
+    ptr = &(*reply_.mutable_result())[0];
   }
   auto *offset_array = reinterpret_cast<const int64_t *>(ptr);
   sz = offset_array[num_elements];
-  CHECK_FAIL_RETURN_UNEXPECTED(support_local_bypass_ || sz == reply_.result().length(), "Length mismatch");
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != -1 || sz == reply_.result().length(), "Length mismatch");
+  // Only the data in the shared memory can be referenced in place, the reply goes away with this request.
+  std::shared_ptr<void> owner = addr != -1 ? block_owner : nullptr;
   TensorTable tbl;
   tbl.reserve(num_elements);
-  ReadableSlice all(ptr, sz);
+  WritableSlice all(ptr, sz);
   for (auto i = 0; i < num_elements; ++i) {
     auto len = offset_array[i + 1] - offset_array[i];
     TensorRow row;
     row.setId(row_id_.at(i));
     if (len > 0) {
-      ReadableSlice row_data(all, offset_array[i], len);
+      WritableSlice row_data(all, offset_array[i], len);
       // Next we de-serialize flat buffer to get back each column
       auto msg = GetTensorRowHeaderMsg(row_data.GetPointer());
       auto msg_sz = msg->size_of_this();
@@ -172,8 +176,8 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
       for (auto k = 0; k < msg->column()->size(); ++k) {
         auto col_ts = msg->column()->Get(k);
         std::shared_ptr<Tensor> ts;
-        ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
-        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
+        WritableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
+        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, owner, &ts));
         row.push_back(ts);
         ts_offset += data.GetSize();
       }
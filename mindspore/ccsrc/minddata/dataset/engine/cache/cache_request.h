@@ -195,7 +195,18 @@ class BatchFetchRequest : public BaseRequest {
   friend class CacheService;
   BatchFetchRequest(connection_id_type connection_id, const std::vector<row_id_type> &row_id, bool local_bypass);
   ~BatchFetchRequest() override = default;
-  Status RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr);
+
+  /// \brief Where the server has put the rows in the shared memory
+  /// \return Address relative to the base of the shared memory, -1 if the rows are inline in the reply
+  int64_t GetSharedMemoryAddr() const;
+
+  /// \brief Deserialize the rows sent back by the server
+  /// \param out The rows fetched
+  /// \param baseAddr Base address of the shared memory the client attaches to
+  /// \param block_owner If not null, holds the shared memory block the rows are in. Numeric tensors then reference
+  /// the data in the block instead of copying it.
+  /// \return Status object
+  Status RestoreRows(TensorTable *out, const void *baseAddr, const std::shared_ptr<void> &block_owner);
 
  private:
   bool support_local_bypass_;
@@ -177,7 +177,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   if (it == end) {
     std::unique_ptr<CacheService> cs;
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, eviction_policy_);
       RETURN_IF_NOT_OK(cs->ServiceStart());
       cookie = cs->cookie();
       all_caches_.emplace(connection_id, std::move(cs));
@@ -338,13 +338,23 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
     // For large amount data to be sent back, we will use shared memory provided it is a local
     // client that has local bypass support
     bool local_bypass = local_client ? (mem_sz >= kLocalByPassThreshold) : false;
+    auto shared_pool = comm_layer_->GetSharedMemoryPool();
+    void *q = nullptr;
+    if (local_bypass) {
+      // The client keeps the block as long as it uses the tensors in it. If the shared memory runs out, we send
+      // the data inline instead.
+      Status rc = shared_pool->Allocate(mem_sz, &q);
+      if (rc.IsOutofMemory()) {
+        MS_LOG(DEBUG) << "Shared memory is full. Sending " << mem_sz << " bytes inline.";
+        local_bypass = false;
+      } else {
+        RETURN_IF_NOT_OK(rc);
+      }
+    }
     reply->set_flag(local_bypass ? kDataIsInSharedMemory : 0);
     if (local_bypass) {
       // We will use shared memory
-      auto shared_pool = comm_layer_->GetSharedMemoryPool();
       auto *base = shared_pool->SharedMemoryBaseAddr();
-      void *q = nullptr;
-      RETURN_IF_NOT_OK(shared_pool->Allocate(mem_sz, &q));
       WritableSlice dest(q, mem_sz);
       RETURN_IF_NOT_OK(cs->BatchFetch(row_id, v, &dest));
       // We can't return the absolute address which makes no sense to the client.
@@ -664,14 +674,16 @@ session_id_type CacheServer::GetSessionID(connection_id_type connection_id) cons
 }
 
 CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port,
-                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio)
+                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio,
+                         CachePool::EvictionPolicy eviction_policy)
     : top_(spill_path),
       num_workers_(num_workers),
       port_(port),
       shared_memory_sz_in_gb_(shared_meory_sz_in_gb),
       global_shutdown_(false),
       memory_cap_ratio_(memory_cap_ratio),
-      cur_mem_usage_(0) {
+      cur_mem_usage_(0),
+      eviction_policy_(eviction_policy) {
   memory_cap_ = CacheServer::GetTotalSystemMemory() * memory_cap_ratio_;
 }
 
@@ -861,6 +873,20 @@ Status CacheServer::Builder::IpcResourceCleanup() {
   return Status::OK();
 }
 
+Status CacheServer::Builder::ParseEvictionPolicy(const std::string &name, CachePool::EvictionPolicy *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (name == "none") {
+    *out = CachePool::EvictionPolicy::kNone;
+  } else if (name == "lru") {
+    *out = CachePool::EvictionPolicy::kLru;
+  } else if (name == "lfu") {
+    *out = CachePool::EvictionPolicy::kLfu;
+  } else {
+    RETURN_STATUS_UNEXPECTED("Eviction policy must be one of none, lru or lfu: " + name);
+  }
+  return Status::OK();
+}
+
 Status CacheServer::Builder::SanityCheck() {
   if (shared_memory_sz_in_gb_ <= 0) {
     RETURN_STATUS_UNEXPECTED("Shared memory size (in GB unit) must be positive");
@@ -887,6 +913,8 @@ Status CacheServer::Builder::SanityCheck() {
   if (memory_cap_ratio_ <= 0 || memory_cap_ratio_ > 1) {
     RETURN_STATUS_UNEXPECTED("Memory cap ratio should be positive and no greater than 1");
   }
+  CachePool::EvictionPolicy policy;
+  RETURN_IF_NOT_OK(ParseEvictionPolicy(eviction_policy_, &policy));
 
   // Check if the shared memory.
   RETURN_IF_NOT_OK(IpcResourceCleanup());
@@ -49,7 +49,13 @@ class CacheServer : public Service {
   using cache_index = std::map<connection_id_type, std::unique_ptr<CacheService>>;
   class Builder {
    public:
-    Builder() : top_("/tmp"), num_workers_(32), port_(50052), shared_memory_sz_in_gb_(4), memory_cap_ratio_(0.8) {}
+    Builder()
+        : top_("/tmp"),
+          num_workers_(32),
+          port_(50052),
+          shared_memory_sz_in_gb_(4),
+          memory_cap_ratio_(0.8),
+          eviction_policy_("none") {}
 
     ~Builder() = default;
 
@@ -59,6 +65,7 @@ class CacheServer : public Service {
     int32_t GetPort() const { return port_; }
     int32_t GetSharedMemorySzInGb() const { return shared_memory_sz_in_gb_; }
     float GetMemoryCapRatio() const { return memory_cap_ratio_; }
+    const std::string &GetEvictionPolicy() const { return eviction_policy_; }
 
     Builder &SetRootDirectory(std::string root) {
       top_ = std::move(root);
@@ -80,6 +87,12 @@ class CacheServer : public Service {
       memory_cap_ratio_ = ratio;
       return *this;
     }
+    /// \brief How a cache that spills picks the rows to move to disk once its memory is full
+    /// \param policy One of "none", "lru" or "lfu"
+    Builder &SetEvictionPolicy(std::string policy) {
+      eviction_policy_ = std::move(policy);
+      return *this;
+    }
 
     Status SanityCheck();
 
@@ -89,7 +102,8 @@ class CacheServer : public Service {
           << "Number of parallel workers: " << GetNumWorkers() << "\n"
           << "Tcp/ip port: " << GetPort() << "\n"
           << "Shared memory size (in GB): " << GetSharedMemorySzInGb() << "\n"
-          << "Memory cap ratio: " << GetMemoryCapRatio();
+          << "Memory cap ratio: " << GetMemoryCapRatio() << "\n"
+          << "Eviction policy: " << GetEvictionPolicy();
     }
 
     friend std::ostream &operator<<(std::ostream &out, const Builder &bld) {
@@ -101,8 +115,10 @@ class CacheServer : public Service {
       RETURN_IF_NOT_OK(SanityCheck());
       // We need to bring up the Task Manager by bringing up the Services singleton.
       RETURN_IF_NOT_OK(Services::CreateInstance());
+      CachePool::EvictionPolicy policy;
+      RETURN_IF_NOT_OK(ParseEvictionPolicy(eviction_policy_, &policy));
       RETURN_IF_NOT_OK(
-        CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_, memory_cap_ratio_));
+        CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_, memory_cap_ratio_, policy));
       return Status::OK();
     }
 
@@ -112,6 +128,11 @@ class CacheServer : public Service {
     int32_t port_;
     int32_t shared_memory_sz_in_gb_;
     float memory_cap_ratio_;
+    std::string eviction_policy_;
+
+    /// \brief Convert the name of an eviction policy
+    /// \return Status object
+    static Status ParseEvictionPolicy(const std::string &name, CachePool::EvictionPolicy *out);
 
     /// \brief Sanity checks on the shared memory.
     /// \return Status object
@@ -127,11 +148,12 @@ class CacheServer : public Service {
   ~CacheServer() override { (void)ServiceStop(); }
 
   static Status CreateInstance(const std::string &spill_path, int32_t num_workers, int32_t port,
-                               int32_t shared_memory_sz, float memory_cap_ratio) {
+                               int32_t shared_memory_sz, float memory_cap_ratio,
+                               CachePool::EvictionPolicy eviction_policy) {
     std::call_once(init_instance_flag_, [&]() -> Status {
       auto &SvcManager = Services::GetInstance();
-      RETURN_IF_NOT_OK(
-        SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz, memory_cap_ratio));
+      RETURN_IF_NOT_OK(SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz,
+                                          memory_cap_ratio, eviction_policy));
       return Status::OK();
     });
     return Status::OK();
@@ -203,12 +225,14 @@ class CacheServer : public Service {
   float memory_cap_ratio_;
   int64_t memory_cap_;
   std::atomic<int64_t> cur_mem_usage_;
+  CachePool::EvictionPolicy eviction_policy_;
 
   /// \brief Constructor
   /// \param spill_path Top directory for spilling buffers to.
   /// \param num_workers Number of threads for handling requests.
+  /// \param eviction_policy How caches that spill pick the rows to move to disk.
   explicit CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port, int32_t share_memory_sz_in_gb,
-                       float memory_cap_ratio);
+                       float memory_cap_ratio, CachePool::EvictionPolicy eviction_policy);
 
   /// \brief Locate a cache service from connection id.
   /// \return Pointer to cache service. Null if not found
@@ -19,9 +19,11 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id,
+                           CachePool::EvictionPolicy policy)
     : root_(root),
       cache_mem_sz_(mem_sz),
+      policy_(policy),
       cp_(nullptr),
       next_id_(0),
       generate_id_(generate_id),
@@ -57,7 +59,7 @@ Status CacheService::DoServiceStart() {
     mp_ = std::make_shared<SystemPool>();
   }
   // Put together a CachePool for backing up the Tensor
-  cp_ = std::make_shared<CachePool>(CachePool::value_allocator(mp_), UseArena(), root_);
+  cp_ = std::make_shared<CachePool>(CachePool::value_allocator(mp_), UseArena(), root_, policy_);
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name.
   cookie_ = cp_->MyName();
@@ -259,7 +261,7 @@ Status CacheService::PreBatchFetch(const std::vector<row_id_type> &v, std::vecto
     auto sz = cp_->GetSize(row_id);
     if (sz > 0) {
       (*out).emplace_back(row_id, sz);
-      (*mem_sz) += sz;
+      (*mem_sz) += RowSizeAligned(sz);
     } else {
       // key not found
       (*out).emplace_back(-1, 0);
@@ -282,7 +284,7 @@ Status CacheService::BatchFetch(const std::vector<row_id_type> &v, const std::ve
   offset_array[0] = data_offset;
   for (auto i = 0; i < num_elements; ++i) {
     auto sz = info.at(i).second;
-    offset_array[i + 1] = offset_array[i] + sz;
+    offset_array[i + 1] = offset_array[i] + RowSizeAligned(sz);
     if (sz > 0) {
       WritableSlice row_data(*out, offset_array[i], sz);
       auto key = info.at(i).first;
@@ -28,6 +28,7 @@
 
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/cache/cache_common.h"
 #include "minddata/dataset/engine/cache/cache_request.h"
 #include "minddata/dataset/util/arena.h"
 #include "minddata/dataset/util/btree.h"
@@ -53,7 +54,9 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param policy How rows in memory are picked to move to disk once the memory is full. Applies only if spilling
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id,
+               CachePool::EvictionPolicy policy = CachePool::EvictionPolicy::kNone);
   ~CacheService();
 
   /// \brief For fixed size memory, we will create an Arena.
@@ -145,6 +148,7 @@ class CacheService : public Service {
   mutable RWLock rw_lock_;
   std::string root_;
   uint64_t cache_mem_sz_;
+  CachePool::EvictionPolicy policy_;
   std::shared_ptr<CachePool> cp_;
   std::atomic<row_id_type> next_id_;
   bool generate_id_;
@@ -164,6 +168,9 @@ class CacheService : public Service {
   /// \brief Private function to generate a row id
   /// \return Row id assigned.
   row_id_type GetNextRowId() { return next_id_.fetch_add(1); }
+  /// \brief Private function to get the space a row takes in the output of BatchFetch
+  /// \return Size of the row padded to kRowAlignment
+  static int64_t RowSizeAligned(int64_t sz) { return (sz + kRowAlignment - 1) / kRowAlignment * kRowAlignment; }
 };
 }  // namespace dataset
 }  // namespace mindspore
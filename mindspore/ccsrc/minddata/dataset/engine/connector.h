@@ -146,6 +146,17 @@ class Connector {
     MS_LOG(DEBUG) << "Connector counters reset.";
   }
 
+  // Change the capacity of every internal queue while the connector is in use.
+  // @param queue_capacity The new number of element (DataBuffer) for each queue.
+  // @return Status - The error code return
+  virtual Status Resize(int32_t queue_capacity) {
+    for (int i = 0; i < queues_.size(); ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    MS_LOG(DEBUG) << "Connector " << my_name_ << " resized to " << queue_capacity << " per queue.";
+    return Status::OK();
+  }
+
   void Print(std::ostream &out, bool showAll) const {
     out << "\n--------- Connector ------------"
         << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
@@ -158,7 +169,7 @@ class Connector {
   }
 
   // Get current size of connector.
-  int32_t size() const {
+  virtual int32_t size() const {
     int32_t size = 0;
     for (int32_t i = 0; i < queues_.size(); ++i) {
       size += queues_[i]->size();
@@ -166,7 +177,7 @@ class Connector {
     return size;
   }
 
-  int32_t capacity() const {
+  virtual int32_t capacity() const {
     int32_t capacity = 0;
     for (int32_t i = 0; i < queues_.size(); ++i) {
       capacity += queues_[i]->capacity();
@@ -177,7 +188,7 @@ class Connector {
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
-  Status Register(TaskGroup *vg) {
+  virtual Status Register(TaskGroup *vg) {
     Status rc = queues_.Register(vg);
     if (rc.IsOk()) {
       rc = cv_.Register(vg->GetIntrpService());
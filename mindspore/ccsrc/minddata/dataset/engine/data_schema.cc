@@ -21,6 +21,7 @@
 #include <map>
 #include <memory>
 #include <sstream>
+#include <utility>
 #include <nlohmann/json.hpp>
 
 #include "utils/ms_utils.h"
@@ -425,6 +426,20 @@ Status DataSchema::AddColumn(const ColDescriptor &cd) {
   return Status::OK();
 }
 
+Status DataSchema::ProjectColumns(const std::vector<std::string> &columns) {
+  std::vector<ColDescriptor> projected_col_descs;
+  for (const auto &col_desc : col_descs_) {
+    if (std::find(columns.begin(), columns.end(), col_desc.name()) != columns.end()) {
+      projected_col_descs.push_back(col_desc);
+    }
+  }
+  if (projected_col_descs.size() != columns.size()) {
+    RETURN_STATUS_UNEXPECTED("Invalid parameter, some of the columns to project are not in the schema.");
+  }
+  col_descs_ = std::move(projected_col_descs);
+  return Status::OK();
+}
+
 // Internal helper function. Performs sanity checks on the json file setup.
 Status DataSchema::PreLoadExceptionCheck(const nlohmann::json &js) {
   // Check if columns node exists.  It is required for building schema from file.
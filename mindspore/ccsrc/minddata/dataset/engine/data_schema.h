@@ -151,6 +151,11 @@ class DataSchema {
   /// \return Status - The error code return
   Status AddColumn(const ColDescriptor &cd);
 
+  /// \brief Keeps only the given columns in the schema, in their schema order. The number of rows is kept.
+  /// \param[in] columns - The names of the columns to keep, all of them must be in the schema
+  /// \return Status - The error code return
+  Status ProjectColumns(const std::vector<std::string> &columns);
+
   /// \brief getter
   /// \return The reference to a ColDescriptor to get (const version)
   const ColDescriptor &column(int32_t idx) const;
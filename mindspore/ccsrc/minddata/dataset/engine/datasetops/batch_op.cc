@@ -15,6 +15,9 @@
  */
 #include "minddata/dataset/engine/datasetops/batch_op.h"
 
+#include <algorithm>
+#include <future>
+#include <thread>
 #include <utility>
 #include <iomanip>
 
@@ -75,7 +78,9 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       out_col_names_(out_col),
       batch_size_func_(batch_size_func),
       batch_map_func_(batch_map_func),
-      pad_info_(pad_map) {
+      pad_info_(pad_map),
+      num_copy_threads_(
+        std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()) / std::max(num_workers, 1))) {
   worker_queues_.Init(num_workers, op_queue_size);
 }
 // if PYTHON is disabled. per_batch_map can't be used
@@ -87,7 +92,9 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       drop_(drop),
       pad_(pad),
       in_col_names_(cols_to_map),
-      pad_info_(pad_map) {
+      pad_info_(pad_map),
+      num_copy_threads_(
+        std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()) / std::max(num_workers, 1))) {
   worker_queues_.Init(num_workers, op_queue_size);
 }
 #endif
@@ -97,13 +104,13 @@ Status BatchOp::operator()() {
   // Synchronize with TaskManager
   TaskManager::FindMe()->Post();
   RETURN_IF_NOT_OK(rc);
-  int64_t epoch_num = 0, batch_num = 0, cnt = 0;
+  int64_t epoch_num = start_epoch_num_, batch_num = start_batch_num_, cnt = 0;
   TensorRow new_row;
   std::unique_ptr<TensorQTable> table = std::make_unique<TensorQTable>();
   child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
   RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   int32_t cur_batch_size = 0;
-  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(0, 0, 0)));
+  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, 0)));
   while (child_iterator_->eof_handled() == false) {
     while (new_row.empty() == false) {
       table->emplace_back(new_row);
@@ -156,13 +163,89 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
+namespace {
+// a batch is only split among copy threads if each thread gets at least this many bytes to copy
+constexpr int64_t kMinBytesPerCopyThread = 4 * 1024 * 1024;
+
+// A numeric column of the batch being assembled, each row is copied into its own slot of the output tensor
+struct ColumnSlots {
+  size_t col_id;
+  TensorShape slot_shape;
+  std::vector<dsize_t> slot_strides;
+  dsize_t slot_bytes;
+  uchar *base;                       // start address of the first slot
+  std::shared_ptr<Tensor> pad_cell;  // pad value cast to the column type, nullptr pads with 0
+};
+
+// Copy a tensor of shape src_shape into a slot of shape slot_shape with the same rank, the dimensions longer than the
+// slot get truncated
+Status CopyToSlot(const uchar *src, const std::vector<dsize_t> &src_shape, const std::vector<dsize_t> &src_strides,
+                  uchar *dst, const std::vector<dsize_t> &slot_shape, const std::vector<dsize_t> &slot_strides,
+                  size_t dim, int64_t type_size) {
+  dsize_t num = std::min(src_shape[dim], slot_shape[dim]);
+  if (dim == src_shape.size() - 1) {
+    dsize_t len = num * type_size;
+    if (len > 0) {
+      CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst, len, src, len) == 0, "memcpy error while padding a batch.");
+    }
+    return Status::OK();
+  }
+  for (dsize_t i = 0; i < num; i++) {
+    RETURN_IF_NOT_OK(CopyToSlot(src + i * src_strides[dim] * type_size, src_shape, src_strides,
+                                dst + i * slot_strides[dim] * type_size, slot_shape, slot_strides, dim + 1, type_size));
+  }
+  return Status::OK();
+}
+
+// Fill a slot with the pad value, doubling the filled part on every copy
+Status FillSlot(uchar *dst, dsize_t slot_bytes, const std::shared_ptr<Tensor> &pad_cell) {
+  if (pad_cell == nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(memset_s(dst, slot_bytes, 0, slot_bytes) == 0, "memset error while padding a batch.");
+    return Status::OK();
+  }
+  dsize_t filled = std::min(pad_cell->SizeInBytes(), slot_bytes);
+  CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst, filled, pad_cell->GetBuffer(), filled) == 0,
+                               "memcpy error while padding a batch.");
+  while (filled < slot_bytes) {
+    dsize_t len = std::min(filled, slot_bytes - filled);
+    CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst + filled, len, dst, len) == 0, "memcpy error while padding a batch.");
+    filled += len;
+  }
+  return Status::OK();
+}
+
+// Copy rows [begin, end) of the table into their slots
+Status CopyRowsToSlots(const TensorQTable &table, const std::vector<ColumnSlots> &columns, dsize_t begin,
+                       dsize_t end) {
+  for (const auto &column : columns) {
+    int64_t type_size = table.at(0).at(column.col_id)->type().SizeInBytes();
+    for (dsize_t j = begin; j < end; j++) {
+      const std::shared_ptr<Tensor> &tensor = table.at(j).at(column.col_id);
+      uchar *slot = column.base + j * column.slot_bytes;
+      if (tensor->shape() == column.slot_shape) {
+        CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(slot, column.slot_bytes, tensor->GetBuffer(), column.slot_bytes) == 0,
+                                     "memcpy error while assembling a batch.");
+      } else {  // only padded columns have rows that differ from the slot shape
+        RETURN_IF_NOT_OK(FillSlot(slot, column.slot_bytes, column.pad_cell));
+        if (tensor->shape().NumOfElements() > 0) {
+          RETURN_IF_NOT_OK(CopyToSlot(tensor->GetBuffer(), tensor->shape().AsVector(), tensor->shape().Strides(), slot,
+                                      column.slot_shape.AsVector(), column.slot_strides, 0, type_size));
+        }
+      }
+    }
+  }
+  return Status::OK();
+}
+}  // namespace
+
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size) {
+                          dsize_t batch_size, const std::vector<std::vector<dsize_t>> &pad_shapes,
+                          const std::vector<std::shared_ptr<Tensor>> &pad_vals, int32_t num_copy_threads) {
   if ((*src)->size() != batch_size) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Source table size does not match the batch_size");
   }
 
-  if (batch_size == 1) {
+  if (batch_size == 1 && pad_shapes.empty()) {
     TensorRow row = std::move((*src)->front());
     (*src)->pop_front();
     (*dest)->push_back(row);
@@ -173,30 +256,50 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
   }
 
   TensorRow batched_row;
+  std::vector<ColumnSlots> numeric_columns;
+  int64_t total_bytes = 0;
   auto num_columns = (*src)->front().size();
   for (size_t i = 0; i < num_columns; i++) {
     std::shared_ptr<Tensor> first_tensor = (*src)->at(0).at(i);  // first row, column i
     TensorShape first_shape = first_tensor->shape();
     DataType first_type = first_tensor->type();
-    TensorShape new_shape = first_shape.PrependDim(static_cast<int64_t>(batch_size));
+    bool padded = i < pad_shapes.size() && !pad_shapes[i].empty();
+    TensorShape slot_shape = padded ? TensorShape(pad_shapes[i]) : first_shape;
+    TensorShape new_shape = slot_shape.PrependDim(static_cast<int64_t>(batch_size));
 
     std::shared_ptr<Tensor> new_tensor;
     if (first_type.IsNumeric()) {  // numeric tensor
-      RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
-      dsize_t j = 0;
-      for (auto row : **src) {
-        std::shared_ptr<Tensor> old_tensor = row.at(i);  // row j, column i
-        if (old_tensor->shape() == first_shape) {        // check the newly popped rows have the same dim as the first
-          if (new_shape.NumOfElements() != 0) {
-            RETURN_IF_NOT_OK(new_tensor->InsertTensor({j++}, old_tensor));
-          }
-          // Don't do anything if the tensor has no data
-        } else {
+      for (const auto &row : **src) {
+        const std::shared_ptr<Tensor> &old_tensor = row.at(i);
+        CHECK_FAIL_RETURN_UNEXPECTED(old_tensor->type().SizeInBytes() == first_type.SizeInBytes(),
+                                     "Invalid data, expect same type for each data row, but got inconsistent data "
+                                     "types in column " +
+                                       std::to_string(i));
+        // check all rows have the same dim as the first, or the same rank as the pad shape if the column is padded
+        if (padded ? old_tensor->Rank() != slot_shape.Rank() : old_tensor->shape() != first_shape) {
           RETURN_STATUS_UNEXPECTED(
             "Invalid data, expect same shape for each data row, but got inconsistent data shapes in column " +
             std::to_string(i));
         }
       }
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+      // Don't do anything if the tensor has no data
+      if (new_shape.NumOfElements() != 0) {
+        ColumnSlots column{i, slot_shape, slot_shape.Strides(), slot_shape.NumOfElements() * first_type.SizeInBytes(),
+                           nullptr, nullptr};
+        TensorShape remaining = TensorShape::CreateUnknownRankShape();
+        RETURN_IF_NOT_OK(new_tensor->StartAddrOfIndex({0}, &column.base, &remaining));
+        if (padded && i < pad_vals.size() && pad_vals[i] != nullptr) {
+          CHECK_FAIL_RETURN_UNEXPECTED(pad_vals[i]->type().IsNumeric(),
+                                       "Source and pad_value tensors are not of the same type.");
+          // same as PadEnd, the pad value goes through float
+          std::shared_ptr<Tensor> float_pad_value;
+          RETURN_IF_NOT_OK(TypeCast(pad_vals[i], &float_pad_value, DataType(DataType::DE_FLOAT32)));
+          RETURN_IF_NOT_OK(TypeCast(float_pad_value, &column.pad_cell, first_type));
+        }
+        total_bytes += column.slot_bytes * batch_size;
+        numeric_columns.push_back(std::move(column));
+      }
     } else {  // handle string column differently
       std::vector<std::string> strings;
       for (dsize_t j = 0; j < batch_size; j++) {
@@ -210,6 +313,23 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
     batched_row.emplace_back(new_tensor);
   }
 
+  // Copy the rows into their slots, big batches are split among threads by rows
+  int64_t num_threads = std::min<int64_t>({static_cast<int64_t>(num_copy_threads), static_cast<int64_t>(batch_size),
+                                           total_bytes / kMinBytesPerCopyThread});
+  num_threads = std::max<int64_t>(num_threads, 1);
+  dsize_t rows_per_thread = (batch_size + num_threads - 1) / num_threads;
+  std::vector<std::future<Status>> copy_results;
+  for (dsize_t begin = rows_per_thread; begin < batch_size; begin += rows_per_thread) {
+    copy_results.push_back(std::async(std::launch::async, &CopyRowsToSlots, std::cref(**src),
+                                      std::cref(numeric_columns), begin, std::min(begin + rows_per_thread, batch_size)));
+  }
+  Status rc = CopyRowsToSlots(**src, numeric_columns, 0, std::min(rows_per_thread, batch_size));
+  for (auto &result : copy_results) {
+    Status copy_rc = result.get();
+    if (rc.IsOk()) rc = copy_rc;
+  }
+  RETURN_IF_NOT_OK(rc);
+
   (*dest)->emplace_back(batched_row);
 
   return Status::OK();
@@ -218,7 +338,10 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
-  RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
+  {
+    OpLatency::IdleScope idle(latency());
+    RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
+  }
   while (table_pair.second.ctrl_ != batchCtrl::kQuit) {
     if (table_pair.second.ctrl_ == batchCtrl::kEOE) {
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
@@ -229,6 +352,7 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(MakeBatchedBuffer(std::move(table_pair), &db));
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::move(db)));
     }
+    OpLatency::IdleScope idle(latency());
     RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
   }
   return Status::OK();
@@ -240,10 +364,14 @@ Status BatchOp::MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatc
 #ifdef ENABLE_PYTHON
   if (!in_col_names_.empty()) RETURN_IF_NOT_OK(MapColumns(&table_pair));  // pass it through pyfunc
 #endif
-  if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));  // do padding if needed
+  // do padding if needed, numeric columns are padded by BatchRows as it copies them into the batch
+  std::vector<std::vector<dsize_t>> pad_shapes;
+  std::vector<std::shared_ptr<Tensor>> pad_vals;
+  if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_, &pad_shapes, &pad_vals));
   (*db) = std::make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> dest_table = std::make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  RETURN_IF_NOT_OK(
+    BatchRows(&table_pair.first, &dest_table, table_pair.first->size(), pad_shapes, pad_vals, num_copy_threads_));
   (*db)->set_tensor_table(std::move(dest_table));
   return Status::OK();
 }
@@ -391,6 +519,13 @@ Status BatchOp::InvokeBatchMapFunc(TensorTable *input, TensorTable *output, CBat
 
 Status BatchOp::PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
                            const std::unordered_map<std::string, int32_t> &column_name_id_map) {
+  return PadColumns(table, pad_info, column_name_id_map, nullptr, nullptr);
+}
+
+Status BatchOp::PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                           const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                           std::vector<std::vector<dsize_t>> *numeric_pad_shapes,
+                           std::vector<std::shared_ptr<Tensor>> *pad_vals_out) {
   RETURN_UNEXPECTED_IF_NULL(table);  // placeholder for now, might need this in the future
   CHECK_FAIL_RETURN_UNEXPECTED(
     (*table)->front().size() == column_name_id_map.size(),
@@ -433,6 +568,21 @@ Status BatchOp::PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &
     }
   }
 
+  // leave the numeric columns to BatchRows if the caller asks for it, rank 0 tensors are never padded
+  if (numeric_pad_shapes != nullptr && pad_vals_out != nullptr) {
+    numeric_pad_shapes->assign(column_name_id_map.size(), {});
+    for (auto itr = pad_cols.begin(); itr != pad_cols.end();) {
+      const std::shared_ptr<Tensor> &front = (*table)->front()[*itr];
+      if (front->type().IsNumeric() && front->Rank() > 0) {
+        (*numeric_pad_shapes)[*itr] = pad_shapes[*itr];
+        itr = pad_cols.erase(itr);
+      } else {
+        ++itr;
+      }
+    }
+    *pad_vals_out = pad_vals;
+  }
+
   // call pad on each tensor that needs to be padded
   for (TensorRow &row : **table) {
     for (size_t col_id : pad_cols) {
@@ -546,9 +696,9 @@ Status BatchOp::GetDatasetSize(int64_t *dataset_size) {
   RETURN_IF_NOT_OK(child_[0]->GetDatasetSize(&num_rows));
   if (num_rows > 0 && start_batch_size_ > 0) {
     if (drop_) {
-      num_rows = floor(num_rows / start_batch_size_);
+      num_rows = num_rows / start_batch_size_;
     } else {
-      num_rows = ceil(num_rows / start_batch_size_);
+      num_rows = (num_rows + start_batch_size_ - 1) / start_batch_size_;
     }
   }
   *dataset_size = num_rows;
@@ -564,5 +714,29 @@ int64_t BatchOp::GetTreeBatchSize() {
   return start_batch_size_;
 }
 
+Status BatchOp::SkipPasses(int64_t passes) {
+  RETURN_IF_NOT_OK(DatasetOp::SkipPasses(passes));
+  start_epoch_num_ += passes;
+  return Status::OK();
+}
+
+bool BatchOp::CanSeekRows() {
+#ifdef ENABLE_PYTHON
+  if (batch_size_func_) {
+    return false;
+  }
+#endif
+  return ChildrenCanSeekRows();
+}
+
+Status BatchOp::SeekRows(int64_t rows) {
+  if (rows == 0) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(CanSeekRows(), "Cannot skip the batches of a batch size function.");
+  start_batch_num_ = rows;
+  return SeekChildrenRows(rows * start_batch_size_);
+}
+
 }  // namespace dataset
 }  // namespace mindspore
@@ -204,13 +204,18 @@ class BatchOp : public ParallelOp {
   std::string Name() const override { return kBatchOp; }
 
   // batch the rows in src table then put it to dest table
+  // numeric columns are copied straight into a pre-allocated output tensor, big batches are copied by several threads
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
   // @param int32_t size - batch_size
-  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param const std::vector<std::vector<dsize_t>> &pad_shapes - shape each numeric column is padded to while it is
+  //     copied into the batch, empty for the columns that are not padded
+  // @param const std::vector<std::shared_ptr<Tensor>> &pad_vals - value to pad each column with, nullptr pads with 0
+  // @param int32_t num_copy_threads - max number of threads copying the rows of one batch
   // @return Status - The error code return
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size);
+                          dsize_t batch_size, const std::vector<std::vector<dsize_t>> &pad_shapes = {},
+                          const std::vector<std::shared_ptr<Tensor>> &pad_vals = {}, int32_t num_copy_threads = 1);
 
   // @param table
   // @param const PadInfo &pad_info pad info
@@ -219,6 +224,19 @@ class BatchOp : public ParallelOp {
   static Status PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
                            const std::unordered_map<std::string, int32_t> &column_name_id_map);
 
+  // Same as above, but if numeric_pad_shapes is not null the numeric columns are left as they are and their pad shapes
+  // and values are returned instead, so BatchRows can pad them in place while it copies them into the batch
+  // @param table
+  // @param const PadInfo &pad_info pad info
+  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param std::vector<std::vector<dsize_t>> *numeric_pad_shapes - pad shape of each numeric column, empty if unpadded
+  // @param std::vector<std::shared_ptr<Tensor>> *pad_vals - pad value of each column
+  // @return Status - The error code return
+  static Status PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                           const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                           std::vector<std::vector<dsize_t>> *numeric_pad_shapes,
+                           std::vector<std::shared_ptr<Tensor>> *pad_vals);
+
   /// \brief Base-class override for GetDatasetSize
   /// \param[out] dataset_size the size of the dataset
   /// \return Status of the function
@@ -226,6 +244,20 @@ class BatchOp : public ParallelOp {
 
   int64_t GetTreeBatchSize() override;
 
+  // Base-class override, the batch numbers in the batch info go on from the skipped epochs
+  // @param int64_t passes - number of epochs to skip
+  // @return Status - The error code return
+  Status SkipPasses(int64_t passes) override;
+
+  // Base-class override, a fixed batch size maps the batches to skip to the rows of the child
+  // @return bool - T/F if the batch size is fixed and the child can seek rows
+  bool CanSeekRows() override;
+
+  // Base-class override, skips whole batches
+  // @param int64_t rows - number of batches to skip
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override;
+
  protected:
   Status ComputeColMap() override;
 
@@ -281,11 +313,14 @@ class BatchOp : public ParallelOp {
 #endif
 
   int32_t start_batch_size_;
+  int64_t start_epoch_num_ = 0;  // epoch_num of the first batch, set when resuming a previous run
+  int64_t start_batch_num_ = 0;  // batch_num of the first batch, set when resuming a previous run
   const bool drop_;                                     // bool for whether to drop remainder or not
   const bool pad_;                                      // bool for whether to perform padding on tensor
   const std::vector<std::string> in_col_names_;         // input column name for per_batch_map
   std::vector<std::string> out_col_names_;              // output column name for per_batch_map
   PadInfo pad_info_;                                    // column names to perform padding on
+  const int32_t num_copy_threads_;                      // max number of threads copying the rows of one batch
   std::unique_ptr<ChildIterator> child_iterator_;       // child iterator for fetching TensorRows 1 by 1
   std::unordered_map<std::string, int32_t> child_map_;  // col_name_id_map of the child node
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;  // internal queue for syncing worker
@@ -131,6 +131,9 @@ Status CacheMergeOp::CacheMissWorkerEntry(int32_t workerId) {
           std::string errMsg = "Expect positive row id: " + std::to_string(row_id);
           RETURN_STATUS_UNEXPECTED(errMsg);
         }
+        const CacheImageCodec &codec = cache_client_->GetImageCodec();
+        TensorRow compact_row;
+        RETURN_IF_NOT_OK(codec.Encode(row, &compact_row));
         if (cache_missing_rows_) {
           // Technically number of this row shows up in the cache miss stream is equal to the number
           // of P() call. However the cleaner wants it too. So we need an extra copy.
@@ -140,12 +143,17 @@ Status CacheMergeOp::CacheMissWorkerEntry(int32_t workerId) {
             // We will send the request async. But any error we most
             // likely ignore and continue.
             Status rc;
-            rc = rq->AsyncSendCacheRequest(cache_client_, row);
+            rc = rq->AsyncSendCacheRequest(cache_client_, compact_row);
             if (rc.IsOk()) {
               RETURN_IF_NOT_OK(io_que_->EmplaceBack(row_id));
             }
           }
         }
+        // The images of a miss go downstream in the form a hit comes back from the cache in
+        if (codec.enabled()) {
+          row = std::move(compact_row);
+          RETURN_IF_NOT_OK(codec.Decode(&row));
+        }
         RETURN_IF_NOT_OK(cache_miss_.Add(row_id, std::move(row)));
       }
     }
@@ -205,6 +213,8 @@ Status CacheMergeOp::PrepareNodePostAction() {  // Run any common code from supe
     rc = Status::OK();
   }
   RETURN_IF_NOT_OK(rc);
+  // The rows of both the lookup and the miss streams have the columns of this op
+  RETURN_IF_NOT_OK(cache_client_->SelectImageColumns(column_name_id_map()));
   return Status::OK();
 }
 
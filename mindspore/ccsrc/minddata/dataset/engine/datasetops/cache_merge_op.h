@@ -53,7 +53,7 @@ class CacheMergeOp : public ParallelOp {
     void SetState(State newState) { st_ = newState; }
     /// Take a tensor row and send rpc call to the server async
     /// \param cc Cache client of the CacheMergeOp
-    /// \param row TensorRow to be sent to the server
+    /// \param row TensorRow to be sent to the server, its images already in the form the cache stores them in
     /// \return Status object
     /// \note Thread safe
     Status AsyncSendCacheRequest(const std::shared_ptr<CacheClient> &cc, const TensorRow &row);
@@ -86,6 +86,7 @@ Status CacheOp::operator()() {
                   "Invalid parameter, CacheOp requires a sampler before it can be executed, but got nullptr.");
   }
   RETURN_IF_NOT_OK(RegisterResources());
+  RETURN_IF_NOT_OK(cache_client_->SelectImageColumns(column_name_id_map()));
   // Kick off the workers
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_, std::bind(&CacheOp::WorkerEntry, this, std::placeholders::_1)));
   // required task group sync after launching workers
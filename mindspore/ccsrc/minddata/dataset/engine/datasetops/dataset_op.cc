@@ -29,6 +29,7 @@
 #include "minddata/dataset/engine/datasetops/epoch_ctrl_op.h"
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/db_connector.h"
+#include "minddata/dataset/engine/lock_free_db_connector.h"
 #include "minddata/dataset/engine/opt/pass.h"
 #ifndef ENABLE_ANDROID
 #include "utils/system/crc32c.h"
@@ -214,7 +215,9 @@ std::vector<DatasetOp *> DatasetOp::parents() const { return parent_; }
 void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   MS_LOG(DEBUG) << "Creating connector in tree operator: " << operator_id_ << ". Producer: " << num_producers
                 << ". Consumer: " << num_consumers << ".";
-  if (oc_queue_size_ > 0) {
+  if (oc_queue_size_ > 0 && lock_free_connector_) {
+    out_connector_ = std::make_unique<LockFreeDbConnector>(num_producers, num_consumers, oc_queue_size_);
+  } else if (oc_queue_size_ > 0) {
     out_connector_ = std::make_unique<DbConnector>(num_producers,  // The number of producers
                                                    num_consumers,  // Only one consumer (the training App)
                                                    oc_queue_size_);
@@ -225,6 +228,38 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   }
 }
 
+// Change the capacity of each queue of the output connector
+Status DatasetOp::ResizeConnector(int32_t queue_capacity) {
+  if (out_connector_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Operator " + std::to_string(operator_id_) + " has no output connector to resize.");
+  }
+  RETURN_IF_NOT_OK(out_connector_->Resize(queue_capacity));
+  oc_queue_size_ = queue_capacity;
+  return Status::OK();
+}
+
+// Attach latency histograms to the output connector and to the connectors this op pops from
+Status DatasetOp::EnableLatencyProfiling() {
+  if (inlined() || latency_ != nullptr) {
+    return Status::OK();
+  }
+  latency_ = std::make_unique<OpLatency>(num_producers(), num_consumers());
+  if (out_connector_ != nullptr) {
+    out_connector_->SetProducerLatency(latency_.get());
+  }
+  for (auto &child : child_) {
+    // Getting a buffer from an inlined child pops from the connector below it, in the thread of this op
+    DatasetOp *op = child.get();
+    while (op->inlined() && op->child_.size() == 1) {
+      op = op->child_[0].get();
+    }
+    if (op->out_connector_ != nullptr) {
+      op->out_connector_->SetConsumerLatency(latency_.get());
+    }
+  }
+  return Status::OK();
+}
+
 // A print method typically used for debugging.  showAll of true will recursively descend to child prints
 void DatasetOp::Print(std::ostream &out, bool show_all) const {
   // When show_all is false, we display a 1 liner piece of text for the op.
@@ -469,6 +504,71 @@ void DatasetOp::UpdateRepeatAndEpochCounter() {
   if (op_current_repeats_ % op_num_repeats_per_epoch_ == 0) op_current_epochs_++;
   MS_LOG(DEBUG) << Name() << " current repeats: " << op_current_repeats_ << ", current epochs: " << op_current_epochs_;
 }
+
+Status DatasetOp::SkipPasses(int64_t passes) {
+  CHECK_FAIL_RETURN_UNEXPECTED(passes >= 0, "Invalid parameter, cannot skip " + std::to_string(passes) + " passes.");
+  op_current_repeats_ += static_cast<int32_t>(passes);
+  if (op_num_repeats_per_epoch_ > 0) {
+    op_current_epochs_ = op_current_repeats_ / op_num_repeats_per_epoch_;
+  }
+  if (IsMappableLeaf()) {
+    RETURN_IF_NOT_OK(sampler_->Seek(passes, 0));
+  }
+  return Status::OK();
+}
+
+Status DatasetOp::SkipSubtreePasses(int64_t passes) {
+  RETURN_IF_NOT_OK(SkipPasses(passes));
+  for (auto &child : child_) {
+    // A child makes op_num_repeats_per_epoch / ours passes for each of ours
+    CHECK_FAIL_RETURN_UNEXPECTED(op_num_repeats_per_epoch_ > 0 && child->op_num_repeats_per_epoch_ > 0,
+                                 "Cannot skip the passes of " + child->Name() + " under " + Name() + ".");
+    RETURN_IF_NOT_OK(child->SkipSubtreePasses(passes * child->op_num_repeats_per_epoch_ / op_num_repeats_per_epoch_));
+  }
+  return Status::OK();
+}
+
+bool DatasetOp::CanSeekRows() { return IsMappableLeaf() && sampler_->CanSkipSamples(); }
+
+Status DatasetOp::SeekRows(int64_t rows) {
+  if (rows == 0) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(CanSeekRows(), Name() + " cannot start part way through a pass.");
+  return sampler_->Seek(0, rows);
+}
+
+Status DatasetOp::SaveState(nlohmann::json *state) {
+  RETURN_UNEXPECTED_IF_NULL(state);
+  if (sampler_ != nullptr) {
+    RETURN_IF_NOT_OK(sampler_->SaveState(&(*state)["sampler"]));
+  }
+  return Status::OK();
+}
+
+Status DatasetOp::RestoreState(const nlohmann::json &state) {
+  if (sampler_ != nullptr && state.find("sampler") != state.end()) {
+    RETURN_IF_NOT_OK(sampler_->RestoreState(state["sampler"]));
+  }
+  return Status::OK();
+}
+
+bool DatasetOp::IsMappableLeaf() const {
+  return child_.empty() && sampler_ != nullptr && dynamic_cast<const RandomAccessOp *>(this) != nullptr;
+}
+
+bool DatasetOp::ChildrenCanSeekRows() {
+  return std::all_of(child_.begin(), child_.end(),
+                     [](const std::shared_ptr<DatasetOp> &child) { return child->CanSeekRows(); });
+}
+
+Status DatasetOp::SeekChildrenRows(int64_t rows) {
+  for (auto &child : child_) {
+    RETURN_IF_NOT_OK(child->SeekRows(rows));
+  }
+  return Status::OK();
+}
+
 int64_t DatasetOp::GetTreeBatchSize() {
   if (!child_.empty()) {
     return child_[0]->GetTreeBatchSize();
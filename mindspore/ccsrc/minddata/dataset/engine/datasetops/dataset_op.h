@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <nlohmann/json.hpp>
 #include "minddata/dataset/callback/callback_manager.h"
 #include "minddata/dataset/core/constants.h"
 #include "minddata/dataset/engine/db_connector.h"
@@ -126,6 +127,11 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// \param num_consumers - number of threads that read from this connector
   void CreateConnector(int32_t num_producers, int32_t num_consumers);
 
+  /// \brief Setter function, choose a LockFreeDbConnector as the output connector. The connector is created when
+  ///     the tree is prepared, so this has to be set before.
+  /// \param lock_free - whether the output connector is lock free
+  void SetLockFreeConnector(bool lock_free) { lock_free_connector_ = lock_free; }
+
   /// \brief A print method typically used for debugging
   /// \param out - The output stream to write output to
   /// \param show_all - A bool to control if you want to show all info or just a summary
@@ -309,6 +315,20 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  /// \brief Change the capacity of each queue of the output connector, the tree may be running
+  /// \param[in] queue_capacity The new capacity of each queue
+  /// \return Status - The error code return
+  Status ResizeConnector(int32_t queue_capacity);
+
+  /// \brief Start recording the latency histograms of the threads of this operator, see OpLatency.
+  ///     Called before the tree is launched. An inlined operator runs in the thread of its parent and has none.
+  /// \return Status - The error code return
+  Status EnableLatencyProfiling();
+
+  /// \brief Getter function
+  /// \return The latency histograms of this operator, nullptr unless latency profiling is enabled
+  OpLatency *latency() const { return latency_.get(); }
+
   /// \brief Getter function
   /// \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
@@ -385,6 +405,40 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// \return Status
   virtual Status WaitForWorkers() { return Status::OK(); }
 
+  /// \brief Skips whole passes of the operator, i.e. what it produces up to an eoe, before it is launched.
+  ///     Used to resume where a previous run of the same pipeline left off. The base version moves the repeat
+  ///     counters and, for a leaf with a sampler, the sampler. Operators with their own per-pass state override it.
+  /// \param[in] passes Number of passes to skip
+  /// \return Status - The error code return
+  virtual Status SkipPasses(int64_t passes);
+
+  /// \brief Skips passes of this operator and the matching passes of all the operators below it
+  /// \param[in] passes Number of passes of this operator to skip
+  /// \return Status - The error code return
+  Status SkipSubtreePasses(int64_t passes);
+
+  /// \brief Checks if the current pass of the operator can start part way through without producing the rows
+  ///     before, see SeekRows
+  /// \return T/F if SeekRows works for any number of rows
+  virtual bool CanSeekRows();
+
+  /// \brief Starts the current pass of the operator after a number of rows, before it is launched.
+  ///     The base version supports a leaf with a sampler that can skip ids.
+  /// \param[in] rows Number of rows to skip
+  /// \return Status - The error code return
+  virtual Status SeekRows(int64_t rows);
+
+  /// \brief Saves what the operator needs to give the same output in another run, such as the seeds.
+  ///     The base version saves the state of the sampler, if any.
+  /// \param[out] state The json object to fill
+  /// \return Status - The error code return
+  virtual Status SaveState(nlohmann::json *state);
+
+  /// \brief Restores the state saved by SaveState, before the operator is launched
+  /// \param[in] state The saved state
+  /// \return Status - The error code return
+  virtual Status RestoreState(const nlohmann::json &state);
+
  protected:
   /// \brief Removes a parent operator from this operator
   /// \notes External callers do not have access to this function
@@ -407,6 +461,19 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// If this repeat happen to be the last repeat in the current epoch, also increase op_current_epochs_ by 1.
   void UpdateRepeatAndEpochCounter();
 
+  /// Checks if this is a leaf reading the rows its sampler picks, so seeking it only takes seeking the sampler
+  /// \return - T/F if the operator is such a leaf
+  bool IsMappableLeaf() const;
+
+  /// Checks if all the children can seek rows, for operators that produce one row per row of each child
+  /// \return - T/F if every child can seek rows
+  bool ChildrenCanSeekRows();
+
+  /// Seeks all the children by the same number of rows, for operators that produce one row per row of each child
+  /// \param rows - number of rows to skip
+  /// \return - Status
+  Status SeekChildrenRows(int64_t rows);
+
   std::vector<std::shared_ptr<DatasetOp>> child_;                // Child nodes
   std::vector<DatasetOp *> parent_;                              // Parent nodes. No ownership
   std::shared_ptr<Sampler> sampler_;                             // Some leaf ops might have a sampler
@@ -419,6 +486,8 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   int32_t op_current_repeats_;                                   // Current number of repeats the operator has handled
   int32_t op_current_epochs_;                                    // Current number of epochs the operator has handled
   std::unique_ptr<DbConnector> out_connector_;                   // Output Connector
+  std::unique_ptr<OpLatency> latency_;                           // Latency histograms, only set when profiling
+  bool lock_free_connector_ = false;                             // Whether out_connector_ is a LockFreeDbConnector
   std::unordered_map<std::string, int32_t> column_name_id_map_;  // Mapping between col index and col name
   std::mutex column_name_map_mutex_;                             // For protecting shared access to the column map
   CallbackManager callback_manager_;                             // Manages callbacks associated with a DatasetOp
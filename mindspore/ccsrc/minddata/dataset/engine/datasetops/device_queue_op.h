@@ -161,6 +161,18 @@ class DeviceQueueOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kDeviceQueueOp; }
 
+  // The op gives sends the rows of its child as they are, so it seeks the rows of its child
+  // @return T/F if the child can seek
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  // @param rows - number of rows to skip
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override { return SeekChildrenRows(rows); }
+
+  // Device id getter
+  // @return Id of the device the data is sent to
+  int32_t device_id() const { return device_id_; }
+
  private:
   //  Name: checkExceptions(DataBuffer);
   //  Description: Check whether the dataBuffer meets the condition for performing DeviceQueueOp
@@ -78,6 +78,14 @@ class EpochCtrlOp : public RepeatOp {
   Status Accept(NodePass *p, bool *modified) override;
 
   int64_t GetTreeRepeatCount() override;
+
+  // An epoch starts with a new pass of the child, so the rows of the epoch are the rows of the child
+  // @return T/F if the child can seek rows
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  // @param rows - number of rows to skip
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override { return SeekChildrenRows(rows); }
 };
 }  // namespace dataset
 }  // namespace mindspore
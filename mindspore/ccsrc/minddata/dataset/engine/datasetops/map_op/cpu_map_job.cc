@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <iterator>
 #include <memory>
 #include <vector>
 #include <utility>
@@ -33,21 +34,22 @@ CpuMapJob::~CpuMapJob() = default;
 
 // A function to execute a cpu map job
 Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
-  int32_t num_rows = in.size();
-  for (int32_t row = 0; row < num_rows; row++) {
-    TensorRow input_row = in[row];
-    TensorRow result_row;
-    for (size_t i = 0; i < ops_.size(); i++) {
-      // Call compute function for cpu
-      RETURN_IF_NOT_OK(ops_[i]->Compute(input_row, &result_row));
-
-      // Assign result_row to to_process for the next TensorOp processing, except for the last TensorOp in the list.
-      if (i + 1 < ops_.size()) {
-        input_row = std::move(result_row);
-      }
+  if (ops_.empty()) {
+    out->resize(out->size() + in.size());
+    return Status::OK();
+  }
+  // Each TensorOp processes the whole table before the next one, so it can share its work across the rows
+  std::vector<TensorRow> result_rows;
+  for (size_t i = 0; i < ops_.size(); i++) {
+    RETURN_IF_NOT_OK(ops_[i]->BatchCompute(in, &result_rows));
+    CHECK_FAIL_RETURN_UNEXPECTED(result_rows.size() == in.size(),
+                                 "TensorOp " + ops_[i]->Name() + " returned a different number of rows.");
+    // Assign result_rows to in for the next TensorOp processing, except for the last TensorOp in the list.
+    if (i + 1 < ops_.size()) {
+      in = std::move(result_rows);
     }
-    out->push_back(std::move(result_row));
   }
+  out->insert(out->end(), std::make_move_iterator(result_rows.begin()), std::make_move_iterator(result_rows.end()));
 
   return Status::OK();
 }
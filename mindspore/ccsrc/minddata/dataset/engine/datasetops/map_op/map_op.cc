@@ -111,7 +111,10 @@ Status MapOp::FetchNextWork(uint32_t worker_id, std::unique_ptr<DataBuffer> *db,
                             std::vector<std::shared_ptr<MapJob>> *job_list) {
   std::unique_ptr<MapWorkerJob> worker_job;
   // Fetch the next worker job and data buffer
-  RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(&worker_job));
+  {
+    OpLatency::IdleScope idle(latency());
+    RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(&worker_job));
+  }
   // Extract the databuffer and job list from the map worker job.
   *db = std::move(worker_job->databuffer);
   *job_list = std::move(worker_job->jobs);
@@ -193,6 +193,14 @@ class MapOp : public ParallelOp {
   // @return Name of the current Op
   std::string Name() const override { return kMapOp; }
 
+  // The op gives one row per input row, so it seeks the rows of its child
+  // @return T/F if the child can seek
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  // @param rows - number of rows to skip
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override { return SeekChildrenRows(rows); }
+
   // List of tensor ops getter/setter
   // @Return the vector of tensor ops by non-const reference
 
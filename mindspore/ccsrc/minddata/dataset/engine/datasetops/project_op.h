@@ -111,6 +111,18 @@ class ProjectOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kProjectOp; }
 
+  // The op gives one row per input row, so it seeks the rows of its child
+  // @return T/F if the child can seek
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  // @param rows - number of rows to skip
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override { return SeekChildrenRows(rows); }
+
+  // Getter method
+  // @return The names of the columns to project
+  const std::vector<std::string> &columns_to_project() const { return columns_to_project_; }
+
  private:
   std::vector<std::string> columns_to_project_;
   std::vector<int32_t> projected_column_indices_;
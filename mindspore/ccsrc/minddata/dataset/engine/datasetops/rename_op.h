@@ -120,6 +120,14 @@ class RenameOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kRenameOp; }
 
+  // The op gives one row per input row, so it seeks the rows of its child
+  // @return T/F if the child can seek
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  // @param rows - number of rows to skip
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override { return SeekChildrenRows(rows); }
+
  protected:
   // Rename core functionality
   // Computing the assignment of the new column name map.
@@ -208,5 +208,27 @@ Status RepeatOp::GetDatasetSize(int64_t *dataset_size) {
   return Status::OK();
 }
 int64_t RepeatOp::GetTreeRepeatCount() { return num_repeats_; }
+
+Status RepeatOp::SkipPasses(int64_t passes) {
+  RETURN_IF_NOT_OK(DatasetOp::SkipPasses(passes));
+  repeat_count_ += static_cast<int32_t>(passes);
+  if (num_repeats_ > 0) {
+    repeat_count_ %= num_repeats_;
+  }
+  return Status::OK();
+}
+
+Status RepeatOp::SeekRows(int64_t rows) {
+  if (rows == 0) {
+    return Status::OK();
+  }
+  int64_t child_rows = 0;
+  RETURN_IF_NOT_OK(child_[0]->GetDatasetSize(&child_rows));
+  CHECK_FAIL_RETURN_UNEXPECTED(child_rows > 0, "Cannot skip rows of a repeat when the size of its child is unknown.");
+  CHECK_FAIL_RETURN_UNEXPECTED(num_repeats_ < 0 || rows < child_rows * num_repeats_,
+                               "Cannot skip " + std::to_string(rows) + " rows, the repeat has fewer.");
+  RETURN_IF_NOT_OK(SkipSubtreePasses(rows / child_rows));
+  return child_[0]->SeekRows(rows % child_rows);
+}
 }  // namespace dataset
 }  // namespace mindspore
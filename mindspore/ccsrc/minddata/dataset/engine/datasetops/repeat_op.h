@@ -140,6 +140,20 @@ class RepeatOp : public PipelineOp {
 
   int64_t GetTreeRepeatCount() override;
 
+  /// \brief Base-class override, also moves the count of the repeats in the current pass
+  /// \param[in] passes Number of passes of the child to skip
+  /// \return Status - The error code return
+  Status SkipPasses(int64_t passes) override;
+
+  /// \brief Base-class override, whole passes of the child are skipped by skipping the passes of the subtree
+  /// \return T/F if the child can seek rows
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  /// \brief Base-class override, skips whole passes of the child, then the rest of the rows in the child
+  /// \param[in] rows Number of rows to skip
+  /// \return Status - The error code return
+  Status SeekRows(int64_t rows) override;
+
   // \brief Adds an operator to the repeat ops list of tracked leaf/eoe nodes
   // \param[in] eoe_op The input leaf/eoe operator to add to the list
   void AddToEoeList(std::shared_ptr<DatasetOp> eoe_op) { eoe_ops_.push_back(std::move(eoe_op)); }
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <limits>
 #include <random>
+#include <sstream>
 #include <utility>
 
 #include "minddata/dataset/core/config_manager.h"
@@ -45,6 +46,7 @@ namespace dataset {
 constexpr int32_t ShuffleOp::kShuffleStateInit;
 constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
+constexpr size_t kShufflePassStates = 4;  // Number of passes whose starting rng state is kept
 
 // Builder constructor. Creates the builder object.
 ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true) {
@@ -79,9 +81,9 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       rng_(shuffle_seed),
       buffer_counter_(0),
       rows_per_buffer_(rows_per_buffer),
-      shuffle_buffer_(std::make_unique<TensorTable>()),
       shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit),
+      pass_(0) {}
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -93,15 +95,65 @@ Status ShuffleOp::SelfReset() {
   // and all subsequent epochs will then keep on using the rng_ without resetting it
   if (!reshuffle_each_epoch_) {
     rng_ = std::mt19937_64(shuffle_seed_);
+  } else {
+    std::stringstream ss;
+    ss << rng_;
+    std::unique_lock<std::mutex> lock(pass_rng_states_mutex_);
+    pass_rng_states_[++pass_] = ss.str();
+    while (pass_rng_states_.size() > kShufflePassStates) {
+      (void)pass_rng_states_.erase(pass_rng_states_.begin());
+    }
   }
 
-  shuffle_buffer_ = std::make_unique<TensorTable>();
+  // Keep the slab of row slots for the next epoch. All of its rows have been emitted already, so only the
+  // index needs to be cleared.
+  shuffle_index_.clear();
   buffer_counter_ = 0;
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
   return Status::OK();
 }
 
+Status ShuffleOp::SkipPasses(int64_t passes) {
+  RETURN_IF_NOT_OK(DatasetOp::SkipPasses(passes));
+  if (!reshuffle_each_epoch_ || passes == 0) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lock(pass_rng_states_mutex_);
+  pass_ += passes;
+  auto itr = pass_rng_states_.find(pass_);
+  CHECK_FAIL_RETURN_UNEXPECTED(itr != pass_rng_states_.end(), "The state of the shuffle at pass " +
+                                                                std::to_string(pass_) + " is not saved.");
+  std::stringstream ss(itr->second);
+  ss >> rng_;
+  return Status::OK();
+}
+
+Status ShuffleOp::SaveState(nlohmann::json *state) {
+  RETURN_IF_NOT_OK(DatasetOp::SaveState(state));
+  (*state)["seed"] = shuffle_seed_;
+  std::unique_lock<std::mutex> lock(pass_rng_states_mutex_);
+  for (const auto &pass_state : pass_rng_states_) {
+    (*state)["passes"][std::to_string(pass_state.first)] = pass_state.second;
+  }
+  return Status::OK();
+}
+
+Status ShuffleOp::RestoreState(const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(DatasetOp::RestoreState(state));
+  if (state.find("seed") != state.end()) {
+    shuffle_seed_ = state["seed"].get<uint32_t>();
+    rng_ = std::mt19937_64(shuffle_seed_);
+  }
+  if (state.find("passes") != state.end()) {
+    std::unique_lock<std::mutex> lock(pass_rng_states_mutex_);
+    for (const auto &pass_state : state["passes"].items()) {
+      pass_rng_states_[std::stoll(pass_state.key())] = pass_state.value().get<std::string>();
+    }
+  }
+  return Status::OK();
+}
+
 // A print method typically used for debugging
 void ShuffleOp::Print(std::ostream &out, bool show_all) const {
   if (!show_all) {
@@ -120,21 +172,27 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
 
 // Private function to add a new row to the shuffle buffer.
 Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
-  // If the last slot of our shuffle buffer was not the full size of the shuffle buffer then we are
-  // filling it during the initial fill codepath and thus growing it's size. In that case, we push
-  // back the new row to grow our shuffle buffer size by 1.
-  // If we are already at the full size, then we overwrite the last slot with our row (and the last
-  // slot better be empty because it should already have been swapped out during the random row
-  // selection that was done previously!)
-  if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
-    shuffle_buffer_->push_back(std::move(new_shuffle_row));
-    shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
+  // If the shuffle index is not yet at the full size of the shuffle buffer then we are filling it
+  // during the initial fill codepath and thus growing it's size. In that case, we take the next slab
+  // slot (the slab only grows the first time through) and push it to the index.
+  // If we are already at the full size, then we overwrite the slot referenced by the tail of the index
+  // with our row (and that slot better be empty because it should already have been drained during the
+  // random row selection that was done previously!)
+  if (shuffle_index_.size() < static_cast<size_t>(shuffle_size_)) {
+    auto slot = static_cast<int32_t>(shuffle_index_.size());
+    if (static_cast<size_t>(slot) == shuffle_buffer_.size()) {
+      shuffle_buffer_.emplace_back();
+    }
+    shuffle_buffer_[slot] = std::move(new_shuffle_row);
+    shuffle_index_.push_back(slot);
+    shuffle_last_row_idx_ = slot;
   } else {
-    if (!(*shuffle_buffer_)[shuffle_last_row_idx_].empty()) {
+    TensorRow &last_row = shuffle_buffer_[shuffle_index_[shuffle_last_row_idx_]];
+    if (!last_row.empty()) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "Last row of shuffle buffer should not be occupied!");
     }
-    (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+    last_row = std::move(new_shuffle_row);
   }
   return Status::OK();
 }
@@ -175,11 +233,11 @@ Status ShuffleOp::operator()() {
       }
 
       // Step 2)
-      // Randomly select a slot from our shuffle buffer and copy that row into the output
-      // tensor table. We remove the data from the shuffle buffer, leaving that slot
-      // in the table as an empty vector
+      // Randomly select a position from our shuffle index and move the row in the slab slot it
+      // references into the output tensor table. We remove the data from the shuffle buffer, leaving
+      // that slot in the slab as an empty vector
       int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-      new_buffer_table->push_back(std::move((*shuffle_buffer_)[random_slot]));
+      new_buffer_table->push_back(std::move(shuffle_buffer_[shuffle_index_[random_slot]]));
 
       // Step 3)
       // If the output tensor table is at the requested size, then create a buffer for it
@@ -194,11 +252,11 @@ Status ShuffleOp::operator()() {
       }
 
       // Step 4)
-      // Take the last row from shuffle buffer, and swap it into the row position that was
-      // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
-      // tail of the shuffle buffer.
+      // Swap the last entry of the shuffle index into the position that was just vacated. Only the
+      // slot numbers move, the rows stay in place. This keeps the occupied slots contiguous in the
+      // index, with the empty slot referenced by the tail of the index.
       if (random_slot != shuffle_last_row_idx_) {
-        (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
+        std::swap(shuffle_index_[random_slot], shuffle_index_[shuffle_last_row_idx_]);
       }
 
       // Step 5)
@@ -270,7 +328,7 @@ Status ShuffleOp::InitShuffleBuffer() {
 
   // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
   // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
+  while (!new_row.empty() && shuffle_index_.size() < static_cast<size_t>(shuffle_size_ - 1)) {
     // Add the previously fetched row
     RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
 
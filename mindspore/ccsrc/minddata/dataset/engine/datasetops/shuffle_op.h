@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
@@ -165,8 +166,25 @@ class ShuffleOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kShuffleOp; }
 
+  // Base-class override, a pass reshuffled with a rng_ that went on from the previous passes starts from the saved
+  // state of the rng_, since the rows of the skipped passes are not read
+  // @param passes - number of passes to skip
+  // @return Status - The error code return
+  Status SkipPasses(int64_t passes) override;
+
+  // Base-class override, saves the seed and the state of the rng_ at the start of the last few passes
+  // @param state - the json object to fill
+  // @return Status - The error code return
+  Status SaveState(nlohmann::json *state) override;
+
+  // Base-class override
+  // @param state - the saved state
+  // @return Status - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
  private:
-  // Private function to add a new row to the shuffle buffer.
+  // Private function to add a new row to the shuffle buffer. The row is moved into the slab slot that is
+  // referenced by the tail of the shuffle index.
   // @return Status - The error code return
   Status AddRowToShuffleBuffer(TensorRow new_shuffle_row);
 
@@ -191,12 +209,22 @@ class ShuffleOp : public PipelineOp {
   std::mt19937_64 rng_;
   int32_t buffer_counter_;   // For creating new buffer id's
   int32_t rows_per_buffer_;  // Number of rows to pack into output buffer
-  // A single (potentially large) buffer of tensor rows for performing shuffling.
-  std::unique_ptr<TensorTable> shuffle_buffer_;
+  // A single (potentially large) slab of tensor rows. Rows stay in their slot from the time they are fetched until
+  // they are emitted, and the slab is kept (not reallocated) across epochs.
+  TensorTable shuffle_buffer_;
+  // The shuffling is done on this compact table of slab slot numbers rather than on the rows themselves.
+  // Positions [0, shuffle_last_row_idx_] hold the occupied slots of the shuffle buffer.
+  std::vector<int32_t> shuffle_index_;
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
+
+  // The state of the rng_ at the start of the last few passes, when it goes on from one pass to the next. The passes
+  // in flight are behind the ones the shuffle works on, so more than the current one are kept.
+  int64_t pass_;
+  std::map<int64_t, std::string> pass_rng_states_;
+  std::mutex pass_rng_states_mutex_;
 };
 }  // namespace dataset
 }  // namespace mindspore
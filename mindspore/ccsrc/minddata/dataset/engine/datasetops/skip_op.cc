@@ -89,8 +89,6 @@ Status SkipOp::operator()() {
   RETURN_IF_NOT_OK(GetNextInput(&curr_buffer));
 
   while (curr_buffer->eof() == false) {
-    // Reset count
-    skip_count_ = 0;
     while (curr_buffer->eoe() == false) {
       // Drop first count rows
       while (skip_count_ < max_skips_) {
@@ -115,6 +113,8 @@ Status SkipOp::operator()() {
     // we got eoe, now try again until we got eof
     MS_LOG(DEBUG) << "Skip operator EOE Received.";
     RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE))));
+    // Reset count
+    skip_count_ = 0;
     RETURN_IF_NOT_OK(GetNextInput(&curr_buffer));
   }
 
@@ -123,6 +123,15 @@ Status SkipOp::operator()() {
   return Status::OK();
 }
 
+Status SkipOp::SeekRows(int64_t rows) {
+  if (rows == 0) {
+    return Status::OK();
+  }
+  // The rows to drop are already skipped in this pass
+  skip_count_ = max_skips_;
+  return SeekChildrenRows(rows + max_skips_);
+}
+
 // Base-class override for handling cases when an eof is received.
 Status SkipOp::EofReceived(int32_t worker_id) {
   MS_LOG(DEBUG) << "Skip operator EOF received, do nothing now.";
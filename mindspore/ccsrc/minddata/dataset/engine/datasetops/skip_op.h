@@ -89,6 +89,14 @@ class SkipOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kSkipOp; }
 
+  // The child skips the rows to drop together with the rows to seek
+  // @return T/F if the child can seek
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  // @param rows - number of rows to skip after the dropped ones
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override;
+
  private:
   int32_t max_skips_;   // The number of skips that the user requested
   int32_t skip_count_;  // A counter for the current number of executed skips
@@ -15,10 +15,19 @@
  */
 #include "minddata/dataset/engine/datasetops/source/csv_op.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 #include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <iterator>
 #include <stdexcept>
+#include <thread>
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -93,7 +102,9 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
       finished_reading_dataset_(false),
       num_devices_(num_device),
       device_id_(device_id),
-      load_io_block_queue_(true) {
+      load_io_block_queue_(true),
+      num_parse_threads_(
+        std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()) / std::max(num_workers, 1))) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -109,380 +120,333 @@ Status CsvOp::Init() {
   return Status::OK();
 }
 
-CsvOp::CsvParser::CsvParser(int32_t worker_id, std::shared_ptr<JaggedConnector> connector, int64_t rows_per_buffer,
-                            char field_delim, std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default)
-    : worker_id_(worker_id),
-      buffer_connector_(connector),
-      csv_rows_per_buffer_(rows_per_buffer),
-      csv_field_delim_(field_delim),
-      column_default_(column_default),
-      cur_state_(START_OF_FILE),
-      pos_(0),
-      cur_row_(0),
-      cur_col_(0),
-      total_rows_(0),
-      start_offset_(0),
-      end_offset_(std::numeric_limits<int64_t>::max()),
-      err_message_("unknown") {
-  cur_buffer_ = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
-  InitCsvParser();
-}
-
-void CsvOp::CsvParser::Reset() {
-  cur_state_ = START_OF_FILE;
-  pos_ = 0;
-  cur_row_ = 0;
-  cur_col_ = 0;
-}
-
-CsvOp::CsvParser::Message CsvOp::CsvParser::GetMessage(int c) {
-  if (c == csv_field_delim_) {
-    return Message::MS_DELIM;
-  } else if (c == '"') {
-    return Message::MS_QUOTE;
-  } else if (c == '\r' || c == '\n') {
-    return Message::MS_END_OF_LINE;
-  } else if (c == std::char_traits<char>::eof()) {
-    return Message::MS_END_OF_FILE;
-  } else {
-    return Message::MS_NORMAL;
+namespace {
+// A block read from a file holds kCsvChunkSize bytes for every thread parsing it
+constexpr size_t kCsvChunkSize = 4 * 1024 * 1024;
+// Chunks smaller than this are not worth a thread of their own
+constexpr size_t kCsvMinChunkSize = 256 * 1024;
+// Bounds the memory of a block on machines with many cores, its chunks are then smaller than kCsvChunkSize
+constexpr size_t kCsvMaxBlockSize = 64 * 1024 * 1024;
+
+// @return size_t - the number of bytes to read at once for a file parsed by num_threads threads
+size_t BlockReadSize(int32_t num_threads) {
+  return std::min(kCsvChunkSize * static_cast<size_t>(num_threads), kCsvMaxBlockSize);
+}
+
+inline bool IsLineEnd(char c) { return c == '\r' || c == '\n'; }
+
+// Finds the first delimiter, quote or line break of [p, end), end if there is none
+const char *FindSpecialChar(const char *p, const char *end, char delim) {
+#if defined(__SSE2__)
+  const __m128i delims = _mm_set1_epi8(delim);
+  const __m128i quotes = _mm_set1_epi8('"');
+  const __m128i crs = _mm_set1_epi8('\r');
+  const __m128i lfs = _mm_set1_epi8('\n');
+  for (; end - p >= 16; p += 16) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, delims), _mm_cmpeq_epi8(chars, quotes)),
+                                 _mm_or_si128(_mm_cmpeq_epi8(chars, crs), _mm_cmpeq_epi8(chars, lfs)));
+    int mask = _mm_movemask_epi8(found);
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
   }
-}
-
-int CsvOp::CsvParser::ProcessMessage(int c) {
-  Message m = GetMessage(c);
-  StateDiagram::iterator it = sd.find({cur_state_, m});
-  if (it == sd.end()) {
-    return -1;
+#elif defined(__aarch64__)
+  const uint8x16_t delims = vdupq_n_u8(static_cast<uint8_t>(delim));
+  const uint8x16_t quotes = vdupq_n_u8('"');
+  const uint8x16_t crs = vdupq_n_u8('\r');
+  const uint8x16_t lfs = vdupq_n_u8('\n');
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    uint8x16_t found = vorrq_u8(vorrq_u8(vceqq_u8(chars, delims), vceqq_u8(chars, quotes)),
+                                vorrq_u8(vceqq_u8(chars, crs), vceqq_u8(chars, lfs)));
+    if (vmaxvq_u8(found) != 0) {
+      break;  // the scalar loop below finds it within these 16 bytes
+    }
+  }
+#endif
+  for (; p < end; ++p) {
+    if (*p == delim || *p == '"' || IsLineEnd(*p)) {
+      return p;
+    }
   }
-  int ret = it->second.second(*this, c);
-  cur_state_ = it->second.first;
-  return ret;
+  return end;
 }
 
-int CsvOp::CsvParser::PutChar(int c) {
-  if (pos_ >= str_buf_.size()) {
-    str_buf_.resize(str_buf_.size() * 2);
-  }
-  str_buf_[pos_] = c;
-  pos_++;
-  return 0;
+// Finds the first quote of [p, end), end if there is none
+inline const char *FindQuote(const char *p, const char *end) {
+  auto found = static_cast<const char *>(std::memchr(p, '"', end - p));
+  return found == nullptr ? end : found;
 }
 
-int CsvOp::CsvParser::PutRecord(int c) {
-  std::string s = std::string(str_buf_.begin(), str_buf_.begin() + pos_);
-  std::shared_ptr<Tensor> t;
-  if (cur_col_ >= column_default_.size()) {
-    err_message_ = "Number of file columns does not match the default records";
-    return -1;
+// Counts the quotes of [p, end)
+int64_t CountQuotes(const char *p, const char *end) {
+  int64_t count = 0;
+#if defined(__SSE2__)
+  const __m128i quotes = _mm_set1_epi8('"');
+  for (; end - p >= 16; p += 16) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, quotes)));
   }
-  switch (column_default_[cur_col_]->type) {
-    case CsvOp::INT:
-      Tensor::CreateScalar(std::stoi(s), &t);
-      break;
-    case CsvOp::FLOAT:
-      Tensor::CreateScalar(std::stof(s), &t);
-      break;
-    default:
-      Tensor::CreateScalar(s, &t);
-      break;
+#elif defined(__aarch64__)
+  const uint8x16_t quotes = vdupq_n_u8('"');
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    // a match is 0xFF, its lowest bit counts it
+    count += vaddvq_u8(vandq_u8(vceqq_u8(chars, quotes), vdupq_n_u8(1)));
   }
-  if (cur_col_ >= (*tensor_table_)[cur_row_].size()) {
-    err_message_ = "Number of file columns does not match the tensor table";
-    return -1;
+#endif
+  for (; p < end; ++p) {
+    count += (*p == '"');
   }
-  (*tensor_table_)[cur_row_][cur_col_] = std::move(t);
-  pos_ = 0;
-  cur_col_++;
-  return 0;
+  return count;
 }
+}  // namespace
 
-int CsvOp::CsvParser::PutRow(int c) {
-  if (total_rows_ < start_offset_) {
-    total_rows_++;
-    cur_col_ = 0;
-    return 0;
-  }
+CsvOp::CsvParser::CsvParser(const std::string &file, char field_delim,
+                            std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default, int32_t num_threads,
+                            JobPool *pool)
+    : file_(file),
+      csv_field_delim_(field_delim),
+      column_default_(std::move(column_default)),
+      num_threads_(std::max(num_threads, 1)),
+      pool_(pool) {}
+
+Status CsvOp::CsvParser::ParseError(int64_t row_id, const std::string &err_message) {
+  RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file_ + ":" + std::to_string(row_id + 1) +
+                           ". Error message: " + err_message);
+}
+
+Status CsvOp::CsvParser::ScanBlock(std::string_view block, std::vector<ChunkRows> *chunks, bool *in_quote) {
+  const char *data = block.data();
+  size_t num_chunks = std::clamp<size_t>(block.size() / kCsvMinChunkSize, 1, num_threads_);
+  size_t chunk_size = block.size() / num_chunks;
+  chunks->assign(num_chunks, ChunkRows());
+  auto chunk_begin = [&](size_t i) { return i * chunk_size; };
+  auto chunk_end = [&](size_t i) { return i + 1 == num_chunks ? block.size() : (i + 1) * chunk_size; };
+
+  // Runs func on every chunk, on the pool when there is one
+  auto for_each_chunk = [this, num_chunks](const std::function<void(size_t)> &func) {
+    if (pool_ == nullptr) {
+      for (size_t i = 0; i < num_chunks; ++i) func(i);
+    } else {
+      pool_->ForEach(num_chunks, func);
+    }
+  };
+
+  // pass 1, a quote opens or closes a quoted field, an escaped quote does both
+  std::vector<int64_t> quotes(num_chunks);
+  for_each_chunk([&](size_t i) { quotes[i] = CountQuotes(data + chunk_begin(i), data + chunk_end(i)); });
+  std::vector<bool> starts_in_quote(num_chunks, false);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    starts_in_quote[i] = starts_in_quote[i - 1] ^ (quotes[i - 1] % 2 == 1);
+  }
+  *in_quote = starts_in_quote[num_chunks - 1] ^ (quotes[num_chunks - 1] % 2 == 1);
+
+  // pass 2, the line breaks outside of quoted fields end the rows, empty lines are no rows
+  for_each_chunk([&](size_t i) {
+    ChunkRows &chunk = (*chunks)[i];
+    bool quoted = starts_in_quote[i];
+    const char *p = data + chunk_begin(i);
+    const char *end = data + chunk_end(i);
+    while (p < end) {
+      p = quoted ? FindQuote(p, end) : FindSpecialChar(p, end, '"');
+      if (p == end) break;
+      if (*p == '"') {
+        quoted = !quoted;
+      } else {
+        // the character before is outside of a quoted field too, no quote is in between
+        if (p > data && !IsLineEnd(p[-1])) chunk.num_rows++;
+        chunk.end = p + 1 - data;
+        chunk.has_line_end = true;
+      }
+      ++p;
+    }
+  });
 
-  if (total_rows_ >= end_offset_) {
-    cur_col_ = 0;
-    return 0;
+  // the first row of a chunk starts after the last line break of the chunks before it
+  size_t row_begin = 0;
+  for (auto &chunk : *chunks) {
+    chunk.begin = row_begin;
+    if (chunk.has_line_end) row_begin = chunk.end;
   }
+  return Status::OK();
+}
 
-  int ret = PutRecord(c);
-  if (ret < 0) {
-    return ret;
+Status CsvOp::CsvParser::CountBlock(std::string_view block, bool eof, size_t *consumed, int64_t *num_rows) {
+  RETURN_UNEXPECTED_IF_NULL(consumed);
+  RETURN_UNEXPECTED_IF_NULL(num_rows);
+  std::vector<ChunkRows> chunks;
+  bool in_quote = false;
+  RETURN_IF_NOT_OK(ScanBlock(block, &chunks, &in_quote));
+  *num_rows = 0;
+  *consumed = 0;
+  for (const auto &chunk : chunks) {
+    *num_rows += chunk.num_rows;
+    if (chunk.has_line_end) *consumed = chunk.end;
   }
-
-  if (cur_col_ != column_default_.size()) {
-    err_message_ = "The number of columns does not match the definition.";
-    return -1;
+  // the last row needs no line break, unless it ends inside a quoted field
+  if (eof && *consumed < block.size()) {
+    if (!in_quote) (*num_rows)++;
+    *consumed = block.size();
   }
+  return Status::OK();
+}
 
-  total_rows_++;
-  cur_row_++;
-  cur_col_ = 0;
+Status CsvOp::CsvParser::ParseBlock(std::string_view block, bool eof, int64_t first_row, int64_t start_offset,
+                                    int64_t end_offset, std::vector<TensorRow> *rows, size_t *consumed,
+                                    int64_t *num_rows) {
+  RETURN_UNEXPECTED_IF_NULL(rows);
+  RETURN_UNEXPECTED_IF_NULL(consumed);
+  RETURN_UNEXPECTED_IF_NULL(num_rows);
+  std::vector<ChunkRows> chunks;
+  bool in_quote = false;
+  RETURN_IF_NOT_OK(ScanBlock(block, &chunks, &in_quote));
+
+  // pass 3, the rows of a chunk are parsed into a table of their own, the tables are joined in order
+  const char *data = block.data();
+  std::vector<std::vector<TensorRow>> chunk_rows(chunks.size());
+  std::vector<size_t> to_parse;
+  std::vector<int64_t> first_rows(chunks.size());
+  int64_t row_id = first_row;
+  *consumed = 0;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    const ChunkRows &chunk = chunks[i];
+    // chunks without rows to keep are not parsed at all
+    if (chunk.num_rows > 0 && row_id < end_offset && row_id + chunk.num_rows > start_offset) {
+      to_parse.push_back(i);
+    }
+    first_rows[i] = row_id;
+    row_id += chunk.num_rows;
+    if (chunk.has_line_end) *consumed = chunk.end;
+  }
+  std::vector<Status> chunk_rcs(to_parse.size());
+  auto parse_chunk = [&](size_t k) {
+    size_t i = to_parse[k];
+    chunk_rcs[k] = ParseRows(data + chunks[i].begin, data + chunks[i].end, first_rows[i], start_offset, end_offset,
+                             &chunk_rows[i]);
+  };
+  if (pool_ == nullptr) {
+    for (size_t k = 0; k < to_parse.size(); ++k) parse_chunk(k);
+  } else {
+    pool_->ForEach(to_parse.size(), parse_chunk);
+  }
+  // Errors are reported for the first row that has one
+  for (const auto &rc : chunk_rcs) {
+    RETURN_IF_NOT_OK(rc);
+  }
 
-  if (cur_row_ == csv_rows_per_buffer_) {
-    cur_buffer_->set_tensor_table(std::move(tensor_table_));
-    buffer_connector_->Add(worker_id_, std::move(cur_buffer_));
+  if (eof && *consumed < block.size()) {
+    // the last row has no line break, a quoted field left open is reported by ParseRows
+    if (row_id >= start_offset && row_id < end_offset) {
+      chunk_rows.emplace_back();
+      RETURN_IF_NOT_OK(ParseRows(data + *consumed, data + block.size(), row_id, start_offset, end_offset,
+                                 &chunk_rows.back()));
+    }
+    if (!in_quote) row_id++;
+    *consumed = block.size();
+  }
 
-    cur_buffer_ = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
-    tensor_table_ = std::make_unique<TensorQTable>();
-    cur_row_ = 0;
+  *num_rows = row_id - first_row;
+  for (auto &table : chunk_rows) {
+    std::move(table.begin(), table.end(), std::back_inserter(*rows));
   }
-  return 0;
+  return Status::OK();
 }
 
-int CsvOp::CsvParser::AddRow(int c) {
-  total_rows_++;
-  return 0;
+Status CsvOp::CsvParser::ParseRows(const char *begin, const char *end, int64_t first_row, int64_t start_offset,
+                                   int64_t end_offset, std::vector<TensorRow> *rows) {
+  std::string field;
+  int64_t row_id = first_row;
+  const char *p = begin;
+  while (p < end) {
+    if (IsLineEnd(*p)) {
+      ++p;
+      continue;
+    }
+    bool keep = row_id >= start_offset && row_id < end_offset;
+    TensorRow row;
+    RETURN_IF_NOT_OK(ParseRow(&p, end, row_id, keep, &field, &row));
+    if (keep) rows->push_back(std::move(row));
+    row_id++;
+  }
+  return Status::OK();
 }
 
-int CsvOp::CsvParser::EndFile(int c) {
-  if (cur_col_ > 0) {
-    int ret = PutRow(c);
-    if (ret < 0) {
-      return ret;
+Status CsvOp::CsvParser::ParseRow(const char **pos, const char *end, int64_t row_id, bool keep, std::string *field,
+                                  TensorRow *row) {
+  const char *p = *pos;
+  int32_t num_columns = column_default_.size();
+  if (keep) *row = TensorRow(num_columns, nullptr);
+  int32_t col = 0;
+  while (true) {
+    if (p < end && *p == '"') {
+      // quoted field, a quote in it is escaped by another one
+      field->clear();
+      ++p;
+      while (true) {
+        const char *quote = FindQuote(p, end);
+        if (quote == end) {
+          return ParseError(row_id, "Reach the end of file in quote field.");
+        }
+        field->append(p, quote);
+        p = quote + 1;
+        if (p < end && *p == '"') {
+          field->push_back('"');
+          ++p;
+        } else {
+          break;
+        }
+      }
+      if (p < end && *p != csv_field_delim_ && !IsLineEnd(*p)) {
+        return ParseError(row_id, "Receive unquote char in quote field.");
+      }
+    } else {
+      const char *field_end = FindSpecialChar(p, end, csv_field_delim_);
+      if (field_end < end && *field_end == '"') {
+        return ParseError(row_id, "Invalid quote in unquote field.");
+      }
+      field->assign(p, field_end);
+      p = field_end;
     }
-  }
 
-  if (cur_row_ > 0) {
-    cur_buffer_->set_tensor_table(std::move(tensor_table_));
-    buffer_connector_->Add(worker_id_, std::move(cur_buffer_));
-  }
-  return 0;
-}
+    if (col >= num_columns) {
+      return ParseError(row_id, "Number of file columns does not match the default records");
+    }
+    if (keep) {
+      try {
+        RETURN_IF_NOT_OK(PutRecord(*field, col, &(*row)[col]));
+      } catch (std::invalid_argument &ia) {
+        RETURN_STATUS_UNEXPECTED("Invalid data, " + file_ + ":" + std::to_string(row_id + 1) +
+                                 ", type does not match.");
+      } catch (std::out_of_range &oor) {
+        RETURN_STATUS_UNEXPECTED("Invalid data, " + file_ + ":" + std::to_string(row_id + 1) + ", out of range.");
+      }
+    }
+    col++;
 
-int CsvOp::CsvParser::CatchException(int c) {
-  if (GetMessage(c) == Message::MS_QUOTE && cur_state_ == State::UNQUOTE) {
-    err_message_ = "Invalid quote in unquote field.";
-  } else if (GetMessage(c) == Message::MS_END_OF_FILE && cur_state_ == State::QUOTE) {
-    err_message_ = "Reach the end of file in quote field.";
-  } else if (GetMessage(c) == Message::MS_NORMAL && cur_state_ == State::SECOND_QUOTE) {
-    err_message_ = "Receive unquote char in quote field.";
+    if (p < end && *p == csv_field_delim_) {
+      ++p;
+    } else {
+      break;
+    }
   }
-  return -1;
+  if (col != num_columns) {
+    return ParseError(row_id, "The number of columns does not match the definition.");
+  }
+  *pos = p;
+  return Status::OK();
 }
 
-int CsvOp::CsvParser::CountRows(int c) {
-  Message m;
-  if (c == '"') {
-    m = Message::MS_QUOTE;
-  } else if (c == '\r' || c == '\n' || c == std::char_traits<char>::eof()) {
-    m = Message::MS_END_OF_LINE;
-  } else {
-    m = Message::MS_NORMAL;
-  }
-  StateDiagram::iterator it = sdl.find({cur_state_, m});
-  if (it == sdl.end()) {
-    return -1;
-  }
-  cur_state_ = it->second.first;
-  return it->second.second(*this, c);
-}
-
-Status CsvOp::CsvParser::InitCsvParser() {
-  str_buf_.resize(CSV_BUFFER_SIZE);
-
-  // State diagram for counting rows
-  sdl = {// START_OF_FILE
-         // |---------------------------------------|
-         // |    abc    |    "      |      \n       |
-         // |---------------------------------------|
-         // | UNQUOTE   |   QUOTE   | START_OF_FILE |
-         // |---------------------------------------|
-         // |  NullFunc |  NullFunc |    NullFunc   |
-         // |---------------------------------------|
-         {{State::START_OF_FILE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::START_OF_FILE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::START_OF_FILE, Message::MS_END_OF_LINE}, {State::START_OF_FILE, &CsvParser::NullFunc}},
-
-         // UNQUOTE
-         // |-------------------------------------|
-         // |    abc    |    "      |    \n       |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // |  NullFunc | NullFunc  |  AddRow     |
-         // |-------------------------------------|
-         {{State::UNQUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::UNQUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::UNQUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::AddRow}},
-
-         // QUOTE
-         // |--------------------------------------|
-         // |    abc    |      "       |    \n     |
-         // |--------------------------------------|
-         // | QUOTE     | SECOND_QUOTE |   QUOTE   |
-         // |--------------------------------------|
-         // |  NullFunc |  NullFunc    | NullFunc  |
-         // |--------------------------------------|
-         {{State::QUOTE, Message::MS_NORMAL}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::QUOTE, Message::MS_QUOTE}, {State::SECOND_QUOTE, &CsvParser::NullFunc}},
-         {{State::QUOTE, Message::MS_END_OF_LINE}, {State::QUOTE, &CsvParser::NullFunc}},
-
-         // SECOND_QUOTE
-         // |-------------------------------------|
-         // |    abc    |     "     |     \n      |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // |  NullFunc | NullFunc  | AddRow      |
-         // |-------------------------------------|
-         {{State::SECOND_QUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::SECOND_QUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::SECOND_QUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::AddRow}},
-
-         // END_OF_LINE
-         // |-------------------------------------|
-         // |    abc    |     "     |     \n      |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // | NullFunc  |  NullFunc | NullFunc    |
-         // |-------------------------------------|
-         {{State::END_OF_LINE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::END_OF_LINE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::END_OF_LINE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::NullFunc}}};
-
-  // State diagram for CSV parser
-  sd = {// START_OF_FILE
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,     |    "     |      \n        |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM    | QUOTE    | START_OF_FILE  | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | lambda    | lambda   | lambda   | NullFunc       |  NullFunc      |
-        // |-------------------------------------------------------------------|
-        {{State::START_OF_FILE, Message::MS_NORMAL},
-         {State::UNQUOTE,
-          [this](CsvParser &, char c) -> int {
-            this->tensor_table_ = std::make_unique<TensorQTable>();
-            this->tensor_table_->push_back(TensorRow(column_default_.size(), nullptr));
-            this->str_buf_[0] = c;
-            this->pos_ = 1;
-            return 0;
-          }}},
-        {{State::START_OF_FILE, Message::MS_DELIM},
-         {State::DELIM,
-          [this](CsvParser &, char c) -> int {
-            this->tensor_table_ = std::make_unique<TensorQTable>();
-            this->tensor_table_->push_back(TensorRow(column_default_.size(), nullptr));
-            return this->PutRecord(c);
-          }}},
-        {{State::START_OF_FILE, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            this->tensor_table_ = std::make_unique<TensorQTable>();
-            this->tensor_table_->push_back(TensorRow(column_default_.size(), nullptr));
-            this->pos_ = 0;
-            return 0;
-          }}},
-        {{State::START_OF_FILE, Message::MS_END_OF_LINE}, {State::START_OF_FILE, &CsvParser::NullFunc}},
-        {{State::START_OF_FILE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::NullFunc}},
-
-        // UNQUOTE
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,       |     "     |      \n     |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM      | EXCEPTION | END_OF_LINE | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | PutChar   | PutRecord  | exception | PutRow      | EndFile        |
-        // |-------------------------------------------------------------------|
-        {{State::UNQUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::PutChar}},
-        {{State::UNQUOTE, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::UNQUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::UNQUOTE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-        // UNQUOTE-Exception
-        {{State::UNQUOTE, Message::MS_QUOTE}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // DELIM
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,       |     "     |      \n     |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM      | QUOTE     | END_OF_LINE | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | PutChar   | PutRecord  | lambda    | PutRow      | EndFile        |
-        // |-------------------------------------------------------------------|
-        {{State::DELIM, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::PutChar}},
-        {{State::DELIM, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::DELIM, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            this->pos_ = 0;
-            return 0;
-          }}},
-        {{State::DELIM, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::DELIM, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-
-        // QUOTE
-        // |-----------------------------------------------------------------|
-        // |    abc    |    ,     |     "        |    \n    |       EOF      |
-        // |-----------------------------------------------------------------|
-        // | QUOTE     | QUOTE    | SECOND_QUOTE | QUOTE    | EXCEPTION      |
-        // |-----------------------------------------------------------------|
-        // | PutChar   | PutChar  |  NullFunc    | PutChar  | exception      |
-        // |-----------------------------------------------------------------|
-        {{State::QUOTE, Message::MS_NORMAL}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::QUOTE, Message::MS_DELIM}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::QUOTE, Message::MS_QUOTE}, {State::SECOND_QUOTE, &CsvParser::NullFunc}},
-        {{State::QUOTE, Message::MS_END_OF_LINE}, {State::QUOTE, &CsvParser::PutChar}},
-        // QUOTE-Exception
-        {{State::QUOTE, Message::MS_END_OF_FILE}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // SECOND_QUOTE
-        // |------------------------------------------------------------------|
-        // |    abc    |     ,      |    "     |    \n       |       EOF      |
-        // |------------------------------------------------------------------|
-        // | EXCEPTION | DELIM      | QUOTE    | END_OF_LINE | END_OF_FILE    |
-        // |------------------------------------------------------------------|
-        // | exception | PutRecord | PutChar   | PutRow      | EndFile        |
-        // |------------------------------------------------------------------|
-        {{State::SECOND_QUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::SECOND_QUOTE, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::SECOND_QUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::SECOND_QUOTE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-        // SECOND_QUOTE-Exception
-        {{State::SECOND_QUOTE, Message::MS_NORMAL}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // END_OF_LINE
-        // |-------------------------------------------------------|
-        // |   abc   |   ,    |   "    |      \n     |     EOF     |
-        // |-------------------------------------------------------|
-        // | UNQUOTE | DELIM  | QUOTE  | END_OF_LINE | END_OF_FILE |
-        // |-------------------------------------------------------|
-        // | lambda  | lambda | lambda |  NullFunc   | EndFile     |
-        // |-------------------------------------------------------|
-        {{State::END_OF_LINE, Message::MS_NORMAL},
-         {State::UNQUOTE,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              this->tensor_table_->push_back(TensorRow(column_default_.size(), nullptr));
-            }
-            this->str_buf_[0] = c;
-            this->pos_ = 1;
-            return 0;
-          }}},
-        {{State::END_OF_LINE, Message::MS_DELIM},
-         {State::DELIM,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              this->tensor_table_->push_back(TensorRow(column_default_.size(), nullptr));
-            }
-            return this->PutRecord(c);
-          }}},
-        {{State::END_OF_LINE, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              this->tensor_table_->push_back(TensorRow(column_default_.size(), nullptr));
-            }
-            return 0;
-          }}},
-        {{State::END_OF_LINE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::NullFunc}},
-        {{State::END_OF_LINE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}}};
-  return Status::OK();
+Status CsvOp::CsvParser::PutRecord(const std::string &field, int32_t col, std::shared_ptr<Tensor> *out) {
+  switch (column_default_[col]->type) {
+    case CsvOp::INT:
+      return Tensor::CreateScalar(std::stoi(field), out);
+    case CsvOp::FLOAT:
+      return Tensor::CreateScalar(std::stof(field), out);
+    default:
+      return Tensor::CreateScalar(field, out);
+  }
 }
 
 Status CsvOp::Reset() {
@@ -497,11 +461,9 @@ Status CsvOp::Reset() {
 
 Status CsvOp::LoadFile(const std::string &file, const int64_t start_offset, const int64_t end_offset,
                        const int32_t worker_id) {
-  CsvParser csv_parser(worker_id, jagged_buffer_connector_, rows_per_buffer_, field_delim_, column_default_list_);
-  csv_parser.SetStartOffset(start_offset);
-  csv_parser.SetEndOffset(end_offset);
+  CsvParser csv_parser(file, field_delim_, column_default_list_, num_parse_threads_, &parse_pool_);
   std::ifstream ifs;
-  ifs.open(file, std::ifstream::in);
+  ifs.open(file, std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     RETURN_STATUS_UNEXPECTED("Error opening file: " + file);
   }
@@ -509,30 +471,51 @@ Status CsvOp::LoadFile(const std::string &file, const int64_t start_offset, cons
     std::string tmp;
     getline(ifs, tmp);
   }
-  csv_parser.Reset();
-  try {
-    while (ifs.good()) {
-      // when ifstream reachs the end of file, the function get() return std::char_traits<char>::eof()
-      // which is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS. So instead of char, we use
-      // int to receive its return value.
-      int chr = ifs.get();
-      if (csv_parser.ProcessMessage(chr) != 0) {
-        RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file + ":" +
-                                 std::to_string(csv_parser.GetTotalRows() + 1) +
-                                 ". Error message: " + csv_parser.GetErrorMessage());
+
+  std::string block;
+  const size_t read_size = BlockReadSize(num_parse_threads_);
+  int64_t rows_total = 0;
+  auto tensor_table = std::make_unique<TensorQTable>();
+  while (load_jagged_connector_ && rows_total < end_offset) {
+    RETURN_IF_INTERRUPTED();
+    // the unparsed end of the previous block is kept at the front
+    size_t kept = block.size();
+    block.resize(kept + read_size);
+    (void)ifs.read(&block[kept], static_cast<std::streamsize>(read_size));
+    block.resize(kept + static_cast<size_t>(ifs.gcount()));
+    bool eof = ifs.eof();
+
+    std::vector<TensorRow> rows;
+    size_t consumed = 0;
+    int64_t num_rows = 0;
+    RETURN_IF_NOT_OK(
+      csv_parser.ParseBlock(block, eof, rows_total, start_offset, end_offset, &rows, &consumed, &num_rows));
+    rows_total += num_rows;
+    (void)block.erase(0, consumed);
+
+    for (auto &row : rows) {
+      tensor_table->push_back(std::move(row));
+      if (tensor_table->size() == rows_per_buffer_) {
+        auto buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
+        buffer->set_tensor_table(std::move(tensor_table));
+        RETURN_IF_NOT_OK(jagged_buffer_connector_->Add(worker_id, std::move(buffer)));
+        tensor_table = std::make_unique<TensorQTable>();
       }
     }
-  } catch (std::invalid_argument &ia) {
-    std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
-    RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ":" + err_row + ", type does not match.");
-  } catch (std::out_of_range &oor) {
-    std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
-    RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ":" + err_row + ", out of range.");
+    if (eof) break;
+  }
+
+  if (!tensor_table->empty()) {
+    auto buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
+    buffer->set_tensor_table(std::move(tensor_table));
+    RETURN_IF_NOT_OK(jagged_buffer_connector_->Add(worker_id, std::move(buffer)));
   }
   return Status::OK();
 }
 
 Status CsvOp::operator()() {
+  // the rows of the files are counted on the pool too
+  RETURN_IF_NOT_OK(parse_pool_.Launch(tree_->AllTasks(), NumParseHelpers(), "CsvOp parser"));
   RETURN_IF_NOT_OK(CalculateNumRowsPerShard());
 
   // Move register to the front of launching thread, this will fix the problem
@@ -798,10 +781,27 @@ Status CsvOp::CalculateNumRowsPerShard() {
   return Status::OK();
 }
 
+int32_t CsvOp::NumParseHelpers() const {
+  // the largest file tells how many chunks a block of any file is split into at most
+  int64_t max_file_size = 0;
+  for (const auto &file : csv_files_list_) {
+    std::ifstream ifs(file, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    if (ifs.is_open()) {
+      max_file_size = std::max(max_file_size, static_cast<int64_t>(ifs.tellg()));
+    }
+  }
+  size_t block_size = std::min(static_cast<size_t>(max_file_size), BlockReadSize(num_parse_threads_));
+  auto threads_per_file =
+    static_cast<int32_t>(std::clamp<size_t>(block_size / kCsvMinChunkSize, 1, static_cast<size_t>(num_parse_threads_)));
+  // the workers parse a chunk of their blocks themselves, the pool adds the other threads of every worker
+  auto num_files = static_cast<int32_t>(std::min<size_t>(std::max(num_workers_, 1), csv_files_list_.size()));
+  return num_files * (threads_per_file - 1);
+}
+
 int64_t CsvOp::CountTotalRows(const std::string &file) {
-  CsvParser csv_parser(0, jagged_buffer_connector_, rows_per_buffer_, field_delim_, column_default_list_);
+  CsvParser csv_parser(file, field_delim_, column_default_list_, num_parse_threads_, &parse_pool_);
   std::ifstream ifs;
-  ifs.open(file, std::ifstream::in);
+  ifs.open(file, std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     return 0;
   }
@@ -809,15 +809,28 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
     std::string tmp;
     getline(ifs, tmp);
   }
-  csv_parser.Reset();
-  while (ifs.good()) {
-    int chr = ifs.get();
-    if (csv_parser.CountRows(chr) != 0) {
+
+  std::string block;
+  const size_t read_size = BlockReadSize(num_parse_threads_);
+  int64_t rows_total = 0;
+  while (true) {
+    size_t kept = block.size();
+    block.resize(kept + read_size);
+    (void)ifs.read(&block[kept], static_cast<std::streamsize>(read_size));
+    block.resize(kept + static_cast<size_t>(ifs.gcount()));
+    bool eof = ifs.eof();
+
+    size_t consumed = 0;
+    int64_t num_rows = 0;
+    if (csv_parser.CountBlock(block, eof, &consumed, &num_rows).IsError()) {
       break;
     }
+    rows_total += num_rows;
+    (void)block.erase(0, consumed);
+    if (eof) break;
   }
 
-  return csv_parser.GetTotalRows();
+  return rows_total;
 }
 
 // Pushes a control indicator onto the IOBlockQueue for each worker to consume.
@@ -828,7 +841,7 @@ Status CsvOp::PostEndOfData() {
     RETURN_IF_NOT_OK(PushIoBlockQueue(i, std::move(eof)));
   }
 
-  return Status::OK();
+  return parse_pool_.Stop();
 }
 
 Status CsvOp::CountAllFileRows(const std::vector<std::string> &files, bool csv_header, int64_t *count) {
@@ -19,18 +19,21 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <map>
 #include <utility>
 #include <limits>
+#include <string_view>
 
 #include "minddata/dataset/util/auto_index.h"
+#include "minddata/dataset/util/job_pool.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/util/queue.h"
 
 namespace mindspore {
 namespace dataset {
 
-const size_t CSV_BUFFER_SIZE = 4096;
 using StringIndex = AutoIndexObj<std::string>;
 class JaggedConnector;
 
@@ -56,92 +59,90 @@ class CsvOp : public ParallelOp {
   };
 
   // CsvParser is a class that parsing CSV file.
-  // We design a state machine to implement CSV syntactic analysis. It contains two state diagram,'sd' and 'sdl'.
-  // The 'sd' is used for parsing CSV syntactic, it's complete and complicate.
-  // The 'sdl' is used for counting the record rows, it's concise and it runs fast.
+  // A file is read in large blocks that always start at the beginning of a row. Each block is cut into chunks at
+  // arbitrary bytes and the chunks are parsed in parallel on the parse pool, in three passes:
+  // 1) count the quotes of every chunk, their parity tells whether a chunk starts inside a quoted field;
+  // 2) find the row boundaries of every chunk, the line breaks outside of quoted fields, and count its rows;
+  // 3) split the rows into fields and convert them, a chunk owns the rows whose line break it holds.
+  // Fields are split with vectorized scans for the delimiter, quote and line break characters. Rows keep the order
+  // they have in the file.
   struct CsvParser {
    public:
     CsvParser() = delete;
 
-    CsvParser(int32_t worker_id, std::shared_ptr<JaggedConnector> connector, int64_t rows_per_buffer, char field_delim,
-              std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default);
+    CsvParser(const std::string &file, char field_delim, std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default,
+              int32_t num_threads, JobPool *pool);
 
     ~CsvParser() = default;
 
-    void Reset();
-
-    void SetStartOffset(int64_t start_offset) { start_offset_ = start_offset; }
-
-    void SetEndOffset(int64_t end_offset) { end_offset_ = end_offset; }
-
-    int ProcessMessage(int c);
-
-    int CountRows(int c);
-
-    Status InitCsvParser();
-
-    int64_t GetTotalRows() { return total_rows_; }
-
-    std::string GetErrorMessage() { return err_message_; }
+    // Parses the complete rows of a block.
+    // @param block - the text to parse, it starts at the beginning of a row.
+    // @param eof - whether the block ends the file, otherwise a last incomplete row is left for the next block.
+    // @param first_row - index in the file of the first row of the block.
+    // @param start_offset - rows before this index are skipped.
+    // @param end_offset - rows from this index on are skipped.
+    // @param rows - the rows which are not skipped are appended here, in order.
+    // @param consumed - number of bytes parsed, the rest of the block starts the next one.
+    // @param num_rows - number of rows found in the block, including the skipped ones.
+    // @return Status - the error code returned.
+    Status ParseBlock(std::string_view block, bool eof, int64_t first_row, int64_t start_offset, int64_t end_offset,
+                      std::vector<TensorRow> *rows, size_t *consumed, int64_t *num_rows);
+
+    // Counts the complete rows of a block, without parsing them.
+    // @param block - the text to count the rows of, it starts at the beginning of a row.
+    // @param eof - whether the block ends the file.
+    // @param consumed - number of bytes counted, the rest of the block starts the next one.
+    // @param num_rows - number of rows found in the block.
+    // @return Status - the error code returned.
+    Status CountBlock(std::string_view block, bool eof, size_t *consumed, int64_t *num_rows);
 
    private:
-    enum State : uint8_t {
-      START_OF_FILE = 0,
-      UNQUOTE,
-      DELIM,
-      QUOTE,
-      SECOND_QUOTE,
-      END_OF_LINE,
-      END_OF_FILE,
-      EXCEPTION
-    };
-
-    enum Message : uint8_t {
-      MS_NORMAL = 0,
-      MS_DELIM,
-      MS_QUOTE,
-      MS_END_OF_LINE,
-      MS_END_OF_FILE,
+    // Where the rows of a chunk are, found by the first two passes
+    struct ChunkRows {
+      size_t begin = 0;           // the first row of the chunk, it may start in a previous chunk
+      size_t end = 0;             // right after the last line break of the chunk
+      int64_t num_rows = 0;       // the number of non empty rows ending in the chunk
+      bool has_line_end = false;  // whether a line break outside of quoted fields is in the chunk
     };
 
-    typedef std::pair<State, Message> StateMessagePair;
-    typedef std::pair<State, std::function<int(CsvParser &, int)>> StateActionPair;
-    typedef std::map<StateMessagePair, StateActionPair> StateDiagram;
-
-    Message GetMessage(int c);
-
-    int NullFunc(int c) { return 0; }
-
-    int PutChar(int c);
-
-    int PutRecord(int c);
-
-    int PutRow(int c);
-
-    int EndFile(int c);
+    // Runs the first two passes on a block.
+    // @param block - the block.
+    // @param chunks - where the rows of every chunk are.
+    // @param in_quote - whether the end of the block is inside a quoted field.
+    // @return Status - the error code returned.
+    Status ScanBlock(std::string_view block, std::vector<ChunkRows> *chunks, bool *in_quote);
+
+    // Parses the rows of [begin, end), their line breaks included.
+    // @param begin - the first row.
+    // @param end - the end of the rows.
+    // @param first_row - index in the file of the first row.
+    // @param start_offset - rows before this index are skipped.
+    // @param end_offset - rows from this index on are skipped.
+    // @param rows - the rows which are not skipped are appended here.
+    // @return Status - the error code returned.
+    Status ParseRows(const char *begin, const char *end, int64_t first_row, int64_t start_offset, int64_t end_offset,
+                     std::vector<TensorRow> *rows);
+
+    // Parses a single row.
+    // @param pos - the beginning of the row, moved to its line break.
+    // @param end - the end of the text.
+    // @param row_id - index of the row in the file, for error messages.
+    // @param keep - whether to convert the fields, otherwise only the syntax is checked.
+    // @param field - buffer for the fields.
+    // @param row - the converted row.
+    // @return Status - the error code returned.
+    Status ParseRow(const char **pos, const char *end, int64_t row_id, bool keep, std::string *field, TensorRow *row);
 
-    int AddRow(int c);
+    // Converts a field into a tensor of the type of its column.
+    Status PutRecord(const std::string &field, int32_t col, std::shared_ptr<Tensor> *out);
 
-    int CatchException(int c);
+    Status ParseError(int64_t row_id, const std::string &err_message);
 
-    int32_t worker_id_;
-    std::shared_ptr<JaggedConnector> buffer_connector_;
-    int64_t csv_rows_per_buffer_;
+    std::string file_;
     const char csv_field_delim_;
     std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_;
-    State cur_state_;
-    size_t pos_;
-    int cur_row_;
-    int cur_col_;
-    int64_t total_rows_;
-    int64_t start_offset_;
-    int64_t end_offset_;
-    StateDiagram sd;
-    StateDiagram sdl;
-    std::vector<char> str_buf_;
-    std::unique_ptr<TensorQTable> tensor_table_;
-    std::unique_ptr<DataBuffer> cur_buffer_;
-    std::string err_message_;
+    int32_t num_threads_;
+    JobPool *pool_;
   };
 
   class Builder {
@@ -387,6 +388,11 @@ class CsvOp : public ParallelOp {
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard();
 
+  // The number of threads the parse pool needs so that every worker gets the threads its blocks are split for. A
+  // block is only split into chunks of kCsvMinChunkSize bytes or more, so small files don't get threads.
+  // @return int32_t - the number of threads to launch in the pool.
+  int32_t NumParseHelpers() const;
+
   // Count number of rows in each file.
   // @param filename - csv file name.
   // @return int64_t - the total number of rows in file.
@@ -426,6 +432,9 @@ class CsvOp : public ParallelOp {
   char field_delim_;
   std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list_;
   std::vector<std::string> column_name_list_;
+  const int32_t num_parse_threads_;  // max number of threads parsing one file
+  // runs the chunks of the blocks next to the workers, the files parsed by the workers share its threads
+  JobPool parse_pool_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -43,22 +43,31 @@ Status GeneratorOp::Builder::SanityCheck() {
 Status GeneratorOp::Builder::Build(std::shared_ptr<GeneratorOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<GeneratorOp>(build_generator_function_, build_column_names_, build_column_types_,
-                                       build_prefetch_size_, build_buffer_size_, build_op_connector_size_);
+                                       build_prefetch_size_, build_buffer_size_, build_op_connector_size_,
+                                       build_shared_rings_);
   return (*ptr)->Init();
 }
 
 GeneratorOp::GeneratorOp(py::function generator_function, std::vector<std::string> column_names,
                          std::vector<DataType> column_types, int32_t prefetch_size, int32_t buffer_size,
-                         int32_t connector_size)
+                         int32_t connector_size, std::vector<std::shared_ptr<SharedRowRing>> shared_rings)
     : PipelineOp(connector_size),
       generator_function_(generator_function),
       column_names_(column_names),
       column_types_(column_types),
       prefetch_size_(prefetch_size),
       buffer_size_(buffer_size),
-      buffer_id_(0) {}
+      buffer_id_(0),
+      shared_rings_(std::move(shared_rings)),
+      next_ring_(0) {}
 
-GeneratorOp::~GeneratorOp() { this->Dealloc(); }
+GeneratorOp::~GeneratorOp() {
+  // Let the worker processes waiting for a free slot give up
+  for (auto &ring : shared_rings_) {
+    ring->Close();
+  }
+  this->Dealloc();
+}
 
 void GeneratorOp::Print(std::ostream &out, bool show_all) const {
   if (!show_all) {
@@ -74,6 +83,9 @@ void GeneratorOp::Print(std::ostream &out, bool show_all) const {
     for (int i = 0; i < column_names_.size(); ++i) {
       out << "\n  " << column_names_[i];
     }
+    if (!shared_rings_.empty()) {
+      out << "\nNumber of worker processes: " << shared_rings_.size();
+    }
     out << "\n\n";
   }
 }
@@ -93,6 +105,7 @@ void GeneratorOp::Dealloc() noexcept {
 Status GeneratorOp::Init() {
   // Reset BufferID
   buffer_id_ = 0;
+  next_ring_ = 0;
   Status ret;
   {
     // Acquire Python GIL
@@ -150,6 +163,57 @@ Status GeneratorOp::FillBuffer(TensorQTable *tt) {
   return Status::OK();
 }
 
+Status GeneratorOp::FillBufferFromRings(TensorQTable *tt, bool *eoe) {
+  auto num_rings = static_cast<int32_t>(shared_rings_.size());
+  SharedRowRing::SlotKind kind;
+  std::string payload;
+  for (int i = 0; i < buffer_size_; i++) {
+    TensorRow row;
+    RETURN_IF_NOT_OK(shared_rings_[next_ring_]->Pop(&kind, &row, &payload));
+    if (kind == SharedRowRing::SlotKind::kEoe) {
+      // Worker i holds the rows at i, i + n... so once one worker ends, all the others end at the same point
+      for (int32_t j = 1; j < num_rings; j++) {
+        RETURN_IF_NOT_OK(shared_rings_[(next_ring_ + j) % num_rings]->Pop(&kind, &row, &payload));
+        CHECK_FAIL_RETURN_UNEXPECTED(kind == SharedRowRing::SlotKind::kEoe,
+                                     "Generator worker processes are out of step at the end of an epoch.");
+      }
+      next_ring_ = 0;
+      *eoe = true;
+      return Status::OK();
+    }
+    if (kind == SharedRowRing::SlotKind::kError) {
+      return Status(StatusCode::kPyFuncException, __LINE__, __FILE__, payload);
+    }
+    if (kind == SharedRowRing::SlotKind::kPickledRow) {
+      py::gil_scoped_acquire gil_acquire;
+      if (Py_IsInitialized() == 0) {
+        return Status(StatusCode::kPythonInterpreterFailure, "Python Interpreter is finalized");
+      }
+      try {
+        py::object py_row = py::module::import("pickle").attr("loads")(py::bytes(payload));
+        RETURN_IF_NOT_OK(PyRowToTensorRow(py_row, &row));
+      } catch (const py::error_already_set &e) {
+        return Status(StatusCode::kPyFuncException, __LINE__, __FILE__, e.what());
+      }
+    } else {
+      if (row.size() != column_names_.size()) {
+        return Status(
+          StatusCode::kPyFuncException, __LINE__, __FILE__,
+          "Invalid parameter, Generator should return same number of numpy arrays as specified in column names.");
+      }
+      for (size_t c = 0; c < column_types_.size() && c < row.size(); c++) {
+        if (column_types_[c] != DataType::DE_UNKNOWN && column_types_[c] != row[c]->type()) {
+          return Status(StatusCode::kPyFuncException, __LINE__, __FILE__,
+                        "Invalid parameter, input column type is not same with output tensor type.");
+        }
+      }
+    }
+    tt->push_back(std::move(row));
+    next_ring_ = (next_ring_ + 1) % num_rings;
+  }
+  return Status::OK();
+}
+
 // Entry point for Generator, called by launch()
 // Note that this function is very easy to break because of the Python GIL mechanism
 // The master thread has the following workflow
@@ -163,6 +227,8 @@ Status GeneratorOp::FillBuffer(TensorQTable *tt) {
 //          Restore Python Exception                                  GIL
 //          If not StopIteration:
 //              Return Status PyFuncException
+//      Or, with worker processes:
+//          Prepare one data buffer from the shared rings            Block, GIL for pickled rows only
 //
 //      Push data buffer to connector                                 Block
 //
@@ -194,7 +260,9 @@ Status GeneratorOp::operator()() {
     fetched_buffer = std::make_unique<DataBuffer>(buffer_id_++, DataBuffer::kDeBFlagNone);
     std::unique_ptr<TensorQTable> fetched_table = std::make_unique<TensorQTable>();
     bool eoe = false;
-    {
+    if (!shared_rings_.empty()) {
+      RETURN_IF_NOT_OK(FillBufferFromRings(fetched_table.get(), &eoe));
+    } else {
       py::gil_scoped_acquire gil_acquire;
       if (Py_IsInitialized() == 0) {
         return Status(StatusCode::kPythonInterpreterFailure, "Python Interpreter is finalized");
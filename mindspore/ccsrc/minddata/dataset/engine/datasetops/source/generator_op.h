@@ -26,6 +26,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/engine/datasetops/source/shared_row_ring.h"
 #include "minddata/dataset/util/wait_post.h"
 #include "pybind11/pybind11.h"
 
@@ -74,6 +75,14 @@ class GeneratorOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @param rings - one ring per worker process, the rows are read from them instead of from the generator
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSharedRings(const std::vector<std::shared_ptr<SharedRowRing>> &rings) {
+      build_shared_rings_ = rings;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @return shared_ptr to the new GeneratorOp object
     Status Build(std::shared_ptr<GeneratorOp> *);
@@ -84,6 +93,7 @@ class GeneratorOp : public PipelineOp {
     py::function build_generator_function_;
     std::vector<std::string> build_column_names_;
     std::vector<DataType> build_column_types_;
+    std::vector<std::shared_ptr<SharedRowRing>> build_shared_rings_;
 
     int32_t build_prefetch_size_ = 0;
     int32_t build_buffer_size_;
@@ -93,7 +103,8 @@ class GeneratorOp : public PipelineOp {
   };
 
   GeneratorOp(py::function generator_function, std::vector<std::string> column_names,
-              std::vector<DataType> column_types, int32_t prefetch_size, int32_t buffer_size, int32_t connector_size);
+              std::vector<DataType> column_types, int32_t prefetch_size, int32_t buffer_size, int32_t connector_size,
+              std::vector<std::shared_ptr<SharedRowRing>> shared_rings = {});
 
   ~GeneratorOp();
 
@@ -146,6 +157,12 @@ class GeneratorOp : public PipelineOp {
   py::object generator_;
   int32_t buffer_id_;
 
+  // In multiprocess mode the generator function only hands the sample ids of the epoch out to the worker processes,
+  // worker i gets the ids at i, i + n, i + 2n... and pushes the rows in order to ring i, so reading the rings in round
+  // robin gives the rows in sampler order.
+  std::vector<std::shared_ptr<SharedRowRing>> shared_rings_;
+  int32_t next_ring_;
+
   WaitPost wp_;
 
   void Dealloc() noexcept;
@@ -154,6 +171,12 @@ class GeneratorOp : public PipelineOp {
 
   Status FillBuffer(TensorQTable *tt);
 
+  // Fill a buffer with the rows of the worker processes, without holding the GIL for numeric rows.
+  // @param tt - the table to fill
+  // @param eoe - set when the epoch ends, once every worker reached its end
+  // @return Status - The error code return
+  Status FillBufferFromRings(TensorQTable *tt, bool *eoe);
+
   // Private function for computing the assignment of the column name map.
   // @return - Status
   Status ComputeColMap() override;
@@ -142,11 +142,18 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
   shard_reader_ = std::make_unique<ShardReader>();
+  shard_reader_->SetMmapRead(GlobalContext::config_manager()->enable_mindrecord_mmap());
+  shard_reader_->SetPrefetchSize(GlobalContext::config_manager()->mindrecord_prefetch_size());
   auto rc = shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_, operators_,
                                 num_padded_);
 
   CHECK_FAIL_RETURN_UNEXPECTED(rc == MSRStatus::SUCCESS, "MindRecordOp init failed, " + ErrnoToMessage(rc));
 
+  return InitSchema();
+}
+
+// Private helper method to build the schema of the loaded columns from the opened reader
+Status MindRecordOp::InitSchema() {
   data_schema_ = std::make_unique<DataSchema>();
 
   std::vector<std::string> col_names = shard_reader_->GetShardColumn()->GetColumnName();
@@ -199,6 +206,27 @@ Status MindRecordOp::Init() {
   return Status::OK();
 }
 
+Status MindRecordOp::ProjectColumns(const std::vector<std::string> &columns, bool *projected) {
+  *projected = false;
+  std::vector<std::string> projected_columns;
+  for (const auto &column : columns_to_load_) {
+    if (std::find(columns.begin(), columns.end(), column) != columns.end()) {
+      projected_columns.push_back(column);
+    }
+  }
+  // Leave it to the project op to report columns that do not exist
+  if (projected_columns.size() != columns.size() || projected_columns.size() == columns_to_load_.size()) {
+    return Status::OK();
+  }
+  auto rc = shard_reader_->SetSelectedColumns(projected_columns);
+  CHECK_FAIL_RETURN_UNEXPECTED(rc == MSRStatus::SUCCESS, "MindRecordOp project failed, " + ErrnoToMessage(rc));
+  columns_to_load_ = std::move(projected_columns);
+  column_name_id_map_.clear();
+  RETURN_IF_NOT_OK(InitSchema());
+  *projected = true;
+  return Status::OK();
+}
+
 // Destructor
 MindRecordOp::~MindRecordOp() {}
 
@@ -282,21 +310,28 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
     int32_t row_id = buffer_id * rows_per_buffer_ + i;
+    if (shard_reader_->GetMmapRead()) {
+      bool row_loaded = false;
+      RETURN_IF_NOT_OK(GetMappedRowFromReader(row_id, tensor_table.get(), &row_loaded));
+      if (!row_loaded) break;
+      continue;
+    }
     auto rc = shard_reader_->GetNextById(row_id, worker_id);
     auto task_type = rc.first;
     auto tupled_buffer = rc.second;
     if (task_type == mindrecord::TaskType::kPaddedTask) {
       TensorRow tensor_row;
-      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, {}, mindrecord::json(), task_type));
+      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, nullptr, 0, nullptr, mindrecord::json(), task_type));
       tensor_table->push_back(std::move(tensor_row));
     }
     if (tupled_buffer.empty()) break;
     if (task_type == mindrecord::TaskType::kCommonTask) {
       for (const auto &tupled_row : tupled_buffer) {
-        std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-        mindrecord::json columns_json = std::get<1>(tupled_row);
+        const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+        const mindrecord::json &columns_json = std::get<1>(tupled_row);
         TensorRow tensor_row;
-        RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, columns_blob, columns_json, task_type));
+        RETURN_IF_NOT_OK(
+          LoadTensorRow(&tensor_row, columns_blob.data(), columns_blob.size(), nullptr, columns_json, task_type));
         tensor_table->push_back(std::move(tensor_row));
       }
     }
@@ -307,7 +342,32 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::GetMappedRowFromReader(int32_t row_id, TensorQTable *tensor_table, bool *row_loaded) {
+  auto rc = shard_reader_->GetNextViewById(row_id);
+  auto task_type = rc.first;
+  auto &viewed_buffer = rc.second;
+  *row_loaded = false;
+  if (task_type == mindrecord::TaskType::kPaddedTask) {
+    TensorRow tensor_row;
+    RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, nullptr, 0, nullptr, mindrecord::json(), task_type));
+    tensor_table->push_back(std::move(tensor_row));
+  }
+  if (viewed_buffer.empty()) return Status::OK();
+  if (task_type == mindrecord::TaskType::kCommonTask) {
+    for (const auto &viewed_row : viewed_buffer) {
+      const mindrecord::ShardBlobView &view = std::get<0>(viewed_row);
+      const mindrecord::json &columns_json = std::get<1>(viewed_row);
+      TensorRow tensor_row;
+      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, view.data, view.size, view.file, columns_json, task_type));
+      tensor_table->push_back(std::move(tensor_row));
+    }
+  }
+  *row_loaded = true;
+  return Status::OK();
+}
+
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                                   const std::shared_ptr<mindrecord::ShardMmapFile> &mmap_file,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   for (uint32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -349,8 +409,8 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       }
     } else {
       auto has_column =
-        shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr, &n_bytes,
-                                           &column_data_type, &column_data_type_size, &column_shape);
+        shard_column->GetColumnValueByName(column_name, columns_blob, blob_size, columns_json, &data, &data_ptr,
+                                           &n_bytes, &column_data_type, &column_data_type_size, &column_shape);
       if (has_column == MSRStatus::FAILED) {
         RETURN_STATUS_UNEXPECTED("Invalid data, failed to retrieve data from mindrecord reader.");
       }
@@ -360,20 +420,30 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
     const ColDescriptor &column = data_schema_->column(i_col);
     DataType type = column.type();
 
+    // A blob column that is not compressed points into the mapped file, the tensor can reference it in place as long
+    // as it is aligned for the data type. Everything else is copied.
+    bool in_place = mmap_file != nullptr && data_ptr == nullptr && type.IsNumeric() &&
+                    reinterpret_cast<uintptr_t>(data) % type.SizeInBytes() == 0;
+
     // Set shape
     CHECK_FAIL_RETURN_UNEXPECTED(column_data_type_size != 0, "The divisor cannot be 0.");
     auto num_elements = n_bytes / column_data_type_size;
     if (type == DataType::DE_STRING) {
       std::string s{data, data + n_bytes};
       RETURN_IF_NOT_OK(Tensor::CreateScalar(s, &tensor));
-    } else if (column.hasShape()) {
-      auto new_shape = TensorShape(column.shape());
-      RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
     } else {
-      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
-      auto new_shape = TensorShape(shapeDetails);
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      TensorShape new_shape = TensorShape({static_cast<dsize_t>(num_elements)});
+      if (column.hasShape()) {
+        new_shape = TensorShape(column.shape());
+        RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
+      }
+      if (in_place) {
+        // The mapping is private, writes through the tensor are copied on write and never reach the file
+        RETURN_IF_NOT_OK(
+          Tensor::CreateFromMemoryView(new_shape, type, const_cast<unsigned char *>(data), mmap_file, &tensor));
+      } else {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      }
     }
     tensor_row->push_back(std::move(tensor));
   }
@@ -202,6 +202,14 @@ class MindRecordOp : public ParallelOp {
 
   Status Init();
 
+  // Restricts the loaded columns to the given ones, so that the other columns are never parsed. The opened reader
+  // keeps its index and samplers, only the columns it reads and the schema change. Nothing is changed if a column
+  // is not loaded by this op.
+  // @param columns - the names of the columns to keep, without duplicates
+  // @param projected - set to true if the loaded columns have been changed
+  // @return Status - The error code return
+  Status ProjectColumns(const std::vector<std::string> &columns, bool *projected);
+
   // Base-class override for NodePass visitor acceptor.
   // @param p - Pointer to the NodePass to be accepted.
   // @param modified - Whether this node visit modified the pipeline.
@@ -220,13 +228,26 @@ class MindRecordOp : public ParallelOp {
  private:
   Status GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_buffer, int64_t buffer_id, int32_t worker_id);
 
+  // Reads a row from the memory mapped shard files, used when the reader is in mmap read mode
+  // @param row_id - the id of the row to read
+  // @param tensor_table - the table to append the row to
+  // @param row_loaded - set to false if there are no rows left
+  Status GetMappedRowFromReader(int32_t row_id, TensorQTable *tensor_table, bool *row_loaded);
+
   // Parses a single cell and puts the data into a tensor
   // @param tensor_row - the tensor row to put the parsed data in
   // @param columns_blob - the blob data received from the reader
+  // @param blob_size - the size of the blob data
+  // @param mmap_file - the mapped file the blob lies in, tensors reference it in place if it is not null
   // @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                       const std::shared_ptr<mindrecord::ShardMmapFile> &mmap_file,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
+  // Builds the schema of the loaded columns from the columns of the opened reader
+  // @return Status - The error code return
+  Status InitSchema();
+
   // Private function for computing the assignment of the column name map.
   // @return - Status
   Status ComputeColMap() override;
@@ -28,6 +28,8 @@ DistributedSampler::DistributedSampler(int64_t num_samples, int64_t num_dev, int
     : Sampler(num_samples, std::numeric_limits<int64_t>::max()),
       cnt_(0),
       seed_(seed == std::numeric_limits<uint32_t>::max() ? GetSeed() : seed),
+      start_seed_(seed_),
+      skip_(0),
       device_id_(dev_id),
       num_devices_(num_dev),
       shuffle_(shuffle),
@@ -137,6 +139,20 @@ Status DistributedSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer
       samples_per_buffer_--;
       cnt_--;
     }
+    if (skip_ > 0) {
+      // A resumed run has already read the first ids of the pass
+      std::shared_ptr<Tensor> rest;
+      RETURN_IF_NOT_OK(CreateSamplerTensor(&rest, sample_ids->Size() - skip_));
+      auto src_ptr = sample_ids->begin<int64_t>();
+      for (int64_t i = 0; i < skip_; i++) {
+        ++src_ptr;
+      }
+      for (auto dst_ptr = rest->begin<int64_t>(); dst_ptr != rest->end<int64_t>(); ++dst_ptr, ++src_ptr) {
+        *dst_ptr = *src_ptr;
+      }
+      sample_ids = rest;
+      skip_ = 0;
+    }
     TensorRow row(1, sample_ids);
     (*out_buffer)->set_tensor_table(std::make_unique<TensorQTable>(1, row));
   }
@@ -160,6 +176,27 @@ Status DistributedSampler::ResetSampler() {
   return Status::OK();
 }
 
+Status DistributedSampler::SkipSamples(int64_t num) {
+  CHECK_FAIL_RETURN_UNEXPECTED(cnt_ == 0 && num < samples_per_buffer_, "Cannot skip more ids than the pass has.");
+  skip_ = num;
+  return Status::OK();
+}
+
+Status DistributedSampler::SaveState(nlohmann::json *state) {
+  RETURN_IF_NOT_OK(Sampler::SaveState(state));
+  (*state)["seed"] = start_seed_;
+  return Status::OK();
+}
+
+Status DistributedSampler::RestoreState(const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(Sampler::RestoreState(state));
+  if (state.find("seed") != state.end()) {
+    start_seed_ = state["seed"].get<uint32_t>();
+    seed_ = start_seed_;
+  }
+  return Status::OK();
+}
+
 void DistributedSampler::Print(std::ostream &out, bool show_all) const {
   out << "\nSampler: DistributedSampler";
   if (show_all) {
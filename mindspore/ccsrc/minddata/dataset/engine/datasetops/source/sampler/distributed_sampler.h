@@ -58,15 +58,33 @@ class DistributedSampler : public Sampler {
   /// \return Status code
   Status ResetSampler() override;
 
+  /// \brief Save the seed the sampler started with
+  /// \param[out] state The json object to fill
+  /// \return Status code
+  Status SaveState(nlohmann::json *state) override;
+
+  /// \brief Start from a saved seed
+  /// \param[in] state The saved state
+  /// \return Status code
+  Status RestoreState(const nlohmann::json &state) override;
+
   int64_t GetDeviceID() { return device_id_; }
 
   int64_t GetDeviceNum() { return num_devices_; }
 
   void Print(std::ostream &out, bool show_all) const override;
 
+ protected:
+  /// \brief The ids of a pass are returned in one buffer, so the skipped ones are cut from its head
+  /// \param[in] num Number of ids to drop
+  /// \return Status code
+  Status SkipSamples(int64_t num) override;
+
  private:
   int64_t cnt_;  // number of samples that have already been filled in to buffer
   uint32_t seed_;
+  uint32_t start_seed_;  // seed_ before the first pass
+  int64_t skip_;         // ids to drop from the next buffer
   int64_t device_id_;
   int64_t num_devices_;
   bool shuffle_;
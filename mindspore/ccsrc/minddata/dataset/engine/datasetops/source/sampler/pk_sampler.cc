@@ -24,6 +24,7 @@ PKSampler::PKSampler(int64_t num_samples, int64_t val, bool shuffle, int64_t sam
     : Sampler(num_samples, samples_per_buffer),
       shuffle_(shuffle),
       seed_(GetSeed()),
+      start_seed_(seed_),
       next_id_(0),
       samples_per_class_(val) {}
 
@@ -112,6 +113,22 @@ Status PKSampler::HandshakeRandomAccessOp(const RandomAccessOp *op) {
   RETURN_UNEXPECTED_IF_NULL(op);
   RETURN_IF_NOT_OK(op->GetClassIds(&label_to_ids_));
   RETURN_IF_NOT_OK(InitSampler());
+  RETURN_IF_NOT_OK(ApplySeek());
+  return Status::OK();
+}
+
+Status PKSampler::SaveState(nlohmann::json *state) {
+  RETURN_IF_NOT_OK(Sampler::SaveState(state));
+  (*state)["seed"] = start_seed_;
+  return Status::OK();
+}
+
+Status PKSampler::RestoreState(const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(Sampler::RestoreState(state));
+  if (state.find("seed") != state.end()) {
+    start_seed_ = state["seed"].get<uint32_t>();
+    seed_ = start_seed_;
+  }
   return Status::OK();
 }
 
@@ -49,6 +49,16 @@ class PKSampler : public Sampler {  // NOT YET FINISHED
   // @return
   Status HandshakeRandomAccessOp(const RandomAccessOp *op) override;
 
+  // Save the seed the sampler started with
+  // @param state - the json object to fill
+  // @return - The error code return
+  Status SaveState(nlohmann::json *state) override;
+
+  // Start from a saved seed
+  // @param state - the saved state
+  // @return - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
   // init sampler, to be called by python or Handshake
   Status InitSampler() override;
 
@@ -64,6 +74,7 @@ class PKSampler : public Sampler {  // NOT YET FINISHED
  private:
   bool shuffle_;
   uint32_t seed_;
+  uint32_t start_seed_;  // seed_ before the first pass
   int64_t next_id_;
   int64_t samples_per_class_;
   std::mt19937 rnd_;
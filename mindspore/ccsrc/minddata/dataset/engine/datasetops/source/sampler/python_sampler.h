@@ -50,6 +50,10 @@ class PythonSampler : public Sampler {
   // @return - The error code return
   Status GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) override;
 
+  // The python sampler returns a whole pass at once
+  // @return - false
+  bool CanSkipSamples() const override { return false; }
+
   // Printer for debugging purposes.
   // @param out - output stream to write to
   // @param show_all - bool to show detailed vs summary
@@ -26,6 +26,7 @@ RandomSampler::RandomSampler(int64_t num_samples, bool replacement, bool reshuff
                              int64_t samples_per_buffer)
     : Sampler(num_samples, samples_per_buffer),
       seed_(GetSeed()),
+      start_seed_(seed_),
       replacement_(replacement),
       next_id_(0),
       reshuffle_each_epoch_(reshuffle_each_epoch),
@@ -115,6 +116,21 @@ Status RandomSampler::ResetSampler() {
   return Status::OK();
 }
 
+Status RandomSampler::SaveState(nlohmann::json *state) {
+  RETURN_IF_NOT_OK(Sampler::SaveState(state));
+  (*state)["seed"] = start_seed_;
+  return Status::OK();
+}
+
+Status RandomSampler::RestoreState(const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(Sampler::RestoreState(state));
+  if (state.find("seed") != state.end()) {
+    start_seed_ = state["seed"].get<uint32_t>();
+    seed_ = start_seed_;
+  }
+  return Status::OK();
+}
+
 void RandomSampler::Print(std::ostream &out, bool show_all) const {
   out << "\nSampler: RandomSampler";
   if (show_all) {
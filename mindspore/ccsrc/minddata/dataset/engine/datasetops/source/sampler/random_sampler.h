@@ -50,10 +50,21 @@ class RandomSampler : public Sampler {
   // @return - The error code return
   Status ResetSampler() override;
 
+  // Save the seed the sampler started with
+  // @param state - the json object to fill
+  // @return - The error code return
+  Status SaveState(nlohmann::json *state) override;
+
+  // Start from a saved seed
+  // @param state - the saved state
+  // @return - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
   virtual void Print(std::ostream &out, bool show_all) const;
 
  private:
   uint32_t seed_;
+  uint32_t start_seed_;  // seed_ before the first pass
   bool replacement_;
   std::vector<int64_t> shuffled_ids_;  // only used for NO REPLACEMENT
   int64_t next_id_;
@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
 
+#include <algorithm>
 #include <string>
 
 namespace mindspore {
@@ -33,7 +34,12 @@ Status RandomAccessOp::GetNumRowsInDataset(int64_t *num) const {
 }
 
 Sampler::Sampler(int64_t num_samples, int64_t samples_per_buffer)
-    : num_rows_(0), num_samples_(num_samples), samples_per_buffer_(samples_per_buffer), col_desc_(nullptr) {}
+    : num_rows_(0),
+      num_samples_(num_samples),
+      samples_per_buffer_(samples_per_buffer),
+      col_desc_(nullptr),
+      seek_passes_(0),
+      seek_samples_(0) {}
 
 Status Sampler::HandshakeRandomAccessOp(const RandomAccessOp *op) {
   std::shared_ptr<Sampler> child_sampler;
@@ -61,6 +67,63 @@ Status Sampler::HandshakeRandomAccessOp(const RandomAccessOp *op) {
   // Because some sampler only needs one of the arg (weighted_random_sampler)
   RETURN_IF_NOT_OK(InitSampler());  // init sampler after callback
 
+  RETURN_IF_NOT_OK(ApplySeek());
+  return Status::OK();
+}
+
+Status Sampler::ApplySeek() {
+  // Replay the skipped passes, the ids of a pass may depend on the ones before
+  for (; seek_passes_ > 0; seek_passes_--) {
+    std::unique_ptr<DataBuffer> db;
+    do {
+      RETURN_IF_NOT_OK(GetNextSample(&db));
+    } while (!db->eoe());
+    RETURN_IF_NOT_OK(ResetSampler());
+  }
+  if (seek_samples_ > 0) {
+    RETURN_IF_NOT_OK(SkipSamples(seek_samples_));
+    seek_samples_ = 0;
+  }
+  return Status::OK();
+}
+
+Status Sampler::Seek(int64_t passes, int64_t samples) {
+  CHECK_FAIL_RETURN_UNEXPECTED(passes >= 0 && samples >= 0, "Invalid parameter, cannot seek backward.");
+  CHECK_FAIL_RETURN_UNEXPECTED(samples == 0 || CanSkipSamples(), "This sampler cannot start part way through a pass.");
+  seek_passes_ += passes;
+  seek_samples_ += samples;
+  return Status::OK();
+}
+
+Status Sampler::SkipSamples(int64_t num) {
+  // Draw buffers no larger than what is left to skip
+  int64_t samples_per_buffer = samples_per_buffer_;
+  while (num > 0) {
+    samples_per_buffer_ = std::min(num, samples_per_buffer);
+    std::unique_ptr<DataBuffer> db;
+    RETURN_IF_NOT_OK(GetNextSample(&db));
+    CHECK_FAIL_RETURN_UNEXPECTED(!db->eoe() && db->NumRows() == 1, "Cannot skip more ids than the pass has.");
+    TensorRow sample_row;
+    RETURN_IF_NOT_OK(db->GetRow(0, &sample_row));
+    CHECK_FAIL_RETURN_UNEXPECTED(sample_row[0]->Size() <= num, "Sampler returned more ids than asked to skip.");
+    num -= sample_row[0]->Size();
+  }
+  samples_per_buffer_ = samples_per_buffer;
+  return Status::OK();
+}
+
+Status Sampler::SaveState(nlohmann::json *state) {
+  RETURN_UNEXPECTED_IF_NULL(state);
+  if (HasChildSampler()) {
+    RETURN_IF_NOT_OK(child_[0]->SaveState(&(*state)["child"]));
+  }
+  return Status::OK();
+}
+
+Status Sampler::RestoreState(const nlohmann::json &state) {
+  if (HasChildSampler() && state.find("child") != state.end()) {
+    RETURN_IF_NOT_OK(child_[0]->RestoreState(state["child"]));
+  }
   return Status::OK();
 }
 
@@ -22,6 +22,7 @@
 #include <random>
 #include <vector>
 
+#include <nlohmann/json.hpp>
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/data_schema.h"
@@ -93,6 +94,28 @@ class Sampler {
   // initialize sampler and perform checks on certain vars
   virtual Status InitSampler() { return Status::OK(); }
 
+  // Move the sampler to where a previous run of the same sampler left off. It takes effect at the handshake, so
+  // the ids of the skipped passes are generated again but no row is read for them.
+  // @param passes - number of full passes (ResetSampler calls) to skip
+  // @param samples - number of ids of the next pass to skip, only if CanSkipSamples()
+  // @return - The error code return
+  Status Seek(int64_t passes, int64_t samples);
+
+  // Check if the sampler can start a pass part way through, i.e. the ids it returns do not depend on how they are
+  // split into buffers
+  // @return - true if SkipSamples works
+  virtual bool CanSkipSamples() const { return child_.empty(); }
+
+  // Save what the sampler needs to give the same ids in another run, such as its seed
+  // @param state - the json object to fill
+  // @return - The error code return
+  virtual Status SaveState(nlohmann::json *state);
+
+  // Restore the state saved by SaveState, before the handshake
+  // @param state - the saved state
+  // @return - The error code return
+  virtual Status RestoreState(const nlohmann::json &state);
+
   // setter for num samples
   // @param num_samples - the number of samples to assign.
   // @return status error code
@@ -146,6 +169,15 @@ class Sampler {
   Status GetAssociatedChildId(int64_t *out_associated_id, int64_t id);
 
  protected:
+  // Move to the position given by Seek, called once the sampler is initialized
+  // @return - The error code return
+  Status ApplySeek();
+
+  // Drop the next ids of the current pass
+  // @param num - number of ids to drop
+  // @return - The error code return
+  virtual Status SkipSamples(int64_t num);
+
   // Number of rows of data from the place this sampler is sampling from. If this sampler
   // has a child sampler, num_rows_ is the number of ids the child sampler will
   // output. Otherwise, num_rows_ is the number of rows in the dataset.
@@ -160,6 +192,10 @@ class Sampler {
   std::unique_ptr<ColDescriptor> col_desc_;
   std::vector<std::shared_ptr<Sampler>> child_;  // Child nodes
   std::unique_ptr<DataBuffer> child_ids_;
+
+ private:
+  int64_t seek_passes_;   // passes to skip at the handshake
+  int64_t seek_samples_;  // ids to skip at the handshake after the passes
 };
 }  // namespace dataset
 }  // namespace mindspore
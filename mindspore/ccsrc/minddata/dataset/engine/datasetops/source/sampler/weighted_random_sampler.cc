@@ -28,19 +28,34 @@ namespace mindspore {
 namespace dataset {
 //  Constructor.
 WeightedRandomSampler::WeightedRandomSampler(int64_t num_samples, const std::vector<double> &weights, bool replacement,
-                                             int64_t samples_per_buffer)
+                                             int64_t samples_per_buffer, int64_t num_shards, int64_t shard_id)
     : Sampler(num_samples, samples_per_buffer),
       weights_(weights),
       replacement_(replacement),
+      num_shards_(num_shards),
+      shard_id_(shard_id),
       sample_id_(0),
       buffer_id_(0) {}
 
+int64_t WeightedRandomSampler::NumShardIds() const {
+  return (static_cast<int64_t>(weights_.size()) - shard_id_ + num_shards_ - 1) / num_shards_;
+}
+
 // Initialized this Sampler.
 Status WeightedRandomSampler::InitSampler() {
+  CHECK_FAIL_RETURN_UNEXPECTED(num_shards_ > 0 && shard_id_ >= 0 && shard_id_ < num_shards_,
+                               "Invalid parameter, shard_id must be in [0, num_shards - 1], but got num_shards: " +
+                                 std::to_string(num_shards_) + ", shard_id: " + std::to_string(shard_id_));
+  CHECK_FAIL_RETURN_UNEXPECTED(weights_.size() >= static_cast<size_t>(num_shards_),
+                               "Invalid parameter, weights size must be greater than or equal to num_shards, "
+                               "but got weight size: " +
+                                 std::to_string(weights_.size()) + ", num_shards: " + std::to_string(num_shards_));
+  // A shard samples from its own ids only
+  int64_t num_rows = num_shards_ > 1 ? std::min(num_rows_, NumShardIds()) : num_rows_;
   // Special value of 0 for num_samples means that the user wants to sample the entire set of data.
   // If the user asked to sample more rows than exists in the dataset, adjust the num_samples accordingly.
-  if (num_samples_ == 0 || num_samples_ > num_rows_) {
-    num_samples_ = num_rows_;
+  if (num_samples_ == 0 || num_samples_ > num_rows) {
+    num_samples_ = num_rows;
   }
   CHECK_FAIL_RETURN_UNEXPECTED(num_rows_ > 0 && num_samples_,
                                "Invalid parameter, num_samples & num_rows must be greater than 0, but got num_rows: " +
@@ -50,14 +65,10 @@ Status WeightedRandomSampler::InitSampler() {
                                  std::to_string(samples_per_buffer_) + ".\n");
 
   CHECK_FAIL_RETURN_UNEXPECTED(weights_.size() != 0, "Invalid parameter, weights size must not be 0.\n");
-  int32_t zero_elem = 0;
   for (auto &elem : weights_) {
     CHECK_FAIL_RETURN_UNEXPECTED(elem >= 0.0, "Invalid parameter, weights must not contain negative number, but got " +
                                                 std::to_string(elem) + ".\n");
-    if (elem == 0.0) zero_elem++;
   }
-  CHECK_FAIL_RETURN_UNEXPECTED(zero_elem != weights_.size(),
-                               "Invalid parameter, elements of weights must not be all zero.\n");
 
   if (weights_.size() > static_cast<size_t>(num_rows_)) {
     return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
@@ -65,11 +76,11 @@ Status WeightedRandomSampler::InitSampler() {
                   "otherwise might cause generated id out of bound or other errors, but got weight size: " +
                     std::to_string(weights_.size()) + ", num of data: " + std::to_string(num_rows_));
   }
-  if (!replacement_ && (weights_.size() < static_cast<size_t>(num_samples_))) {
+  if (!replacement_ && NumShardIds() < num_samples_) {
     RETURN_STATUS_UNEXPECTED(
       "Invalid parameter, without replacement, weights size must be greater than or equal to num_samples, "
       "but got weight size: " +
-      std::to_string(weights_.size()) + ", num_samples: " + std::to_string(num_samples_));
+      std::to_string(NumShardIds()) + ", num_samples: " + std::to_string(num_samples_));
   }
 
   // Initialize random generator with seed from config manager
@@ -77,41 +88,32 @@ Status WeightedRandomSampler::InitSampler() {
 
   samples_per_buffer_ = (samples_per_buffer_ > num_samples_) ? num_samples_ : samples_per_buffer_;
 
-  if (!replacement_) {
-    exp_dist_ = std::make_unique<std::exponential_distribution<>>(1);
-    InitOnePassSampling();
-  } else {
-    discrete_dist_ = std::make_unique<std::discrete_distribution<int64_t>>(weights_.begin(), weights_.end());
+  std::unique_lock<std::mutex> lock(weights_mux_);
+  std::vector<double> shard_weights;
+  for (size_t i = shard_id_; i < weights_.size(); i += num_shards_) {
+    shard_weights.push_back(weights_[i]);
   }
+  tree_.Build(shard_weights);
+  CHECK_FAIL_RETURN_UNEXPECTED(tree_.total() > 0.0, "Invalid parameter, elements of weights must not be all zero.\n");
+  drawn_.assign(shard_weights.size(), false);
+  drawn_leaves_.clear();
 
   return Status::OK();
 }
 
-// Initialized the computation for generating weighted random numbers without replacement using onepass method.
-void WeightedRandomSampler::InitOnePassSampling() {
-  exp_dist_->reset();
-  onepass_ids_.clear();
-  std::vector<std::pair<double, int64_t>> val_idx;
-  for (size_t i = 0; i < weights_.size(); i++) {
-    val_idx.emplace_back(std::make_pair((*exp_dist_)(rand_gen_) / weights_[i], i));
-  }
-
-  // Partial sort the first `numSamples` elements.
-  std::partial_sort(val_idx.begin(), val_idx.begin() + num_samples_, val_idx.end());
-  for (int64_t i = 0; i < num_samples_; i++) {
-    onepass_ids_.push_back(val_idx[i].second);
-  }
-}
-
 // Reset the internal variable to the initial state and reshuffle the indices.
 Status WeightedRandomSampler::ResetSampler() {
   sample_id_ = 0;
   buffer_id_ = 0;
   rand_gen_.seed(GetSeed());
-  if (!replacement_) {
-    InitOnePassSampling();
-  } else {
-    discrete_dist_->reset();
+  {
+    // Put back the ids drawn without replacement, with the weights they have now
+    std::unique_lock<std::mutex> lock(weights_mux_);
+    for (auto leaf : drawn_leaves_) {
+      tree_.Update(leaf, weights_[shard_id_ + leaf * num_shards_]);
+      drawn_[leaf] = false;
+    }
+    drawn_leaves_.clear();
   }
 
   if (HasChildSampler()) {
@@ -121,6 +123,56 @@ Status WeightedRandomSampler::ResetSampler() {
   return Status::OK();
 }
 
+Status WeightedRandomSampler::UpdateWeights(const std::vector<int64_t> &ids, const std::vector<double> &weights) {
+  CHECK_FAIL_RETURN_UNEXPECTED(ids.size() == weights.size(),
+                               "Invalid parameter, ids and weights must have the same size, but got ids size: " +
+                                 std::to_string(ids.size()) + ", weights size: " + std::to_string(weights.size()));
+  std::unique_lock<std::mutex> lock(weights_mux_);
+  for (size_t i = 0; i < ids.size(); i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(ids[i] >= 0 && ids[i] < static_cast<int64_t>(weights_.size()),
+                                 "Invalid parameter, id must be in [0, weights size - 1], but got id: " +
+                                   std::to_string(ids[i]) + ", weights size: " + std::to_string(weights_.size()));
+    CHECK_FAIL_RETURN_UNEXPECTED(weights[i] >= 0.0, "Invalid parameter, weights must not contain negative number, "
+                                                    "but got " +
+                                                      std::to_string(weights[i]) + ".");
+  }
+  for (size_t i = 0; i < ids.size(); i++) {
+    weights_[ids[i]] = weights[i];
+    // The tree only holds the ids of the shard, and is built when the sampler is initialized
+    if (ids[i] < shard_id_ || (ids[i] - shard_id_) % num_shards_ != 0) {
+      continue;
+    }
+    auto leaf = static_cast<size_t>((ids[i] - shard_id_) / num_shards_);
+    if (leaf < tree_.size() && !drawn_[leaf]) {
+      tree_.Update(leaf, weights[i]);
+    }
+  }
+  return Status::OK();
+}
+
+Status WeightedRandomSampler::DrawId(int64_t *id) {
+  size_t leaf;
+  if (tree_.total() > 0.0) {
+    std::uniform_real_distribution<double> dist(0.0, tree_.total());
+    leaf = tree_.Find(dist(rand_gen_));
+  } else {
+    CHECK_FAIL_RETURN_UNEXPECTED(!replacement_, "Invalid parameter, elements of weights must not be all zero.");
+    // Without replacement, the ids of zero weight are drawn once all the others are
+    std::uniform_int_distribution<size_t> dist(0, drawn_.size() - 1);
+    leaf = dist(rand_gen_);
+    while (drawn_[leaf]) {
+      leaf = (leaf + 1) % drawn_.size();
+    }
+  }
+  if (!replacement_) {
+    tree_.Update(leaf, 0.0);
+    drawn_[leaf] = true;
+    drawn_leaves_.push_back(leaf);
+  }
+  *id = shard_id_ + static_cast<int64_t>(leaf) * num_shards_;
+  return Status::OK();
+}
+
 // Get the sample ids.
 Status WeightedRandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
   if (weights_.size() > static_cast<size_t>(num_rows_)) {
@@ -130,11 +182,11 @@ Status WeightedRandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buf
                     std::to_string(weights_.size()) + ", num of data: " + std::to_string(num_rows_));
   }
 
-  if (!replacement_ && (weights_.size() < static_cast<size_t>(num_samples_))) {
+  if (!replacement_ && NumShardIds() < num_samples_) {
     RETURN_STATUS_UNEXPECTED(
       "Invalid parameter, without replacement, weights size must be greater than or equal to num_samples, "
       "but got weight size: " +
-      std::to_string(weights_.size()) + ", num_samples: " + std::to_string(num_samples_));
+      std::to_string(NumShardIds()) + ", num_samples: " + std::to_string(num_samples_));
   }
 
   if (sample_id_ == num_samples_) {
@@ -159,15 +211,10 @@ Status WeightedRandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buf
     // Initialize tensor.
     auto id_ptr = outputIds->begin<int64_t>();
     // Assign the data to tensor element.
+    std::unique_lock<std::mutex> lock(weights_mux_);
     while (sample_id_ < last_id) {
       int64_t genId;
-      if (replacement_) {
-        genId = (*discrete_dist_)(rand_gen_);
-      } else {
-        // Draw sample without replacement.
-        genId = onepass_ids_.front();
-        onepass_ids_.pop_front();
-      }
+      RETURN_IF_NOT_OK(DrawId(&genId));
 
       if (genId >= num_rows_) {
         RETURN_STATUS_UNEXPECTED("Generated indice is out of bound, expect range [0, num_data-1], got indice: " +
@@ -183,6 +230,8 @@ Status WeightedRandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buf
       sample_id_++;
     }
 
+    lock.unlock();
+
     // Create a TensorTable from that single tensor and push into DataBuffer
     (*out_buffer)->set_tensor_table(std::make_unique<TensorQTable>(1, TensorRow(1, outputIds)));
   }
@@ -190,12 +239,65 @@ Status WeightedRandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buf
   return Status::OK();
 }
 
+Status WeightedRandomSampler::SaveState(nlohmann::json *state) {
+  RETURN_IF_NOT_OK(Sampler::SaveState(state));
+  std::unique_lock<std::mutex> lock(weights_mux_);
+  (*state)["weights"] = weights_;
+  return Status::OK();
+}
+
+void WeightedRandomSamplerGroup::Add(const std::shared_ptr<WeightedRandomSampler> &sampler) {
+  std::unique_lock<std::mutex> lock(mux_);
+  Prune();
+  samplers_.push_back(sampler);
+}
+
+Status WeightedRandomSamplerGroup::UpdateWeights(const std::vector<int64_t> &ids, const std::vector<double> &weights) {
+  std::unique_lock<std::mutex> lock(mux_);
+  Prune();
+  for (auto &weak_sampler : samplers_) {
+    auto sampler = weak_sampler.lock();
+    if (sampler != nullptr) {
+      RETURN_IF_NOT_OK(sampler->UpdateWeights(ids, weights));
+    }
+  }
+  return Status::OK();
+}
+
+size_t WeightedRandomSamplerGroup::size() {
+  std::unique_lock<std::mutex> lock(mux_);
+  Prune();
+  return samplers_.size();
+}
+
+void WeightedRandomSamplerGroup::Prune() {
+  (void)samplers_.erase(std::remove_if(samplers_.begin(), samplers_.end(),
+                                       [](const std::weak_ptr<WeightedRandomSampler> &p) { return p.expired(); }),
+                        samplers_.end());
+}
+
+Status WeightedRandomSampler::RestoreState(const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(Sampler::RestoreState(state));
+  if (state.find("weights") != state.end()) {
+    auto weights = state["weights"].get<std::vector<double>>();
+    CHECK_FAIL_RETURN_UNEXPECTED(weights.size() == weights_.size(),
+                                 "The saved weights do not match the sampler, weights size: " +
+                                   std::to_string(weights_.size()) + ", saved: " + std::to_string(weights.size()));
+    std::unique_lock<std::mutex> lock(weights_mux_);
+    weights_ = std::move(weights);
+  }
+  return Status::OK();
+}
+
 void WeightedRandomSampler::Print(std::ostream &out, bool show_all) const {
   out << "\nSampler: WeightedRandomSampler";
   if (show_all) {
     // Call the super class for displaying any common detailed info
     Sampler::Print(out, show_all);
     // Then add our own info if any
+    if (num_shards_ > 1) {
+      out << "\nShard: " << shard_id_ << " of " << num_shards_;
+    }
   }
 }
 }  // namespace dataset
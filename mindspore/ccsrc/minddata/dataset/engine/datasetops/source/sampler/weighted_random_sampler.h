@@ -16,16 +16,20 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_WEIGHTED_RANDOM_SAMPLER_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_WEIGHTED_RANDOM_SAMPLER_H_
 
-#include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
+#include "minddata/dataset/util/sum_tree.h"
 
 namespace mindspore {
 namespace dataset {
 // Samples elements from id `0, 1, ..., weights.size()-1` with given probabilities (weights).
+// The weights are held in a sum tree, so each id is drawn in O(log n), and the weights can be changed while the
+// pipeline runs, e.g. from the training loop, in O(log n) each. A change applies to the ids drawn after it.
+// With shards, shard k only draws the ids i with i % num_shards == k, in proportion to their weights.
 class WeightedRandomSampler : public Sampler {
  public:
   // Constructor.
@@ -34,8 +38,11 @@ class WeightedRandomSampler : public Sampler {
   // @param replacement Determine if samples are drawn with/without replacement.
   // @param samples_per_buffer The number of ids we draw on each call to GetNextBuffer().
   // When samplesPerBuffer=0, GetNextBuffer() will draw all the sample ids and return them at once.
+  // @param num_shards Number of shards the ids are split into.
+  // @param shard_id The shard to draw the ids of.
   WeightedRandomSampler(int64_t num_samples, const std::vector<double> &weights, bool replacement,
-                        int64_t samples_per_buffer = std::numeric_limits<int64_t>::max());
+                        int64_t samples_per_buffer = std::numeric_limits<int64_t>::max(), int64_t num_shards = 1,
+                        int64_t shard_id = 0);
 
   // Destructor.
   ~WeightedRandomSampler() = default;
@@ -53,6 +60,23 @@ class WeightedRandomSampler : public Sampler {
   // @note the sample ids (int64_t) will be placed in one Tensor and be placed into pBuffer.
   Status GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) override;
 
+  // Change the weights of some ids, it can be called from another thread while the sampler runs.
+  // Without replacement, an id already drawn in the current epoch takes its new weight at the next epoch.
+  // @param ids The ids, in [0, weights.size()-1], the ids of other shards are accepted and only recorded.
+  // @param weights Their new weights.
+  // @return Status
+  Status UpdateWeights(const std::vector<int64_t> &ids, const std::vector<double> &weights);
+
+  // Save the current weights, so that a pipeline resumed from the state samples with them
+  // @param state - the json object to fill
+  // @return - The error code return
+  Status SaveState(nlohmann::json *state) override;
+
+  // Start from saved weights
+  // @param state - the saved state
+  // @return - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
   // Printer for debugging purposes.
   // @param out - output stream to write to
   // @param show_all - bool to show detailed vs summary
@@ -65,6 +89,10 @@ class WeightedRandomSampler : public Sampler {
   // A flag indicating if samples are drawn with/without replacement.
   bool replacement_;
 
+  // Number of shards and the shard to draw from.
+  int64_t num_shards_;
+  int64_t shard_id_;
+
   // Current sample id.
   int64_t sample_id_;
 
@@ -74,19 +102,53 @@ class WeightedRandomSampler : public Sampler {
   // Random engine and device
   std::mt19937 rand_gen_;
 
-  // Discrete distribution for generating weighted random numbers with replacement.
-  std::unique_ptr<std::discrete_distribution<int64_t>> discrete_dist_;
+  // Weights of the ids of the shard, leaf j is id shard_id_ + j * num_shards_. Without replacement, the leaves drawn
+  // in the current epoch have a weight of 0.
+  SumTree tree_;
+
+  // Without replacement, the leaves drawn in the current epoch, as flags and as a list to restore them.
+  std::vector<bool> drawn_;
+  std::vector<size_t> drawn_leaves_;
+
+  // Guards the weights against updates from other threads.
+  std::mutex weights_mux_;
+
+  // Number of ids of the shard.
+  int64_t NumShardIds() const;
+
+  // Draw the next id of the shard.
+  // @param[out] id The drawn id.
+  // @return Status
+  Status DrawId(int64_t *id);
+};
+
+// The samplers built from the same sampler of the Python API, so that a weight update reaches every pipeline still
+// running one of them. They are held weakly: a sampler is dropped once its pipeline is released.
+class WeightedRandomSamplerGroup {
+ public:
+  WeightedRandomSamplerGroup() = default;
+
+  ~WeightedRandomSamplerGroup() = default;
 
-  // Exponential distribution for generating weighted random numbers without replacement.
-  // based on "Accelerating weighted random sampling without replacement" by Kirill Muller.
-  std::unique_ptr<std::exponential_distribution<>> exp_dist_;
+  // Add a sampler to the group.
+  // @param sampler The sampler.
+  void Add(const std::shared_ptr<WeightedRandomSampler> &sampler);
 
-  // Initialized the computation for generating weighted random numbers without replacement
-  // using onepass method.
-  void InitOnePassSampling();
+  // Change the weights of some ids in the samplers of the group, see WeightedRandomSampler::UpdateWeights.
+  // @param ids The ids.
+  // @param weights Their new weights.
+  // @return Status
+  Status UpdateWeights(const std::vector<int64_t> &ids, const std::vector<double> &weights);
+
+  // @return Number of samplers of the group still in use.
+  size_t size();
+
+ private:
+  // Forget the samplers no longer in use, the caller holds mux_.
+  void Prune();
 
-  // Store the random weighted ids generated by onepass method in `InitOnePassSampling`
-  std::deque<int64_t> onepass_ids_;
+  std::mutex mux_;
+  std::vector<std::weak_ptr<WeightedRandomSampler>> samplers_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,272 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/shared_row_ring.h"
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kAlign = 64;
+// Polls before a waiting side starts sleeping, and the longest sleep in microseconds
+constexpr int32_t kSpinCount = 64;
+constexpr int64_t kMaxSleepUs = 1000;
+// Sleeps of the consumer between two checks of the worker process
+constexpr int32_t kLivenessCheckInterval = 100;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "The indices of a shared ring must be lock free to be shared between processes.");
+
+// Metadata at the start of a slot
+struct SlotHeader {
+  int32_t kind;
+  int32_t num_columns;
+  int64_t payload_size;  // Bytes following the header for a payload, unused for a row
+};
+
+// Metadata of a column of a row, followed by its dims, and then by its data at the next aligned offset
+struct ColumnHeader {
+  int32_t type;
+  int32_t rank;
+  int64_t nbytes;
+};
+
+int64_t AlignUp(int64_t n) { return (n + kAlign - 1) / kAlign * kAlign; }
+
+int64_t ColumnDataOffset(int32_t rank) {
+  return AlignUp(static_cast<int64_t>(sizeof(ColumnHeader)) + rank * static_cast<int64_t>(sizeof(int64_t)));
+}
+
+// Poll, then sleep for exponentially longer up to kMaxSleepUs
+void Backoff(int32_t *count) {
+  if (*count < kSpinCount) {
+    std::this_thread::yield();
+  } else {
+    int64_t sleep_us = std::min<int64_t>(int64_t(1) << std::min(*count - kSpinCount, 10), kMaxSleepUs);
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_us));
+  }
+  (*count)++;
+}
+}  // namespace
+
+Status SharedRowRing::CreateSharedRowRing(int32_t num_slots, int64_t slot_size,
+                                          std::shared_ptr<SharedRowRing> *out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(num_slots > 0, "Invalid number of slots of a shared ring: " + std::to_string(num_slots));
+  CHECK_FAIL_RETURN_UNEXPECTED(slot_size >= kAlign, "Invalid slot size of a shared ring: " + std::to_string(slot_size));
+  *out = std::make_shared<SharedRowRing>(num_slots, AlignUp(slot_size));
+  return (*out)->Init();
+}
+
+SharedRowRing::SharedRowRing(int32_t num_slots, int64_t slot_size)
+    : num_slots_(num_slots),
+      slot_size_(slot_size),
+      mapped_size_(0),
+      mem_(nullptr),
+      header_(nullptr),
+      slots_(nullptr) {}
+
+SharedRowRing::~SharedRowRing() {
+  if (mem_ != nullptr) {
+    (void)munmap(mem_, mapped_size_);
+  }
+}
+
+Status SharedRowRing::Init() {
+  int64_t header_size = AlignUp(sizeof(Header));
+  mapped_size_ = static_cast<size_t>(header_size + slot_size_ * num_slots_);
+  // Anonymous shared memory stays shared with the processes forked from now on, the pages are only backed on use.
+  void *mem = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED) {
+    RETURN_STATUS_UNEXPECTED("Failed to map " + std::to_string(mapped_size_) +
+                             " bytes of shared memory for a generator worker, errno: " + std::to_string(errno));
+  }
+  mem_ = mem;
+  header_ = new (mem_) Header();
+  header_->tail.store(0);
+  header_->head.store(0);
+  header_->closed.store(0);
+  header_->consumer_pid = getpid();
+  header_->producer_pid.store(0);
+  slots_ = static_cast<uint8_t *>(mem_) + header_size;
+  return Status::OK();
+}
+
+Status SharedRowRing::AcquireSlot(uint8_t **slot) {
+  if (header_->producer_pid.load(std::memory_order_relaxed) == 0) {
+    header_->producer_pid.store(getpid(), std::memory_order_relaxed);
+  }
+  uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+  int32_t count = 0;
+  while (tail - header_->head.load(std::memory_order_acquire) >= static_cast<uint64_t>(num_slots_)) {
+    if (header_->closed.load(std::memory_order_acquire) != 0 || ConsumerExited()) {
+      return Status(StatusCode::kInterrupted, __LINE__, __FILE__, "The shared ring is closed.");
+    }
+    Backoff(&count);
+  }
+  *slot = Slot(tail);
+  return Status::OK();
+}
+
+void SharedRowRing::PublishSlot() {
+  header_->tail.store(header_->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+Status SharedRowRing::PushRow(const std::vector<ColumnView> &columns) {
+  int64_t row_size = AlignUp(sizeof(SlotHeader));
+  for (const auto &col : columns) {
+    row_size += ColumnDataOffset(static_cast<int32_t>(col.shape.size())) + AlignUp(col.nbytes);
+  }
+  if (row_size > slot_size_) {
+    RETURN_STATUS_UNEXPECTED("A row of " + std::to_string(row_size) + " bytes exceeds the " +
+                             std::to_string(slot_size_) + " bytes of a slot of the shared ring, raise max_rowsize.");
+  }
+  uint8_t *slot = nullptr;
+  RETURN_IF_NOT_OK(AcquireSlot(&slot));
+  auto *slot_header = reinterpret_cast<SlotHeader *>(slot);
+  slot_header->kind = static_cast<int32_t>(SlotKind::kRow);
+  slot_header->num_columns = static_cast<int32_t>(columns.size());
+  slot_header->payload_size = 0;
+  uint8_t *cur = slot + AlignUp(sizeof(SlotHeader));
+  for (const auto &col : columns) {
+    auto *col_header = reinterpret_cast<ColumnHeader *>(cur);
+    col_header->type = static_cast<int32_t>(col.type.value());
+    col_header->rank = static_cast<int32_t>(col.shape.size());
+    col_header->nbytes = col.nbytes;
+    auto *dims = reinterpret_cast<int64_t *>(cur + sizeof(ColumnHeader));
+    std::copy(col.shape.begin(), col.shape.end(), dims);
+    cur += ColumnDataOffset(col_header->rank);
+    if (col.nbytes > 0) {
+      (void)std::memcpy(cur, col.data, col.nbytes);
+    }
+    cur += AlignUp(col.nbytes);
+  }
+  PublishSlot();
+  return Status::OK();
+}
+
+Status SharedRowRing::PushPayload(SlotKind kind, const std::string &payload) {
+  CHECK_FAIL_RETURN_UNEXPECTED(kind == SlotKind::kPickledRow || kind == SlotKind::kError,
+                               "Invalid kind of a payload of the shared ring.");
+  int64_t size = AlignUp(sizeof(SlotHeader)) + static_cast<int64_t>(payload.size());
+  size_t length = payload.size();
+  if (size > slot_size_) {
+    if (kind == SlotKind::kPickledRow) {
+      RETURN_STATUS_UNEXPECTED("A pickled row of " + std::to_string(size) + " bytes exceeds the " +
+                               std::to_string(slot_size_) + " bytes of a slot of the shared ring, raise max_rowsize.");
+    }
+    // An error message is cut to fit rather than lost
+    length = static_cast<size_t>(slot_size_ - AlignUp(sizeof(SlotHeader)));
+  }
+  uint8_t *slot = nullptr;
+  RETURN_IF_NOT_OK(AcquireSlot(&slot));
+  auto *slot_header = reinterpret_cast<SlotHeader *>(slot);
+  slot_header->kind = static_cast<int32_t>(kind);
+  slot_header->num_columns = 0;
+  slot_header->payload_size = static_cast<int64_t>(length);
+  (void)std::memcpy(slot + AlignUp(sizeof(SlotHeader)), payload.data(), length);
+  PublishSlot();
+  return Status::OK();
+}
+
+Status SharedRowRing::PushEoe() {
+  uint8_t *slot = nullptr;
+  RETURN_IF_NOT_OK(AcquireSlot(&slot));
+  auto *slot_header = reinterpret_cast<SlotHeader *>(slot);
+  slot_header->kind = static_cast<int32_t>(SlotKind::kEoe);
+  slot_header->num_columns = 0;
+  slot_header->payload_size = 0;
+  PublishSlot();
+  return Status::OK();
+}
+
+Status SharedRowRing::Pop(SlotKind *kind, TensorRow *row, std::string *payload) {
+  RETURN_UNEXPECTED_IF_NULL(kind);
+  RETURN_UNEXPECTED_IF_NULL(row);
+  RETURN_UNEXPECTED_IF_NULL(payload);
+  uint64_t head = header_->head.load(std::memory_order_relaxed);
+  int32_t count = 0;
+  while (header_->tail.load(std::memory_order_acquire) == head) {
+    RETURN_IF_INTERRUPTED();
+    CHECK_FAIL_RETURN_UNEXPECTED(header_->closed.load(std::memory_order_acquire) == 0, "The shared ring is closed.");
+    int32_t exit_status = 0;
+    if (count > kSpinCount && (count - kSpinCount) % kLivenessCheckInterval == 0 && ProducerExited(&exit_status)) {
+      RETURN_STATUS_UNEXPECTED("Generator worker process exited unexpectedly, exit status: " +
+                               std::to_string(exit_status));
+    }
+    Backoff(&count);
+  }
+  const uint8_t *slot = Slot(head);
+  const auto *slot_header = reinterpret_cast<const SlotHeader *>(slot);
+  *kind = static_cast<SlotKind>(slot_header->kind);
+  row->clear();
+  payload->clear();
+  const uint8_t *cur = slot + AlignUp(sizeof(SlotHeader));
+  if (*kind == SlotKind::kRow) {
+    for (int32_t i = 0; i < slot_header->num_columns; i++) {
+      const auto *col_header = reinterpret_cast<const ColumnHeader *>(cur);
+      const auto *dims = reinterpret_cast<const int64_t *>(cur + sizeof(ColumnHeader));
+      TensorShape shape(std::vector<dsize_t>(dims, dims + col_header->rank));
+      cur += ColumnDataOffset(col_header->rank);
+      std::shared_ptr<Tensor> tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(shape, DataType(static_cast<DataType::Type>(col_header->type)), cur,
+                                                col_header->nbytes, &tensor));
+      row->push_back(std::move(tensor));
+      cur += AlignUp(col_header->nbytes);
+    }
+  } else if (*kind == SlotKind::kPickledRow || *kind == SlotKind::kError) {
+    payload->assign(reinterpret_cast<const char *>(cur), slot_header->payload_size);
+  }
+  header_->head.store(head + 1, std::memory_order_release);
+  return Status::OK();
+}
+
+void SharedRowRing::SetProducer(pid_t pid) { header_->producer_pid.store(pid, std::memory_order_relaxed); }
+
+void SharedRowRing::Close() { header_->closed.store(1, std::memory_order_release); }
+
+int64_t SharedRowRing::size() const {
+  uint64_t head = header_->head.load(std::memory_order_relaxed);
+  return static_cast<int64_t>(header_->tail.load(std::memory_order_relaxed) - head);
+}
+
+bool SharedRowRing::ConsumerExited() const {
+  // A producer thread of the creating process itself never sees it gone
+  return getpid() != header_->consumer_pid && getppid() != header_->consumer_pid;
+}
+
+bool SharedRowRing::ProducerExited(int32_t *exit_status) const {
+  pid_t pid = header_->producer_pid.load(std::memory_order_relaxed);
+  if (pid == 0) {
+    return false;
+  }
+  siginfo_t info;
+  info.si_pid = 0;
+  // WNOWAIT leaves the worker to be reaped by whoever started it
+  if (waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT) != 0 || info.si_pid != pid) {
+    return false;
+  }
+  *exit_status = info.si_status;
+  return true;
+}
+}  // namespace dataset
+}  // namespace mindspore
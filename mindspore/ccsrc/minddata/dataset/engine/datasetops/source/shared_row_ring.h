@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SHARED_ROW_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SHARED_ROW_RING_H_
+
+#include <sys/types.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// SharedRowRing is a bounded ring of rows in memory shared between the process that creates it and the processes
+// it forks afterwards. One forked worker process pushes rows into it and one thread of the creating process pops them,
+// so the rows of a generator worker reach the pipeline with a plain copy instead of being pickled through a pipe.
+// Each slot of the ring holds one row: the type, the shape and the bytes of every column. A row that has a column
+// which is not numeric is held as a pickled payload instead, the consumer unpickles it.
+// The ring can be closed by either side, a producer waiting for a free slot then gives up.
+class SharedRowRing {
+ public:
+  // What a slot holds
+  enum class SlotKind : int32_t { kRow = 0, kPickledRow = 1, kEoe = 2, kError = 3 };
+
+  // A column to push, the data is not owned
+  struct ColumnView {
+    DataType type;
+    std::vector<dsize_t> shape;
+    const void *data = nullptr;
+    int64_t nbytes = 0;
+  };
+
+  // Create a ring and map its memory, to be called before the worker processes are forked.
+  // @param num_slots - number of rows the ring holds
+  // @param slot_size - maximum size in bytes of a row including its metadata
+  // @param out - the created ring
+  // @return Status - The error code return
+  static Status CreateSharedRowRing(int32_t num_slots, int64_t slot_size, std::shared_ptr<SharedRowRing> *out);
+
+  SharedRowRing(int32_t num_slots, int64_t slot_size);
+
+  ~SharedRowRing();
+
+  SharedRowRing(const SharedRowRing &) = delete;
+  SharedRowRing &operator=(const SharedRowRing &) = delete;
+
+  // Producer side, called from the worker process. Every push waits for a free slot and returns kInterrupted if the
+  // ring is closed meanwhile.
+  // @param columns - the columns of the row
+  // @return Status - The error code return, an error if the row does not fit in a slot
+  Status PushRow(const std::vector<ColumnView> &columns);
+
+  // Push a payload that is not a row of columns: a pickled row or an error message.
+  // @param kind - kPickledRow or kError
+  // @param payload - the bytes to push
+  // @return Status - The error code return
+  Status PushPayload(SlotKind kind, const std::string &payload);
+
+  // Push the end of the epoch of the worker.
+  // @return Status - The error code return
+  Status PushEoe();
+
+  // Consumer side. Wait for the next slot, copy it out and release it. Waiting stops on interrupt, and with an error
+  // if the ring is closed or the worker process exits.
+  // @param kind - what the slot held
+  // @param row - the columns, for kRow
+  // @param payload - the bytes, for kPickledRow and kError
+  // @return Status - The error code return
+  Status Pop(SlotKind *kind, TensorRow *row, std::string *payload);
+
+  // Set the worker process pushing into the ring, so that Pop notices it exiting even before its first push. To be
+  // called by the creating process right after the worker is started, the worker sets itself otherwise.
+  // @param pid - the process id of the worker
+  void SetProducer(pid_t pid);
+
+  // Close the ring from either side
+  void Close();
+
+  // @return int64_t - number of rows held
+  int64_t size() const;
+
+  int32_t num_slots() const { return num_slots_; }
+
+  int64_t slot_size() const { return slot_size_; }
+
+ private:
+  // Indices of the ring, at the start of the shared memory
+  struct Header {
+    alignas(64) std::atomic<uint64_t> tail;  // Slots filled by the producer
+    alignas(64) std::atomic<uint64_t> head;  // Slots released by the consumer
+    alignas(64) std::atomic<int32_t> closed;
+    pid_t consumer_pid;               // The process that created the ring
+    std::atomic<pid_t> producer_pid;  // The worker process, once it is started or it pushed
+  };
+
+  // Map the shared memory and set up the header
+  // @return Status - The error code return
+  Status Init();
+
+  // Wait for a free slot and return it
+  // @param slot - the free slot
+  // @return Status - The error code return
+  Status AcquireSlot(uint8_t **slot);
+
+  // Make the slot acquired last visible to the consumer
+  void PublishSlot();
+
+  // Whether the process that created the ring is gone, seen from the worker process
+  bool ConsumerExited() const;
+
+  // Whether the worker process of the ring exited, the process is not reaped.
+  // @param exit_status - set to the exit status or signal of the worker if it exited
+  bool ProducerExited(int32_t *exit_status) const;
+
+  uint8_t *Slot(uint64_t index) const { return slots_ + (index % num_slots_) * slot_size_; }
+
+  int32_t num_slots_;
+  int64_t slot_size_;
+  size_t mapped_size_;
+  void *mem_;
+  Header *header_;
+  uint8_t *slots_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SHARED_ROW_RING_H_
@@ -0,0 +1,206 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// field numbers in example.proto and feature.proto
+constexpr uint32_t kExampleFeaturesField = 1;  // Example.features
+constexpr uint32_t kFeaturesMapField = 1;      // Features.feature, a map entry per feature
+constexpr uint32_t kMapKeyField = 1;
+constexpr uint32_t kMapValueField = 2;
+}  // namespace
+
+TFExampleParser::TFExampleParser(const std::vector<std::string> &feature_names) : feature_names_(feature_names) {
+  // The names are not touched any more, so the views stay valid
+  for (size_t i = 0; i < feature_names_.size(); ++i) {
+    feature_ids_[feature_names_[i]] = i;
+  }
+}
+
+Status TFExampleParser::Parse(std::string_view record, std::vector<Feature> *features) const {
+  RETURN_UNEXPECTED_IF_NULL(features);
+  features->assign(feature_names_.size(), Feature());
+  WireReader reader(record);
+  uint32_t field = 0, wire_type = 0;
+  while (!reader.AtEnd()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), "Invalid data, malformed Example.");
+    if (field == kExampleFeaturesField && wire_type == WireReader::kLengthDelimited) {
+      // a repeated message field is merged, so the features of every occurrence count
+      std::string_view data;
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&data), "Invalid data, malformed Example.");
+      RETURN_IF_NOT_OK(ParseFeatures(data, features));
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed Example.");
+    }
+  }
+  return Status::OK();
+}
+
+Status TFExampleParser::ParseFeatures(std::string_view data, std::vector<Feature> *features) const {
+  WireReader reader(data);
+  uint32_t field = 0, wire_type = 0;
+  while (!reader.AtEnd()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), "Invalid data, malformed Features.");
+    if (field != kFeaturesMapField || wire_type != WireReader::kLengthDelimited) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed Features.");
+      continue;
+    }
+    std::string_view entry;
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&entry), "Invalid data, malformed Features.");
+    // Only the key is read here, the value is kept as it is unless the feature is asked for
+    std::string_view key;
+    std::vector<std::string_view> values;
+    WireReader entry_reader(entry);
+    while (!entry_reader.AtEnd()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.ReadTag(&field, &wire_type), "Invalid data, malformed Features.");
+      if (field == kMapKeyField && wire_type == WireReader::kLengthDelimited) {
+        CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.ReadLengthDelimited(&key), "Invalid data, malformed Features.");
+      } else if (field == kMapValueField && wire_type == WireReader::kLengthDelimited) {
+        std::string_view value;
+        CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.ReadLengthDelimited(&value), "Invalid data, malformed Features.");
+        values.push_back(value);
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(entry_reader.Skip(wire_type), "Invalid data, malformed Features.");
+      }
+    }
+    auto itr = feature_ids_.find(key);
+    if (itr == feature_ids_.end()) {
+      continue;
+    }
+    // The last entry of a key wins, as it does in a protobuf map
+    Feature &feature = (*features)[itr->second];
+    feature = Feature();
+    feature.found = true;
+    for (const auto &value : values) {
+      RETURN_IF_NOT_OK(ParseFeature(value, &feature));
+    }
+  }
+  return Status::OK();
+}
+
+Status TFExampleParser::ParseFeature(std::string_view data, Feature *feature) {
+  WireReader reader(data);
+  uint32_t field = 0, wire_type = 0;
+  while (!reader.AtEnd()) {
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), "Invalid data, malformed Feature.");
+    auto kind = static_cast<FeatureKind>(field);
+    if ((kind == FeatureKind::kBytesList || kind == FeatureKind::kFloatList || kind == FeatureKind::kInt64List) &&
+        wire_type == WireReader::kLengthDelimited) {
+      std::string_view list;
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&list), "Invalid data, malformed Feature.");
+      // Setting another member of the oneof clears the previous one, the same member is merged
+      if (kind != feature->kind) {
+        feature->kind = kind;
+        feature->lists.clear();
+      }
+      feature->lists.push_back(list);
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed Feature.");
+    }
+  }
+  return Status::OK();
+}
+
+Status TFExampleParser::CountValues(const Feature &feature, int64_t *count, int64_t *max_bytes) {
+  RETURN_UNEXPECTED_IF_NULL(count);
+  RETURN_UNEXPECTED_IF_NULL(max_bytes);
+  *count = 0;
+  *max_bytes = 0;
+  for (const auto &list : feature.lists) {
+    WireReader reader(list);
+    uint32_t field = 0, wire_type = 0;
+    while (!reader.AtEnd()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), "Invalid data, malformed feature list.");
+      if (field != kValueField) {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed feature list.");
+        continue;
+      }
+      std::string_view value;
+      if (feature.kind == FeatureKind::kBytesList && wire_type == WireReader::kLengthDelimited) {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&value), "Invalid data, malformed bytes list.");
+        *max_bytes = std::max(*max_bytes, static_cast<int64_t>(value.size()));
+        (*count)++;
+      } else if (feature.kind == FeatureKind::kFloatList && wire_type == WireReader::kLengthDelimited) {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&value) && value.size() % sizeof(float) == 0,
+                                     "Invalid data, malformed float list.");
+        *count += value.size() / sizeof(float);
+      } else if (feature.kind == FeatureKind::kInt64List && wire_type == WireReader::kLengthDelimited) {
+        // every varint ends with a byte that has the high bit clear
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&value), "Invalid data, malformed int64 list.");
+        *count += std::count_if(value.begin(), value.end(), [](char c) { return (c & 0x80) == 0; });
+      } else {
+        // a value that is not packed
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed feature list.");
+        (*count)++;
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status TFExampleParser::GetBytes(const Feature &feature, std::vector<std::string_view> *values) {
+  RETURN_UNEXPECTED_IF_NULL(values);
+  values->clear();
+  for (const auto &list : feature.lists) {
+    WireReader reader(list);
+    uint32_t field = 0, wire_type = 0;
+    while (!reader.AtEnd()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), "Invalid data, malformed bytes list.");
+      if (field == kValueField && wire_type == WireReader::kLengthDelimited) {
+        std::string_view value;
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&value), "Invalid data, malformed bytes list.");
+        values->push_back(value);
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed bytes list.");
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status TFExampleParser::GetFloats(const Feature &feature, float *out, int64_t count) {
+  int64_t i = 0;
+  for (const auto &list : feature.lists) {
+    WireReader reader(list);
+    uint32_t field = 0, wire_type = 0;
+    while (!reader.AtEnd()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), "Invalid data, malformed float list.");
+      if (field == kValueField && wire_type == WireReader::kLengthDelimited) {  // packed
+        std::string_view packed;
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&packed), "Invalid data, malformed float list.");
+        int64_t n = std::min(static_cast<int64_t>(packed.size() / sizeof(float)), count - i);
+        // fixed32 values are little endian on the wire, like the floats of the hosts we run on
+        if (n > 0) (void)std::memcpy(out + i, packed.data(), n * sizeof(float));
+        i += n;
+      } else if (field == kValueField && wire_type == WireReader::kFixed32) {
+        uint32_t bits = 0;
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadFixed32(&bits), "Invalid data, malformed float list.");
+        if (i < count) (void)std::memcpy(out + i++, &bits, sizeof(float));
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed float list.");
+      }
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(i == count, "Invalid data, malformed float list.");
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Parses serialized tf.Example records (core/example.proto) straight from the protobuf wire format.
+/// A record is scanned once and only the features that are asked for are kept, as views into the record. Their values
+/// are decoded later, directly into the buffers of the output tensors, so no protobuf message is ever built.
+class TFExampleParser {
+ public:
+  /// \brief The kind of a feature, the field numbers of the oneof in dataengine::Feature
+  enum class FeatureKind : uint8_t { kNotSet = 0, kBytesList = 1, kFloatList = 2, kInt64List = 3 };
+
+  /// \brief A feature found in a record. The values are not decoded, only the list messages holding them are kept.
+  struct Feature {
+    bool found = false;
+    FeatureKind kind = FeatureKind::kNotSet;
+    std::vector<std::string_view> lists;  // more than one if the list message is repeated, protobuf merges them
+  };
+
+  /// \brief Reads the protobuf wire format from a buffer
+  class WireReader {
+   public:
+    explicit WireReader(std::string_view data)
+        : ptr_(reinterpret_cast<const uint8_t *>(data.data())), end_(ptr_ + data.size()) {}
+
+    bool AtEnd() const { return ptr_ >= end_; }
+
+    bool ReadVarint(uint64_t *value) {
+      *value = 0;
+      for (int shift = 0; shift < 64 && ptr_ < end_; shift += 7) {
+        uint8_t byte = *ptr_++;
+        *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+      }
+      return false;
+    }
+
+    bool ReadTag(uint32_t *field, uint32_t *wire_type) {
+      uint64_t tag = 0;
+      if (!ReadVarint(&tag)) return false;
+      *field = static_cast<uint32_t>(tag >> 3);
+      *wire_type = static_cast<uint32_t>(tag & 0x7);
+      return true;
+    }
+
+    bool ReadFixed32(uint32_t *value) {
+      if (end_ - ptr_ < 4) return false;
+      *value = static_cast<uint32_t>(ptr_[0]) | static_cast<uint32_t>(ptr_[1]) << 8 |
+               static_cast<uint32_t>(ptr_[2]) << 16 | static_cast<uint32_t>(ptr_[3]) << 24;
+      ptr_ += 4;
+      return true;
+    }
+
+    bool ReadLengthDelimited(std::string_view *value) {
+      uint64_t len = 0;
+      if (!ReadVarint(&len) || len > static_cast<uint64_t>(end_ - ptr_)) return false;
+      *value = std::string_view(reinterpret_cast<const char *>(ptr_), len);
+      ptr_ += len;
+      return true;
+    }
+
+    bool Skip(uint32_t wire_type) {
+      uint64_t value = 0;
+      std::string_view unused;
+      switch (wire_type) {
+        case kVarint:
+          return ReadVarint(&value);
+        case kFixed64:
+          if (end_ - ptr_ < 8) return false;
+          ptr_ += 8;
+          return true;
+        case kLengthDelimited:
+          return ReadLengthDelimited(&unused);
+        case kFixed32:
+          if (end_ - ptr_ < 4) return false;
+          ptr_ += 4;
+          return true;
+        default:  // groups are not used by the Example protos
+          return false;
+      }
+    }
+
+    static constexpr uint32_t kVarint = 0;
+    static constexpr uint32_t kFixed64 = 1;
+    static constexpr uint32_t kLengthDelimited = 2;
+    static constexpr uint32_t kFixed32 = 5;
+
+   private:
+    const uint8_t *ptr_;
+    const uint8_t *end_;
+  };
+
+  /// \brief Constructor
+  /// \param[in] feature_names The features to keep, the others are skipped
+  explicit TFExampleParser(const std::vector<std::string> &feature_names);
+
+  ~TFExampleParser() = default;
+
+  // The lookup table holds views of the names
+  TFExampleParser(const TFExampleParser &) = delete;
+
+  TFExampleParser &operator=(const TFExampleParser &) = delete;
+
+  /// \brief Scans a serialized Example and finds the features to keep
+  /// \param[in] record The serialized Example, the features point into it
+  /// \param[out] features One feature per name given to the constructor, in the same order
+  /// \return Status code
+  Status Parse(std::string_view record, std::vector<Feature> *features) const;
+
+  /// \brief Counts the values of a feature, and for a bytes list the size of the longest one too
+  /// \param[in] feature The feature
+  /// \param[out] count Number of values
+  /// \param[out] max_bytes Size of the longest bytes value, 0 for the other kinds
+  /// \return Status code
+  static Status CountValues(const Feature &feature, int64_t *count, int64_t *max_bytes);
+
+  /// \brief Decodes the values of a bytes list
+  static Status GetBytes(const Feature &feature, std::vector<std::string_view> *values);
+
+  /// \brief Decodes the first count values of a float list into a buffer of count floats, the list must hold at
+  ///     least count values
+  static Status GetFloats(const Feature &feature, float *out, int64_t count);
+
+  /// \brief Decodes the first count values of an int64 list into a buffer of count values of type T, the list must
+  ///     hold at least count values
+  template <typename T>
+  static Status GetInts(const Feature &feature, T *out, int64_t count) {
+    int64_t i = 0;
+    for (const auto &list : feature.lists) {
+      WireReader reader(list);
+      uint32_t field = 0, wire_type = 0;
+      while (!reader.AtEnd()) {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), "Invalid data, malformed int64 list.");
+        uint64_t value = 0;
+        if (field == kValueField && wire_type == WireReader::kLengthDelimited) {  // packed
+          std::string_view packed;
+          CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&packed), "Invalid data, malformed int64 list.");
+          WireReader values(packed);
+          while (!values.AtEnd()) {
+            CHECK_FAIL_RETURN_UNEXPECTED(values.ReadVarint(&value), "Invalid data, malformed int64 list.");
+            if (i < count) out[i++] = static_cast<T>(static_cast<int64_t>(value));
+          }
+        } else if (field == kValueField && wire_type == WireReader::kVarint) {
+          CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadVarint(&value), "Invalid data, malformed int64 list.");
+          if (i < count) out[i++] = static_cast<T>(static_cast<int64_t>(value));
+        } else {
+          CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), "Invalid data, malformed int64 list.");
+        }
+      }
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(i == count, "Invalid data, malformed int64 list.");
+    return Status::OK();
+  }
+
+ private:
+  // field number of the value in BytesList, FloatList and Int64List
+  static constexpr uint32_t kValueField = 1;
+
+  /// \brief Reads a dataengine::Features message and keeps the features that are asked for
+  Status ParseFeatures(std::string_view data, std::vector<Feature> *features) const;
+
+  /// \brief Reads a dataengine::Feature message, merging it into feature
+  static Status ParseFeature(std::string_view data, Feature *feature);
+
+  std::vector<std::string> feature_names_;
+  std::unordered_map<std::string_view, int32_t> feature_ids_;  // views of the names above
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
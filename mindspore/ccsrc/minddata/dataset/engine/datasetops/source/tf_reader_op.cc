@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -31,6 +32,7 @@
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -211,6 +213,28 @@ Status TFReaderOp::Init() {
   return Status::OK();
 }
 
+Status TFReaderOp::ProjectColumns(const std::vector<std::string> &columns, bool *projected) {
+  *projected = false;
+  std::unordered_map<std::string, int32_t> column_name_map;
+  RETURN_IF_NOT_OK(data_schema_->GetColumnNameMap(&column_name_map));
+  // Leave it to the project op to report columns that do not exist
+  for (const auto &column : columns) {
+    if (column_name_map.find(column) == column_name_map.end()) {
+      return Status::OK();
+    }
+  }
+  if (columns.size() == column_name_map.size()) {
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(data_schema_->ProjectColumns(columns));
+  columns_to_load_.clear();
+  for (int32_t i = 0; i < data_schema_->NumColumns(); ++i) {
+    columns_to_load_.push_back(data_schema_->column(i).name());
+  }
+  *projected = true;
+  return Status::OK();
+}
+
 Status TFReaderOp::CalculateNumRowsPerShard() {
   if (!equal_rows_per_shard_) {
     return Status::OK();
@@ -576,6 +600,15 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
   std::unique_ptr<DataBuffer> current_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> new_tensor_table = std::make_unique<TensorQTable>();
 
+  // Only the columns of the schema are decoded, the other features of a record are skipped
+  std::vector<std::string> column_names;
+  for (int32_t col = 0; col < data_schema_->NumColumns(); ++col) {
+    column_names.push_back(data_schema_->column(col).name());
+  }
+  TFExampleParser parser(column_names);
+  std::vector<TFExampleParser::Feature> features;
+  std::string serialized_example;
+
   while (reader.peek() != EOF) {
     if (!load_jagged_connector_) {
       break;
@@ -589,17 +622,15 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
     // ignore crc header
     (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
 
-    // read serialized Example
-    std::string serialized_example;
+    // read serialized Example, the buffer is reused across records
     serialized_example.resize(record_length);
     (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
     if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Invalid file, failed to parse tfrecord file : " + serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
+      Status rc = parser.Parse(serialized_example, &features);
+      if (rc.IsError()) {
+        RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse tfrecord file: " + filename + ", " + rc.ToString());
       }
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &new_tensor_table, rows_read));
+      RETURN_IF_NOT_OK(LoadExample(features, &new_tensor_table, rows_read));
       rows_read++;
     }
 
@@ -626,22 +657,18 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
 }
 
 // Parses a single row and puts the data into a tensor table.
-Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table,
-                               int64_t row) {
+Status TFReaderOp::LoadExample(const std::vector<TFExampleParser::Feature> &features,
+                               std::unique_ptr<TensorQTable> *tensor_table, int64_t row) {
   int32_t num_columns = data_schema_->NumColumns();
   TensorRow newRow(num_columns, nullptr);
   (*tensor_table)->push_back(std::move(newRow));
 
   for (int32_t col = 0; col < num_columns; ++col) {
     const ColDescriptor current_col = data_schema_->column(col);
-    const dataengine::Features &example_features = tf_file->features();
-    const google::protobuf::Map<std::string, dataengine::Feature> &feature_map = example_features.feature();
-    auto iter_column = feature_map.find(current_col.name());
-    if (iter_column == feature_map.end()) {
+    if (!features[col].found) {
       RETURN_STATUS_UNEXPECTED("Invalid parameter, column name: " + current_col.name() + " does not exist.");
     }
-    const dataengine::Feature &column_values_list = iter_column->second;
-    RETURN_IF_NOT_OK(LoadFeature(tensor_table, column_values_list, current_col, row, col));
+    RETURN_IF_NOT_OK(LoadFeature(tensor_table, features[col], current_col, row, col));
   }
 
   return Status::OK();
@@ -649,46 +676,28 @@ Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, std::unique_p
 
 // Parses a single cell and puts the data into a tensor table.
 Status TFReaderOp::LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table,
-                               const dataengine::Feature &column_values_list, const ColDescriptor &current_col,
+                               const TFExampleParser::Feature &column_values_list, const ColDescriptor &current_col,
                                int64_t row, int32_t col) {
-  const dataengine::Feature::KindCase column_list_type = column_values_list.kind_case();
-  std::unique_ptr<float[]> float_array;     // For staging data from protobuf deserialization
-  const unsigned char *data_ptr = nullptr;  // Generic pointer used for populating the Tensor
-
-  // This variable will point into the above staging variables.
   // Also used for creating shape attributes.
   int32_t num_elements = 0;
 
-  // we build a tensor first a read directly into it if we need to cast
+  // every list decodes its values directly into the tensor it creates
   std::shared_ptr<Tensor> ts;
 
-  // Depending on the type of data from the tf_file, we want to extract 2 things:
-  // 1) A pointer to the data as a const unsigned char *
-  // 2) The number of elements of the data
-  // After those are determined, we can then build the tensor to represent this data.
-  switch (column_list_type) {
-    case dataengine::Feature::KindCase::kBytesList: {
+  switch (column_values_list.kind) {
+    case TFExampleParser::FeatureKind::kBytesList: {
       RETURN_IF_NOT_OK(LoadBytesList(current_col, column_values_list, &num_elements, &ts));
-
       break;
     }
-    case dataengine::Feature::KindCase::kFloatList: {
-      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &float_array));
-
-      data_ptr = reinterpret_cast<const unsigned char *>(float_array.get());
-
-      // only floatList needs to create the tensor here, other two lists read directly
-      // into the tensor
-      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.type(), data_ptr, &ts));
+    case TFExampleParser::FeatureKind::kFloatList: {
+      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &ts));
       break;
     }
-    case dataengine::Feature::KindCase::kInt64List: {
+    case TFExampleParser::FeatureKind::kInt64List: {
       RETURN_IF_NOT_OK(LoadIntListSwitch(current_col, column_values_list, &num_elements, &ts));
       break;
     }
-    case dataengine::Feature::KindCase::KIND_NOT_SET: {
+    case TFExampleParser::FeatureKind::kNotSet: {
       std::string err_msg = "Invalid data, tf_file column type must be uint8, int64 or float32.";
       RETURN_STATUS_UNEXPECTED(err_msg);
     }
@@ -721,7 +730,7 @@ Status TFReaderOp::Reset() {
   return Status::OK();
 }
 
-Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                                  int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   // kBytesList can map to the following DE types ONLY!
   // DE_UINT8, DE_INT8
@@ -733,20 +742,22 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::BytesList &bytes_list = column_values_list.bytes_list();
+  int64_t count = 0;
+  int64_t max_size = 0;
+  RETURN_IF_NOT_OK(TFExampleParser::CountValues(column_values_list, &count, &max_size));
+  std::vector<std::string_view> bytes_list;
+  bytes_list.reserve(count);
+  RETURN_IF_NOT_OK(TFExampleParser::GetBytes(column_values_list, &bytes_list));
 
-  *num_elements = bytes_list.value_size();
+  *num_elements = bytes_list.size();
 
   if (current_col.type() == DataType::DE_STRING) {
     TensorShape shape = TensorShape::CreateScalar();
     RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &shape));
-    RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, shape, tensor));
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(bytes_list, shape, tensor));
     return Status::OK();
   }
 
-  uint64_t max_size = 0;
-  for (uint32_t i = 0; i < bytes_list.value_size(); ++i) max_size = std::max(max_size, bytes_list.value(i).size());
-
   int64_t pad_size = max_size;
 
   // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
@@ -777,13 +788,36 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
   // know how many elements there are and the total bytes, create tensor here:
   TensorShape current_shape = TensorShape::CreateScalar();
   RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, current_shape, current_col.type(), pad_size, tensor));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+
+  // copy every value into its slot of pad_size bytes, padded with spaces
+  if ((*tensor)->Size() > 0) {
+    auto *current_tensor_addr = reinterpret_cast<char *>(&*(*tensor)->begin<uint8_t>());
+    int64_t tensor_bytes_remaining = (*tensor)->SizeInBytes();
+    for (const auto &current_element : bytes_list) {
+      int64_t element_size = current_element.size();
+      CHECK_FAIL_RETURN_UNEXPECTED(element_size <= pad_size && pad_size <= tensor_bytes_remaining,
+                                   "Invalid data, bytesList element does not fit into the Tensor.");
+      if (element_size > 0) {
+        int return_code =
+          memcpy_s(current_tensor_addr, tensor_bytes_remaining, current_element.data(), current_element.size());
+        CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memcpy_s failed when reading bytesList element into Tensor");
+      }
+      if (pad_size > element_size) {
+        int return_code = memset_s(current_tensor_addr + element_size, tensor_bytes_remaining - element_size,
+                                   static_cast<int>(' '), pad_size - element_size);
+        CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memset_s failed when padding Tensor");
+      }
+      current_tensor_addr += pad_size;
+      tensor_bytes_remaining -= pad_size;
+    }
+  }
 
   return Status::OK();
 }
 
-Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::unique_ptr<float[]> *float_array) {
+Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
+                                 int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   // KFloatList can only map to DE types:
   // DE_FLOAT32
   if (current_col.type() != DataType::DE_FLOAT32) {
@@ -792,22 +826,29 @@ Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataeng
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::FloatList &float_list = column_values_list.float_list();
+  // Identify how many values we have and then decode them straight into the tensor
+  int64_t count = 0;
+  int64_t unused = 0;
+  RETURN_IF_NOT_OK(TFExampleParser::CountValues(column_values_list, &count, &unused));
+  *num_elements = count;
 
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = float_list.value_size();
-  *float_array = std::make_unique<float[]>(*num_elements);
-  for (int i = 0; i < float_list.value_size(); ++i) {
-    (*float_array)[i] = float_list.value(i);
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+  // A fixed shape keeps the first values of a record holding more of them
+  CHECK_FAIL_RETURN_UNEXPECTED((*tensor)->Size() <= count,
+                               "Invalid data, shape of column: " + current_col.name() + " does not match its values.");
+  if ((*tensor)->Size() > 0) {
+    RETURN_IF_NOT_OK(TFExampleParser::GetFloats(column_values_list, &*(*tensor)->begin<float>(), (*tensor)->Size()));
   }
 
   return Status::OK();
 }
 
 // Determines which template type to use and calls LoadIntList
-Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                     int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
+Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col,
+                                     const TFExampleParser::Feature &column_values_list, int32_t *num_elements,
+                                     std::shared_ptr<Tensor> *tensor) {
   if (current_col.type() == DataType::DE_UINT64) {
     RETURN_IF_NOT_OK(LoadIntList<uint64_t>(current_col, column_values_list, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_INT64) {
@@ -837,7 +878,7 @@ Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dat
 // Reads values from a bytes list and casts the value to type T, must be an integral type
 // compatible with int64_t
 template <typename T>
-Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                                int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   if (!(current_col.type().IsInt())) {
     std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
@@ -845,22 +886,21 @@ Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengin
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::Int64List &int64_list = column_values_list.int64_list();
-
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = int64_list.value_size();
+  // Identify how many values we have and then decode them straight into the tensor
+  int64_t count = 0;
+  int64_t unused = 0;
+  RETURN_IF_NOT_OK(TFExampleParser::CountValues(column_values_list, &count, &unused));
+  *num_elements = count;
 
   // know how many elements there are, create tensor here:
   TensorShape current_shape = TensorShape::CreateUnknownRankShape();
   RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
   RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
-
-  int64_t i = 0;
-  auto it = (*tensor)->begin<T>();
-  for (; it != (*tensor)->end<T>(); i++, ++it) {
-    T element = static_cast<T>(int64_list.value(i));
-    *it = element;
+  // A fixed shape keeps the first values of a record holding more of them
+  CHECK_FAIL_RETURN_UNEXPECTED((*tensor)->Size() <= count,
+                               "Invalid data, shape of column: " + current_col.name() + " does not match its values.");
+  if ((*tensor)->Size() > 0) {
+    RETURN_IF_NOT_OK(TFExampleParser::GetInts<T>(column_values_list, &*(*tensor)->begin<T>(), (*tensor)->Size()));
   }
 
   return Status::OK();
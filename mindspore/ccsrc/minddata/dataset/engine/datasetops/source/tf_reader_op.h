@@ -31,12 +31,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
-
-namespace dataengine {
-class Example;
-class Feature;
-class BytesList;
-}  // namespace dataengine
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 
 namespace mindspore {
 namespace dataset {
@@ -207,6 +202,13 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status Init();
 
+  // Restricts the schema to the given columns, so that the other features are never converted to tensors.
+  // Nothing is changed if a column is not in the schema.
+  // @param columns - the names of the columns to keep, without duplicates
+  // @param projected - set to true if the schema has been changed
+  // @return Status - the error code returned.
+  Status ProjectColumns(const std::vector<std::string> &columns, bool *projected);
+
   // Class functor operator () override.
   // All dataset operators operate by launching a thread (see ExecutionTree). This class functor will
   // provide the master loop that drives the logic for performing the work
@@ -307,36 +309,38 @@ class TFReaderOp : public ParallelOp {
                   const int32_t &worker_id);
 
   // Parses a single row and puts the data into a tensor table.
-  // @param tf_file - the row to be parsed.
+  // @param features - the features of the row, one per column of the schema.
   // @param tensor_table - the tensor table to put the parsed data in.
   // @param row - the id of the row filled in the tensor table.
   // @return Status - the error code returned.
-  Status LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table, int64_t row);
+  Status LoadExample(const std::vector<TFExampleParser::Feature> &features, std::unique_ptr<TensorQTable> *tensor_table,
+                     int64_t row);
 
   // Parses a single cell and puts the data into a tensor table.
   // @param tensor_table - the tensor table to put the parsed data in.
   // @param column_values_list - the cell to parse.
   // @param current_col - the column descriptor containing the expected shape and type of the data.
   // @return Status - the error code returned.
-  Status LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table, const dataengine::Feature &column_values_list,
-                     const ColDescriptor &current_col, int64_t row, int32_t col);
+  Status LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table,
+                     const TFExampleParser::Feature &column_values_list, const ColDescriptor &current_col, int64_t row,
+                     int32_t col);
 
   // Reads values from a bytes list
   // @param current_col - the column descriptor containing the expected shape and type of the data.
   // @param column_values_list - the cell that contains the bytes list to read from.
   // @param elementStr - the string we read the value into.
   // @return Status - the error code returned.
-  static Status LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  static Status LoadBytesList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                               int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   // Reads values from a float list
   // @param current_col - the column descriptor containing the expected shape and type of the data.
   // @param column_values_list - the cell that contains the float list to read from.
   // @Param numElements - number of values in the float list.
-  // @param float_array - the array we read the values into.
+  // @param tensor - the tensor we read the values into.
   // @return Status - the error code returned.
-  Status LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                       int32_t *num_elements, std::unique_ptr<float[]> *float_array);
+  Status LoadFloatList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
+                       int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   // Reads values from a bytes list and casts the value to type T, must be an integral
   // type compatible with int64_t
@@ -346,7 +350,7 @@ class TFReaderOp : public ParallelOp {
   // @param tensor - the tensor we read the values into.
   // @return Status - the error code returned.
   template <typename T>
-  Status LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  Status LoadIntList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                      int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   // Determines which template type to use and calls LoadIntList
@@ -355,7 +359,7 @@ class TFReaderOp : public ParallelOp {
   // @Param numElements - number of values in the int list.
   // @param tensor - the tensor we read the values into.
   // @return Status - the error code returned.
-  Status LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  Status LoadIntListSwitch(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                            int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   // Reads one row of data from a tf file and creates a schema based on that row
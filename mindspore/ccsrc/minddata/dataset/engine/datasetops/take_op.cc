@@ -106,6 +106,13 @@ Status TakeOp::operator()() {
   return Status::OK();
 }
 
+Status TakeOp::SeekRows(int64_t rows) {
+  CHECK_FAIL_RETURN_UNEXPECTED(rows < max_takes_, "Cannot skip " + std::to_string(rows) + " rows, only " +
+                                                    std::to_string(max_takes_) + " rows are taken.");
+  take_count_ = static_cast<int32_t>(rows);
+  return SeekChildrenRows(rows);
+}
+
 // Function FillBuffer mainly prepare the buffer for returning
 Status TakeOp::FillBuffer(std::unique_ptr<DataBuffer> *buffer, std::unique_ptr<DataBuffer> *data_buffer) {
   int32_t buffer_size = (*buffer)->NumRows();
@@ -120,6 +120,14 @@ class ZipOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kZipOp; }
 
+  // The op gives one row per row of each child, so it seeks the rows of its children
+  // @return T/F if the children can seek
+  bool CanSeekRows() override { return ChildrenCanSeekRows(); }
+
+  // @param rows - number of rows to skip
+  // @return Status - The error code return
+  Status SeekRows(int64_t rows) override { return SeekChildrenRows(rows); }
+
   /// \brief Base-class override for GetDatasetSize
   /// \param[out] dataset_size the size of the dataset
   /// \return Status of the function
@@ -20,6 +20,7 @@
 #include <utility>
 #include "minddata/dataset/engine/connector.h"
 #include "minddata/dataset/engine/data_buffer.h"
+#include "minddata/dataset/engine/perf/op_latency.h"
 #include "minddata/dataset/core/constants.h"
 
 namespace mindspore {
@@ -38,14 +39,21 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
 
   // Destructor of DbConnector
-  ~DbConnector() = default;
+  ~DbConnector() override = default;
 
   // Add a unique_ptr<DataBuffer> into the DbConnector.
   // @note The caller of this add method should use std::move to pass the ownership to DbConnector.
   // @param worker_id The id of a worker thread calling this method.
   // @param el A rvalue reference to an element to be passed/added/pushed.
-  Status Add(int32_t worker_id, std::unique_ptr<DataBuffer> &&el) noexcept {
-    return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+  virtual Status Add(int32_t worker_id, std::unique_ptr<DataBuffer> &&el) noexcept {
+    if (producer_latency_ == nullptr) {
+      return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+    }
+    bool is_data = el != nullptr && !el->eoe() && !el->eof();
+    int64_t start_us = OpLatency::NowUs();
+    Status rc = Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el));
+    producer_latency_->RecordOutput(worker_id, start_us, OpLatency::NowUs(), is_data);
+    return rc;
   }
 
   // Get a unique_ptr<DataBuffer> from the DbConnector.
@@ -56,11 +64,13 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param worker_id The id of a worker thread calling this method.
   // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
   // @param retry_if_eoe A flag to allow the same thread invoke pop() again if the current pop returns eoe buffer.
-  Status PopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe = false) noexcept {
+  virtual Status PopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result,
+                              bool retry_if_eoe = false) noexcept {
     if (result == nullptr) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "[ERROR] nullptr detected when getting data from db connector");
     } else {
+      int64_t start_us = consumer_latency_ == nullptr ? 0 : OpLatency::NowUs();
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return (expect_consumer_ == worker_id) || end_of_file_; }));
       // Once an EOF message is encountered this flag will be set and we can return early.
@@ -82,12 +92,28 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       if (!((*result)->eoe() && retry_if_eoe)) {
         expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
       }
+      if (consumer_latency_ != nullptr) {
+        consumer_latency_->RecordInput(worker_id, start_us, OpLatency::NowUs());
+      }
     }
     out_buffers_count_++;
     cv_.NotifyAll();
     return Status::OK();
   }
 
+  // Record the time the producers of this DbConnector wait to add a buffer, see OpLatency.
+  // @param latency The histograms of the op owning this DbConnector, nullptr to stop recording.
+  void SetProducerLatency(OpLatency *latency) { producer_latency_ = latency; }
+
+  // Record the time the consumers of this DbConnector wait to get a buffer, see OpLatency.
+  // @param latency The histograms of the op consuming from this DbConnector, nullptr to stop recording.
+  void SetConsumerLatency(OpLatency *latency) { consumer_latency_ = latency; }
+
+ protected:
+  // Latency histograms of the producing and the consuming ops, only set when profiling.
+  OpLatency *producer_latency_ = nullptr;
+  OpLatency *consumer_latency_ = nullptr;
+
  private:
   // A flag to indicate the end of stream has been encountered.
   bool end_of_file_;
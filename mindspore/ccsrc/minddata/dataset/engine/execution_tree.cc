@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include <iostream>
 #include <string>
+#include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/datasetops/device_queue_op.h"
@@ -27,15 +28,17 @@
 #include "minddata/dataset/engine/opt/post/repeat_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_error_pass.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
+#include "minddata/dataset/engine/opt/optional/projection_pushdown_pass.h"
 #endif
 #include "minddata/dataset/engine/opt/pre/epoch_injection_pass.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
 
 namespace mindspore {
 namespace dataset {
 // Constructor
-ExecutionTree::ExecutionTree() : id_count_(0) {
+ExecutionTree::ExecutionTree() : id_count_(0), numa_node_(-1) {
   tg_ = std::make_unique<TaskGroup>();
   tree_state_ = kDeTStateInit;
   prepare_flags_ = kDePrepNone;
@@ -52,6 +55,9 @@ ExecutionTree::~ExecutionTree() {
   }
 #endif
   (void)tg_->ServiceStop();
+  if (numa_node_ >= 0) {
+    ReportNumaTraffic();
+  }
 }
 
 // Associates a DatasetOp with this tree. This assigns a valid node id to the operator and
@@ -143,6 +149,11 @@ Status ExecutionTree::Launch() {
   std::ostringstream ss;
   ss << *this;
 
+  // Bind before any thread of the tree is created
+  if (GlobalContext::config_manager()->numa_enable()) {
+    RETURN_IF_NOT_OK(BindToNumaNode());
+  }
+
   // Profiling infrastructures need to be initialized before Op launching
   if (profiling_manager_->IsProfilingEnable()) {
     // Setup profiling manager
@@ -151,6 +162,12 @@ Status ExecutionTree::Launch() {
     RETURN_IF_NOT_OK(profiling_manager_->LaunchMonitor());
   }
 
+  // AutoTune samples the connectors of the ops, so it does not depend on the profiling being enabled
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    autotune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune Thread launched", std::ref(*autotune_)));
+  }
+
   MS_LOG(DEBUG) << "Printing the tree before launch tasks:\n" << ss.str();
   for (auto itr = this->begin(); itr != this->end(); ++itr) {
     // An inlined operator is one that has an output connector size of 0, and it does not
@@ -169,6 +186,98 @@ Status ExecutionTree::Launch() {
   return Status::OK();
 }
 
+Status ExecutionTree::SaveState(nlohmann::json *state) {
+  RETURN_UNEXPECTED_IF_NULL(state);
+  for (auto itr = this->begin(); itr != this->end(); ++itr) {
+    nlohmann::json op_state;
+    op_state["name"] = itr->Name();
+    RETURN_IF_NOT_OK(itr->SaveState(&op_state));
+    (*state)[std::to_string(itr->id())] = op_state;
+  }
+  return Status::OK();
+}
+
+Status ExecutionTree::Resume(const nlohmann::json &state, int64_t epochs, int64_t rows, int64_t *rows_to_drop) {
+  RETURN_UNEXPECTED_IF_NULL(rows_to_drop);
+  CHECK_FAIL_RETURN_UNEXPECTED(tree_state_ == kDeTStateReady, "The tree can only resume before it is launched.");
+  CHECK_FAIL_RETURN_UNEXPECTED(epochs >= 0 && rows >= 0, "Invalid position to resume at.");
+  for (auto itr = this->begin(); itr != this->end(); ++itr) {
+    std::string name = itr->Name();
+    // A cache serves the rows of the epochs before, skipping them would leave it empty
+    CHECK_FAIL_RETURN_UNEXPECTED(name != kCacheOp && name != kCacheLookupOp && name != kCacheMergeOp,
+                                 "A pipeline with a cache cannot resume.");
+    auto op_state = state.find(std::to_string(itr->id()));
+    if (op_state != state.end()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(op_state->value("name", "") == name,
+                                   "The saved state is not of this pipeline, operator " + std::to_string(itr->id()) +
+                                     " is " + name + ".");
+      RETURN_IF_NOT_OK(itr->RestoreState(*op_state));
+    }
+  }
+  // Each operator below the epoch control makes op_num_repeats_per_epoch passes an epoch, the ones above make one
+  // pass for the whole run
+  for (auto itr = this->begin(); itr != this->end(); ++itr) {
+    if (epochs > 0 && itr->op_num_repeats_per_epoch() > 0) {
+      RETURN_IF_NOT_OK(itr->SkipPasses(epochs * itr->op_num_repeats_per_epoch()));
+    }
+  }
+  *rows_to_drop = 0;
+  if (rows > 0) {
+    if (root_->CanSeekRows()) {
+      RETURN_IF_NOT_OK(root_->SeekRows(rows));
+    } else {
+      MS_LOG(INFO) << "The pipeline cannot skip the rows of an epoch, " << rows << " rows are read and dropped.";
+      *rows_to_drop = rows;
+    }
+  }
+  return Status::OK();
+}
+
+Status ExecutionTree::BindToNumaNode() {
+  int32_t num_nodes = Numa::NumNodes();
+  if (num_nodes <= 1) {
+    MS_LOG(INFO) << "Single NUMA node, the tree is not bound.";
+    return Status::OK();
+  }
+  // A tree that feeds a device is bound to the node of the device, others stay unbound
+  int32_t device_id = -1;
+  for (auto itr = this->begin(); itr != this->end(); ++itr) {
+    auto device_queue = dynamic_cast<DeviceQueueOp *>(&(*itr));
+    if (device_queue != nullptr) {
+      device_id = device_queue->device_id();
+      break;
+    }
+  }
+  if (device_id < 0) {
+    MS_LOG(INFO) << "The tree does not feed a device, it is not bound to a NUMA node.";
+    return Status::OK();
+  }
+  numa_node_ = device_id % num_nodes;
+  tg_->set_numa_node(numa_node_);
+  if (Numa::GetNodeStat(numa_node_, &numa_stat_at_launch_).IsError()) {
+    numa_stat_at_launch_ = NumaStat();
+  }
+  MS_LOG(INFO) << "The threads of the tree are bound to NUMA node " << numa_node_ << " of " << num_nodes
+               << " for device " << device_id << ".";
+  return Status::OK();
+}
+
+void ExecutionTree::ReportNumaTraffic() const {
+  NumaStat stat;
+  Status rc = Numa::GetNodeStat(numa_node_, &stat);
+  if (rc.IsError()) {
+    MS_LOG(INFO) << "No NUMA traffic report: " << rc.ToString();
+    return;
+  }
+  // The counters are host wide, other processes on the host are included
+  MS_LOG(INFO) << "NUMA node " << numa_node_ << " page allocations while the tree ran: "
+               << stat.numa_hit - numa_stat_at_launch_.numa_hit << " on the intended node, "
+               << stat.numa_foreign - numa_stat_at_launch_.numa_foreign
+               << " intended for it but placed on another node, "
+               << stat.numa_miss - numa_stat_at_launch_.numa_miss << " intended for another node but placed on it, "
+               << stat.other_node - numa_stat_at_launch_.other_node << " made by threads running on another node.";
+}
+
 // A function that traverse the tree in postorder then save the results in nodes
 void ExecutionTree::Iterator::PostOrderTraverse(const std::shared_ptr<DatasetOp> &node) {
   if (node == nullptr) {
@@ -273,10 +382,11 @@ Status ExecutionTree::PrepareTreePostAction() {
 }
 
 Status ExecutionTree::Optimize() {
-  // Vector of optimizations, currently only 1, add more as necessary
+  // Vector of optimizations, add more as necessary
   std::vector<std::unique_ptr<NodePass>> optimizations;
 #ifndef ENABLE_ANDROID
   optimizations.push_back(std::make_unique<TensorOpFusionPass>());
+  optimizations.push_back(std::make_unique<ProjectionPushdownPass>());
 #endif
   // vector of flags for each optimization
   std::vector<bool> modified(optimizations.size(), false);
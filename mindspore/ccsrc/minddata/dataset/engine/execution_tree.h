@@ -22,12 +22,14 @@
 #include <string>
 #include <vector>
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/util/numa.h"
 #include "minddata/dataset/util/status.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/perf/profiling.h"
 
 namespace mindspore {
 namespace dataset {
 // Forward declares
+class AutoTune;
 class TaskGroup;
 class DatasetOp;
 
@@ -121,6 +123,22 @@ class ExecutionTree {
   // @return Status - The error code return
   Status Launch();
 
+  // Save what the operators need to give the same output in another run of the same pipeline, such as their seeds.
+  // Together with the number of rows consumed, it lets the other run resume where this one is.
+  // @param state - the json object to fill, with the state of each operator under its id
+  // @return Status - The error code return
+  Status SaveState(nlohmann::json *state);
+
+  // Move a prepared tree that is not launched yet to where a previous run of the same pipeline left off. Whole
+  // epochs are skipped without reading their rows. The rows of the current epoch are skipped by the operators if
+  // they all can, otherwise the consumer has to drop them.
+  // @param state - the operator states saved by SaveState in the previous run
+  // @param epochs - number of epochs the previous run completed
+  // @param rows - number of rows of the next epoch the previous run consumed
+  // @param rows_to_drop - returned number of rows the consumer has to fetch and drop
+  // @return Status - The error code return
+  Status Resume(const nlohmann::json &state, int64_t epochs, int64_t rows, int64_t *rows_to_drop);
+
   /// A print method typically used for debugging
   /// \param out - The output stream to write output to
   void Print(std::ostream &out, const std::shared_ptr<DatasetOp> &op = nullptr) const;
@@ -253,7 +271,19 @@ class ExecutionTree {
   // @return total number of epochs
   int32_t num_epochs() { return num_epochs_; }
 
+  // Getter function for the NUMA node the tree is bound to
+  // @return The node, -1 if the tree is not bound
+  int32_t numa_node() const { return numa_node_; }
+
  private:
+  // Binds the threads of the tree to the NUMA node of its device, if any, so they and the memory they allocate
+  // stay on one node
+  // @return Status - The error code return
+  Status BindToNumaNode();
+
+  // Logs the page allocations that crossed NUMA nodes since the tree was bound
+  void ReportNumaTraffic() const;
+
   // A helper functions for doing the recursive printing
   // @param dataset_op - The dataset op to print
   // @param indent - an indent string for aligning child levels in output
@@ -269,7 +299,10 @@ class ExecutionTree {
   TreeState tree_state_;                                 // Tracking the current tree state
   int32_t num_epochs_;                                   // Total number of epochs to run for this tree
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::unique_ptr<AutoTune> autotune_;                   // Online pipeline tuning, created if enabled in the config
   bool optimize_;                                        // Flag to enable optional optimizations
+  int32_t numa_node_;                                    // NUMA node the tree is bound to, -1 if not bound
+  NumaStat numa_stat_at_launch_;                         // Page allocation counters of the node at launch
 };
 }  // namespace dataset
 }  // namespace mindspore
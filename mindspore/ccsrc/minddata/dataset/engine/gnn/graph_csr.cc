@@ -0,0 +1,177 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_csr.h"
+
+#include <algorithm>
+#include <string>
+
+#include "minddata/dataset/core/tensor.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+GraphCsr::FeatureColumn::FeatureColumn(const DataType &type, const TensorShape &shape, dsize_t num_items)
+    : type_(type), shape_(shape), row_size_(type.SizeInBytes() * shape.NumOfElements()), rows_(num_items, -1) {}
+
+Status GraphCsr::FeatureColumn::Add(int32_t index, const std::shared_ptr<Tensor> &value) {
+  RETURN_UNEXPECTED_IF_NULL(value);
+  CHECK_FAIL_RETURN_UNEXPECTED(value->type() == type_ && value->shape() == shape_,
+                               "All values of a feature need the same type and shape in CSR storage, got " +
+                                 value->type().ToString() + value->shape().ToString() + " and " + type_.ToString() +
+                                 shape_.ToString());
+  CHECK_FAIL_RETURN_UNEXPECTED(value->SizeInBytes() == row_size_, "Invalid feature value of size " +
+                                                                     std::to_string(value->SizeInBytes()));
+  rows_[index] = static_cast<int32_t>(data_.size() / row_size_);
+  (void)data_.insert(data_.end(), value->GetBuffer(), value->GetBuffer() + row_size_);
+  return Status::OK();
+}
+
+template <typename T>
+Status GraphCsr::AddFeature(const std::shared_ptr<T> &object, int32_t index, FeatureType feature_type,
+                            dsize_t num_items,
+                            std::unordered_map<FeatureType, std::unique_ptr<FeatureColumn>> *columns) {
+  std::shared_ptr<Feature> feature;
+  if (object->GetFeatures(feature_type, &feature).IsError()) {
+    return Status::OK();
+  }
+  std::shared_ptr<Tensor> value = feature->Value();
+  RETURN_UNEXPECTED_IF_NULL(value);
+  auto &column = (*columns)[feature_type];
+  if (column == nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(value->type().IsNumeric(), "CSR storage only supports numeric features, feature " +
+                                                              std::to_string(feature_type) + " is " +
+                                                              value->type().ToString());
+    column = std::make_unique<FeatureColumn>(value->type(), value->shape(), num_items);
+  }
+  return column->Add(index, value);
+}
+
+Status GraphCsr::Build(const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+                       const std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> &edges,
+                       const std::vector<NodeType> &node_types,
+                       const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_features,
+                       const std::unordered_map<EdgeType, std::unordered_set<FeatureType>> &edge_features) {
+  node_ids_.clear();
+  node_ids_.reserve(nodes.size());
+  for (const auto &node : nodes) {
+    node_ids_.push_back(node.first);
+  }
+  std::sort(node_ids_.begin(), node_ids_.end());
+  edge_ids_.clear();
+  edge_ids_.reserve(edges.size());
+  for (const auto &edge : edges) {
+    edge_ids_.push_back(edge.first);
+  }
+  std::sort(edge_ids_.begin(), edge_ids_.end());
+  auto num_nodes = static_cast<dsize_t>(node_ids_.size());
+  auto num_edges = static_cast<dsize_t>(edge_ids_.size());
+
+  // Neighbors, one CSR per neighbor type
+  std::vector<NodeIdType> neighbors;
+  for (auto neighbor_type : node_types) {
+    Adjacency adjacency;
+    adjacency.offsets.reserve(num_nodes + 1);
+    adjacency.offsets.push_back(0);
+    for (auto id : node_ids_) {
+      RETURN_IF_NOT_OK(nodes.at(id)->GetAllNeighbors(neighbor_type, &neighbors, true));
+      for (auto neighbor : neighbors) {
+        int32_t neighbor_index = 0;
+        RETURN_IF_NOT_OK(GetNodeIndex(neighbor, &neighbor_index));
+        adjacency.neighbors.push_back(neighbor_index);
+      }
+      adjacency.offsets.push_back(static_cast<int64_t>(adjacency.neighbors.size()));
+    }
+    if (!adjacency.neighbors.empty()) {
+      adjacency.neighbors.shrink_to_fit();
+      adjacency_[neighbor_type] = std::move(adjacency);
+    }
+  }
+
+  for (int32_t i = 0; i < num_nodes; ++i) {
+    const std::shared_ptr<Node> &node = nodes.at(node_ids_[i]);
+    auto itr = node_features.find(node->type());
+    if (itr == node_features.end()) continue;
+    for (auto feature_type : itr->second) {
+      RETURN_IF_NOT_OK(AddFeature(node, i, feature_type, num_nodes, &node_features_));
+    }
+  }
+
+  edge_src_.resize(num_edges);
+  edge_dst_.resize(num_edges);
+  for (int32_t i = 0; i < num_edges; ++i) {
+    const std::shared_ptr<Edge> &edge = edges.at(edge_ids_[i]);
+    std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> edge_nodes;
+    RETURN_IF_NOT_OK(edge->GetNode(&edge_nodes));
+    RETURN_IF_NOT_OK(GetNodeIndex(edge_nodes.first->id(), &edge_src_[i]));
+    RETURN_IF_NOT_OK(GetNodeIndex(edge_nodes.second->id(), &edge_dst_[i]));
+    auto itr = edge_features.find(edge->type());
+    if (itr == edge_features.end()) continue;
+    for (auto feature_type : itr->second) {
+      RETURN_IF_NOT_OK(AddFeature(edge, i, feature_type, num_edges, &edge_features_));
+    }
+  }
+  for (auto &column : node_features_) column.second->ShrinkToFit();
+  for (auto &column : edge_features_) column.second->ShrinkToFit();
+  MS_LOG(INFO) << "CSR storage of " << num_nodes << " nodes and " << num_edges << " edges uses " << MemoryUsage()
+               << " bytes.";
+  return Status::OK();
+}
+
+Status GraphCsr::GetNodeIndex(NodeIdType id, int32_t *index) const {
+  auto itr = std::lower_bound(node_ids_.begin(), node_ids_.end(), id);
+  if (itr == node_ids_.end() || *itr != id) {
+    std::string err_msg = "Invalid node id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  *index = static_cast<int32_t>(itr - node_ids_.begin());
+  return Status::OK();
+}
+
+Status GraphCsr::GetEdgeIndex(EdgeIdType id, int32_t *index) const {
+  auto itr = std::lower_bound(edge_ids_.begin(), edge_ids_.end(), id);
+  if (itr == edge_ids_.end() || *itr != id) {
+    std::string err_msg = "Invalid edge id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  *index = static_cast<int32_t>(itr - edge_ids_.begin());
+  return Status::OK();
+}
+
+const GraphCsr::FeatureColumn *GraphCsr::NodeFeature(FeatureType feature_type) const {
+  auto itr = node_features_.find(feature_type);
+  return itr == node_features_.end() ? nullptr : itr->second.get();
+}
+
+const GraphCsr::FeatureColumn *GraphCsr::EdgeFeature(FeatureType feature_type) const {
+  auto itr = edge_features_.find(feature_type);
+  return itr == edge_features_.end() ? nullptr : itr->second.get();
+}
+
+size_t GraphCsr::MemoryUsage() const {
+  size_t usage = (node_ids_.capacity() + edge_ids_.capacity() + edge_src_.capacity() + edge_dst_.capacity()) *
+                 sizeof(int32_t);
+  for (const auto &adjacency : adjacency_) {
+    usage += adjacency.second.offsets.capacity() * sizeof(int64_t) +
+             adjacency.second.neighbors.capacity() * sizeof(int32_t);
+  }
+  for (const auto &column : node_features_) usage += column.second->MemoryUsage();
+  for (const auto &column : edge_features_) usage += column.second->MemoryUsage();
+  return usage;
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+// Read-only storage of a graph in compressed sparse row (CSR) form.
+// Nodes and edges are addressed by their index in the sorted id arrays. The neighbors of each neighbor type are one
+// contiguous array of node indices with an offset array per node, and every feature is one contiguous buffer holding
+// the values of the nodes (or edges) that have it. No object is allocated per node or per edge.
+class GraphCsr {
+ public:
+  // The values of one feature type, packed row after row
+  class FeatureColumn {
+   public:
+    FeatureColumn(const DataType &type, const TensorShape &shape, dsize_t num_items);
+
+    // @return DataType - type of the values
+    const DataType &type() const { return type_; }
+
+    // @return TensorShape - shape of one value
+    const TensorShape &shape() const { return shape_; }
+
+    // @return dsize_t - size of one value in bytes
+    dsize_t row_size() const { return row_size_; }
+
+    // Get the value of a node or an edge
+    // @param int32_t index - index of the node or the edge
+    // @return const uchar * - the value, nullptr if the node or the edge does not have this feature
+    const uchar *Row(int32_t index) const {
+      int32_t row = rows_[index];
+      return row < 0 ? nullptr : data_.data() + static_cast<dsize_t>(row) * row_size_;
+    }
+
+    // Add the value of a node or an edge
+    // @param int32_t index - index of the node or the edge
+    // @param std::shared_ptr<Tensor> value - the value
+    // @return Status - The error code return
+    Status Add(int32_t index, const std::shared_ptr<Tensor> &value);
+
+    // Release the spare capacity once all values are added
+    void ShrinkToFit() { data_.shrink_to_fit(); }
+
+    // @return size_t - bytes held by the column
+    size_t MemoryUsage() const { return rows_.capacity() * sizeof(int32_t) + data_.capacity(); }
+
+   private:
+    DataType type_;
+    TensorShape shape_;
+    dsize_t row_size_;
+    std::vector<int32_t> rows_;  // row of each node or edge in data_, -1 if it has no value
+    std::vector<uchar> data_;
+  };
+
+  GraphCsr() = default;
+
+  ~GraphCsr() = default;
+
+  // Build the storage from the loaded node and edge objects, which can be released afterwards
+  // @param NodeIdMap nodes - all nodes, connected to their neighbors
+  // @param EdgeIdMap edges - all edges
+  // @param std::vector<NodeType> node_types - all node types, i.e. the possible neighbor types
+  // @param NodeFeatureMap node_features - feature types of each node type
+  // @param EdgeFeatureMap edge_features - feature types of each edge type
+  // @return Status - The error code return
+  Status Build(const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+               const std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> &edges,
+               const std::vector<NodeType> &node_types,
+               const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_features,
+               const std::unordered_map<EdgeType, std::unordered_set<FeatureType>> &edge_features);
+
+  // Find the index of a node
+  // @param NodeIdType id - node id
+  // @param int32_t *index - Returned node index
+  // @return Status - The error code return
+  Status GetNodeIndex(NodeIdType id, int32_t *index) const;
+
+  // Find the index of an edge
+  // @param EdgeIdType id - edge id
+  // @param int32_t *index - Returned edge index
+  // @return Status - The error code return
+  Status GetEdgeIndex(EdgeIdType id, int32_t *index) const;
+
+  // @return NodeIdType - id of the node at an index
+  NodeIdType NodeId(int32_t index) const { return node_ids_[index]; }
+
+  // @return std::pair<int32_t, int32_t> - indices of the source and the destination nodes of the edge at an index
+  std::pair<int32_t, int32_t> EdgeNodes(int32_t index) const { return {edge_src_[index], edge_dst_[index]}; }
+
+  // Get the neighbors of a node
+  // @param int32_t index - node index
+  // @param NodeType neighbor_type - type of neighbor
+  // @return std::pair<const int32_t *, const int32_t *> - begin and end of the neighbor indices, in the order the
+  // edges were loaded
+  std::pair<const int32_t *, const int32_t *> Neighbors(int32_t index, NodeType neighbor_type) const {
+    auto itr = adjacency_.find(neighbor_type);
+    if (itr == adjacency_.end()) {
+      return {nullptr, nullptr};
+    }
+    const int32_t *neighbors = itr->second.neighbors.data();
+    return {neighbors + itr->second.offsets[index], neighbors + itr->second.offsets[index + 1]};
+  }
+
+  // @return const FeatureColumn * - the column of a node feature type, nullptr if no node has it
+  const FeatureColumn *NodeFeature(FeatureType feature_type) const;
+
+  // @return const FeatureColumn * - the column of an edge feature type, nullptr if no edge has it
+  const FeatureColumn *EdgeFeature(FeatureType feature_type) const;
+
+  // @return size_t - bytes held by the storage
+  size_t MemoryUsage() const;
+
+ private:
+  struct Adjacency {
+    std::vector<int64_t> offsets;  // the neighbors of node i are [offsets[i], offsets[i + 1])
+    std::vector<int32_t> neighbors;
+  };
+
+  // Copy a feature of an object into its column, creating the column on first use
+  template <typename T>
+  Status AddFeature(const std::shared_ptr<T> &object, int32_t index, FeatureType feature_type, dsize_t num_items,
+                    std::unordered_map<FeatureType, std::unique_ptr<FeatureColumn>> *columns);
+
+  std::vector<NodeIdType> node_ids_;  // sorted, the position of an id is the index of the node
+  std::vector<EdgeIdType> edge_ids_;  // sorted, the position of an id is the index of the edge
+  std::vector<int32_t> edge_src_;
+  std::vector<int32_t> edge_dst_;
+  std::unordered_map<NodeType, Adjacency> adjacency_;
+  std::unordered_map<FeatureType, std::unique_ptr<FeatureColumn>> node_features_;
+  std::unordered_map<FeatureType, std::unique_ptr<FeatureColumn>> edge_features_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
@@ -27,13 +27,58 @@
 namespace mindspore {
 namespace dataset {
 namespace gnn {
+namespace {
+// Appends samples_num neighbors taken at random from [begin, end). Each round takes distinct neighbors, once all of
+// them are taken the next round starts over, as LocalNode::GetSampledNeighbors does.
+void SampleNeighbors(const int32_t *begin, const int32_t *end, int32_t samples_num, std::mt19937 *rnd,
+                     std::vector<int32_t> *scratch, std::vector<int32_t> *out) {
+  auto degree = static_cast<int32_t>(end - begin);
+  if (degree == 0) {
+    out->insert(out->end(), samples_num, -1);
+    return;
+  }
+  while (samples_num >= degree) {
+    scratch->assign(begin, end);
+    std::shuffle(scratch->begin(), scratch->end(), *rnd);
+    out->insert(out->end(), scratch->begin(), scratch->end());
+    samples_num -= degree;
+  }
+  if (samples_num == 0) {
+    return;
+  }
+  // Few samples from a large neighborhood, draw positions until they are distinct instead of touching every neighbor
+  constexpr int32_t kMaxRejectionSamples = 64;
+  if (samples_num <= kMaxRejectionSamples && degree > 4 * samples_num) {
+    std::uniform_int_distribution<int32_t> distribution(0, degree - 1);
+    scratch->clear();
+    while (scratch->size() < samples_num) {
+      int32_t pos = distribution(*rnd);
+      if (std::find(scratch->begin(), scratch->end(), pos) == scratch->end()) {
+        scratch->push_back(pos);
+      }
+    }
+    for (auto pos : *scratch) {
+      out->push_back(begin[pos]);
+    }
+    return;
+  }
+  // Partial Fisher-Yates shuffle
+  scratch->assign(begin, end);
+  for (int32_t i = 0; i < samples_num; ++i) {
+    std::uniform_int_distribution<int32_t> distribution(i, degree - 1);
+    std::swap((*scratch)[i], (*scratch)[distribution(*rnd)]);
+  }
+  out->insert(out->end(), scratch->begin(), scratch->begin() + samples_num);
+}
+}  // namespace
 
-GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode)
+GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode, bool csr_storage)
     : dataset_file_(dataset_file),
       num_workers_(num_workers),
       rnd_(GetRandomDevice()),
       random_walk_(this),
-      server_mode_(server_mode) {
+      server_mode_(server_mode),
+      csr_storage_(csr_storage) {
   rnd_.seed(GetSeed());
   MS_LOG(INFO) << "num_workers:" << num_workers;
 }
@@ -113,6 +158,16 @@ Status GraphDataImpl::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list
 
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
+  if (csr_ != nullptr) {
+    for (const auto &edge_id : edge_list) {
+      int32_t index = 0;
+      RETURN_IF_NOT_OK(csr_->GetEdgeIndex(edge_id, &index));
+      auto nodes = csr_->EdgeNodes(index);
+      node_list.push_back({csr_->NodeId(nodes.first), csr_->NodeId(nodes.second)});
+    }
+    RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(node_list, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  }
   for (const auto &edge_id : edge_list) {
     auto itr = edge_id_map_.find(edge_id);
     if (itr == edge_id_map_.end()) {
@@ -137,9 +192,7 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   size_t max_neighbor_num = 0;
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+    RETURN_IF_NOT_OK(GetNeighborIds(node_list[i], neighbor_type, false, &neighbors[i]));
     max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
   }
 
@@ -181,6 +234,9 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   for (const auto &type : neighbor_types) {
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
+  if (csr_ != nullptr) {
+    return GetSampledNeighborsCsr(node_list, neighbor_nums, neighbor_types, out);
+  }
   std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
     std::shared_ptr<Node> input_node;
@@ -211,6 +267,53 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   return Status::OK();
 }
 
+Status GraphDataImpl::GetSampledNeighborsCsr(const std::vector<NodeIdType> &node_list,
+                                             const std::vector<NodeIdType> &neighbor_nums,
+                                             const std::vector<NodeType> &neighbor_types,
+                                             std::shared_ptr<Tensor> *out) {
+  // Every node gets one row holding itself and then the samples of each hop
+  dsize_t row_size = 1, hop_size = 1;
+  for (auto num : neighbor_nums) {
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  auto num_nodes = static_cast<dsize_t>(node_list.size());
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({num_nodes, row_size}), DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *data = &*tensor->begin<NodeIdType>();
+  auto sample = [&, this](int64_t begin, int64_t end, uint32_t seed) -> Status {
+    std::mt19937 rnd(seed);
+    std::vector<int32_t> hop, next_hop, scratch;
+    for (int64_t n = begin; n < end; ++n) {
+      NodeIdType *row = data + n * row_size;
+      int32_t index = 0;
+      RETURN_IF_NOT_OK(csr_->GetNodeIndex(node_list[n], &index));
+      *row++ = node_list[n];
+      hop.assign(1, index);
+      for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+        next_hop.clear();
+        for (auto node : hop) {
+          if (node < 0) {
+            next_hop.insert(next_hop.end(), neighbor_nums[i], -1);
+          } else {
+            auto neighbors = csr_->Neighbors(node, neighbor_types[i]);
+            SampleNeighbors(neighbors.first, neighbors.second, neighbor_nums[i], &rnd, &scratch, &next_hop);
+          }
+        }
+        for (auto node : next_hop) {
+          *row++ = node < 0 ? kDefaultNodeId : csr_->NodeId(node);
+        }
+        hop.swap(next_hop);
+      }
+    }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(num_nodes, sample));
+  tensor->Squeeze();
+  *out = std::move(tensor);
+  return Status::OK();
+}
+
 Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
                                      size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
                                      int32_t samples_num, std::vector<NodeIdType> *out_samples) {
@@ -246,15 +349,14 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
   neg_neighbors_vec.resize(node_list.size());
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
+    NodeIdType node_id = node_list[node_idx];
     std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
+    RETURN_IF_NOT_OK(GetNeighborIds(node_id, neg_neighbor_type, false, &neighbors));
     std::unordered_set<NodeIdType> exclude_nodes;
     std::transform(neighbors.begin(), neighbors.end(),
                    std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
                    [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
+    neg_neighbors_vec[node_idx].emplace_back(node_id);
     if (all_nodes.size() > exclude_nodes.size()) {
       while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
         RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
@@ -265,7 +367,7 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
         }
       }
     } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
+      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_id
                     << " neg_neighbor_type:" << neg_neighbor_type;
       // If there are no negative neighbors, they are filled with kDefaultNodeId
       for (int32_t i = 0; i < samples_num; ++i) {
@@ -285,7 +387,8 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
 Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const std::vector<NodeType> &meta_path,
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
+  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1,
+                                      std::max(num_workers_, 1)));
   std::vector<std::vector<NodeIdType>> walks;
   RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
@@ -333,20 +436,24 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
-      } else {
-        std::shared_ptr<Node> node;
-        RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
-        if (!node->GetFeatures(f_type, &feature).IsOk()) {
+    if (csr_ != nullptr) {
+      RETURN_IF_NOT_OK(CopyFeatureCsr(nodes, true, csr_->NodeFeature(f_type), default_feature->Value(), fea_tensor));
+    } else {
+      dsize_t index = 0;
+      for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+        std::shared_ptr<Feature> feature;
+        if (*node_itr == kDefaultNodeId) {
           feature = default_feature;
+        } else {
+          std::shared_ptr<Node> node;
+          RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
+          if (!node->GetFeatures(f_type, &feature).IsOk()) {
+            feature = default_feature;
+          }
         }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(nodes->shape());
@@ -369,6 +476,12 @@ Status GraphDataImpl::GetNodeFeatureSharedMemory(const std::shared_ptr<Tensor> &
   TensorShape shape = nodes->shape().AppendDim(2);
   std::shared_ptr<Tensor> fea_tensor;
   RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, DataType(DataType::DE_INT64), &fea_tensor));
+  if (csr_ != nullptr) {
+    RETURN_IF_NOT_OK(CopyFeatureCsr(nodes, true, csr_->NodeFeature(type), nullptr, fea_tensor));
+    fea_tensor->Squeeze();
+    *out = std::move(fea_tensor);
+    return Status::OK();
+  }
 
   auto out_fea_itr = fea_tensor->begin<int64_t>();
   for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
@@ -421,16 +534,20 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
-      std::shared_ptr<Edge> edge;
-      RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
-      std::shared_ptr<Feature> feature;
-      if (!edge->GetFeatures(f_type, &feature).IsOk()) {
-        feature = default_feature;
+    if (csr_ != nullptr) {
+      RETURN_IF_NOT_OK(CopyFeatureCsr(edges, false, csr_->EdgeFeature(f_type), default_feature->Value(), fea_tensor));
+    } else {
+      dsize_t index = 0;
+      for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+        std::shared_ptr<Edge> edge;
+        RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
+        std::shared_ptr<Feature> feature;
+        if (!edge->GetFeatures(f_type, &feature).IsOk()) {
+          feature = default_feature;
+        }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(edges->shape());
@@ -453,6 +570,12 @@ Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &
   TensorShape shape = edges->shape().AppendDim(2);
   std::shared_ptr<Tensor> fea_tensor;
   RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, DataType(DataType::DE_INT64), &fea_tensor));
+  if (csr_ != nullptr) {
+    RETURN_IF_NOT_OK(CopyFeatureCsr(edges, false, csr_->EdgeFeature(type), nullptr, fea_tensor));
+    fea_tensor->Squeeze();
+    *out = std::move(fea_tensor);
+    return Status::OK();
+  }
 
   auto out_fea_itr = fea_tensor->begin<int64_t>();
   for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
@@ -478,8 +601,94 @@ Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &
   return Status::OK();
 }
 
+Status GraphDataImpl::CopyFeatureCsr(const std::shared_ptr<Tensor> &ids, bool is_node,
+                                     const GraphCsr::FeatureColumn *column,
+                                     const std::shared_ptr<Tensor> &default_value,
+                                     const std::shared_ptr<Tensor> &out) {
+  dsize_t row_size = out->SizeInBytes() / std::max<dsize_t>(ids->Size(), 1);
+  if (default_value != nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(default_value->SizeInBytes() == row_size, "Invalid default feature.");
+  }
+  if (column != nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(column->row_size() == row_size && column->type() == out->type(),
+                                 "Feature values of type " + column->type().ToString() + column->shape().ToString() +
+                                   " do not match the output of type " + out->type().ToString());
+  }
+  // Without a default value, the ones that lack the feature are filled with -1, as their shared memory offset
+  std::vector<uchar> missing(row_size, 0xFF);
+  const uchar *missing_row = default_value != nullptr ? default_value->GetBuffer() : missing.data();
+  auto dst = reinterpret_cast<uchar *>(&*out->begin<uint8_t>());
+  dsize_t dst_size = out->SizeInBytes();
+  for (auto itr = ids->begin<int32_t>(); itr != ids->end<int32_t>(); ++itr) {
+    const uchar *src = missing_row;
+    int32_t index = 0;
+    if (is_node && *itr != kDefaultNodeId) {
+      RETURN_IF_NOT_OK(csr_->GetNodeIndex(*itr, &index));
+    } else if (!is_node) {
+      RETURN_IF_NOT_OK(csr_->GetEdgeIndex(*itr, &index));
+    } else {
+      index = -1;
+    }
+    if (index >= 0 && column != nullptr && column->Row(index) != nullptr) {
+      src = column->Row(index);
+    }
+    if (row_size > 0) {
+      CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst, dst_size, src, row_size) == 0, "Failed to copy feature.");
+    }
+    dst += row_size;
+    dst_size -= row_size;
+  }
+  return Status::OK();
+}
+
 Status GraphDataImpl::Init() {
   RETURN_IF_NOT_OK(LoadNodeAndEdge());
+  if (csr_storage_) {
+    std::vector<NodeType> node_types;
+    for (const auto &itr : node_type_map_) {
+      node_types.push_back(itr.first);
+    }
+    csr_ = std::make_unique<GraphCsr>();
+    RETURN_IF_NOT_OK(csr_->Build(node_id_map_, edge_id_map_, node_types, node_feature_map_, edge_feature_map_));
+    // The objects are not needed any more, the CSR arrays answer every query
+    node_id_map_ = std::unordered_map<NodeIdType, std::shared_ptr<Node>>();
+    edge_id_map_ = std::unordered_map<EdgeIdType, std::shared_ptr<Edge>>();
+  }
+  RETURN_IF_NOT_OK(LaunchWorkers());
+  return Status::OK();
+}
+
+Status GraphDataImpl::LaunchWorkers() {
+  if (num_workers_ <= 1 || workers_ != nullptr) {
+    return Status::OK();
+  }
+  // the workers run until the graph is destroyed
+  auto workers = std::make_unique<TaskGroup>();
+  RETURN_IF_NOT_OK(pool_.Launch(workers.get(), num_workers_ - 1, "GraphDataImpl"));
+  workers_ = std::move(workers);
+  return Status::OK();
+}
+
+Status GraphDataImpl::ParallelFor(int64_t num, const std::function<Status(int64_t, int64_t, uint32_t)> &func) {
+  int64_t num_chunks = std::max<int64_t>(1, std::min<int64_t>(num_workers_, num));
+  if (workers_ == nullptr || num_chunks == 1) {
+    return func(0, num, static_cast<uint32_t>(rnd_()));
+  }
+  int64_t chunk = (num + num_chunks - 1) / num_chunks;
+  num_chunks = (num + chunk - 1) / chunk;
+  std::vector<uint32_t> seeds(num_chunks);
+  for (auto &seed : seeds) {
+    seed = static_cast<uint32_t>(rnd_());
+  }
+  std::vector<Status> rcs(num_chunks);
+  std::function<void(size_t)> run_chunk = [&](size_t i) {
+    int64_t begin = static_cast<int64_t>(i) * chunk;
+    rcs[i] = func(begin, std::min(num, begin + chunk), seeds[i]);
+  };
+  pool_.ForEach(num_chunks, run_chunk);
+  for (const auto &rc : rcs) {
+    RETURN_IF_NOT_OK(rc);
+  }
   return Status::OK();
 }
 
@@ -556,6 +765,27 @@ Status GraphDataImpl::GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node
   return Status::OK();
 }
 
+Status GraphDataImpl::GetNeighborIds(NodeIdType id, NodeType neighbor_type, bool exclude_itself,
+                                     std::vector<NodeIdType> *out_neighbors) {
+  if (csr_ == nullptr) {
+    std::shared_ptr<Node> node;
+    RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+    return node->GetAllNeighbors(neighbor_type, out_neighbors, exclude_itself);
+  }
+  int32_t index = 0;
+  RETURN_IF_NOT_OK(csr_->GetNodeIndex(id, &index));
+  auto neighbors = csr_->Neighbors(index, neighbor_type);
+  out_neighbors->clear();
+  out_neighbors->reserve(neighbors.second - neighbors.first + 1);
+  if (!exclude_itself) {
+    out_neighbors->push_back(id);
+  }
+  for (auto itr = neighbors.first; itr != neighbors.second; ++itr) {
+    out_neighbors->push_back(csr_->NodeId(*itr));
+  }
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge) {
   auto itr = edge_id_map_.find(id);
   if (itr == edge_id_map_.end()) {
@@ -611,19 +841,18 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd,
+                                                   std::vector<NodeIdType> *walk_path) {
   // Simulate a random walk starting from start node.
   auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
   // walk simulate
   while (walk.size() - 1 < meta_path_.size()) {
     // current nodE
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
 
     // current neighbors
     std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
+    RETURN_IF_NOT_OK(graph_->GetNeighborIds(cur_node_id, meta_path_[walk.size() - 1], true, &cur_neighbors));
     std::sort(cur_neighbors.begin(), cur_neighbors.end());
 
     // break if no neighbors
@@ -634,12 +863,12 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
     // walk by the fist node, then by the previous 2 nodes
     std::shared_ptr<StochasticIndex> stochastic_index;
     if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], rnd, &stochastic_index));
     } else {
       NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, rnd, &stochastic_index));
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
+    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index, rnd)];
     walk.push_back(next_node_id);
   }
 
@@ -652,44 +881,44 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
 }
 
 Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
+  // The walks only read the graph, so they are split among the workers, each with its own random engine
+  int64_t num_nodes = node_list_.size();
+  int64_t first = walks->size();
+  walks->resize(first + num_walks_ * num_nodes);
+  auto walk = [&, this](int64_t begin, int64_t end, uint32_t seed) -> Status {
+    std::mt19937 rnd(seed);
+    for (int64_t i = begin; i < end; ++i) {
+      RETURN_IF_NOT_OK(Node2vecWalk(node_list_[i % num_nodes], &rnd, &(*walks)[first + i]));
     }
-  }
-  return Status::OK();
+    return Status::OK();
+  };
+  return graph_->ParallelFor(num_walks_ * num_nodes, walk);
 }
 
 Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
+                                                         std::mt19937 *rnd,
                                                          std::shared_ptr<StochasticIndex> *node_probability) {
   // Generate alias nodes
-  std::shared_ptr<Node> node;
-  graph_->GetNodeByNodeId(node_id, &node);
   std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighborIds(node_id, node_type, true, &neighbors));
   std::sort(neighbors.begin(), neighbors.end());
   auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
   *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
 Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
+                                                         uint32_t meta_path_index, std::mt19937 *rnd,
                                                          std::shared_ptr<StochasticIndex> *edge_probability) {
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  graph_->GetNodeByNodeId(src, &src_node);
   std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighborIds(src, meta_path_[meta_path_index], true, &src_neighbors));
 
-  std::shared_ptr<Node> dst_node;
-  graph_->GetNodeByNodeId(dst, &dst_node);
   std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighborIds(dst, meta_path_[meta_path_index + 1], true, &dst_neighbors));
 
+  std::sort(src_neighbors.begin(), src_neighbors.end());
   std::sort(dst_neighbors.begin(), dst_neighbors.end());
   std::vector<float> non_normalized_probability;
   for (const auto &dst_nbr : dst_neighbors) {
@@ -697,8 +926,7 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
       non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
       continue;
     }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    if (std::binary_search(src_neighbors.begin(), src_neighbors.end(), dst_nbr)) {
       // stay close, this node connect both src and dst
       non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
     } else {
@@ -708,21 +936,21 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
   }
 
   *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability), rnd));
   return Status::OK();
 }
 
-StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
+StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability,
+                                                                   std::mt19937 *rnd) {
   uint32_t K = probability.size();
   std::vector<int32_t> switch_to_large_index(K, 0);
   std::vector<float> weight(K, .0);
   std::vector<int32_t> smaller;
   std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
   float accumulate_threshold = 0.0;
   for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
+    float threshold_one = distribution(*rnd);
     accumulate_threshold += threshold_one;
     weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
     weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
@@ -740,18 +968,17 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
   return StochasticIndex(switch_to_large_index, weight);
 }
 
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd) {
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(0.0, 1.0);
 
   // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
+  uint32_t random_idx = std::floor(distribution(*rnd) * size_of_index);
 
-  if (distribution(random_device) < weight[random_idx]) {
+  if (distribution(*rnd) < weight[random_idx]) {
     return random_idx;
   }
   return switch_to_large_index[random_idx];
@@ -17,18 +17,23 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <map>
+#include <random>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
 #endif
+#include "minddata/dataset/util/job_pool.h"
+#include "minddata/dataset/util/task_manager.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
 
 namespace mindspore {
@@ -44,7 +49,9 @@ class GraphDataImpl : public GraphData {
   // Constructor
   // @param std::string dataset_file -
   // @param int32_t num_workers - number of parallel threads
-  GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode = false);
+  // @param bool server_mode - whether the features are loaded into shared memory for the clients
+  // @param bool csr_storage - whether the graph is kept in compact CSR arrays instead of node and edge objects
+  GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode = false, bool csr_storage = false);
 
   ~GraphDataImpl();
 
@@ -175,17 +182,17 @@ class GraphDataImpl : public GraphData {
     Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
+    Status Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd, std::vector<NodeIdType> *walk_path);
 
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
+    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type, std::mt19937 *rnd,
                               std::shared_ptr<StochasticIndex> *node_probability);
 
     Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
+                              std::mt19937 *rnd, std::shared_ptr<StochasticIndex> *edge_probability);
 
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
+    static StochasticIndex GenerateProbability(const std::vector<float> &probability, std::mt19937 *rnd);
 
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
+    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd);
 
     template <typename T>
     std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
@@ -239,6 +246,45 @@ class GraphDataImpl : public GraphData {
   // @return Status - The error code return
   Status GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node);
 
+  // Get the neighbors of a node from whichever storage holds the graph
+  // @param NodeIdType id - node id
+  // @param NodeType neighbor_type - type of neighbor
+  // @param bool exclude_itself - whether the node itself is left out of the neighbors
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @return Status - The error code return
+  Status GetNeighborIds(NodeIdType id, NodeType neighbor_type, bool exclude_itself,
+                        std::vector<NodeIdType> *out_neighbors);
+
+  // Sample the neighbors of a list of nodes hop by hop from the CSR storage, on several threads
+  // @param std::vector<NodeType> node_list - List of nodes
+  // @param std::vector<NodeIdType> neighbor_nums - Number of neighbors sampled per hop
+  // @param std::vector<NodeType> neighbor_types - Neighbor type sampled per hop
+  // @param std::shared_ptr<Tensor> *out - Returned neighbor's id.
+  // @return Status - The error code return
+  Status GetSampledNeighborsCsr(const std::vector<NodeIdType> &node_list, const std::vector<NodeIdType> &neighbor_nums,
+                                const std::vector<NodeType> &neighbor_types, std::shared_ptr<Tensor> *out);
+
+  // Run func(begin, end, seed) over [0, num) split into contiguous chunks, on the calling thread and the workers.
+  // The seed of each chunk is drawn from rnd_, so the results only depend on the seed of the graph
+  // @param int64_t num - the size of the range
+  // @param func - runs one chunk
+  // @return Status - The error code return, the one of the first chunk that fails
+  Status ParallelFor(int64_t num, const std::function<Status(int64_t, int64_t, uint32_t)> &func);
+
+  // Launch the num_workers_ - 1 threads helping the calling thread of ParallelFor
+  // @return Status - The error code return
+  Status LaunchWorkers();
+
+  // Copy the features of nodes or edges from a CSR feature column into a tensor
+  // @param std::shared_ptr<Tensor> ids - List of nodes or edges, kDefaultNodeId takes the default value
+  // @param bool is_node - whether the ids are node ids
+  // @param GraphCsr::FeatureColumn *column - The feature column, nullptr if none of the graph has the feature
+  // @param std::shared_ptr<Tensor> default_value - value of the ones without the feature, nullptr to fill them with -1
+  // @param std::shared_ptr<Tensor> out - The tensor to fill, with one value per id
+  // @return Status - The error code return
+  Status CopyFeatureCsr(const std::shared_ptr<Tensor> &ids, bool is_node, const GraphCsr::FeatureColumn *column,
+                        const std::shared_ptr<Tensor> &default_value, const std::shared_ptr<Tensor> &out);
+
   // Find edge object using edge id
   // @param EdgeIdType id -
   // @param std::shared_ptr<Node> *edge - Returned edge object
@@ -265,6 +311,8 @@ class GraphDataImpl : public GraphData {
   RandomWalkBase random_walk_;
   mindrecord::json data_schema_;
   bool server_mode_;
+  bool csr_storage_;
+  std::unique_ptr<GraphCsr> csr_;  // holds the graph when csr_storage_ is set, the object maps are then empty
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
 #endif
@@ -279,6 +327,9 @@ class GraphDataImpl : public GraphData {
 
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_node_feature_map_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_edge_feature_map_;
+
+  JobPool pool_;                        // runs the chunks of ParallelFor on the workers
+  std::unique_ptr<TaskGroup> workers_;  // declared last, so that the workers stop first
 };
 }  // namespace gnn
 }  // namespace dataset
@@ -30,7 +30,7 @@ namespace dataset {
 namespace gnn {
 
 GraphDataServer::GraphDataServer(const std::string &dataset_file, int32_t num_workers, const std::string &hostname,
-                                 int32_t port, int32_t client_num, bool auto_shutdown)
+                                 int32_t port, int32_t client_num, bool auto_shutdown, bool csr_storage)
     : dataset_file_(dataset_file),
       num_workers_(num_workers),
       client_num_(client_num),
@@ -38,7 +38,7 @@ GraphDataServer::GraphDataServer(const std::string &dataset_file, int32_t num_wo
       auto_shutdown_(auto_shutdown),
       state_(kGdsUninit) {
   tg_ = std::make_unique<TaskGroup>();
-  graph_data_impl_ = std::make_unique<GraphDataImpl>(dataset_file, num_workers, true);
+  graph_data_impl_ = std::make_unique<GraphDataImpl>(dataset_file, num_workers, true, csr_storage);
 #if !defined(_WIN32) && !defined(_WIN64)
   service_impl_ = std::make_unique<GraphDataServiceImpl>(this, graph_data_impl_.get());
   async_server_ = std::make_unique<GraphDataGrpcServer>(hostname, port, service_impl_.get());
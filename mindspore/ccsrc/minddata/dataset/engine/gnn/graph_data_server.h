@@ -38,7 +38,7 @@ class GraphDataServer {
  public:
   enum ServerState { kGdsUninit = 0, kGdsInitializing, kGdsRunning, kGdsStopped };
   GraphDataServer(const std::string &dataset_file, int32_t num_workers, const std::string &hostname, int32_t port,
-                  int32_t client_num, bool auto_shutdown);
+                  int32_t client_num, bool auto_shutdown, bool csr_storage = false);
   ~GraphDataServer() = default;
 
   Status Init();
@@ -0,0 +1,242 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_LOCK_FREE_DB_CONNECTOR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_LOCK_FREE_DB_CONNECTOR_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/engine/db_connector.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include "minddata/dataset/util/cond_var.h"
+
+namespace mindspore {
+namespace dataset {
+// LockFreeDbConnector is a DbConnector whose internal queues are lock free bounded rings.
+// It keeps the ordering of DbConnector: producer i only pushes to ring i, and the buffers are popped from the rings
+// in round robin by the consumers in turn. Since a ring has one producer, and only the consumer holding the turn
+// pops from it, each ring is single producer single consumer and needs no lock:
+//   - the producer writes the slot at the tail and then publishes the new tail,
+//   - the consumer holding the turn moves the buffer out of the slot at the head, publishes the new head and then
+//     hands the turn over to the next consumer.
+// Each side caches the index published by the other side and only reloads it when the cached one shows the ring
+// full (or empty), so a consumer that finds several buffers ready takes them all without touching the cache line
+// of the producer, and vice versa.
+// A thread that has to wait polls for a while, then yields for a while, and then parks on a condition variable.
+// The threads only take the parking lock to park and to wake parked threads up, which is rare under load.
+class LockFreeDbConnector : public DbConnector {
+ public:
+  // Number of polls of a waiting thread before it starts yielding
+  static constexpr int32_t kSpinCount = 128;
+
+  // Number of yields of a waiting thread before it parks
+  static constexpr int32_t kYieldCount = 16;
+
+  // Constructor of LockFreeDbConnector
+  // @param n_producers The number of threads producing data into this DbConnector.
+  // @param n_consumers The number of thread consuming data from this DbConnector.
+  // @param queue_capacity The number of element (DataBuffer) for each internal queue. The rings hold enough slots
+  //     for AutoTune to grow it.
+  LockFreeDbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
+      : DbConnector(n_producers, n_consumers, 1),
+        limit_(static_cast<uint64_t>(queue_capacity)),
+        turn_(0),
+        next_ring_(0),
+        eof_(false),
+        sleepers_(0) {
+    size_t slots = 1;
+    while (slots < static_cast<size_t>(queue_capacity) * AutoTune::kMaxQueueGrowth) {
+      slots <<= 1;
+    }
+    for (int32_t i = 0; i < n_producers; i++) {
+      rings_.push_back(std::make_unique<Ring>(slots));
+    }
+  }
+
+  // Destructor of LockFreeDbConnector
+  ~LockFreeDbConnector() override = default;
+
+  // Add a unique_ptr<DataBuffer> into the ring of the worker, waiting while it is full.
+  // @param worker_id The id of a worker thread calling this method.
+  // @param el A rvalue reference to an element to be passed/added/pushed.
+  Status Add(int32_t worker_id, std::unique_ptr<DataBuffer> &&el) noexcept override {
+    int64_t start_us = producer_latency_ == nullptr ? 0 : OpLatency::NowUs();
+    bool is_data = el != nullptr && !el->eoe() && !el->eof();
+    Ring &ring = *rings_[worker_id];
+    uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    if (tail - ring.head_cache >= limit_.load(std::memory_order_relaxed)) {
+      RETURN_IF_NOT_OK(WaitFor([this, &ring, tail]() {
+        ring.head_cache = ring.head.load(std::memory_order_acquire);
+        return tail - ring.head_cache < limit_.load(std::memory_order_relaxed);
+      }));
+    }
+    ring.slots[tail & ring.mask] = std::move(el);
+    ring.tail.store(tail + 1, std::memory_order_release);
+    WakeUp();
+    if (producer_latency_ != nullptr) {
+      producer_latency_->RecordOutput(worker_id, start_us, OpLatency::NowUs(), is_data);
+    }
+    return Status::OK();
+  }
+
+  // Get a unique_ptr<DataBuffer> from the LockFreeDbConnector, with the same semantics as DbConnector.
+  // @param worker_id The id of a worker thread calling this method.
+  // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
+  // @param retry_if_eoe A flag to allow the same thread invoke pop() again if the current pop returns eoe buffer.
+  Status PopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result,
+                      bool retry_if_eoe = false) noexcept override {
+    if (result == nullptr) {
+      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                    "[ERROR] nullptr detected when getting data from db connector");
+    }
+    int64_t start_us = consumer_latency_ == nullptr ? 0 : OpLatency::NowUs();
+    RETURN_IF_NOT_OK(WaitFor([this, worker_id]() {
+      return turn_.load(std::memory_order_acquire) == worker_id || eof_.load(std::memory_order_acquire);
+    }));
+    // Once an EOF message is encountered this flag will be set and we can return early.
+    if (eof_.load(std::memory_order_acquire)) {
+      *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
+    } else {
+      Ring &ring = *rings_[next_ring_];
+      uint64_t head = ring.head.load(std::memory_order_relaxed);
+      if (head == ring.tail_cache) {
+        RETURN_IF_NOT_OK(WaitFor([&ring, head]() {
+          ring.tail_cache = ring.tail.load(std::memory_order_acquire);
+          return head != ring.tail_cache;
+        }));
+      }
+      *result = std::move(ring.slots[head & ring.mask]);
+      ring.head.store(head + 1, std::memory_order_release);
+      if (*result == nullptr) {
+        return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                      "[ERROR] nullptr detected when getting data from db connector");
+      }
+      next_ring_ = (next_ring_ + 1) % num_producers_;
+      if ((*result)->eof()) {
+        // Setting the flag once the first EOF is encountered, every consumer returns EOF from then on.
+        eof_.store(true, std::memory_order_release);
+      } else if (!((*result)->eoe() && retry_if_eoe)) {
+        // Do not hand the turn over when result is eoe and retry_if_eoe is set.
+        turn_.store((worker_id + 1) % num_consumers_, std::memory_order_release);
+      }
+      WakeUp();
+    }
+    if (consumer_latency_ != nullptr) {
+      consumer_latency_->RecordInput(worker_id, start_us, OpLatency::NowUs());
+    }
+    out_buffers_count_++;
+    return Status::OK();
+  }
+
+  // Change the capacity of every ring while the connector is in use.
+  // @param queue_capacity The new number of element (DataBuffer) for each ring, at most AutoTune::kMaxQueueGrowth
+  //     times the initial capacity.
+  // @return Status - The error code return
+  Status Resize(int32_t queue_capacity) override {
+    size_t slots = rings_[0]->slots.size();
+    if (queue_capacity <= 0 || static_cast<size_t>(queue_capacity) > slots) {
+      RETURN_STATUS_UNEXPECTED("Invalid capacity " + std::to_string(queue_capacity) +
+                               " for a lock free connector, it must be in [1, " + std::to_string(slots) + "].");
+    }
+    limit_.store(static_cast<uint64_t>(queue_capacity), std::memory_order_relaxed);
+    WakeUp();
+    return Status::OK();
+  }
+
+  // Get current size of connector.
+  int32_t size() const override {
+    uint64_t size = 0;
+    for (const auto &ring : rings_) {
+      uint64_t head = ring->head.load(std::memory_order_relaxed);
+      size += ring->tail.load(std::memory_order_relaxed) - head;
+    }
+    return static_cast<int32_t>(size);
+  }
+
+  int32_t capacity() const override {
+    return static_cast<int32_t>(limit_.load(std::memory_order_relaxed) * rings_.size());
+  }
+
+  // Register the parking condition variable with Task group for interruption service.
+  // @param vg
+  // @return
+  Status Register(TaskGroup *vg) override {
+    RETURN_IF_NOT_OK(DbConnector::Register(vg));
+    return park_cv_.Register(vg->GetIntrpService());
+  }
+
+ private:
+  struct Ring {
+    explicit Ring(size_t num_slots) : mask(num_slots - 1), slots(num_slots) {}
+
+    const uint64_t mask;
+    std::vector<std::unique_ptr<DataBuffer>> slots;
+    // Written by the producer
+    alignas(64) std::atomic<uint64_t> tail{0};
+    uint64_t head_cache = 0;
+    // Written by the consumer holding the turn
+    alignas(64) std::atomic<uint64_t> head{0};
+    uint64_t tail_cache = 0;
+  };
+
+  // Wait until a condition holds: poll, then yield, then park until woken up.
+  // @param pred The condition, it is always checked by the waiting thread itself.
+  // @return Status - The error code return, an interrupt while parked is returned as is
+  template <typename Pred>
+  Status WaitFor(Pred pred) {
+    for (int32_t i = 0; i < kSpinCount + kYieldCount; i++) {
+      if (pred()) {
+        return Status::OK();
+      }
+      if (i >= kSpinCount) {
+        std::this_thread::yield();
+      }
+    }
+    std::unique_lock<std::mutex> lock(park_mux_);
+    (void)sleepers_.fetch_add(1);
+    // Pairs with the fence in WakeUp: either the waker sees this thread parking, or this thread sees its change.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Status rc = park_cv_.Wait(&lock, pred);
+    (void)sleepers_.fetch_sub(1);
+    return rc;
+  }
+
+  // Wake the parked threads up after a change of the rings or of the turn.
+  void WakeUp() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> lock(park_mux_);
+      park_cv_.NotifyAll();
+    }
+  }
+
+  std::vector<std::unique_ptr<Ring>> rings_;
+  std::atomic<uint64_t> limit_;  // Capacity of each ring, at most its number of slots
+  std::atomic<int32_t> turn_;    // The consumer that may pop next
+  int32_t next_ring_;            // The ring to pop next, only used by the consumer holding the turn
+  std::atomic<bool> eof_;        // A flag to indicate the end of stream has been encountered
+  std::mutex park_mux_;
+  CondVar park_cv_;
+  std::atomic<int32_t> sleepers_;  // Number of parked threads
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_LOCK_FREE_DB_CONNECTOR_H_
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/dataset/engine/opt/optional/projection_pushdown_pass.h"
+#include "minddata/dataset/engine/datasetops/project_op.h"
+#include "minddata/dataset/engine/datasetops/source/mindrecord_op.h"
+#include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
+
+namespace mindspore {
+namespace dataset {
+
+Status ProjectionPushdownPass::RunOnNode(std::shared_ptr<ProjectOp> node, bool *modified) {
+  if (modified == nullptr) {
+    RETURN_STATUS_UNEXPECTED("modified is nullptr");
+  }
+  // These ops pass the rows of their child through as they are, projecting above them is the same as projecting
+  // right above the source
+  auto passes_rows_through = [](const std::shared_ptr<DatasetOp> &op) {
+    const std::string name = op->Name();
+    return op->Children().size() == 1 && (name == kRepeatOp || name == kEpochCtrlOp || name == kShuffleOp ||
+                                          name == kSkipOp || name == kTakeOp);
+  };
+  if (node->Children().size() != 1) {
+    return Status::OK();
+  }
+  std::shared_ptr<DatasetOp> source = node->child(0);
+  while (passes_rows_through(source)) {
+    source = source->child(0);
+  }
+
+  // A column may be projected more than once, the source loads it once
+  std::vector<std::string> columns;
+  for (const auto &column : node->columns_to_project()) {
+    if (std::find(columns.begin(), columns.end(), column) == columns.end()) {
+      columns.push_back(column);
+    }
+  }
+
+  // The project op stays in place, it still orders the columns the way they were asked for
+  bool projected = false;
+  if (auto mindrecord_op = std::dynamic_pointer_cast<MindRecordOp>(source)) {
+    RETURN_IF_NOT_OK(mindrecord_op->ProjectColumns(columns, &projected));
+  } else if (auto tf_reader_op = std::dynamic_pointer_cast<TFReaderOp>(source)) {
+    RETURN_IF_NOT_OK(tf_reader_op->ProjectColumns(columns, &projected));
+  }
+  if (projected) {
+    MS_LOG(INFO) << "Pushed the projection of " << columns.size() << " columns down into " << source->Name() << ".";
+    *modified = true;
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
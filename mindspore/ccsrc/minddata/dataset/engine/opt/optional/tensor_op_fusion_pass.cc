@@ -18,6 +18,8 @@
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 
 namespace mindspore {
@@ -47,6 +49,22 @@ Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified
     *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
     tfuncs.erase(next);
   }
+
+  // Second pattern: RandomCropDecodeResizeOp (fused above or given by the user) immediately followed by
+  // NormalizeOp, and optionally HwcToChwOp. All of them are replaced by a single op which writes the
+  // normalized image straight into the output float tensor.
+  auto rcdr_it = std::find_if(tfuncs.begin(), tfuncs.end(),
+                              [](const auto &tf) -> bool { return tf->Name() == kRandomCropDecodeResizeOp; });
+  if (rcdr_it != tfuncs.end() && rcdr_it + 1 != tfuncs.end() && (*(rcdr_it + 1))->Name() == kNormalizeOp) {
+    auto normalize_it = rcdr_it + 1;
+    auto chw_it = normalize_it + 1;
+    bool hwc_to_chw = chw_it != tfuncs.end() && (*chw_it)->Name() == kHwcToChwOp;
+    auto rcdr_op = static_cast<RandomCropDecodeResizeOp *>(rcdr_it->get());
+    auto normalize_op = static_cast<NormalizeOp *>(normalize_it->get());
+    *rcdr_it = std::static_pointer_cast<TensorOp>(
+      std::make_shared<RandomCropDecodeResizeNormalizeOp>(*rcdr_op, *normalize_op, hwc_to_chw));
+    tfuncs.erase(normalize_it, hwc_to_chw ? chw_it + 1 : chw_it);
+  }
   if (modified != nullptr) {
     *modified = true;
   } else {
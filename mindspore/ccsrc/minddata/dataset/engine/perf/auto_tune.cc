@@ -0,0 +1,158 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include <algorithm>
+#include <thread>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/execution_tree.h"
+
+namespace mindspore {
+namespace dataset {
+constexpr int32_t AutoTune::kSamplesPerStep;
+constexpr double AutoTune::kBurstRatio;
+constexpr double AutoTune::kBottleneckRatio;
+constexpr int32_t AutoTune::kMaxQueueGrowth;
+
+AutoTune::AutoTune(ExecutionTree *tree) : tree_(tree), num_samples_(0) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  sampling_interval_ = cfg->monitor_sampling_interval();
+  cpu_budget_ = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+}
+
+Status AutoTune::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+
+  // Keep tuning if
+  // 1) AutoTune Task is not interrupted by TaskManager AND
+  // 2) Iterator has not received EOF
+  while (!this_thread::is_interrupted() && !(tree_->isFinished())) {
+    Sample();
+    if (num_samples_ == kSamplesPerStep) {
+      RETURN_IF_NOT_OK(Tune());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
+  }
+  LogSuggestions();
+  return Status::OK();
+}
+
+void AutoTune::Sample() {
+  for (auto &op : *tree_) {
+    // Inlined ops have no connector of their own. DeviceQueueOp is not inlined but its output queue is invalid.
+    if (op.inlined() || op.Name() == kDeviceQueueOp || op.ConnectorOutBufferCount() < 0) {
+      continue;
+    }
+    RecordSample(op, op.ConnectorSize());
+  }
+  num_samples_++;
+}
+
+void AutoTune::RecordSample(const DatasetOp &op, int32_t size) {
+  auto &stats = stats_[op.id()];
+  int32_t capacity = op.ConnectorCapacity();
+  if (stats.initial_capacity == 0) {
+    stats.initial_capacity = capacity / std::max(op.num_producers(), 1);
+    stats.capacity = stats.initial_capacity;
+  }
+  if (size == 0) {
+    stats.empty_count++;
+  } else if (size >= capacity) {
+    stats.full_count++;
+  }
+}
+
+Status AutoTune::TuneWithSamples(const std::map<int32_t, std::vector<int32_t>> &samples) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!samples.empty(), "AutoTune needs samples to tune.");
+  size_t num_samples = samples.begin()->second.size();
+  CHECK_FAIL_RETURN_UNEXPECTED(num_samples > 0, "AutoTune needs samples to tune.");
+  for (auto &op : *tree_) {
+    auto it = samples.find(op.id());
+    if (it == samples.end()) {
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(it->second.size() == num_samples, "AutoTune needs as many samples of every op.");
+    for (auto size : it->second) {
+      RecordSample(op, size);
+    }
+  }
+  num_samples_ = static_cast<int32_t>(num_samples);
+  return Tune();
+}
+
+Status AutoTune::Tune() {
+  int32_t total_workers = 0;
+  for (auto &op : *tree_) {
+    total_workers += op.num_workers();
+  }
+  for (auto &op : *tree_) {
+    auto it = stats_.find(op.id());
+    if (it == stats_.end()) {
+      continue;
+    }
+    auto &stats = it->second;
+    double empty_ratio = static_cast<double>(stats.empty_count) / num_samples_;
+    double full_ratio = static_cast<double>(stats.full_count) / num_samples_;
+
+    // A connector that swings between empty and full needs more room to absorb the bursts of its producer.
+    if (empty_ratio >= kBurstRatio && full_ratio >= kBurstRatio &&
+        stats.capacity < stats.initial_capacity * kMaxQueueGrowth) {
+      int32_t new_capacity = std::min(stats.capacity * 2, stats.initial_capacity * kMaxQueueGrowth);
+      RETURN_IF_NOT_OK(op.ResizeConnector(new_capacity));
+      MS_LOG(INFO) << "AutoTune resized the output connector of " << op.Name() << "(ID: " << op.id() << ") from "
+                   << stats.capacity << " to " << new_capacity << " per queue.";
+      stats.capacity = new_capacity;
+    }
+
+    // An op that starves its consumer while being fed faster than it can consume is the bottleneck.
+    if (empty_ratio >= kBottleneckRatio) {
+      auto children = op.Children();
+      bool input_saturated = std::all_of(children.begin(), children.end(), [this](const auto &child) {
+        auto child_stats = stats_.find(child->id());
+        return child_stats == stats_.end() ||
+               static_cast<double>(child_stats->second.full_count) / num_samples_ >= kBottleneckRatio;
+      });
+      // Only ops with more than one worker can make use of more workers.
+      if (input_saturated && op.num_workers() > 1) {
+        int32_t spare_cpus = cpu_budget_ - total_workers;
+        int32_t suggestion = op.num_workers() + std::min(op.num_workers(), std::max(spare_cpus, 0));
+        if (suggestion > op.num_workers() && suggestion > suggested_workers_[op.id()]) {
+          suggested_workers_[op.id()] = suggestion;
+          MS_LOG(INFO) << "AutoTune found " << op.Name() << "(ID: " << op.id() << ") to be the bottleneck, "
+                       << "its output connector was empty in " << static_cast<int32_t>(empty_ratio * 100)
+                       << "% of the samples.";
+        }
+      }
+    }
+    stats.empty_count = 0;
+    stats.full_count = 0;
+  }
+  num_samples_ = 0;
+  return Status::OK();
+}
+
+void AutoTune::LogSuggestions() const {
+  for (auto &op : *tree_) {
+    auto it = suggested_workers_.find(op.id());
+    if (it != suggested_workers_.end()) {
+      MS_LOG(WARNING) << "AutoTune suggests num_parallel_workers=" << it->second << " for " << op.Name()
+                      << "(ID: " << op.id() << "), which currently runs " << op.num_workers() << " workers.";
+    }
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
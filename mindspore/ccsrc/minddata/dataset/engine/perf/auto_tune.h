@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <map>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+class ExecutionTree;
+
+// AutoTune samples the output connector of every op while the ExecutionTree runs (the same counters the
+// ConnectorSize and ConnectorThroughput samplers record) and tunes the pipeline online:
+// 1) An output connector that is seen both empty and full within a tuning step has a producer that is bursty
+//    compared to its consumer. Its queues are grown, up to kMaxQueueGrowth times their initial capacity,
+//    which bounds the extra memory taken by the tuning.
+// 2) An op whose output connector is mostly empty while the connectors of its children are mostly full is the
+//    bottleneck of the pipeline. Workers are bound to the connector queues once the tree is launched, so the
+//    worker count can not be changed without breaking the row order; instead a num_parallel_workers value
+//    that fits in the cpu budget is suggested in the log.
+class AutoTune {
+ public:
+  // Number of samples taken before each tuning step
+  static constexpr int32_t kSamplesPerStep = 20;
+
+  // Fraction of the samples in which a connector must be empty/full to count as bursty
+  static constexpr double kBurstRatio = 0.2;
+
+  // Fraction of the samples in which a connector must be empty/full to count as starved/saturated
+  static constexpr double kBottleneckRatio = 0.5;
+
+  // Upper bound of the capacity of a connector queue, relative to its initial capacity
+  static constexpr int32_t kMaxQueueGrowth = 4;
+
+  explicit AutoTune(ExecutionTree *tree);
+
+  ~AutoTune() = default;
+
+  // Functor for the AutoTune main loop.
+  // This function will be the entry point of mindspore::Dataset::Task
+  Status operator()();
+
+  // Getter of the suggested number of workers, keyed by op id
+  const std::map<int32_t, int32_t> &GetSuggestedWorkers() const { return suggested_workers_; }
+
+  // Run one tuning step over given sizes of the output connectors instead of the ones sampled while the tree runs,
+  // so that the tuning can be checked without depending on timing
+  // @param samples - the sizes each output connector was seen at, keyed by op id, as many for every op
+  // @return Status - The error code return
+  Status TuneWithSamples(const std::map<int32_t, std::vector<int32_t>> &samples);
+
+ private:
+  // Statistics of one output connector over the current tuning step
+  struct ConnectorStats {
+    int32_t initial_capacity = 0;  // Initial capacity of each queue of the connector
+    int32_t capacity = 0;          // Current capacity of each queue of the connector
+    int32_t empty_count = 0;       // Number of samples where the connector was empty
+    int32_t full_count = 0;        // Number of samples where the connector was full
+  };
+
+  // Take one sample of every output connector
+  void Sample();
+
+  // Record a size of the output connector of an op in the statistics of the current step
+  // @param op - the op
+  // @param size - the number of buffers in its output connector
+  void RecordSample(const DatasetOp &op, int32_t size);
+
+  // Analyze the samples of the last step, resize the connectors and update the suggestions
+  // @return Status - The error code return
+  Status Tune();
+
+  // Write the suggested number of workers to the log
+  void LogSuggestions() const;
+
+  ExecutionTree *tree_;
+  int64_t sampling_interval_;
+  int32_t num_samples_;
+  int32_t cpu_budget_;                           // Number of cpus the workers of the pipeline may use
+  std::map<int32_t, ConnectorStats> stats_;      // Connector statistics keyed by op id
+  std::map<int32_t, int32_t> suggested_workers_;  // Suggested number of workers keyed by op id
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/perf/critical_path.h"
+#include <cmath>
+#include <sstream>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+std::string OpLabel(const CriticalPath::OpTimes &op) { return op.name + "(ID: " + std::to_string(op.op_id) + ")"; }
+
+std::string Ms(double us) {
+  std::ostringstream ss;
+  ss.precision(1);
+  ss << std::fixed << us / 1000 << "ms";
+  return ss.str();
+}
+}  // namespace
+
+CriticalPath::CriticalPath(std::vector<OpTimes> ops, int32_t root_id, int32_t cpu_budget)
+    : root_id_(root_id), cpu_budget_(cpu_budget) {
+  for (auto &op : ops) {
+    int32_t id = op.op_id;
+    ops_[id] = std::move(op);
+  }
+}
+
+Status CriticalPath::Analyze() {
+  bottleneck_ = -1;
+  path_.clear();
+  suggested_workers_ = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED(ops_.count(root_id_) != 0, "Root op " + std::to_string(root_id_) + " not profiled.");
+  parents_.clear();
+  for (const auto &op : ops_) {
+    for (auto child : op.second.children) {
+      CHECK_FAIL_RETURN_UNEXPECTED(ops_.count(child) != 0, "Child op " + std::to_string(child) + " not profiled.");
+      parents_[child] = op.first;
+    }
+  }
+
+  int32_t total_workers = 0;
+  double max_busy_us = 0;
+  double next_busy_us = 0;
+  for (const auto &op : ops_) {
+    total_workers += op.second.num_workers;
+    double busy_us = BusyUs(op.second);
+    if (busy_us > max_busy_us) {
+      next_busy_us = max_busy_us;
+      max_busy_us = busy_us;
+      bottleneck_ = op.first;
+    } else if (busy_us > next_busy_us) {
+      next_busy_us = busy_us;
+    }
+  }
+  if (bottleneck_ == -1) {
+    reason_ = "No op has computed any buffer yet.";
+    return Status::OK();
+  }
+
+  // The top op is the first one that pushes data to a connector, above it there are only ops like the device
+  // queue that hand the data over to the consumer. Its time waiting on output is the time the consumer keeps it.
+  int32_t top = root_id_;
+  while (ops_[top].num_outputs == 0 && ops_[top].children.size() == 1) {
+    top = ops_[top].children[0];
+  }
+  const OpTimes &top_op = ops_[top];
+  double consumer_us = static_cast<double>(top_op.wait_output_us) / std::max(top_op.num_workers, 1);
+  if (consumer_us > max_busy_us) {
+    reason_ = OpLabel(top_op) + " waits " + Ms(consumer_us) + " per worker on its consumer, longer than any op " +
+              "computes (at most " + Ms(max_busy_us) + " per worker), so the pipeline is not the bottleneck.";
+    bottleneck_ = -1;
+    return Status::OK();
+  }
+
+  for (int32_t id = bottleneck_;; id = parents_[id]) {
+    path_.insert(path_.begin(), id);
+    if (parents_.count(id) == 0) break;
+  }
+  for (int32_t id = bottleneck_; !ops_[id].children.empty();) {
+    const auto &children = ops_[id].children;
+    id = *std::max_element(children.begin(), children.end(),
+                           [this](int32_t a, int32_t b) { return BusyUs(ops_[a]) < BusyUs(ops_[b]); });
+    path_.push_back(id);
+  }
+  SuggestWorkers(ops_[bottleneck_], next_busy_us, total_workers);
+  return Status::OK();
+}
+
+void CriticalPath::SuggestWorkers(const OpTimes &op, double next_busy_us, int32_t total_workers) {
+  double busy_us = BusyUs(op);
+  reason_ = OpLabel(op) + " is the bottleneck, it computes for " + Ms(busy_us) + " per worker";
+  if (next_busy_us > 0) {
+    std::ostringstream ratio;
+    ratio.precision(1);
+    ratio << std::fixed << busy_us / next_busy_us;
+    reason_ += ", " + ratio.str() + " times as long as the next busiest op";
+  }
+  suggested_workers_ = op.num_workers;
+  if (!op.parallel) {
+    reason_ += ". It runs on one thread, consider caching its output or moving work out of it.";
+    return;
+  }
+  // Enough workers to bring the op down to the busy time of the next busiest op, within the spare cpus
+  auto target = next_busy_us > 0 ? static_cast<int32_t>(std::ceil(op.num_workers * busy_us / next_busy_us))
+                                 : op.num_workers * 2;
+  int32_t spare_cpus = std::max(cpu_budget_ - total_workers, 0);
+  suggested_workers_ = std::max(std::min(target, op.num_workers + spare_cpus), op.num_workers);
+  if (suggested_workers_ > op.num_workers) {
+    reason_ += ". Suggest num_parallel_workers=" + std::to_string(suggested_workers_) + " instead of " +
+               std::to_string(op.num_workers) + ".";
+  } else {
+    reason_ += ". There is no spare cpu for more workers, consider lowering num_parallel_workers of other ops.";
+  }
+}
+
+nlohmann::json CriticalPath::ToJson() const {
+  nlohmann::json out;
+  for (const auto &op : ops_) {
+    out["op_info"].push_back({{"op_id", op.first},
+                              {"op_type", op.second.name},
+                              {"num_workers", op.second.num_workers},
+                              {"busy_us", BusyUs(op.second)},
+                              {"compute_us", op.second.compute_us},
+                              {"wait_input_us", op.second.wait_input_us},
+                              {"wait_output_us", op.second.wait_output_us},
+                              {"num_outputs", op.second.num_outputs}});
+  }
+  out["critical_path"] = path_;
+  if (bottleneck_ != -1) {
+    const OpTimes &op = ops_.at(bottleneck_);
+    out["bottleneck"] = {{"op_id", op.op_id},
+                         {"op_type", op.name},
+                         {"num_workers", op.num_workers},
+                         {"suggested_workers", suggested_workers_}};
+  } else {
+    out["bottleneck"] = nullptr;
+  }
+  out["reason"] = reason_;
+  return out;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_CRITICAL_PATH_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_CRITICAL_PATH_H_
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// CriticalPath finds the op that limits the throughput of a pipeline from the latency totals of its ops.
+// All the rows of a pipeline go through every op between a leaf and the root, so the op whose workers need the
+// longest time to compute what they have output so far (its busy time: compute time per worker) sets the pace
+// of the others, which in turn wait on input or on output. That op is the bottleneck, unless the root waits on
+// its consumer for longer, in which case the pipeline keeps up with the training and there is nothing to tune.
+// The critical path runs from the root down to the bottleneck and on to a leaf through the busiest children.
+class CriticalPath {
+ public:
+  // Latency totals of one op, in microseconds
+  struct OpTimes {
+    int32_t op_id = 0;
+    std::string name;
+    std::vector<int32_t> children;
+    int32_t num_workers = 1;
+    bool parallel = false;  // Whether num_parallel_workers of the op can be changed
+    int64_t compute_us = 0;
+    int64_t wait_input_us = 0;
+    int64_t wait_output_us = 0;
+    int64_t num_outputs = 0;  // Number of data buffers the op pushed to its output connector
+  };
+
+  // Constructor
+  // @param std::vector<OpTimes> ops - the profiled ops, in any order
+  // @param int32_t root_id - id of the root op
+  // @param int32_t cpu_budget - number of cpus the workers of the pipeline may use
+  CriticalPath(std::vector<OpTimes> ops, int32_t root_id, int32_t cpu_budget);
+
+  ~CriticalPath() = default;
+
+  // Find the bottleneck and the critical path, and suggest a number of workers for the bottleneck
+  // @return Status - The error code return
+  Status Analyze();
+
+  // @return int32_t - id of the bottleneck op, -1 if there is none
+  int32_t bottleneck() const { return bottleneck_; }
+
+  // @return std::vector<int32_t> - ids of the ops on the critical path, from the root down
+  const std::vector<int32_t> &path() const { return path_; }
+
+  // @return int32_t - suggested num_parallel_workers of the bottleneck, its current number if it can not be raised
+  int32_t suggested_workers() const { return suggested_workers_; }
+
+  // @return std::string - why the bottleneck was chosen and what to do about it
+  const std::string &reason() const { return reason_; }
+
+  // @return nlohmann::json - the busy time of every op, the critical path and the bottleneck
+  nlohmann::json ToJson() const;
+
+ private:
+  // @return double - compute time per worker of an op
+  static double BusyUs(const OpTimes &op) { return static_cast<double>(op.compute_us) / std::max(op.num_workers, 1); }
+
+  // Pick the suggested number of workers of the bottleneck
+  // @param OpTimes op - the bottleneck
+  // @param double next_busy_us - busy time of the busiest other op
+  // @param int32_t total_workers - number of workers of all the ops
+  void SuggestWorkers(const OpTimes &op, double next_busy_us, int32_t total_workers);
+
+  std::map<int32_t, OpTimes> ops_;  // keyed by op id
+  std::map<int32_t, int32_t> parents_;
+  int32_t root_id_;
+  int32_t cpu_budget_;
+  int32_t bottleneck_ = -1;
+  std::vector<int32_t> path_;
+  int32_t suggested_workers_ = 0;
+  std::string reason_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_CRITICAL_PATH_H_
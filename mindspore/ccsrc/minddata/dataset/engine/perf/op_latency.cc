@@ -0,0 +1,193 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/perf/op_latency.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The compute interval of the calling thread: it started at mark_us, and idle_us of it were spent waiting.
+// A thread only ever works for one op, the owner tells whether the interval was started by that op at all.
+struct ThreadClock {
+  const OpLatency *owner = nullptr;
+  int64_t mark_us = -1;
+  int64_t idle_us = 0;
+};
+
+thread_local ThreadClock gThreadClock;
+
+int32_t BucketOf(int64_t us) {
+  int32_t bucket = 0;
+  while (us > 0 && bucket < LatencyHistogram::kNumBuckets - 1) {
+    us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+}  // namespace
+
+constexpr int32_t LatencyHistogram::kNumBuckets;
+
+void LatencyHistogram::Add(int64_t us) {
+  us = std::max(us, int64_t(0));
+  buckets_[BucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_us_.fetch_add(us, std::memory_order_relaxed);
+  int64_t max_us = max_us_.load(std::memory_order_relaxed);
+  while (us > max_us && !max_us_.compare_exchange_weak(max_us, us, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other) {
+  for (int32_t i = 0; i < kNumBuckets; i++) {
+    buckets_[i].fetch_add(other.buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  count_.fetch_add(other.count(), std::memory_order_relaxed);
+  total_us_.fetch_add(other.total_us(), std::memory_order_relaxed);
+  int64_t max_us = max_us_.load(std::memory_order_relaxed);
+  while (other.max_us() > max_us && !max_us_.compare_exchange_weak(max_us, other.max_us(), std::memory_order_relaxed)) {
+  }
+}
+
+int64_t LatencyHistogram::Percentile(double p) const {
+  int64_t count = this->count();
+  if (count == 0) {
+    return 0;
+  }
+  auto rank = std::max(static_cast<int64_t>(std::ceil(p / 100 * count)), int64_t(1));
+  int64_t seen = 0;
+  for (int32_t i = 0; i < kNumBuckets; i++) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      int64_t upper = i == 0 ? 0 : (int64_t(1) << i) - 1;
+      return std::min(upper, max_us());
+    }
+  }
+  return max_us();
+}
+
+nlohmann::json LatencyHistogram::ToJson() const {
+  nlohmann::json out;
+  int64_t count = this->count();
+  out["count"] = count;
+  out["total_us"] = total_us();
+  out["mean_us"] = count == 0 ? 0.0 : static_cast<double>(total_us()) / count;
+  out["p50_us"] = Percentile(50);
+  out["p90_us"] = Percentile(90);
+  out["p99_us"] = Percentile(99);
+  out["max_us"] = max_us();
+  // Bucket b > 0 holds the durations in [2^(b-1), 2^b), trailing empty buckets are left out
+  std::vector<int64_t> buckets;
+  for (int32_t i = 0; i < kNumBuckets; i++) {
+    buckets.push_back(buckets_[i].load(std::memory_order_relaxed));
+  }
+  while (!buckets.empty() && buckets.back() == 0) {
+    buckets.pop_back();
+  }
+  out["buckets"] = buckets;
+  return out;
+}
+
+OpLatency::OpLatency(int32_t num_producers, int32_t num_consumers) {
+  for (int32_t i = 0; i < std::max(num_producers, 1); i++) {
+    compute_.push_back(std::make_unique<LatencyHistogram>());
+    wait_output_.push_back(std::make_unique<LatencyHistogram>());
+  }
+  for (int32_t i = 0; i < std::max(num_consumers, 1); i++) {
+    wait_input_.push_back(std::make_unique<LatencyHistogram>());
+  }
+}
+
+int64_t OpLatency::NowUs() {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::steady_clock;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void OpLatency::AddThreadWait(int64_t start_us, int64_t end_us) {
+  ThreadClock &clock = gThreadClock;
+  if (clock.owner != this || clock.mark_us < 0) {
+    clock.owner = this;
+    clock.mark_us = start_us;
+    clock.idle_us = 0;
+  }
+  clock.idle_us += end_us - start_us;
+}
+
+void OpLatency::RecordInput(int32_t worker_id, int64_t start_us, int64_t end_us) {
+  if (worker_id >= 0 && worker_id < num_consumers()) {
+    wait_input_[worker_id]->Add(end_us - start_us);
+  }
+  AddThreadWait(start_us, end_us);
+}
+
+void OpLatency::RecordIdle(int64_t start_us, int64_t end_us) { AddThreadWait(start_us, end_us); }
+
+void OpLatency::RecordOutput(int32_t worker_id, int64_t start_us, int64_t end_us, bool is_data) {
+  if (worker_id < 0 || worker_id >= num_producers()) {
+    return;
+  }
+  wait_output_[worker_id]->Add(end_us - start_us);
+  ThreadClock &clock = gThreadClock;
+  if (is_data && clock.owner == this && clock.mark_us >= 0) {
+    compute_[worker_id]->Add(start_us - clock.mark_us - clock.idle_us);
+  }
+  // The time until the first buffer of the next epoch is spent waiting for the epoch to start, not computing
+  clock.owner = this;
+  clock.mark_us = is_data ? end_us : -1;
+  clock.idle_us = 0;
+}
+
+const LatencyHistogram &OpLatency::Histogram(Stage stage, int32_t worker_id) const {
+  switch (stage) {
+    case kCompute:
+      return *compute_[worker_id];
+    case kWaitOutput:
+      return *wait_output_[worker_id];
+    default:
+      return *wait_input_[worker_id];
+  }
+}
+
+std::unique_ptr<LatencyHistogram> OpLatency::Total(Stage stage) const {
+  auto total = std::make_unique<LatencyHistogram>();
+  int32_t num_threads = stage == kWaitInput ? num_consumers() : num_producers();
+  for (int32_t i = 0; i < num_threads; i++) {
+    total->Merge(Histogram(stage, i));
+  }
+  return total;
+}
+
+nlohmann::json OpLatency::ToJson() const {
+  nlohmann::json out;
+  out["compute"] = Total(kCompute)->ToJson();
+  out["wait_input"] = Total(kWaitInput)->ToJson();
+  out["wait_output"] = Total(kWaitOutput)->ToJson();
+  for (int32_t i = 0; i < num_producers(); i++) {
+    out["producers"].push_back(
+      {{"compute", compute_[i]->ToJson()}, {"wait_output", wait_output_[i]->ToJson()}, {"worker_id", i}});
+  }
+  for (int32_t i = 0; i < num_consumers(); i++) {
+    out["consumers"].push_back({{"wait_input", wait_input_[i]->ToJson()}, {"worker_id", i}});
+  }
+  return out;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace mindspore {
+namespace dataset {
+// A histogram of durations in microseconds with power of two buckets: bucket 0 counts durations of 0us and
+// bucket b > 0 counts durations in [2^(b-1), 2^b). Recording is lock free, so the threads of an op can share it.
+class LatencyHistogram {
+ public:
+  static constexpr int32_t kNumBuckets = 40;
+
+  LatencyHistogram() = default;
+
+  ~LatencyHistogram() = default;
+
+  // Record one duration
+  // @param int64_t us - the duration in microseconds, negative values count as 0
+  void Add(int64_t us);
+
+  // Add the counts of another histogram to this one
+  // @param LatencyHistogram other - the histogram to merge
+  void Merge(const LatencyHistogram &other);
+
+  // @return int64_t - number of recorded durations
+  int64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+  // @return int64_t - sum of the recorded durations in microseconds
+  int64_t total_us() const { return total_us_.load(std::memory_order_relaxed); }
+
+  // @return int64_t - longest recorded duration in microseconds
+  int64_t max_us() const { return max_us_.load(std::memory_order_relaxed); }
+
+  // Estimate a percentile from the buckets
+  // @param double p - the percentile, in [0, 100]
+  // @return int64_t - upper bound of the bucket holding the percentile, capped by the longest duration
+  int64_t Percentile(double p) const;
+
+  // @return nlohmann::json - count, total, mean, p50, p90, p99 and max, followed by the non empty buckets
+  nlohmann::json ToJson() const;
+
+ private:
+  std::array<std::atomic<int64_t>, kNumBuckets> buckets_{};
+  std::atomic<int64_t> count_{0};
+  std::atomic<int64_t> total_us_{0};
+  std::atomic<int64_t> max_us_{0};
+};
+
+// OpLatency keeps latency histograms of the threads of one op, split by what the thread was doing:
+// 1) wait-on-input: blocked popping a buffer from the output connector of a child, one histogram per consumer id
+// 2) wait-on-output: blocked pushing a buffer to the own output connector, one histogram per producer id
+// 3) compute: the time between two buffers pushed by the same producer thread, less the waits it recorded in
+//    between, one histogram per producer id
+// The connectors record the waits (see DbConnector). Ops whose workers are fed by an internal queue mark the time
+// blocked on that queue as idle, so that it does not count as compute.
+class OpLatency {
+ public:
+  enum Stage : int32_t { kCompute = 0, kWaitInput, kWaitOutput, kNumStages };
+
+  // Marks the lifetime of the object as idle time of the calling thread, does nothing if the latency is null
+  class IdleScope {
+   public:
+    explicit IdleScope(OpLatency *latency) : latency_(latency), start_us_(latency == nullptr ? 0 : NowUs()) {}
+
+    ~IdleScope() {
+      if (latency_ != nullptr) {
+        latency_->RecordIdle(start_us_, NowUs());
+      }
+    }
+
+   private:
+    OpLatency *latency_;
+    int64_t start_us_;
+  };
+
+  // Constructor
+  // @param int32_t num_producers - number of threads pushing to the output connector of the op
+  // @param int32_t num_consumers - number of threads popping from the output connectors of the children
+  OpLatency(int32_t num_producers, int32_t num_consumers);
+
+  ~OpLatency() = default;
+
+  // @return int64_t - the current time of the steady clock in microseconds
+  static int64_t NowUs();
+
+  // Record the wait of a consumer thread for an input buffer
+  // @param int32_t worker_id - consumer id of the calling thread
+  // @param int64_t start_us - when the pop started
+  // @param int64_t end_us - when the pop returned
+  void RecordInput(int32_t worker_id, int64_t start_us, int64_t end_us);
+
+  // Record the push of an output buffer by a producer thread
+  // @param int32_t worker_id - producer id of the calling thread
+  // @param int64_t start_us - when the push started
+  // @param int64_t end_us - when the push returned
+  // @param bool is_data - false for eoe and eof buffers, which end the compute interval instead of closing it
+  void RecordOutput(int32_t worker_id, int64_t start_us, int64_t end_us, bool is_data);
+
+  // Record a wait of the calling thread that is neither for input nor for output, it is excluded from compute
+  // @param int64_t start_us - when the wait started
+  // @param int64_t end_us - when the wait ended
+  void RecordIdle(int64_t start_us, int64_t end_us);
+
+  // @return int32_t - number of producer histograms
+  int32_t num_producers() const { return static_cast<int32_t>(compute_.size()); }
+
+  // @return int32_t - number of consumer histograms
+  int32_t num_consumers() const { return static_cast<int32_t>(wait_input_.size()); }
+
+  // Get the histogram of one thread
+  // @param Stage stage - what the thread was doing
+  // @param int32_t worker_id - producer id for compute and wait-on-output, consumer id for wait-on-input
+  // @return const LatencyHistogram & - the histogram
+  const LatencyHistogram &Histogram(Stage stage, int32_t worker_id) const;
+
+  // Merge the histograms of all the threads
+  // @param Stage stage - what the threads were doing
+  // @return std::unique_ptr<LatencyHistogram> - the merged histogram, not shared with the recording threads
+  std::unique_ptr<LatencyHistogram> Total(Stage stage) const;
+
+  // @return nlohmann::json - the merged histograms and the histograms of each thread
+  nlohmann::json ToJson() const;
+
+ private:
+  // Account a wait of the calling thread, starting its compute interval if it has none yet
+  void AddThreadWait(int64_t start_us, int64_t end_us);
+
+  std::vector<std::unique_ptr<LatencyHistogram>> compute_;
+  std::vector<std::unique_ptr<LatencyHistogram>> wait_output_;
+  std::vector<std::unique_ptr<LatencyHistogram>> wait_input_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_H_
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/perf/op_latency_tracing.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/engine/perf/critical_path.h"
+#include "minddata/dataset/engine/perf/op_latency.h"
+#include "minddata/dataset/util/path.h"
+#include "mindspore/core/utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+Status OpLatencyTracing::Init(const std::string &dir_path, const std::string &device_id) {
+  file_path_ = (Path(dir_path) / Path("op_latency_profiling_" + device_id + ".json")).toString();
+  for (auto &op : *tree_) {
+    RETURN_IF_NOT_OK(op.EnableLatencyProfiling());
+  }
+  start_us_ = OpLatency::NowUs();
+  return Status::OK();
+}
+
+Status OpLatencyTracing::SaveToFile() {
+  nlohmann::json output;
+  std::vector<CriticalPath::OpTimes> ops;
+  for (auto &op : *tree_) {
+    CriticalPath::OpTimes times;
+    times.op_id = op.id();
+    times.name = op.Name();
+    for (const auto &child : op.Children()) {
+      times.children.push_back(child->id());
+    }
+    times.num_workers = op.num_workers();
+    times.parallel = dynamic_cast<ParallelOp *>(&op) != nullptr;
+    nlohmann::json json_node = {{"op_id", op.id()}, {"op_type", op.Name()}, {"num_workers", op.num_workers()}};
+    OpLatency *latency = op.latency();
+    if (latency != nullptr) {
+      auto compute = latency->Total(OpLatency::kCompute);
+      times.compute_us = compute->total_us();
+      times.num_outputs = compute->count();
+      times.wait_input_us = latency->Total(OpLatency::kWaitInput)->total_us();
+      times.wait_output_us = latency->Total(OpLatency::kWaitOutput)->total_us();
+      json_node["latency"] = latency->ToJson();
+    }
+    output["op_info"].push_back(json_node);
+    ops.push_back(std::move(times));
+  }
+  output["elapsed_us"] = OpLatency::NowUs() - start_us_;
+
+  int32_t cpu_budget = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+  CriticalPath critical_path(std::move(ops), tree_->root()->id(), cpu_budget);
+  RETURN_IF_NOT_OK(critical_path.Analyze());
+  output["analysis"] = critical_path.ToJson();
+  MS_LOG(INFO) << "Critical path of the pipeline: " << output["analysis"]["critical_path"].dump() << ". "
+               << critical_path.reason();
+
+  // Discard the content of the file when opening.
+  std::ofstream os(file_path_, std::ios::trunc);
+  os << output;
+  return Status::OK();
+}
+
+Status OpLatencyTracing::ChangeFileMode() {
+  if (file_path_.empty()) {
+    return Status::OK();
+  }
+
+  if (chmod(common::SafeCStr(file_path_), S_IRUSR | S_IWUSR) == -1) {
+    std::string err_str = "Change file mode failed," + file_path_;
+    return Status(StatusCode::kUnexpectedError, err_str);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_TRACING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_TRACING_H_
+
+#include <string>
+#include "minddata/dataset/engine/perf/profiling.h"
+
+namespace mindspore {
+namespace dataset {
+class ExecutionTree;
+
+// Op latency tracing turns on the latency histograms of every op of the pipeline (see OpLatency) and saves them
+// together with the critical path of the pipeline (see CriticalPath) to op_latency_profiling_<device id>.json.
+// The ops and the connectors record the latencies themselves, so this node has nothing to record on request.
+class OpLatencyTracing : public Tracing {
+ public:
+  explicit OpLatencyTracing(ExecutionTree *tree) : tree_(tree), start_us_(0) {}
+
+  ~OpLatencyTracing() override = default;
+
+  std::string Name() const override { return kOpLatencyTracingName; }
+
+  // Save the histograms and the analysis to file, the bottleneck is also written to the log
+  // @return Status - The error code return
+  Status SaveToFile() override;
+
+  Status Init(const std::string &dir_path, const std::string &device_id) override;
+
+  Status ChangeFileMode() override;
+
+ private:
+  ExecutionTree *tree_ = nullptr;  // ExecutionTree pointer
+  int64_t start_us_;               // When the recording started
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_TRACING_H_
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+Status RandomCropDecodeResizeNormalizeOp::Compute(const std::shared_ptr<Tensor> &input,
+                                                  std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  // The decode, crop and resize stay in uint8, the first float buffer written is the output itself.
+  std::shared_ptr<Tensor> resized;
+  RETURN_IF_NOT_OK(RandomCropDecodeResizeOp::Compute(input, &resized));
+  return NormalizeHwcToChw(resized, output, mean_, std_, hwc_to_chw_);
+}
+
+Status RandomCropDecodeResizeNormalizeOp::OutputShape(const std::vector<TensorShape> &inputs,
+                                                      std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  if (hwc_to_chw_) {
+    outputs.emplace_back(TensorShape{3, target_height_, target_width_});
+  } else {
+    outputs.emplace_back(TensorShape{target_height_, target_width_, 3});
+  }
+  return Status::OK();
+}
+
+Status RandomCropDecodeResizeNormalizeOp::OutputType(const std::vector<DataType> &inputs,
+                                                     std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_FLOAT32);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \class RandomCropDecodeResizeNormalizeOp
+/// \brief Fused form of RandomCropDecodeResizeOp followed by NormalizeOp and optionally HwcToChwOp. The normalization
+///     and the channel transposition are done in one pass that writes directly into the output float tensor.
+///     It is created by TensorOpFusionPass and is not exposed to the user.
+class RandomCropDecodeResizeNormalizeOp : public RandomCropDecodeResizeOp {
+ public:
+  RandomCropDecodeResizeNormalizeOp(const RandomCropAndResizeOp &rhs, const NormalizeOp &normalize, bool hwc_to_chw)
+      : RandomCropDecodeResizeOp(rhs), mean_(normalize.GetMean()), std_(normalize.GetStd()), hwc_to_chw_(hwc_to_chw) {}
+
+  ~RandomCropDecodeResizeNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override {
+    out << Name() << ": " << target_height_ << " " << target_width_ << " hwc_to_chw: " << hwc_to_chw_;
+  }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kRandomCropDecodeResizeNormalizeOp; }
+
+ private:
+  std::shared_ptr<Tensor> mean_;
+  std::shared_ptr<Tensor> std_;
+  bool hwc_to_chw_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
@@ -48,6 +48,21 @@ Status TensorOp::Compute(const TensorRow &input, TensorRow *output) {
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+// Name: BatchCompute()
+// Description: This BatchCompute() takes a batch of rows and calls Compute() on each of them.
+Status TensorOp::BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  if (output == nullptr) {
+    RETURN_STATUS_UNEXPECTED("output is null.");
+  }
+  output->clear();
+  output->reserve(input.size());
+  for (const auto &row : input) {
+    output->emplace_back();
+    RETURN_IF_NOT_OK(Compute(row, &output->back()));
+  }
+  return Status::OK();
+}
+
 Status TensorOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   if (inputs.size() != NumInput())
     return Status(StatusCode::kUnexpectedError,
@@ -67,6 +67,7 @@ constexpr char kRandomColorAdjustOp[] = "RandomColorAdjustOp";
 constexpr char kRandomCropAndResizeOp[] = "RandomCropAndResizeOp";
 constexpr char kRandomCropAndResizeWithBBoxOp[] = "RandomCropAndResizeWithBBoxOp";
 constexpr char kRandomCropDecodeResizeOp[] = "RandomCropDecodeResizeOp";
+constexpr char kRandomCropDecodeResizeNormalizeOp[] = "RandomCropDecodeResizeNormalizeOp";
 constexpr char kRandomCropOp[] = "RandomCropOp";
 constexpr char kRandomCropWithBBoxOp[] = "RandomCropWithBBoxOp";
 constexpr char kRandomHorizontalFlipWithBBoxOp[] = "RandomHorizontalFlipWithBBoxOp";
@@ -165,6 +166,13 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const TensorRow &input, TensorRow *output);
 
+  // Perform the operation on a batch of rows at once. A TensorOp that can share work across rows (scratch buffers,
+  // lookup tables) overrides this, the default computes the rows one by one.
+  // @param input is the rows to process.
+  // @param output is the address to a vector where one result row per input row will be placed.
+  // @return Status
+  virtual Status BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output);
+
   // Returns true oif the TensorOp takes one input and returns one output.
   // @return true/false
   bool OneToOne() { return NumInput() == 1 && NumOutput() == 1; }
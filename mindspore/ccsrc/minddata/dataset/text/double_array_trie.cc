@@ -0,0 +1,136 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/double_array_trie.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kFreeSlot = -1;
+}  // namespace
+
+DoubleArrayTrie::DoubleArrayTrie(std::vector<std::string> keys) {
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  // slot 0 is the root, it is nobody's child
+  Resize(1);
+  Occupy(kRoot, kRoot);
+  Insert(keys, kRoot, 0, 0, keys.size());
+  // the tail past the last child is never used
+  size_t size = check_.size();
+  while (size > 1 && check_[size - 1] == kFreeSlot) size--;
+  base_.resize(size);
+  check_.resize(size);
+  is_key_.resize(size);
+  base_.shrink_to_fit();
+  check_.shrink_to_fit();
+  is_key_.shrink_to_fit();
+  std::vector<int32_t>().swap(next_free_);
+  std::vector<int32_t>().swap(prev_free_);
+}
+
+void DoubleArrayTrie::Resize(size_t size) {
+  size_t old_size = check_.size();
+  base_.resize(size, 0);
+  check_.resize(size, kFreeSlot);
+  is_key_.resize(size, 0);
+  next_free_.resize(size, -1);
+  prev_free_.resize(size, -1);
+  for (size_t i = old_size; i < size; i++) {
+    auto slot = static_cast<int32_t>(i);
+    prev_free_[slot] = last_free_;
+    if (last_free_ == -1) {
+      first_free_ = slot;
+    } else {
+      next_free_[last_free_] = slot;
+    }
+    last_free_ = slot;
+  }
+}
+
+void DoubleArrayTrie::Occupy(int32_t slot, int32_t state) {
+  check_[slot] = state;
+  int32_t prev = prev_free_[slot];
+  int32_t next = next_free_[slot];
+  if (prev == -1) {
+    first_free_ = next;
+  } else {
+    next_free_[prev] = next;
+  }
+  if (next == -1) {
+    last_free_ = prev;
+  } else {
+    prev_free_[next] = prev;
+  }
+}
+
+void DoubleArrayTrie::Insert(const std::vector<std::string> &keys, int32_t state, size_t depth, size_t begin,
+                             size_t end) {
+  // keys are sorted, so the one equal to the prefix comes first and each child owns a contiguous range
+  if (begin < end && keys[begin].size() == depth) {
+    is_key_[state] = 1;
+    begin++;
+  }
+  if (begin == end) {
+    return;
+  }
+  std::vector<uint8_t> labels;
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t i = begin; i < end; i++) {
+    auto label = static_cast<uint8_t>(keys[i][depth]);
+    if (labels.empty() || labels.back() != label) {
+      labels.push_back(label);
+      ranges.emplace_back(i, i);
+    }
+    ranges.back().second = i + 1;
+  }
+
+  int32_t base = FindBase(labels);
+  base_[state] = base;
+  for (auto label : labels) {
+    Occupy(base + label + 1, state);
+  }
+
+  for (size_t i = 0; i < labels.size(); i++) {
+    Insert(keys, base + labels[i] + 1, depth + 1, ranges[i].first, ranges[i].second);
+  }
+}
+
+int32_t DoubleArrayTrie::FindBase(const std::vector<uint8_t> &labels) {
+  // try the free slots in turn for the first label, past the last one the arrays grow
+  int32_t pos = first_free_;
+  while (true) {
+    if (pos == -1) {
+      pos = std::max(static_cast<int32_t>(check_.size()), labels[0] + 1);
+    }
+    int32_t base = pos - labels[0] - 1;
+    if (base >= 0) {
+      size_t needed = static_cast<size_t>(base) + labels.back() + 2;
+      if (needed > check_.size()) {
+        Resize(needed);
+      }
+      if (std::all_of(labels.begin(), labels.end(),
+                      [this, base](uint8_t label) { return check_[base + label + 1] == kFreeSlot; })) {
+        return base;
+      }
+    }
+    pos = next_free_[pos];
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+/// \brief An immutable byte-wise trie of a set of strings, stored as a double array.
+/// The child of state s along byte c is t = base[s] + c + 1, which exists only if check[t] == s. A lookup takes one
+/// step per byte and touches two arrays only, so walking a word finds all the keys that are prefixes of it at once.
+class DoubleArrayTrie {
+ public:
+  /// \brief The state of the empty prefix
+  static constexpr int32_t kRoot = 0;
+
+  /// \brief Constructor
+  /// \param[in] keys The strings in the trie, in any order and possibly repeated
+  explicit DoubleArrayTrie(std::vector<std::string> keys = {});
+
+  ~DoubleArrayTrie() = default;
+
+  /// \brief Moves a state along a byte
+  /// \param[in, out] state The state to move, left as it is if there is no such child
+  /// \param[in] c The byte
+  /// \return Whether the child exists, i.e. whether some key starts with the prefix of the state followed by c
+  bool Next(int32_t *state, uint8_t c) const {
+    size_t next = static_cast<size_t>(base_[*state]) + c + 1;
+    if (next >= check_.size() || check_[next] != *state) {
+      return false;
+    }
+    *state = static_cast<int32_t>(next);
+    return true;
+  }
+
+  /// \return Whether the prefix of a state is a key
+  bool IsKey(int32_t state) const { return is_key_[state] != 0; }
+
+  /// \return Number of slots in the arrays
+  size_t Size() const { return check_.size(); }
+
+ private:
+  /// \brief Places the children of a state and then their own children
+  /// \param[in] keys The sorted keys
+  /// \param[in] state The state
+  /// \param[in] depth Length of the prefix of the state
+  /// \param[in] begin First key starting with the prefix
+  /// \param[in] end One past the last key starting with the prefix
+  void Insert(const std::vector<std::string> &keys, int32_t state, size_t depth, size_t begin, size_t end);
+
+  /// \brief Finds a base where the slots of all the labels are free and makes sure the arrays hold them
+  int32_t FindBase(const std::vector<uint8_t> &labels);
+
+  /// \brief Grows the arrays to a number of slots, the new ones are free
+  void Resize(size_t size);
+
+  /// \brief Takes a free slot for a child of a state
+  void Occupy(int32_t slot, int32_t state);
+
+  std::vector<int32_t> base_;
+  std::vector<int32_t> check_;  // parent of a slot, -1 if it is free
+  std::vector<uint8_t> is_key_;
+  // While building, the free slots are linked in ascending order so finding a base skips the used ones
+  std::vector<int32_t> next_free_;
+  std::vector<int32_t> prev_free_;
+  int32_t first_free_ = -1;
+  int32_t last_free_ = -1;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
@@ -23,5 +23,12 @@ Status BertTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   RETURN_IF_NOT_OK(wordpiece_tokenizer_.Compute(basic_tensor, output));
   return Status::OK();
 }
+
+Status BertTokenizerOp::BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  std::vector<TensorRow> basic_tensors;
+  RETURN_IF_NOT_OK(basic_tokenizer_.BatchCompute(input, &basic_tensors));
+  RETURN_IF_NOT_OK(wordpiece_tokenizer_.BatchCompute(basic_tensors, output));
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
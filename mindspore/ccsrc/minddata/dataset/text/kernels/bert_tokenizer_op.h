@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_BERT_TOKENIZER_OP_H_
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -44,6 +45,8 @@ class BertTokenizerOp : public TensorOp {
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  Status BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) override;
+
   std::string Name() const override { return kBertTokenizerOp; }
 
  private:
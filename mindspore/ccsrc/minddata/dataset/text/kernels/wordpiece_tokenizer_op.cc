@@ -26,6 +26,18 @@ const int WordpieceTokenizerOp::kDefMaxBytesPerToken = 100;
 const char WordpieceTokenizerOp::kDefUnknownToken[] = "[UNK]";
 const bool WordpieceTokenizerOp::kDefWithOffsets = false;
 
+namespace {
+std::vector<std::string> VocabWords(const std::shared_ptr<Vocab> &vocab) {
+  std::vector<std::string> words;
+  if (vocab != nullptr) {
+    for (const auto &item : vocab->vocab()) {
+      words.push_back(item.first);
+    }
+  }
+  return words;
+}
+}  // namespace
+
 WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                                            const int &max_bytes_per_token, const std::string &unknown_token,
                                            const bool &with_offsets)
@@ -33,31 +45,40 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
       unknown_token_(unknown_token),
-      with_offsets_(with_offsets) {}
+      with_offsets_(with_offsets),
+      vocab_trie_(VocabWords(vocab)),
+      suffix_state_(DoubleArrayTrie::kRoot) {
+  for (auto c : suffix_indicator_) {
+    if (!vocab_trie_.Next(&suffix_state_, static_cast<uint8_t>(c))) {
+      suffix_state_ = -1;
+      break;
+    }
+  }
+}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
+Status WordpieceTokenizerOp::LookupWord(std::string_view input_token, const int start, bool *out_found,
+                                        int *out_end) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "Out of range");
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
+  int32_t state = start > 0 ? suffix_state_ : DoubleArrayTrie::kRoot;
+  if (state < 0) {
+    return Status::OK();
+  }
+  int size = static_cast<int>(input_token.size());
+  for (int i = start; i < size && vocab_trie_.Next(&state, static_cast<uint8_t>(input_token[i]));) {
+    i++;
+    // only a word ending right before the leading byte of a rune counts, not one ending inside it
+    if (vocab_trie_.IsKey(state) && (i == size || (static_cast<uint8_t>(input_token[i]) & 0xC0) != 0x80)) {
       *out_found = true;
-      break;
+      *out_end = i;
     }
   }
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::FoundNoToken(std::string_view input_token, const uint32_t &basic_start,
                                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
-  out_tokens->clear();
   offsets_start->push_back(basic_start);
   if (unknown_token_.empty()) {
     out_tokens->emplace_back(input_token);
@@ -69,18 +90,21 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
+Status WordpieceTokenizerOp::AddSubword(std::string_view input_token, const int &start, const int &end,
                                         std::vector<std::string> *out_tokens) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= input_token.size(), "Out of range");
-  std::string subword = input_token.substr(start, end - start);
   if (start > 0) {
-    subword = suffix_indicator_ + subword;
+    std::string subword;
+    subword.reserve(suffix_indicator_.size() + end - start);
+    subword.append(suffix_indicator_).append(input_token.substr(start, end - start));
+    out_tokens->emplace_back(std::move(subword));
+  } else {
+    out_tokens->emplace_back(input_token.substr(start, end - start));
   }
-  out_tokens->emplace_back(subword);
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::GetTokens(std::string_view input_token, const uint32_t &basic_start,
                                        std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > max_bytes_per_token_) {
@@ -98,47 +122,59 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
     RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
   }
+  // the subwords found so far are dropped if the rest of the token is not in the vocab
+  size_t num_tokens = out_tokens->size();
+  size_t num_offsets = offsets_start->size();
   int end = 0;
   for (int start = 0; start < input_token.size();) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(input_token, start, &found, &end));
     if (found) {
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
       offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
       start = end;
     } else {
+      out_tokens->resize(num_tokens);
+      offsets_start->resize(num_offsets);
+      offsets_limit->resize(num_offsets);
       return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
     }
   }
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
-  IO_CHECK_VECTOR(input, output);
-  if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
+Status WordpieceTokenizerOp::TokenizeRow(const TensorRow &input, std::vector<std::string> *out_tokens,
+                                         std::vector<uint32_t> *offsets_start,
+                                         std::vector<uint32_t> *offsets_limit) const {
+  if (input.size() == 0 || input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("The input tensor should be scalar or 1-D string tensor");
   }
+  out_tokens->clear();
+  offsets_start->clear();
+  offsets_limit->clear();
   dsize_t count = 0;
-  std::vector<std::string> out_tokens;
-  std::vector<uint32_t> offsets_start, offsets_limit;
-  std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
-    std::vector<std::string> temp_tokens;
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count, 0}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
-    out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, out_tokens, offsets_start, offsets_limit));
     count++;
   }
-  if (out_tokens.empty()) {
-    out_tokens.emplace_back("");
-    offsets_start.push_back(0);
-    offsets_limit.push_back(0);
+  if (out_tokens->empty()) {
+    out_tokens->emplace_back("");
+    offsets_start->push_back(0);
+    offsets_limit->push_back(0);
   }
-  Tensor::CreateFromVector(out_tokens, &token_tensor);
+  return Status::OK();
+}
+
+Status WordpieceTokenizerOp::OutputRow(const std::vector<std::string> &out_tokens,
+                                       const std::vector<uint32_t> &offsets_start,
+                                       const std::vector<uint32_t> &offsets_limit, TensorRow *output) const {
+  std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(out_tokens, &token_tensor));
   output->push_back(token_tensor);
   if (with_offsets_) {
     RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_start, &offsets_start_tensor));
@@ -150,5 +186,29 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
   return Status::OK();
 }
 
+Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  std::vector<std::string> out_tokens;
+  std::vector<uint32_t> offsets_start, offsets_limit;
+  RETURN_IF_NOT_OK(TokenizeRow(input, &out_tokens, &offsets_start, &offsets_limit));
+  return OutputRow(out_tokens, offsets_start, offsets_limit, output);
+}
+
+Status WordpieceTokenizerOp::BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  RETURN_UNEXPECTED_IF_NULL(output);
+  // The buffers keep their capacity from one row to the next
+  std::vector<std::string> out_tokens;
+  std::vector<uint32_t> offsets_start, offsets_limit;
+  output->clear();
+  output->reserve(input.size());
+  for (const auto &row : input) {
+    IO_CHECK_VECTOR(row, output);
+    RETURN_IF_NOT_OK(TokenizeRow(row, &out_tokens, &offsets_start, &offsets_limit));
+    output->emplace_back();
+    RETURN_IF_NOT_OK(OutputRow(out_tokens, offsets_start, offsets_limit, &output->back()));
+  }
+  return Status::OK();
+}
+
 }  // namespace dataset
 }  // namespace mindspore
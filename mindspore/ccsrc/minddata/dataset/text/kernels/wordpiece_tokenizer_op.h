@@ -24,6 +24,7 @@
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/text/double_array_trie.h"
 #include "minddata/dataset/text/vocab.h"
 #include "minddata/dataset/util/status.h"
 
@@ -46,15 +47,23 @@ class WordpieceTokenizerOp : public TensorOp {
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  Status BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) override;
+
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
+  Status AddSubword(std::string_view input_token, const int &start, const int &end,
                     std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  Status FoundNoToken(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                       std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  // Walks the vocab trie from start and finds the longest word (a suffix word if start > 0) ending on a rune boundary
+  Status LookupWord(std::string_view input_token, const int start, bool *out_found, int *out_end) const;
+  // Appends the subwords of a token and their offsets
+  Status GetTokens(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                    std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  // Tokenizes all the tokens of a row into the given buffers, which are cleared first
+  Status TokenizeRow(const TensorRow &input, std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                     std::vector<uint32_t> *offsets_limit) const;
+  Status OutputRow(const std::vector<std::string> &out_tokens, const std::vector<uint32_t> &offsets_start,
+                   const std::vector<uint32_t> &offsets_limit, TensorRow *output) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
@@ -64,6 +73,10 @@ class WordpieceTokenizerOp : public TensorOp {
   const bool with_offsets_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  // all the words of the vocab, so a lookup walks the token once instead of hashing every prefix of it
+  DoubleArrayTrie vocab_trie_;
+  // state of the suffix indicator in the trie, where the lookup of a suffix word starts, -1 if no word has it
+  int32_t suffix_state_;
 };
 }  // namespace dataset
 }  // namespace mindspore
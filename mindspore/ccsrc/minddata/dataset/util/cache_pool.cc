@@ -20,13 +20,16 @@
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(const value_allocator &alloc, bool ourOwnArena, const std::string &root)
+CachePool::CachePool(const value_allocator &alloc, bool ourOwnArena, const std::string &root, EvictionPolicy policy)
     : alloc_(alloc),
       root_(root),
       subfolder_(Services::GetUniqueID()),
       sm_(nullptr),
       tree_(nullptr),
-      custom_arena_(ourOwnArena) {}
+      custom_arena_(ourOwnArena),
+      policy_(root.empty() ? EvictionPolicy::kNone : policy),
+      tracker_(policy_),
+      num_evicted_(0) {}
 
 Status CachePool::DoServiceStart() {
   tree_ = std::make_shared<data_index>();
@@ -85,9 +88,9 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
-  try {
-    if (!writeToDiskDirectly) {
-      bl.ptr = alloc_.allocate(sz);
+  if (!writeToDiskDirectly) {
+    rc = AllocateBuffer(sz, &bl.ptr);
+    if (rc.IsOk()) {
       // We will do a piecewise copy.
       WritableSlice dest(bl.ptr, bl.sz);
       size_t pos = 0;
@@ -104,7 +107,12 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
         bl.ptr = nullptr;
         return rc;
       }
-    } else if (sm_ != nullptr) {
+    } else if (!rc.IsOutofMemory()) {
+      return rc;
+    }
+  }
+  if (bl.ptr == nullptr) {
+    if (sm_ != nullptr) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
       RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
     } else {
@@ -112,12 +120,6 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       // instead.
       return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
     }
-  } catch (std::bad_alloc &e) {
-    if (sm_ != nullptr) {
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
-    } else {
-      return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
-    }
   }
   // Insert into the B+ tree. We may still get out of memory error. So need to catch it.
   try {
@@ -129,16 +131,65 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   if (rc.IsError() && bl.ptr != nullptr) {
     alloc_.deallocate(bl.ptr, sz);
   }
+  if (rc.IsOk() && bl.ptr != nullptr && policy_ != EvictionPolicy::kNone) {
+    tracker_.Add(key);
+  }
   return rc;
 }
+Status CachePool::AllocateBuffer(size_t sz, pointer *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  while (true) {
+    try {
+      *out = alloc_.allocate(sz);
+      return Status::OK();
+    } catch (const std::bad_alloc &e) {
+      key_type victim;
+      if (policy_ == EvictionPolicy::kNone || !tracker_.PopVictim(&victim)) {
+        return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+      }
+      RETURN_IF_NOT_OK(Evict(victim));
+    }
+  }
+}
+Status CachePool::Evict(key_type key) {
+  // Only the thread that pops a victim evicts it, so nobody else changes where the buffer is while we write it out.
+  // The locator itself never moves once inserted, we can hold on to it without locking the tree.
+  DataLocator *dl = nullptr;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second || r.first->ptr == nullptr) {
+      return Status::OK();
+    }
+    dl = &r.first.value();
+  }
+  pointer ptr = dl->ptr;
+  size_t sz = dl->sz;
+  StorageManager::key_type storage_key = 0;
+  ReadableSlice data(ptr, sz);
+  RETURN_IF_NOT_OK(sm_->Write(&storage_key, {data}));
+  {
+    UniqueLock lck(&evict_lock_);
+    dl->storage_key = storage_key;
+    dl->ptr = nullptr;
+  }
+  // No reader can be using the memory now
+  alloc_.deallocate(ptr, sz);
+  ++num_evicted_;
+  return Status::OK();
+}
 Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
   RETURN_UNEXPECTED_IF_NULL(dest);
+  // Always lock before searching the tree, eviction never holds the two at the same time.
+  SharedLock lck(&evict_lock_);
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
     if (it->ptr != nullptr) {
       ReadableSlice src(it->ptr, it->sz);
       RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      if (policy_ != EvictionPolicy::kNone) {
+        tracker_.Touch(key);
+      }
     } else if (sm_ != nullptr) {
       size_t expectedLength = 0;
       RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
@@ -164,6 +215,7 @@ Path CachePool::GetSpillPath() const {
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   CacheStat cs{-1, -1, 0, 0, 0};
   int64_t total_sz = 0;
+  SharedLock lck(&evict_lock_);
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
     cs.max_key = cs.min_key;  // will adjust later.
@@ -227,6 +279,47 @@ Status CachePool::Locate(CachePool::DataLocator *dl) {
   }
   return Status::OK();
 }
+void CachePool::EvictionTracker::Add(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (policy_ == EvictionPolicy::kLru) {
+    lru_.push_front(key);
+    lru_pos_[key] = lru_.begin();
+  } else if (policy_ == EvictionPolicy::kLfu) {
+    lfu_.emplace(0, key);
+    lfu_cnt_[key] = 0;
+  }
+}
+void CachePool::EvictionTracker::Touch(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (policy_ == EvictionPolicy::kLru) {
+    auto it = lru_pos_.find(key);
+    if (it != lru_pos_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+    }
+  } else if (policy_ == EvictionPolicy::kLfu) {
+    auto it = lfu_cnt_.find(key);
+    if (it != lfu_cnt_.end()) {
+      lfu_.erase(std::make_pair(it->second, key));
+      ++it->second;
+      lfu_.emplace(it->second, key);
+    }
+  }
+}
+bool CachePool::EvictionTracker::PopVictim(key_type *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (policy_ == EvictionPolicy::kLru && !lru_.empty()) {
+    *key = lru_.back();
+    lru_.pop_back();
+    lru_pos_.erase(*key);
+    return true;
+  } else if (policy_ == EvictionPolicy::kLfu && !lfu_.empty()) {
+    *key = lfu_.begin()->second;
+    lfu_.erase(lfu_.begin());
+    lfu_cnt_.erase(*key);
+    return true;
+  }
+  return false;
+}
 size_t CachePool::GetSize(CachePool::key_type key) const {
   auto r = tree_->Search(key);
   if (r.second) {
@@ -16,11 +16,17 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "minddata/dataset/util/allocator.h"
+#include "minddata/dataset/util/lock.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/storage_manager.h"
@@ -32,6 +38,8 @@ namespace dataset {
 /// \brief A CachePool provides service for backup/restore a buffer. A buffer can be represented in a form of vector of
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). User must provide a key to insert the buffer.
+/// With an eviction policy, buffers in memory are moved to disk to make room for new ones once the memory runs out,
+/// so that memory is a hot tier and disk a warm tier. Without one, new buffers go to disk directly instead.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -42,6 +50,13 @@ class CachePool : public Service {
   using const_reference = const base_type &;
   using value_allocator = Allocator<base_type>;
 
+  /// \brief How to pick the buffer to move to disk when the memory runs out
+  enum class EvictionPolicy : uint8_t {
+    kNone = 0,  // Nothing is evicted
+    kLru = 1,   // Evict the least recently used buffer
+    kLfu = 2    // Evict the least frequently used buffer
+  };
+
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
@@ -91,7 +106,9 @@ class CachePool : public Service {
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(const value_allocator &alloc, bool customArena, const std::string &root = "");
+  /// \param policy Eviction policy. Applies only if a disk folder is given
+  explicit CachePool(const value_allocator &alloc, bool customArena, const std::string &root = "",
+                     EvictionPolicy policy = EvictionPolicy::kNone);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -136,13 +153,51 @@ class CachePool : public Service {
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
 
+  /// \brief Number of buffers moved from memory to disk so far
+  int64_t GetNumEvicted() const { return num_evicted_; }
+
  private:
+  /// \brief Keeps track of the buffers in memory in the order they are to be evicted
+  class EvictionTracker {
+   public:
+    explicit EvictionTracker(EvictionPolicy policy) : policy_(policy) {}
+    ~EvictionTracker() = default;
+    /// \brief Start tracking a buffer put in memory
+    void Add(key_type key);
+    /// \brief Record a use of a buffer. Buffers not tracked are ignored.
+    void Touch(key_type key);
+    /// \brief Pick the buffer to evict and stop tracking it
+    /// \return false if there is nothing to evict
+    bool PopVictim(key_type *key);
+
+   private:
+    EvictionPolicy policy_;
+    std::mutex mux_;
+    std::list<key_type> lru_;  // Most recently used at the front
+    std::unordered_map<key_type, std::list<key_type>::iterator> lru_pos_;
+    std::set<std::pair<int64_t, key_type>> lfu_;  // Ordered by use count, least used first
+    std::unordered_map<key_type, int64_t> lfu_cnt_;
+  };
+
   value_allocator alloc_;
   Path root_;
   const std::string subfolder_;
   std::shared_ptr<StorageManager> sm_;
   std::shared_ptr<data_index> tree_;
   bool custom_arena_;
+  EvictionPolicy policy_;
+  // Readers hold it shared while they copy a buffer out of memory, eviction holds it exclusive to take the buffer
+  // out of memory.
+  mutable RWLock evict_lock_;
+  mutable EvictionTracker tracker_;
+  std::atomic<int64_t> num_evicted_;
+
+  /// \brief Allocate memory for a buffer, evicting other buffers to disk if needed
+  /// \return kOutOfMemory if there is no room even after evicting everything possible
+  Status AllocateBuffer(size_t sz, pointer *out);
+
+  /// \brief Move a buffer from memory to disk
+  Status Evict(key_type key);
 };
 }  // namespace dataset
 }  // namespace mindspore
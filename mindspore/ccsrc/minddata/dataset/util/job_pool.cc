@@ -0,0 +1,106 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/job_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace mindspore {
+namespace dataset {
+struct JobPool::Job {
+  Job(size_t n, const std::function<void(size_t)> *f) : num(n), func(f), next(0), done(0) {}
+  const size_t num;
+  const std::function<void(size_t)> *func;  // only called for an item left to run, ForEach waits for them
+  std::atomic<size_t> next;
+  std::atomic<size_t> done;
+  std::mutex mux;
+  std::condition_variable cv;
+};
+
+Status JobPool::Launch(TaskGroup *vg, int32_t num_threads, const std::string &name) {
+  RETURN_UNEXPECTED_IF_NULL(vg);
+  CHECK_FAIL_RETURN_UNEXPECTED(!launched_, "The threads of the job pool are already launched.");
+  if (num_threads <= 0) {
+    return Status::OK();
+  }
+  // every thread may hold a job of each caller, the ones added beyond wait for a free slot
+  RETURN_IF_NOT_OK(jobs_.Resize(2 * static_cast<size_t>(num_threads)));
+  RETURN_IF_NOT_OK(jobs_.Register(vg));
+  for (int32_t i = 0; i < num_threads; ++i) {
+    RETURN_IF_NOT_OK(vg->CreateAsyncTask(name, std::bind(&JobPool::ThreadEntry, this)));
+  }
+  num_threads_ = num_threads;
+  launched_ = true;
+  return Status::OK();
+}
+
+Status JobPool::Stop() {
+  if (!launched_) {
+    return Status::OK();
+  }
+  // an empty job makes a thread quit
+  for (int32_t i = 0; i < num_threads_; ++i) {
+    RETURN_IF_NOT_OK(jobs_.Add(std::shared_ptr<Job>()));
+  }
+  launched_ = false;
+  return Status::OK();
+}
+
+Status JobPool::ThreadEntry() {
+  TaskManager::FindMe()->Post();
+  std::shared_ptr<Job> job;
+  RETURN_IF_NOT_OK(jobs_.PopFront(&job));
+  while (job != nullptr) {
+    RunJob(job.get());
+    RETURN_IF_NOT_OK(jobs_.PopFront(&job));
+  }
+  return Status::OK();
+}
+
+void JobPool::RunJob(Job *job) {
+  for (size_t i = job->next++; i < job->num; i = job->next++) {
+    (*job->func)(i);
+    if (++job->done == job->num) {
+      std::lock_guard<std::mutex> lock(job->mux);
+      job->cv.notify_all();
+    }
+  }
+}
+
+void JobPool::ForEach(size_t num, const std::function<void(size_t)> &func) {
+  if (!launched_ || num < 2) {
+    for (size_t i = 0; i < num; ++i) {
+      func(i);
+    }
+    return;
+  }
+  auto job = std::make_shared<Job>(num, &func);
+  // a thread taking the job late finds no item left and drops it
+  size_t num_helpers = std::min(num - 1, static_cast<size_t>(num_threads_));
+  for (size_t i = 0; i < num_helpers; ++i) {
+    if (jobs_.Add(job).IsError()) {
+      break;
+    }
+  }
+  RunJob(job.get());
+  // only the items already taken by the threads of the pool are left
+  std::unique_lock<std::mutex> lock(job->mux);
+  job->cv.wait(lock, [&job]() { return job->done == job->num; });
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_JOB_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_JOB_POOL_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A pool of threads helping the threads that call ForEach. Every call is a job whose items are taken one at a
+/// time by the calling thread and the threads of the pool, so a job is done even while all the threads of the pool
+/// are busy with the jobs of other callers.
+class JobPool {
+ public:
+  JobPool() : num_threads_(0), launched_(false), jobs_(1) {}
+
+  ~JobPool() = default;
+
+  /// \brief Launches the threads, until then the items are all run by the calling thread.
+  /// \param[in] vg The task group running the threads, the queue of the jobs is interrupted with it.
+  /// \param[in] num_threads The number of threads to launch, none are launched if it is not positive.
+  /// \param[in] name The name of the threads.
+  /// \return Status code
+  Status Launch(TaskGroup *vg, int32_t num_threads, const std::string &name);
+
+  /// \brief Runs func(0), ..., func(num - 1) on the calling thread and the threads of the pool, and waits for all of
+  /// them.
+  void ForEach(size_t num, const std::function<void(size_t)> &func);
+
+  /// \brief Makes the threads quit once the jobs queued before are run. Without it, the threads run until their task
+  /// group is interrupted.
+  /// \return Status code
+  Status Stop();
+
+  /// \return The number of threads launched.
+  int32_t NumThreads() const { return launched_ ? num_threads_ : 0; }
+
+ private:
+  // The items of one ForEach call
+  struct Job;
+
+  Status ThreadEntry();
+
+  // Runs items of the job until none is left
+  static void RunJob(Job *job);
+
+  int32_t num_threads_;
+  bool launched_;
+  Queue<std::shared_ptr<Job>> jobs_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_JOB_POOL_H_
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/numa.h"
+
+#if defined(__linux__) && !defined(__ANDROID__) && !defined(ANDROID)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr char kNodeDir[] = "/sys/devices/system/node/";
+// mode of set_mempolicy, allocate from the given node first and fall back to the others when it is full
+constexpr int kMpolPreferred = 1;
+constexpr int32_t kBitsPerMaskWord = 8 * sizeof(unsigned long);  // NOLINT
+}  // namespace
+
+Status Numa::ParseList(const std::string &list, std::vector<int32_t> *ids) {
+  RETURN_UNEXPECTED_IF_NULL(ids);
+  ids->clear();
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range == "\n") continue;
+    try {
+      size_t dash = range.find('-');
+      int32_t first = std::stoi(range.substr(0, dash));
+      int32_t last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int32_t id = first; id <= last; id++) {
+        ids->push_back(id);
+      }
+    } catch (const std::exception &) {
+      RETURN_STATUS_UNEXPECTED("Invalid sysfs list: " + list);
+    }
+  }
+  return Status::OK();
+}
+
+int32_t Numa::NumNodes() {
+  std::ifstream in(std::string(kNodeDir) + "online");
+  std::string online;
+  std::vector<int32_t> nodes;
+  if (!in.is_open() || !std::getline(in, online) || ParseList(online, &nodes).IsError() || nodes.empty()) {
+    return 1;
+  }
+  return *std::max_element(nodes.begin(), nodes.end()) + 1;
+}
+
+Status Numa::BindThread(int32_t node) {
+#if defined(__linux__) && !defined(__ANDROID__) && !defined(ANDROID)
+  CHECK_FAIL_RETURN_UNEXPECTED(node >= 0 && node < NumNodes(), "Invalid NUMA node: " + std::to_string(node));
+  std::string node_name = "node" + std::to_string(node);
+  std::ifstream in(std::string(kNodeDir) + node_name + "/cpulist");
+  std::string cpu_list;
+  CHECK_FAIL_RETURN_UNEXPECTED(in.is_open() && std::getline(in, cpu_list), "Failed to read the cpus of " + node_name);
+  std::vector<int32_t> cpus;
+  RETURN_IF_NOT_OK(ParseList(cpu_list, &cpus));
+  // A node may have memory only
+  CHECK_FAIL_RETURN_UNEXPECTED(!cpus.empty(), "NUMA " + node_name + " has no cpus.");
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpu_set);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0,
+                               "Failed to bind the thread to the cpus of " + node_name);
+  // The kernel reads one bit less than maxnode, hence the + 1
+  std::vector<unsigned long> node_mask(node / kBitsPerMaskWord + 1, 0);  // NOLINT
+  node_mask[node / kBitsPerMaskWord] = 1UL << (node % kBitsPerMaskWord);
+  unsigned long max_node = node_mask.size() * kBitsPerMaskWord + 1;  // NOLINT
+  CHECK_FAIL_RETURN_UNEXPECTED(syscall(SYS_set_mempolicy, kMpolPreferred, node_mask.data(), max_node) == 0,
+                               "Failed to set the memory policy of the thread to " + node_name);
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Binding threads to a NUMA node is only supported on Linux.");
+#endif
+}
+
+int32_t Numa::CurrentNode() {
+#if defined(__linux__) && !defined(__ANDROID__) && !defined(ANDROID)
+  unsigned int cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int32_t>(node);
+  }
+#endif
+  return -1;
+}
+
+Status Numa::GetNodeStat(int32_t node, NumaStat *stat) {
+  RETURN_UNEXPECTED_IF_NULL(stat);
+  std::string node_name = "node" + std::to_string(node);
+  std::ifstream in(std::string(kNodeDir) + node_name + "/numastat");
+  CHECK_FAIL_RETURN_UNEXPECTED(in.is_open(), "Failed to read the numastat of " + node_name);
+  *stat = NumaStat();
+  std::string name;
+  int64_t pages = 0;
+  while (in >> name >> pages) {
+    if (name == "numa_hit") {
+      stat->numa_hit = pages;
+    } else if (name == "numa_miss") {
+      stat->numa_miss = pages;
+    } else if (name == "numa_foreign") {
+      stat->numa_foreign = pages;
+    } else if (name == "local_node") {
+      stat->local_node = pages;
+    } else if (name == "other_node") {
+      stat->other_node = pages;
+    }
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
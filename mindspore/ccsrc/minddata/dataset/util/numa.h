@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_NUMA_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_NUMA_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Page allocation counters of a NUMA node, as the kernel reports them in its numastat file.
+/// The counters are host wide, they count the pages of every process.
+struct NumaStat {
+  int64_t numa_hit = 0;      // pages allocated on this node as intended
+  int64_t numa_miss = 0;     // pages allocated on this node although another node was preferred
+  int64_t numa_foreign = 0;  // pages intended for this node but allocated on another node
+  int64_t local_node = 0;    // pages allocated on this node by a thread running on it
+  int64_t other_node = 0;    // pages allocated on this node by a thread running on another node
+};
+
+/// \brief Helpers to keep threads and the memory they allocate on one NUMA node.
+/// The topology is read from sysfs and the placement is done with the kernel syscalls, so there is no dependency on
+/// libnuma. Only Linux is supported, elsewhere the host looks like a single node and binding fails.
+class Numa {
+ public:
+  /// \return Number of NUMA nodes of the host, 1 if it can't be found
+  static int32_t NumNodes();
+
+  /// \brief Restrict the calling thread to the cpus of a node and make the node its preferred source of memory.
+  /// Threads created by the calling thread afterwards inherit both.
+  /// \param[in] node The node to bind to
+  /// \return Status code
+  static Status BindThread(int32_t node);
+
+  /// \return The node the calling thread is running on, -1 if it can't be found
+  static int32_t CurrentNode();
+
+  /// \brief Read the page allocation counters of a node
+  /// \param[in] node The node to read the counters of
+  /// \param[out] stat The counters
+  /// \return Status code
+  static Status GetNodeStat(int32_t node, NumaStat *stat);
+
+ private:
+  /// \brief Parse a sysfs list such as "0-3,8-11"
+  static Status ParseList(const std::string &list, std::vector<int32_t> *ids);
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_NUMA_H_
@@ -131,6 +131,29 @@ class Queue {
     return rc;
   }
 
+  // Change the capacity of the queue. The elements already in the queue are kept in order, so the
+  // new capacity can not be smaller than the number of elements currently in the queue.
+  Status Resize(size_t new_capacity) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    auto n = size();
+    if (new_capacity == 0 || new_capacity < n) {
+      RETURN_STATUS_UNEXPECTED("Invalid queue capacity " + std::to_string(new_capacity) + ", queue holds " +
+                               std::to_string(n) + " elements.");
+    }
+    MemGuard<T, Allocator<T>> new_arr(Services::GetAllocator<T>());
+    RETURN_IF_NOT_OK(new_arr.allocate(new_capacity));
+    for (size_t i = 0; i < n; ++i) {
+      *(new_arr[i]) = std::move(*(arr_[(head_ + i) % sz_]));
+    }
+    arr_ = std::move(new_arr);
+    sz_ = new_capacity;
+    head_ = 0;
+    tail_ = n;
+    // Producers blocked on a full queue may be able to continue now.
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, drain them. We won't call PopFront directly
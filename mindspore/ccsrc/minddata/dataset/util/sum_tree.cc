@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/sum_tree.h"
+#include <algorithm>
+
+namespace mindspore {
+namespace dataset {
+void SumTree::Build(const std::vector<double> &weights) {
+  num_leaves_ = weights.size();
+  first_leaf_ = 1;
+  while (first_leaf_ < num_leaves_) {
+    first_leaf_ <<= 1;
+  }
+  nodes_.assign(first_leaf_ * 2, 0.0);
+  std::copy(weights.begin(), weights.end(), nodes_.begin() + first_leaf_);
+  for (size_t i = first_leaf_ - 1; i > 0; i--) {
+    nodes_[i] = nodes_[2 * i] + nodes_[2 * i + 1];
+  }
+}
+
+void SumTree::Update(size_t leaf, double weight) {
+  size_t node = first_leaf_ + leaf;
+  nodes_[node] = weight;
+  // Sums are recomputed rather than adjusted by the difference, so rounding errors do not pile up over updates
+  for (node >>= 1; node > 0; node >>= 1) {
+    nodes_[node] = nodes_[2 * node] + nodes_[2 * node + 1];
+  }
+}
+
+size_t SumTree::Find(double value) const {
+  value = std::max(value, 0.0);
+  size_t node = 1;
+  while (node < first_leaf_) {
+    size_t left = 2 * node;
+    if (value < nodes_[left]) {
+      node = left;
+    } else if (nodes_[left + 1] > 0.0) {
+      value -= nodes_[left];
+      node = left + 1;
+    } else {
+      // The value is at the very end of the range of the node, which rounding can push past the left child
+      node = left;
+    }
+  }
+  return std::min(node - first_leaf_, num_leaves_ > 0 ? num_leaves_ - 1 : 0);
+}
+}  // namespace dataset
+}  // namespace mindspore
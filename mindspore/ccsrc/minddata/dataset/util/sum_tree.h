@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SUM_TREE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SUM_TREE_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+// A SumTree holds non negative weights at its leaves and the sum of its children at every inner node, so that
+//   - a weight is changed in O(log n) by recomputing the sums on the path to the root,
+//   - a leaf is drawn with a probability proportional to its weight in O(log n), by walking down from the root
+//     with a uniform value in [0, total).
+// The tree is a complete binary tree stored in an array: node 1 is the root, the children of node i are 2i and 2i+1,
+// and the leaves start at the first power of two not less than the number of weights.
+class SumTree {
+ public:
+  SumTree() : num_leaves_(0), first_leaf_(1), nodes_(2, 0.0) {}
+
+  ~SumTree() = default;
+
+  // Set all the weights at once in O(n)
+  // @param weights - the weights of the leaves, they must not be negative
+  void Build(const std::vector<double> &weights);
+
+  // Change the weight of a leaf
+  // @param leaf - index of the leaf, less than size()
+  // @param weight - the new weight, it must not be negative
+  void Update(size_t leaf, double weight);
+
+  // @param leaf - index of the leaf, less than size()
+  // @return double - the weight of the leaf
+  double Get(size_t leaf) const { return nodes_[first_leaf_ + leaf]; }
+
+  // Find the leaf whose range of the cumulative weights holds a value
+  // @param value - a value in [0, total()), values out of the range are clamped to it
+  // @return size_t - the index of the leaf, a leaf of zero weight is never returned unless total() is 0
+  size_t Find(double value) const;
+
+  // @return double - the sum of the weights
+  double total() const { return nodes_[1]; }
+
+  // @return size_t - the number of leaves
+  size_t size() const { return num_leaves_; }
+
+ private:
+  size_t num_leaves_;
+  size_t first_leaf_;
+  std::vector<double> nodes_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SUM_TREE_H_
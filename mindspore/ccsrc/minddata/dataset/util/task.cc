@@ -16,6 +16,7 @@
 #include "minddata/dataset/util/task.h"
 #include "utils/ms_utils.h"
 #include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/numa.h"
 #include "minddata/dataset/util/task_manager.h"
 #if defined(__ANDROID__) || defined(ANDROID)
 #include "minddata/dataset/util/services.h"
@@ -43,6 +44,14 @@ void Task::operator()() {
     // get the thread id.
     TaskGroup *vg = MyTaskGroup();
     rc_ = vg->GetIntrpService()->Register(ss.str(), this);
+    if (rc_.IsOk() && vg->numa_node() >= 0) {
+      // An unbound thread is only slower, so the task runs anyway
+      Status rc = Numa::BindThread(vg->numa_node());
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << my_name_ << " Thread ID " << ss.str() << " is not bound to NUMA node " << vg->numa_node()
+                        << ": " << rc.ToString();
+      }
+    }
     if (rc_.IsOk()) {
       // Now we can run the given task.
       rc_ = fnc_obj_();
@@ -326,7 +326,7 @@ Status TaskGroup::DoServiceStop() {
   return (join_all(Task::WaitFlag::kNonBlocking));
 }
 
-TaskGroup::TaskGroup() : grp_list_(&Task::group), intrp_svc_(nullptr) {
+TaskGroup::TaskGroup() : grp_list_(&Task::group), intrp_svc_(nullptr), numa_node_(-1) {
   auto alloc = Services::GetAllocator<IntrpService>();
   intrp_svc_ = std::allocate_shared<IntrpService>(alloc);
   (void)Service::ServiceStart();
@@ -149,6 +149,11 @@ class TaskGroup : public Service {
 
   std::shared_ptr<IntrpService> GetIntrpService();
 
+  // Bind the threads created in this group from now on to a NUMA node, -1 leaves them unbound
+  void set_numa_node(int32_t node) { numa_node_ = node; }
+
+  int32_t numa_node() const { return numa_node_; }
+
  private:
   Status rc_;
   // Can't use rw_lock_ as we will lead to deadlatch. Create another mutex to serialize access to rc_.
@@ -156,6 +161,7 @@ class TaskGroup : public Service {
   RWLock rw_lock_;
   List<Task> grp_list_;
   std::shared_ptr<IntrpService> intrp_svc_;
+  int32_t numa_node_;
 };
 
 namespace this_thread {
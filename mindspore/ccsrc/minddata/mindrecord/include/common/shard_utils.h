@@ -110,6 +110,9 @@ const int kMaxFileCount = 4096;   // read
 const int kMinConsumerCount = 1;
 const int kMaxConsumerCount = 128;
 
+const int kPrefetchThreadCount = 4;  // io threads reading rows ahead of the consumers
+const int kPrefetchBatchSize = 16;   // rows claimed at a time by one io thread
+
 const int kMaxSchemaCount = 1;
 const int kMaxThreadCount = 32;
 const int kMaxFieldCount = 100;
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief A shard file mapped into memory.
+/// The mapping is private, so data read through it can be modified in place (copy-on-write) without ever
+/// reaching the file. Views into the mapping hold a shared_ptr to it, the file is unmapped when the last one goes.
+class ShardMmapFile {
+ public:
+  ShardMmapFile() = default;
+
+  ~ShardMmapFile();
+
+  ShardMmapFile(const ShardMmapFile &) = delete;
+
+  ShardMmapFile &operator=(const ShardMmapFile &) = delete;
+
+  /// \brief map the whole file into memory
+  /// \param[in] file_path the path of the shard file
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus Open(const std::string &file_path);
+
+  /// \brief unmap the file
+  void Close();
+
+  /// \brief check if [offset, offset + length) lies in the mapped file
+  bool Contains(uint64_t offset, uint64_t length) const {
+    return data_ != nullptr && offset <= size_ && length <= size_ - offset;
+  }
+
+  uint8_t *GetData() const { return data_; }
+
+  uint64_t GetSize() const { return size_; }
+
+ private:
+  uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+};
+
+/// \brief The blob of one row, read in place from a mapped shard file
+struct ShardBlobView {
+  uint8_t *data = nullptr;
+  uint64_t size = 0;
+  std::shared_ptr<ShardMmapFile> file;  // keeps the mapping alive as long as the view is used
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_FILE_H_
@@ -48,6 +48,7 @@
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mmap_file.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -63,6 +64,7 @@ using ROW_GROUP_BRIEF =
   std::tuple<MSRStatus, std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_RETURN_CONTENT =
   std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>>;
+using TASK_RETURN_VIEW = std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<ShardBlobView, json>>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
 class ShardReader {
@@ -183,6 +185,10 @@ class ShardReader {
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
                                                                                        const int32_t &consumer_id);
 
+  /// \brief return a row by id, the blob is read in place from the mapped shard file, used in mmap read mode
+  /// \return a batch of image views and image data
+  std::pair<TaskType, std::vector<std::tuple<ShardBlobView, json>>> GetNextViewById(const int64_t &task_id);
+
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<std::vector<uint8_t>>, pybind11::object>> GetNextPy();
@@ -199,6 +205,23 @@ class ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set flag of reading shard files through memory mapping, takes effect when the reader is opened
+  /// \return null
+  void SetMmapRead(bool mmap_read) { mmap_read_ = mmap_read; }
+
+  /// \brief get flag of reading shard files through memory mapping, false if the files could not be mapped
+  bool GetMmapRead() const { return mmap_read_; }
+
+  /// \brief set the number of rows read ahead of GetNextById in task order, 0 disables reading ahead.
+  ///     Must be set before the reader is opened, it takes effect in simple reader mode without memory mapping.
+  /// \return null
+  void SetPrefetchSize(int prefetch_size) { prefetch_size_ = prefetch_size; }
+
+  /// \brief change the columns which will be read, takes effect when the reader is launched
+  /// \param[in] selected_columns the columns to read, all columns if empty
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SetSelectedColumns(const std::vector<std::string> &selected_columns);
+
   /// \brief get all classes
   MSRStatus GetAllClasses(const std::string &category_field, std::set<std::string> &categories);
 
@@ -270,6 +293,26 @@ class ShardReader {
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
+  /// \brief get one row from the mapped shard files without copying the blob
+  TASK_RETURN_VIEW ConsumerOneTaskView(int task_id);
+
+  /// \brief map all shard files into memory, fall back to file streams if any of them fails
+  void OpenMmapFiles();
+
+  /// \brief start the io threads reading rows ahead from the first task
+  void StartPrefetch();
+
+  /// \brief stop the io threads and drop the rows read ahead
+  void StopPrefetch();
+
+  /// \brief io thread reading batches of rows ahead of the consumers
+  void PrefetchByRow(int io_thread_id);
+
+  /// \brief take a row read ahead, wait for it if it is being read
+  /// \return false if the row was not read ahead
+  bool TakePrefetchedRow(int64_t task_id,
+                         std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> *row);
+
   /// \brief get labels from binary file
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
     int shard_id, const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &label_offsets);
@@ -297,6 +340,7 @@ class ShardReader {
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMmapFile>> mmap_files_;                       // mapped file list
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -309,6 +353,7 @@ class ShardReader {
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
   bool interrupt_ = false;    // reader interrupted
+  bool mmap_read_ = false;    // read shard files through memory mapping
 
   int num_padded_;  // number of padding samples
 
@@ -325,6 +370,20 @@ class ShardReader {
   // map of delivery
   std::unordered_map<int, std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>>> delivery_map_;
   // Delivery/Iterator mode end
+
+  // Read ahead mode start
+  const std::string kPrefetchThreadName = "THRD_PREFETCH_";  // prefix of io thread name
+  int prefetch_size_ = 0;                         // number of rows read ahead of the consumers
+  std::vector<std::thread> prefetch_threads_;     // io threads reading ahead
+  std::mutex mtx_prefetch_;                       // locker for read ahead
+  std::condition_variable cv_prefetch_;           // conditional variable for io threads
+  std::condition_variable cv_prefetched_;         // conditional variable for consumers waiting for a row
+  bool prefetch_stop_ = true;                     // io threads are not running or asked to quit
+  int64_t prefetch_next_id_ = 0;                  // next task ID to be read ahead
+  std::unordered_set<int64_t> prefetch_pending_;  // task IDs being read by io threads
+  // rows read ahead, waiting for consumers
+  std::unordered_map<int64_t, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>> prefetch_map_;
+  // Read ahead mode end
 };
 }  // namespace mindrecord
 }  // namespace mindspore
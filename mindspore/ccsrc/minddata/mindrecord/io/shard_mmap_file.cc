@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mmap_file.h"
+
+#include <fcntl.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
+#include <sys/stat.h>
+#include <unistd.h>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+ShardMmapFile::~ShardMmapFile() { Close(); }
+
+MSRStatus ShardMmapFile::Open(const std::string &file_path) {
+  Close();
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(common::SafeCStr(file_path), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Invalid file, failed to open file: " << file_path;
+    return FAILED;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "Invalid file, failed to get the size of file: " << file_path;
+    close(fd);
+    return FAILED;
+  }
+  // A private writable mapping lets tensors built on the mapped data be modified in place by later ops, pages are
+  // copied on write and the file itself is never changed.
+  void *addr = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Failed to map file: " << file_path;
+    return FAILED;
+  }
+  data_ = static_cast<uint8_t *>(addr);
+  size_ = static_cast<uint64_t>(file_stat.st_size);
+  MS_LOG(INFO) << "Map shard file successfully, size: " << size_ << ".";
+  return SUCCESS;
+#else
+  MS_LOG(ERROR) << "Memory mapped shard file is not supported on this platform.";
+  return FAILED;
+#endif
+}
+
+void ShardMmapFile::Close() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    munmap(data_, static_cast<size_t>(size_));
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
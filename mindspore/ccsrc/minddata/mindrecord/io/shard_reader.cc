@@ -23,6 +23,7 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::MsLogLevel::DEBUG;
 using mindspore::MsLogLevel::ERROR;
 using mindspore::MsLogLevel::INFO;
+using mindspore::MsLogLevel::WARNING;
 
 namespace mindspore {
 namespace mindrecord {
@@ -191,10 +192,19 @@ MSRStatus ShardReader::Open() {
 }
 
 MSRStatus ShardReader::Open(int n_consumer) {
+  if (mmap_read_) {
+    OpenMmapFiles();
+  }
+  // Mapped shard files are shared by all consumers, no file stream is needed
+  if (mmap_read_) {
+    return SUCCESS;
+  }
+  // io threads reading ahead have their own file streams, after the ones of the consumers
+  int n_streams = prefetch_size_ > 0 ? n_consumer + kPrefetchThreadCount : n_consumer;
   file_streams_random_ =
-    std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_consumer, std::vector<std::shared_ptr<std::fstream>>());
+    std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_streams, std::vector<std::shared_ptr<std::fstream>>());
   for (const auto &file : file_paths_) {
-    for (int j = 0; j < n_consumer; ++j) {
+    for (int j = 0; j < n_streams; ++j) {
       std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
       fs->open(common::SafeCStr(file), std::ios::in | std::ios::binary);
       if (!fs->good()) {
@@ -209,6 +219,21 @@ MSRStatus ShardReader::Open(int n_consumer) {
   return SUCCESS;
 }
 
+void ShardReader::OpenMmapFiles() {
+  mmap_files_.clear();
+  for (const auto &file : file_paths_) {
+    auto mmap_file = std::make_shared<ShardMmapFile>();
+    if (mmap_file->Open(file) == FAILED) {
+      MS_LOG(WARNING) << "Failed to map shard file, read it through file streams instead: " << file;
+      mmap_files_.clear();
+      mmap_read_ = false;
+      return;
+    }
+    mmap_files_.push_back(mmap_file);
+  }
+  MS_LOG(INFO) << "Map shard files successfully.";
+}
+
 void ShardReader::FileStreamsOperator() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
@@ -231,6 +256,8 @@ void ShardReader::FileStreamsOperator() {
       database_paths_[i] = nullptr;
     }
   }
+  // Views still in use keep their mapping alive until they are released
+  mmap_files_.clear();
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -241,6 +268,7 @@ void ShardReader::Close() {
     interrupt_ = true;  // interrupt reading and stop threads
   }
   cv_delivery_.notify_all();
+  StopPrefetch();
 
   // Wait for all threads to finish
   for (auto &i_thread : thread_set_) {
@@ -899,6 +927,15 @@ MSRStatus ShardReader::Open(const std::vector<std::string> &file_paths, bool loa
   return SUCCESS;
 }
 
+MSRStatus ShardReader::SetSelectedColumns(const std::vector<std::string> &selected_columns) {
+  if (CheckColumnList(selected_columns) == FAILED) {
+    MS_LOG(ERROR) << "Illegal column list";
+    return ILLEGAL_COLUMN_LIST;
+  }
+  selected_columns_ = selected_columns;
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::OpenPy(const std::vector<std::string> &file_paths, bool load_dataset, const int &n_consumer,
                               const std::vector<std::string> &selected_columns,
                               const std::vector<std::shared_ptr<ShardOperator>> &operators) {
@@ -944,7 +981,11 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
     interrupt_ = true;
     return FAILED;
   }
-  if (isSimpleReader) return SUCCESS;
+  if (isSimpleReader) {
+    // Consumers pull rows by id, read them ahead in task order
+    StartPrefetch();
+    return SUCCESS;
+  }
   // Start provider consumer threads
   thread_set_ = std::vector<std::thread>(n_consumer_);
   if (n_consumer_ <= 0 || n_consumer_ > kMaxConsumerCount) {
@@ -1122,21 +1163,31 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   std::vector<uint8_t> images(addr[1] - addr[0]);
   auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
-  }
+  if (mmap_read_) {
+    const auto &mmap_file = mmap_files_[shard_id];
+    if (!mmap_file->Contains(file_offset, images.size())) {
+      MS_LOG(ERROR) << "Blob is out of the range of the mapped file";
+      return std::make_pair(
+        FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
+    std::copy(mmap_file->GetData() + file_offset, mmap_file->GetData() + file_offset + images.size(), images.begin());
+  } else {
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(
+        FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    auto &io_read =
+      file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED,
+                            std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
   }
 
   // Deliver batch data to output map
@@ -1146,6 +1197,51 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
 }
 
+TASK_RETURN_VIEW ShardReader::ConsumerOneTaskView(int task_id) {
+  // All tasks are done
+  if (task_id >= static_cast<int>(tasks_.Size())) {
+    return std::make_pair(FAILED,
+                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobView, json>>()));
+  }
+
+  // Pick up task from task list
+  auto task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+
+  // check task type
+  auto task_type = std::get<0>(task);
+  if (task_type == TaskType::kPaddedTask) {
+    return std::make_pair(SUCCESS,
+                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<ShardBlobView, json>>()));
+  }
+
+  auto shard_id = std::get<0>(std::get<1>(task));
+  auto group_id = std::get<1>(std::get<1>(task));
+  auto addr = std::get<2>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  if (SUCCESS != ret.first) {
+    return std::make_pair(FAILED,
+                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobView, json>>()));
+  }
+  const std::shared_ptr<Page> &page = ret.second;
+
+  // Point into the mapped file instead of packing the image list
+  ShardBlobView view;
+  view.size = addr[1] - addr[0];
+  auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
+  view.file = mmap_files_[shard_id];
+  if (!view.file->Contains(file_offset, view.size)) {
+    MS_LOG(ERROR) << "Blob is out of the range of the mapped file";
+    return std::make_pair(FAILED,
+                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobView, json>>()));
+  }
+  view.data = view.file->GetData() + file_offset;
+
+  std::vector<std::tuple<ShardBlobView, json>> batch;
+  batch.emplace_back(std::move(view), std::move(std::get<3>(task)));
+
+  return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
+}
+
 MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
   // Set thread name
 #if !defined(_WIN32) && !defined(_WIN64)
@@ -1212,6 +1308,12 @@ std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardRe
   if (interrupt_) {
     return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
+  if (prefetch_size_ > 0) {
+    std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> row;
+    if (TakePrefetchedRow(task_id, &row)) {
+      return row;
+    }
+  }
   const auto &ret = ConsumerOneTask(task_id, consumer_id);
   if (SUCCESS != ret.first) {
     return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
@@ -1219,6 +1321,18 @@ std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardRe
   return std::move(ret.second);
 }
 
+std::pair<TaskType, std::vector<std::tuple<ShardBlobView, json>>> ShardReader::GetNextViewById(
+  const int64_t &task_id) {
+  if (interrupt_ || !mmap_read_) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobView, json>>());
+  }
+  auto ret = ConsumerOneTaskView(task_id);
+  if (SUCCESS != ret.first) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobView, json>>());
+  }
+  return std::move(ret.second);
+}
+
 std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> ShardReader::UnCompressBlob(
   const std::vector<uint8_t> &raw_blob_data) {
   auto loaded_columns = selected_columns_.size() == 0 ? shard_column_->GetColumnName() : selected_columns_;
@@ -1265,7 +1379,119 @@ void ShardReader::Reset() {
   cv_delivery_.notify_all();
 }
 
+void ShardReader::StartPrefetch() {
+  if (prefetch_size_ <= 0 || mmap_read_ || tasks_.Size() == 0) {
+    return;
+  }
+  if (static_cast<int>(file_streams_random_.size()) < n_consumer_ + kPrefetchThreadCount) {
+    MS_LOG(WARNING) << "No file streams are opened for reading ahead, rows are read when they are requested.";
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    prefetch_stop_ = false;
+    prefetch_next_id_ = 0;
+  }
+  for (int i = 0; i < kPrefetchThreadCount; ++i) {
+    prefetch_threads_.emplace_back(&ShardReader::PrefetchByRow, this, i);
+  }
+  MS_LOG(INFO) << "Launch " << kPrefetchThreadCount << " io threads to read " << prefetch_size_ << " rows ahead.";
+}
+
+void ShardReader::StopPrefetch() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    prefetch_stop_ = true;
+  }
+  cv_prefetch_.notify_all();
+  for (auto &io_thread : prefetch_threads_) {
+    if (io_thread.joinable()) {
+      io_thread.join();
+    }
+  }
+  prefetch_threads_.clear();
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    prefetch_pending_.clear();
+    prefetch_map_.clear();
+  }
+  cv_prefetched_.notify_all();
+}
+
+void ShardReader::PrefetchByRow(int io_thread_id) {
+  // Set thread name
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto thread_id = kPrefetchThreadName + std::to_string(io_thread_id);
+  prctl(PR_SET_NAME, common::SafeCStr(thread_id), 0, 0, 0);
+#endif
+  auto stream_id = static_cast<uint32_t>(n_consumer_ + io_thread_id);
+  auto num_tasks = static_cast<int64_t>(tasks_.Size());
+
+  for (;;) {
+    int64_t begin_id = 0;
+    int64_t end_id = 0;
+    {
+      // Claim the next batch of rows in task order, as long as the read ahead window has room for it
+      std::unique_lock<std::mutex> lck(mtx_prefetch_);
+      cv_prefetch_.wait(lck, [this, num_tasks] {
+        return prefetch_stop_ || interrupt_ ||
+               (prefetch_next_id_ < num_tasks &&
+                static_cast<int>(prefetch_map_.size() + prefetch_pending_.size()) < prefetch_size_);
+      });
+      if (prefetch_stop_ || interrupt_) {
+        return;
+      }
+      int64_t room = prefetch_size_ - static_cast<int64_t>(prefetch_map_.size() + prefetch_pending_.size());
+      begin_id = prefetch_next_id_;
+      end_id = std::min({begin_id + kPrefetchBatchSize, begin_id + room, num_tasks});
+      prefetch_next_id_ = end_id;
+      for (int64_t task_id = begin_id; task_id < end_id; ++task_id) {
+        prefetch_pending_.insert(task_id);
+      }
+    }
+
+    for (int64_t task_id = begin_id; task_id < end_id; ++task_id) {
+      auto ret = ConsumerOneTask(static_cast<int>(task_id), stream_id);
+      {
+        std::lock_guard<std::mutex> lck(mtx_prefetch_);
+        prefetch_pending_.erase(task_id);
+        // A row that failed is left to the consumer, which reads it again and reports the error
+        if (ret.first == SUCCESS) {
+          prefetch_map_[task_id] = std::move(ret.second);
+        }
+      }
+      cv_prefetched_.notify_all();
+    }
+  }
+}
+
+bool ShardReader::TakePrefetchedRow(int64_t task_id,
+                                    std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> *row) {
+  {
+    std::unique_lock<std::mutex> lck(mtx_prefetch_);
+    cv_prefetched_.wait(lck, [this, task_id] {
+      return prefetch_stop_ || interrupt_ || prefetch_pending_.find(task_id) == prefetch_pending_.end();
+    });
+    if (prefetch_stop_ || interrupt_) {
+      return false;
+    }
+    auto it = prefetch_map_.find(task_id);
+    if (it == prefetch_map_.end()) {
+      // The consumers got ahead of the io threads, they skip the rows being read by the consumers
+      prefetch_next_id_ = std::max(prefetch_next_id_, task_id + 1);
+      return false;
+    }
+    *row = std::move(it->second);
+    prefetch_map_.erase(it);
+  }
+  cv_prefetch_.notify_all();
+  return true;
+}
+
 void ShardReader::ShuffleTask() {
+  // The task order changes, drop the rows read ahead and restart from the first task
+  bool prefetching = !prefetch_threads_.empty();
+  StopPrefetch();
   // exist shuffle and distributed sampler in ops, skip shuffle
   bool has_sharding = false;
   for (const auto &op : operators_) {
@@ -1285,6 +1511,9 @@ void ShardReader::ShuffleTask() {
     }
   }
   if (tasks_.permutation_.empty()) tasks_.MakePerm();
+  if (prefetching) {
+    StartPrefetch();
+  }
 }
 
 }  // namespace mindrecord
@@ -21,6 +21,7 @@
 #include <utility>
 #include <functional>
 #include "backend/kernel_compiler/kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "utils/ms_context.h"
 #include "backend/session/anf_runtime_algorithm.h"
@@ -38,6 +39,24 @@ void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   AssignInputNodeAddress(kernel_graph);
   AssignKernelOutputAddress(kernel_graph);
   resource_manager_.AssignMemory(kernel_graph);
+
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (context_ptr->get_param<uint32_t>(MS_CTX_CPU_INTER_OP_THREADS) > 1 && !resource_manager_.dynamic_malloc()) {
+    // The session runs the graph with the optimizer kernels last
+    auto kernels = kernel_graph->execution_order();
+    AnfAlgo::ReorderExecList(NOT_NULL(&kernels));
+    std::lock_guard<std::mutex> lock(schedulers_mutex_);
+    schedulers_[kernel_graph->graph_id()].Init(kernel_graph, kernels, resource_manager_.ReuseDependencies());
+  }
+}
+
+void CPUKernelRuntime::ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &inputs,
+                                                 const std::unordered_set<ValueNodePtr> &value_nodes,
+                                                 const std::vector<CNodePtr> &execution_order) {
+  KernelRuntime::ClearGraphRuntimeResource(graph_id, inputs, value_nodes, execution_order);
+  std::lock_guard<std::mutex> lock(schedulers_mutex_);
+  (void)schedulers_.erase(graph_id);
 }
 
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
@@ -319,44 +338,67 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.IncreaseAddressRefCount(kernel_graph);
 
-  auto kernels = kernel_graph->execution_order();
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  kernel::CPUThreadPool::GetInstance().set_intra_op_threads(
+    context_ptr->get_param<uint32_t>(MS_CTX_CPU_INTRA_OP_THREADS));
+  size_t inter_op_threads = context_ptr->get_param<uint32_t>(MS_CTX_CPU_INTER_OP_THREADS);
+  auto &kernels = kernel_graph->execution_order();
+  const CPUKernelScheduler *scheduler = nullptr;
+  {
+    // Only the entries of released graphs are erased, this one stays valid while the graph runs
+    std::lock_guard<std::mutex> lock(schedulers_mutex_);
+    auto iter = schedulers_.find(kernel_graph->graph_id());
+    if (iter != schedulers_.end() && iter->second.IsScheduled(kernels)) {
+      scheduler = &iter->second;
+    }
+  }
+  // Dynamic malloc frees the memory by reference counts, which needs the kernels to run one by one
+  if (inter_op_threads > 1 && !resource_manager_.dynamic_malloc() && scheduler != nullptr) {
+    scheduler->Run(inter_op_threads, [this](const CNodePtr &kernel) { LaunchKernel(kernel); });
+    return true;
+  }
   for (const auto &kernel : kernels) {
+    LaunchKernel(kernel);
+  }
+  return true;
+}
+
+void CPUKernelRuntime::LaunchKernel(const CNodePtr &kernel) {
 #ifdef ENABLE_PROFILE
-    double start_time = GetTime();
+  double start_time = GetTime();
 #endif
-    std::vector<kernel::AddressPtr> kernel_inputs;
-    std::vector<kernel::AddressPtr> kernel_workspaces;
-    std::vector<kernel::AddressPtr> kernel_outputs;
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_inputs);
-    }
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_outputs);
-    }
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_workspaces);
-    }
-    auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    resource_manager_.DecreaseAddressRefCount(kernel);
-    if (!ret) {
-      MS_LOG(EXCEPTION) << "Launch kernel failed.";
-    }
+  std::vector<kernel::AddressPtr> kernel_inputs;
+  std::vector<kernel::AddressPtr> kernel_workspaces;
+  std::vector<kernel::AddressPtr> kernel_outputs;
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_inputs);
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_outputs);
+  }
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+    auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_workspaces);
+  }
+  auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+  resource_manager_.DecreaseAddressRefCount(kernel);
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  }
 #ifdef ENABLE_PROFILE
-    double cost_time = GetTime() - start_time;
-    MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
+  double cost_time = GetTime() - start_time;
+  MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
 #endif
-  }
-  return true;
 }
 }  // namespace cpu
 }  // namespace device
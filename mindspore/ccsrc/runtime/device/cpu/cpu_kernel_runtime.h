@@ -20,11 +20,14 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_set>
 #include "runtime/device/kernel_runtime.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
 #include "runtime/device/cpu/cpu_resource_manager.h"
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "utils/any.h"
 namespace mindspore {
@@ -37,6 +40,9 @@ class CPUKernelRuntime : public KernelRuntime {
 
   bool Init() override { return true; }
   bool Run(session::KernelGraph *graph, bool is_task_sink) override;
+  void ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &inputs,
+                                 const std::unordered_set<ValueNodePtr> &value_nodes,
+                                 const std::vector<CNodePtr> &execution_order) override;
   void AssignKernelAddress(session::KernelGraph *kernel_graph);
   void CreateOutputTensors(session::KernelGraph *kernel_graph, const std::vector<tensor::TensorPtr> &inputs,
                            VectorRef *outputs);
@@ -61,7 +67,12 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  void LaunchKernel(const CNodePtr &kernel);
   CPUResourceManager resource_manager_;
+  // The schedulers of the graphs compiled to run their independent kernels in parallel, by graph id, until the
+  // graphs are released
+  std::map<uint32_t, CPUKernelScheduler> schedulers_;
+  std::mutex schedulers_mutex_;
   std::set<DeviceAddressPtr> bound_addresses_;
   std::map<AnfNodePtr, tensor::TensorPtr> input_param_tensor_map_;
 };
@@ -0,0 +1,210 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "base/core_ops.h"
+#include "ir/graph_utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+void CPUKernelScheduler::AddDependency(size_t from, size_t to) {
+  if (from == to) {
+    return;
+  }
+  // Follow the execution order, so that the dependencies never make a cycle
+  if (from > to) {
+    std::swap(from, to);
+  }
+  successors_[from].push_back(to);
+}
+
+void CPUKernelScheduler::CollectProducers(const AnfNodePtr &node, std::vector<size_t> *producers,
+                                          std::set<AnfNodePtr> *visited) const {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!visited->insert(node).second) {
+    return;
+  }
+  auto iter = positions_.find(node);
+  if (iter != positions_.end()) {
+    producers->push_back(iter->second);
+    return;
+  }
+  if (!node->isa<CNode>()) {
+    return;
+  }
+  // Depend, MakeTuple, TupleGetItem...: all their inputs have to be ready
+  auto cnode = node->cast<CNodePtr>();
+  for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+    CollectProducers(cnode->input(i), producers, visited);
+  }
+}
+
+void CPUKernelScheduler::AddControlDependencies(const session::KernelGraph *graph,
+                                                const std::map<AnfNodePtr, std::vector<size_t>> &param_users) {
+  auto side_kernels = [this, &param_users](const AnfNodePtr &node) {
+    std::vector<size_t> kernels;
+    if (node->isa<Parameter>()) {
+      auto iter = param_users.find(node);
+      if (iter != param_users.end()) {
+        kernels = iter->second;
+      }
+      return kernels;
+    }
+    std::set<AnfNodePtr> visited;
+    CollectProducers(node, &kernels, &visited);
+    return kernels;
+  };
+  for (const auto &node : TopoSort(graph->get_return())) {
+    if (!IsPrimitiveCNode(node, prim::kPrimControlDepend)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    if (cnode->inputs().size() <= kControlDependBehindIndex) {
+      continue;
+    }
+    auto prior_kernels = side_kernels(cnode->input(kControlDependPriorIndex));
+    auto behind_kernels = side_kernels(cnode->input(kControlDependBehindIndex));
+    for (auto prior : prior_kernels) {
+      for (auto behind : behind_kernels) {
+        AddDependency(prior, behind);
+      }
+    }
+  }
+}
+
+void CPUKernelScheduler::Init(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+                              const std::vector<std::pair<CNodePtr, CNodePtr>> &reuse_deps) {
+  MS_EXCEPTION_IF_NULL(graph);
+  kernels_ = kernels;
+  size_t num_kernels = kernels_.size();
+  positions_.clear();
+  successors_.assign(num_kernels, {});
+  num_predecessors_.assign(num_kernels, 0);
+  for (size_t i = 0; i < num_kernels; ++i) {
+    positions_[kernels_[i]] = i;
+  }
+
+  std::map<AnfNodePtr, std::vector<size_t>> param_users;
+  for (size_t i = 0; i < num_kernels; ++i) {
+    const auto &kernel = kernels_[i];
+    MS_EXCEPTION_IF_NULL(kernel);
+    std::vector<size_t> producers;
+    std::set<AnfNodePtr> visited;
+    for (size_t j = 1; j < kernel->inputs().size(); ++j) {
+      CollectProducers(kernel->input(j), &producers, &visited);
+    }
+    for (auto producer : producers) {
+      AddDependency(producer, i);
+    }
+    for (const auto &node : visited) {
+      if (node->isa<Parameter>()) {
+        param_users[node].push_back(i);
+      }
+    }
+  }
+  // The kernels using a weight keep their order, the optimizers updating it in place
+  for (const auto &item : param_users) {
+    auto param = item.first->cast<ParameterPtr>();
+    if (!AnfAlgo::IsParameterWeight(param)) {
+      continue;
+    }
+    for (size_t i = 1; i < item.second.size(); ++i) {
+      AddDependency(item.second[i - 1], item.second[i]);
+    }
+  }
+  AddControlDependencies(graph, param_users);
+  for (const auto &dep : reuse_deps) {
+    auto first = positions_.find(dep.first);
+    auto second = positions_.find(dep.second);
+    if (first == positions_.end() || second == positions_.end()) {
+      MS_LOG(EXCEPTION) << "The kernels reusing memory are not in the graph " << graph->graph_id();
+    }
+    AddDependency(first->second, second->second);
+  }
+
+  size_t num_deps = 0;
+  for (auto &successors : successors_) {
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    for (auto successor : successors) {
+      num_predecessors_[successor]++;
+    }
+    num_deps += successors.size();
+  }
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " scheduled: " << num_kernels << " kernels, " << num_deps
+               << " dependencies";
+}
+
+void CPUKernelScheduler::Run(size_t inter_op_threads, const KernelLauncher &launch) const {
+  size_t num_kernels = kernels_.size();
+  std::vector<size_t> waiting(num_predecessors_);
+  // The ready kernels run in the execution order as much as possible
+  std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+  for (size_t i = 0; i < num_kernels; ++i) {
+    if (waiting[i] == 0) {
+      ready.push(i);
+    }
+  }
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t done = 0;
+  bool failed = false;
+  auto run_kernels = [&](size_t) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [&] { return failed || done == num_kernels || !ready.empty(); });
+      if (failed || done == num_kernels) {
+        return;
+      }
+      size_t index = ready.top();
+      ready.pop();
+      lock.unlock();
+      try {
+        launch(kernels_[index]);
+      } catch (...) {
+        lock.lock();
+        failed = true;
+        cv.notify_all();
+        throw;
+      }
+      lock.lock();
+      done++;
+      size_t newly_ready = 0;
+      for (auto successor : successors_[index]) {
+        if (--waiting[successor] == 0) {
+          ready.push(successor);
+          newly_ready++;
+        }
+      }
+      // This thread takes one of the ready kernels itself
+      if (done == num_kernels || newly_ready > 1) {
+        cv.notify_all();
+      }
+    }
+  };
+  size_t num_lanes = std::max(static_cast<size_t>(1), std::min(inter_op_threads, num_kernels));
+  kernel::CPUThreadPool::GetInstance().RunAll(num_lanes, run_kernels);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
+
+#include <functional>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include "backend/session/kernel_graph.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using KernelLauncher = std::function<void(const CNodePtr &)>;
+
+// Runs the kernels of a graph as soon as the kernels they depend on are done, several at once on the CPU kernel
+// thread pool, so that independent branches of the graph run in parallel.
+// A kernel depends on the earlier kernels of the execution order that
+//   - produce its inputs, including the inputs attached to them by Depend nodes,
+//   - come before it in a ControlDepend node,
+//   - use a same weight, since the optimizers update the weights in place,
+//   - last used the memory its outputs and workspaces reuse (given by the memory plan).
+// A kernel only ever depends on kernels before it in the execution order, so running it sequentially stays valid.
+class CPUKernelScheduler {
+ public:
+  CPUKernelScheduler() = default;
+  ~CPUKernelScheduler() = default;
+
+  // @param graph - the graph to schedule
+  // @param kernels - the kernels in the order the graph runs them
+  // @param reuse_deps - pairs of kernels, the second one reusing memory the first one used
+  void Init(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+            const std::vector<std::pair<CNodePtr, CNodePtr>> &reuse_deps);
+
+  // @return bool - whether the kernels are the ones scheduled, in the same order
+  bool IsScheduled(const std::vector<CNodePtr> &kernels) const { return kernels == kernels_; }
+
+  // Launch every kernel once, at most inter_op_threads at a time, and rethrow the first exception a launch threw
+  void Run(size_t inter_op_threads, const KernelLauncher &launch) const;
+
+  // @return std::vector<size_t> - the positions of the kernels depending directly on the kernel at a position
+  const std::vector<size_t> &successors(size_t index) const { return successors_[index]; }
+
+ private:
+  void AddDependency(size_t from, size_t to);
+  // Collect the kernels of the execution order producing a node, looking through the nodes that are not kernels
+  void CollectProducers(const AnfNodePtr &node, std::vector<size_t> *producers, std::set<AnfNodePtr> *visited) const;
+  void AddControlDependencies(const session::KernelGraph *graph,
+                              const std::map<AnfNodePtr, std::vector<size_t>> &param_users);
+
+  std::vector<CNodePtr> kernels_;
+  std::map<AnfNodePtr, size_t> positions_;
+  std::vector<std::vector<size_t>> successors_;
+  std::vector<size_t> num_predecessors_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
@@ -0,0 +1,236 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/device/cpu/cpu_mem_reuse_plan.h"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <utility>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "base/core_ops.h"
+#include "ir/graph_utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kSummaryInputIndex = 2;
+
+size_t AlignMemSize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+
+bool IsSummaryNode(const AnfNodePtr &node) {
+  return IsPrimitiveCNode(node, prim::kPrimScalarSummary) || IsPrimitiveCNode(node, prim::kPrimTensorSummary) ||
+         IsPrimitiveCNode(node, prim::kPrimImageSummary) || IsPrimitiveCNode(node, prim::kPrimHistogramSummary);
+}
+}  // namespace
+
+size_t PackMemBlocks(std::vector<MemBlock> *blocks) {
+  MS_EXCEPTION_IF_NULL(blocks);
+  std::vector<size_t> order(blocks->size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [blocks](size_t a, size_t b) { return (*blocks)[a].size > (*blocks)[b].size; });
+  size_t total_size = 0;
+  std::vector<size_t> placed;
+  for (auto index : order) {
+    auto &block = (*blocks)[index];
+    size_t size = AlignMemSize(block.size);
+    // The ranges of the placed blocks used at one of the steps of this block
+    std::vector<std::pair<size_t, size_t>> busy;
+    for (auto placed_index : placed) {
+      const auto &other = (*blocks)[placed_index];
+      if (other.first_use <= block.last_use && block.first_use <= other.last_use) {
+        busy.emplace_back(other.offset, other.offset + AlignMemSize(other.size));
+      }
+    }
+    std::sort(busy.begin(), busy.end());
+    size_t offset = 0;
+    for (const auto &range : busy) {
+      if (range.first >= offset + size) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    block.offset = offset;
+    total_size = std::max(total_size, offset + size);
+    placed.push_back(index);
+  }
+  return total_size;
+}
+
+void CPUMemReusePlan::AddUse(DeviceAddress *address, size_t step) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->ptr_ != nullptr) {
+    return;
+  }
+  auto iter = address_blocks_.find(address);
+  if (iter == address_blocks_.end()) {
+    address_blocks_[address] = blocks_.size();
+    blocks_.push_back({address->size_, step, step, 0});
+    block_addresses_.push_back(address);
+    block_steps_.push_back({step});
+    return;
+  }
+  auto &block = blocks_[iter->second];
+  block.first_use = std::min(block.first_use, step);
+  block.last_use = std::max(block.last_use, step);
+  auto &steps = block_steps_[iter->second];
+  if (steps.back() != step) {
+    steps.push_back(step);
+  }
+}
+
+void CPUMemReusePlan::KeepUntilEnd(const AnfNodePtr &node, size_t index, size_t end) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>()) {
+    return;
+  }
+  if (AnfAlgo::GetCNodeName(node) == prim::kPrimMakeTuple->name()) {
+    auto cnode = node->cast<CNodePtr>();
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      auto item_with_index = AnfAlgo::VisitKernelWithReturnType(cnode->input(i), 0);
+      KeepUntilEnd(item_with_index.first, item_with_index.second, end);
+    }
+    return;
+  }
+  if (!AnfAlgo::OutputAddrExist(node, index)) {
+    return;
+  }
+  auto address = AnfAlgo::GetMutableOutputAddr(node, index);
+  auto iter = address_blocks_.find(address.get());
+  if (iter != address_blocks_.end()) {
+    blocks_[iter->second].last_use = end;
+  }
+}
+
+void CPUMemReusePlan::KeepGraphOutputsUntilEnd(const session::KernelGraph *graph, size_t end) {
+  for (const auto &output : graph->outputs()) {
+    auto item_with_index = AnfAlgo::VisitKernelWithReturnType(output, 0, true);
+    KeepUntilEnd(item_with_index.first, item_with_index.second, end);
+  }
+  if (!graph->summary_node_exist()) {
+    return;
+  }
+  // The summary nodes are only collected when the graph runs, find them the same way
+  for (const auto &node : TopoSort(graph->get_return())) {
+    if (!IsSummaryNode(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    if (cnode->inputs().size() <= kSummaryInputIndex) {
+      continue;
+    }
+    auto item_with_index = AnfAlgo::VisitKernelWithReturnType(cnode->input(kSummaryInputIndex), 0, true);
+    KeepUntilEnd(item_with_index.first, item_with_index.second, end);
+  }
+}
+
+size_t CPUMemReusePlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  graph_ = graph;
+  blocks_.clear();
+  block_steps_.clear();
+  block_addresses_.clear();
+  address_blocks_.clear();
+  // The session moves the optimizer kernels to the end before running the graph, the lifetimes follow that order
+  kernels_ = graph->execution_order();
+  AnfAlgo::ReorderExecList(NOT_NULL(&kernels_));
+  for (size_t step = 0; step < kernels_.size(); ++step) {
+    const auto &kernel = kernels_[step];
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
+      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
+      if (kernel_with_index.first->isa<Parameter>()) {
+        continue;
+      }
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
+      AddUse(address.get(), step);
+    }
+
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
+      AddUse(address.get(), step);
+    }
+
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      AddUse(AnfAlgo::GetWorkspaceAddr(kernel, i), step);
+    }
+  }
+  KeepGraphOutputsUntilEnd(graph, kernels_.size());
+
+  size_t total_size = PackMemBlocks(&blocks_);
+  size_t linear_size = 0;
+  for (const auto &block : blocks_) {
+    linear_size += AlignMemSize(block.size);
+  }
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " memory planned: " << total_size << " bytes for "
+               << blocks_.size() << " blocks of " << linear_size << " bytes";
+  // Room to align the base of the memory
+  return total_size + kMemAlignSize;
+}
+
+void CPUMemReusePlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  if (graph != graph_) {
+    MS_LOG(EXCEPTION) << "The memory of graph " << graph->graph_id() << " is not planned";
+  }
+  size_t misalign = reinterpret_cast<uintptr_t>(base_ptr) % kMemAlignSize;
+  uint8_t *aligned_ptr = misalign == 0 ? base_ptr : base_ptr + (kMemAlignSize - misalign);
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    block_addresses_[i]->ptr_ = aligned_ptr + blocks_[i].offset;
+  }
+}
+
+std::set<std::pair<size_t, size_t>> MemReuseSteps(const std::vector<MemBlock> &blocks,
+                                                  const std::vector<std::vector<size_t>> &block_steps) {
+  if (block_steps.size() != blocks.size()) {
+    MS_LOG(EXCEPTION) << "The steps of " << block_steps.size() << " blocks are given for " << blocks.size()
+                      << " blocks";
+  }
+  std::set<std::pair<size_t, size_t>> steps;
+  for (const auto &block : blocks) {
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      const auto &used = blocks[i];
+      bool reused = used.last_use < block.first_use && used.offset < block.offset + block.size &&
+                    block.offset < used.offset + used.size;
+      if (!reused) {
+        continue;
+      }
+      // The first kernel using the block writes it
+      for (auto step : block_steps[i]) {
+        (void)steps.emplace(step, block.first_use);
+      }
+    }
+  }
+  return steps;
+}
+
+std::vector<std::pair<CNodePtr, CNodePtr>> CPUMemReusePlan::ReuseDependencies() const {
+  std::vector<std::pair<CNodePtr, CNodePtr>> dependencies;
+  for (const auto &step : MemReuseSteps(blocks_, block_steps_)) {
+    dependencies.emplace_back(kernels_[step.first], kernels_[step.second]);
+  }
+  return dependencies;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
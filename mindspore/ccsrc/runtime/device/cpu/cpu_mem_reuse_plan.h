@@ -0,0 +1,91 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_MEM_REUSE_PLAN_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_MEM_REUSE_PLAN_H_
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include "backend/session/kernel_graph.h"
+#include "runtime/device/device_address.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Alignment of the blocks in the graph memory
+constexpr size_t kMemAlignSize = 64;
+
+// A block of the graph memory, used by the kernels of the steps [first_use, last_use] of the execution order
+struct MemBlock {
+  size_t size{0};
+  size_t first_use{0};
+  size_t last_use{0};
+  size_t offset{0};
+};
+
+// Set the offsets of the blocks so that blocks used at a same step never overlap, reusing the memory of the blocks
+// that are no longer used. The biggest blocks are placed first, each at the lowest offset that is free during its
+// steps.
+// @param blocks - the blocks to place, their offsets are set
+// @return size_t - the size of the memory holding all the blocks
+size_t PackMemBlocks(std::vector<MemBlock> *blocks);
+
+// Find the steps that write memory an earlier step used, in the packed blocks.
+// @param blocks - the packed blocks
+// @param block_steps - the steps using each block
+// @return std::set<std::pair<size_t, size_t>> - pairs of steps, the second one writing a block over memory of a block
+//     the first one uses, so that it must not start before the first one is done
+std::set<std::pair<size_t, size_t>> MemReuseSteps(const std::vector<MemBlock> &blocks,
+                                                  const std::vector<std::vector<size_t>> &block_steps);
+
+// Plans the memory of the kernel outputs and workspaces of a graph from their lifetimes: an output lives from the
+// kernel writing it to the last kernel reading it, a workspace only during its kernel, so that memory no longer used
+// is reused by the kernels that come after.
+// The outputs of the graph and the outputs read by summary nodes are read once the graph has run, they live until the
+// end of the graph.
+class CPUMemReusePlan {
+ public:
+  CPUMemReusePlan() = default;
+  ~CPUMemReusePlan() = default;
+
+  // @return size_t - the size of the memory to pass to MemAssign
+  size_t MemPlan(const session::KernelGraph *graph);
+  // Set the addresses of the graph planned by the last MemPlan
+  void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  // @return std::vector<std::pair<CNodePtr, CNodePtr>> - pairs of kernels of the last planned graph, the second one
+  //     reusing memory the first one uses, so that it must not start before the first one is done
+  std::vector<std::pair<CNodePtr, CNodePtr>> ReuseDependencies() const;
+
+ private:
+  void AddUse(DeviceAddress *address, size_t step);
+  void KeepUntilEnd(const AnfNodePtr &node, size_t index, size_t end);
+  void KeepGraphOutputsUntilEnd(const session::KernelGraph *graph, size_t end);
+
+  const session::KernelGraph *graph_{nullptr};
+  std::vector<CNodePtr> kernels_;
+  std::vector<MemBlock> blocks_;
+  // The steps of the kernels using each block
+  std::vector<std::vector<size_t>> block_steps_;
+  // The address of each block
+  std::vector<DeviceAddress *> block_addresses_;
+  std::map<DeviceAddress *, size_t> address_blocks_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_MEM_REUSE_PLAN_H_
@@ -18,10 +18,11 @@
 
 #include <vector>
 #include <map>
+#include <utility>
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
 #include "runtime/device/device_address.h"
-#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include "runtime/device/cpu/cpu_mem_reuse_plan.h"
 namespace mindspore {
 namespace device {
 namespace cpu {
@@ -37,10 +38,13 @@ class CPUResourceManager {
   void MemFree(void *ptr);
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
+  // Whether the memory is allocated kernel by kernel from the reference counts, rather than planned
+  bool dynamic_malloc() const { return dynamic_malloc_; }
+  std::vector<std::pair<CNodePtr, CNodePtr>> ReuseDependencies() const { return mem_plan_.ReuseDependencies(); }
 
  private:
   void MemFree();
-  CPUSimpleMemPlan mem_plan_;
+  CPUMemReusePlan mem_plan_;
 
   size_t mem_size_{0};
   uint8_t *mem_ptr_{nullptr};
@@ -27,7 +27,7 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
-class CPUSimpleMemPlan;
+class CPUMemReusePlan;
 class CPUResourceManager;
 class CPUKernelRuntime;
 }  // namespace cpu
@@ -92,7 +92,7 @@ class DeviceAddress : public mindspore::DeviceSync {
   friend class KernelRuntime;
   friend class MemoryManager;
   friend class mindspore::device::ascend::tasksink::TaskGenerator;
-  friend class mindspore::device::cpu::CPUSimpleMemPlan;
+  friend class mindspore::device::cpu::CPUMemReusePlan;
   friend class mindspore::device::cpu::CPUResourceManager;
   friend class mindspore::device::cpu::CPUKernelRuntime;
   friend class mindspore::device::gpu::GPUKernelRuntime;
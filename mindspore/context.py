@@ -213,6 +213,16 @@ class _Context:
             raise ValueError(f"Max call depth must be greater than 0, but got {max_call_depth}")
         self.set_param(ms_ctx_param.max_call_depth, max_call_depth)
 
+    def set_cpu_inter_op_threads(self, threads):
+        if threads <= 0:
+            raise ValueError(f"Cpu inter op threads must be greater than 0, but got {threads}")
+        self.set_param(ms_ctx_param.cpu_inter_op_threads, threads)
+
+    def set_cpu_intra_op_threads(self, threads):
+        if threads < 0:
+            raise ValueError(f"Cpu intra op threads must not be less than 0, but got {threads}")
+        self.set_param(ms_ctx_param.cpu_intra_op_threads, threads)
+
     def set_profiling_options(self, option):
         options = ["training_trace", "task_trace",
                    "task_trace:training_trace", "training_trace:task_trace", "op_trace"]
@@ -264,6 +274,8 @@ class _Context:
         'device_target': set_device_target,
         'device_id': set_device_id,
         'max_call_depth': set_max_call_depth,
+        'cpu_inter_op_threads': set_cpu_inter_op_threads,
+        'cpu_intra_op_threads': set_cpu_intra_op_threads,
         'profiling_options': set_profiling_options,
         'variable_memory_max_size': set_variable_memory_max_size,
         'max_device_memory': set_max_device_memory,
@@ -462,7 +474,9 @@ def _check_target_specific_cfgs(device, arg_key):
         'profiling_options': ['Ascend'],
         'print_file_path': ['Ascend'],
         'variable_memory_max_size': ['Ascend'],
-        'max_device_memory': ['GPU']
+        'max_device_memory': ['GPU'],
+        'cpu_inter_op_threads': ['CPU'],
+        'cpu_intra_op_threads': ['CPU']
     }
     # configs not in map device_cfgs are supposed to be suitable for all devices
     if not arg_key in device_cfgs:
@@ -480,7 +494,7 @@ def _check_target_specific_cfgs(device, arg_key):
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool, max_call_depth=int)
+                 enable_sparse=bool, max_call_depth=int, cpu_inter_op_threads=int, cpu_intra_op_threads=int)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -502,11 +516,11 @@ def set_context(**kwargs):
 
     Some configurations are device specific, see the bellow table for details:
 
-    ===========================  ===========================  =================
-    Common(CPU/GPU/Ascend)       Ascend                       GPU
-    ===========================  ===========================  =================
-    check_bprop                  enable_auto_mixed_precision  max_device_memory
-    device_id                    enable_dump                  enable_graph_kernel
+    ===========================  ===========================  ===================  ====================
+    Common(CPU/GPU/Ascend)       Ascend                       GPU                  CPU
+    ===========================  ===========================  ===================  ====================
+    check_bprop                  enable_auto_mixed_precision  max_device_memory    cpu_inter_op_threads
+    device_id                    enable_dump                  enable_graph_kernel  cpu_intra_op_threads
     device_target                save_dump_path
     enable_sparse                enable_graph_kernel
     max_call_depth               enable_reduce_precision
@@ -514,7 +528,7 @@ def set_context(**kwargs):
     reserve_class_name_in_scope  profiling_options
     save_graphs                  variable_memory_max_size
     save_graphs_path             print_file_path
-    ===========================  ===========================  =================
+    ===========================  ===========================  ===================  ====================
 
     Args:
         mode (int): Running in GRAPH_MODE(0) or PYNATIVE_MODE(1). Default: PYNATIVE_MODE(1).
@@ -557,6 +571,10 @@ def set_context(**kwargs):
             suffix to the file. Default: ''.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
         max_call_depth(int): Specify the maximum depth of function call. Default: 1000.
+        cpu_inter_op_threads(int): Number of independent operators of a graph run at once on CPU, 1 runs them one
+            by one. It applies to the graphs compiled after it is set. Default: 1.
+        cpu_intra_op_threads(int): Number of threads one CPU operator runs on, 0 for all the available CPUs.
+            Default: 0.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -578,6 +596,7 @@ def set_context(**kwargs):
         >>> context.set_context(max_device_memory="3.5GB")
         >>> context.set_context(print_file_path="print.pb")
         >>> context.set_context(max_call_depth=80)
+        >>> context.set_context(cpu_inter_op_threads=4, cpu_intra_op_threads=2)
     """
     ctx = _context()
     # set device target first
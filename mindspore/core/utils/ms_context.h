@@ -86,6 +86,8 @@ enum MsCtxParam : unsigned {
   MS_CTX_GE_REF,
   MS_CTX_MAX_CALL_DEPTH,
   MS_CTX_TSD_REF,
+  MS_CTX_CPU_INTER_OP_THREADS,
+  MS_CTX_CPU_INTRA_OP_THREADS,
   MS_CTX_TYPE_UINT32_END,
 
   // paramater of type float
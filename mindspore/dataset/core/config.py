@@ -197,6 +197,140 @@ def get_callback_timeout():
     return _config.get_callback_timeout()
 
 
+def set_enable_autotune(enable):
+    """
+    Set whether the dataset pipeline is tuned while it runs.
+    When enabled, the output queue sizes of the operators are adjusted online from the performance monitor
+    samples, and suggested num_parallel_workers values are logged.
+
+    Args:
+        enable (bool): Whether to enable the online tuning of the pipeline.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Tune the pipelines that are created after this call.
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_autotune(enable)
+
+
+def get_enable_autotune():
+    """
+    Get whether the dataset pipeline is tuned while it runs.
+
+    Returns:
+        Bool, whether the online tuning of the pipeline is enabled.
+    """
+    return _config.get_enable_autotune()
+
+
+def set_enable_mindrecord_mmap(enable):
+    """
+    Set whether MindRecord files are memory mapped when they are read.
+    When enabled, MindDataset reads the blob data in place from the mapped files, and numeric columns are not
+    copied into new buffers. It suits datasets on fast local storage where reading is bound by memory copies.
+
+    Args:
+        enable (bool): Whether to read MindRecord files through memory mapping.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Map the MindRecord files of the datasets that are created after this call.
+        >>> ds.config.set_enable_mindrecord_mmap(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_mindrecord_mmap(enable)
+
+
+def get_enable_mindrecord_mmap():
+    """
+    Get whether MindRecord files are memory mapped when they are read.
+
+    Returns:
+        Bool, whether MindRecord files are read through memory mapping.
+    """
+    return _config.get_enable_mindrecord_mmap()
+
+
+def set_mindrecord_prefetch_size(size):
+    """
+    Set the number of rows MindDataset reads ahead of its workers.
+    When the size is greater than 0, a few io threads read the MindRecord files ahead in sampler order, so the
+    reading keeps up with the following operators without many parallel workers. 0 disables reading ahead.
+
+    Args:
+        size (int): Number of rows read ahead.
+
+    Raises:
+        ValueError: If size is invalid (< 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Read 1024 rows ahead in the MindDatasets that are created after this call.
+        >>> ds.config.set_mindrecord_prefetch_size(1024)
+    """
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("MindRecord prefetch size given is not within the required range.")
+    _config.set_mindrecord_prefetch_size(size)
+
+
+def get_mindrecord_prefetch_size():
+    """
+    Get the number of rows MindDataset reads ahead of its workers.
+
+    Returns:
+        Int, number of rows read ahead, 0 if reading ahead is disabled.
+    """
+    return _config.get_mindrecord_prefetch_size()
+
+
+def set_numa_enable(numa_enable):
+    """
+    Set whether each pipeline is bound to a NUMA node.
+    When enabled, the threads of a pipeline that feeds a device only run on the cpus of NUMA node
+    (device_id % number of nodes), and the memory they allocate comes from that node when possible.
+    The allocations that still cross nodes are logged when the pipeline ends. It has no effect on hosts
+    with a single NUMA node or on platforms other than Linux.
+
+    Args:
+        numa_enable (bool): Whether to bind pipelines to NUMA nodes.
+
+    Raises:
+        TypeError: If numa_enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Bind the pipelines launched after this call to the NUMA node of their device.
+        >>> ds.config.set_numa_enable(True)
+    """
+    if not isinstance(numa_enable, bool):
+        raise TypeError("numa_enable must be of type bool.")
+    _config.set_numa_enable(numa_enable)
+
+
+def get_numa_enable():
+    """
+    Get whether each pipeline is bound to a NUMA node.
+
+    Returns:
+        Bool, whether pipelines are bound to NUMA nodes.
+    """
+    return _config.get_numa_enable()
+
+
 def __str__():
     """
     String representation of the configurations.
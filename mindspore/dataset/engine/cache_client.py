@@ -18,19 +18,44 @@
 import os
 import copy
 
-from ..core.validator_helpers import type_check, check_uint32, check_uint64
+from ..core.validator_helpers import type_check, check_uint32, check_uint64, check_value_normalize_std, \
+    check_columns
 
 
 class DatasetCache:
     """
     A client to interface with tensor caching service
+
+    The columns of decoded images, uint8 of shape <H, W> or <H, W, C> with C being 1, 3 or 4, can be cached in a
+    compact form to fit in memory, and are inflated when fetched, which is still far cheaper than decoding them
+    again. The other columns, such as masks, are cached as they are.
+
+    Args:
+        image_columns (Union[str, list[str]], optional): The columns of decoded images to cache in a compact form,
+            required by image_scale and chroma_subsampling (default=None).
+        image_scale (float, optional): Cache the decoded images scaled down by this factor in (0, 1] (default=None,
+            keep their size). The rows are fetched with the smaller images, the rows missing from the cache are
+            passed on with their images in the same form.
+        chroma_subsampling (bool, optional): Cache the decoded RGB images as YUV 4:2:0, which takes half the
+            memory at the cost of some color detail (default=None, keep them as they are).
     """
 
     def __init__(self, session_id=None, size=0, spilling=False, hostname=None, port=None, num_connections=None,
-                 prefetch_size=None):
+                 prefetch_size=None, image_columns=None, image_scale=None, chroma_subsampling=None):
         check_uint32(session_id, "session_id")
         check_uint64(size, "size")
         type_check(spilling, (bool,), "spilling")
+        if image_columns is not None:
+            check_columns(image_columns, "image_columns")
+            if isinstance(image_columns, str):
+                image_columns = [image_columns]
+        if image_scale is not None:
+            type_check(image_scale, (float, int), "image_scale")
+            check_value_normalize_std(image_scale, [0, 1], "image_scale")
+        if chroma_subsampling is not None:
+            type_check(chroma_subsampling, (bool,), "chroma_subsampling")
+        if (image_scale not in (None, 1) or chroma_subsampling) and image_columns is None:
+            raise ValueError("image_columns is required to cache compact images.")
 
         self.session_id = session_id
         self.size = size
@@ -39,12 +64,16 @@ class DatasetCache:
         self.port = port
         self.prefetch_size = prefetch_size
         self.num_connections = num_connections
+        self.image_columns = image_columns
+        self.image_scale = image_scale
+        self.chroma_subsampling = chroma_subsampling
         if os.getenv('MS_ENABLE_CACHE') != 'TRUE':
             # temporary disable cache feature in the current release
             self.cache_client = None
         else:
             from mindspore._c_dataengine import CacheClient
-            self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size)
+            self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size,
+                                            image_columns, image_scale, chroma_subsampling)
 
     def GetStat(self):
         return self.cache_client.GetStat()
@@ -62,5 +91,8 @@ class DatasetCache:
         new_cache.port = copy.deepcopy(self.port, memodict)
         new_cache.prefetch_size = copy.deepcopy(self.prefetch_size, memodict)
         new_cache.num_connections = copy.deepcopy(self.num_connections, memodict)
+        new_cache.image_columns = copy.deepcopy(self.image_columns, memodict)
+        new_cache.image_scale = copy.deepcopy(self.image_scale, memodict)
+        new_cache.chroma_subsampling = copy.deepcopy(self.chroma_subsampling, memodict)
         new_cache.cache_client = self.cache_client
         return new_cache
@@ -28,12 +28,13 @@ import queue
 from enum import Enum
 from importlib import import_module
 import threading
+import traceback
 
 import copy
 import numpy as np
 
 from mindspore._c_dataengine import DataType, TFReaderOp, ImageFolderOp, CifarOp, MnistOp, ManifestOp, \
-    MindRecordOp, TextFileOp, ClueOp, CsvOp, VOCOp, CocoOp, CBatchInfo
+    MindRecordOp, TextFileOp, ClueOp, CsvOp, VOCOp, CocoOp, CBatchInfo, SharedRowRing
 from mindspore._c_expression import typing
 
 from mindspore import log as logger
@@ -49,7 +50,7 @@ from .validators import check_batch, check_shuffle, check_map, check_filter, che
     check_tfrecorddataset, check_vocdataset, check_cocodataset, check_celebadataset, check_minddataset, \
     check_generatordataset, check_sync_wait, check_zip_dataset, check_add_column, check_textfiledataset, check_concat, \
     check_random_dataset, check_split, check_bucket_batch_by_length, check_cluedataset, check_save, check_csvdataset, \
-    check_paddeddataset, check_iterator
+    check_paddeddataset, check_iterator, check_resume_state, check_lock_free_connector
 from ..core.config import get_callback_timeout
 from ..core.datatypes import mstype_to_detype, mstypelist_to_detypelist
 from ..text.utils import DE_C_INTER_SENTENCEPIECE_MODE
@@ -153,6 +154,8 @@ class Dataset:
         self._num_classes = None
         self._repeat_count = None
         self._sync = False
+        self.resume_state = None
+        self.lock_free_connector = False
 
     def _noop_mode(self):
         if _is_role_sched() or _is_role_pserver():
@@ -1375,6 +1378,55 @@ class Dataset:
             return self.children[0].get_repeat_count()
         return 1
 
+    @check_resume_state
+    def set_resume_state(self, state):
+        """
+        Make the next iterator created over this dataset resume where an earlier iterator over the same pipeline
+        was, the iterators after it start from the beginning again. Whole epochs are skipped without reading their
+        rows, and so are the rows of the current epoch if every operation of the pipeline can skip them, otherwise
+        these are read and dropped. The seeds and the shuffle states of the earlier run are restored, so the rows
+        come in the same order.
+
+        Note:
+            A pipeline with a cache cannot resume.
+
+        Args:
+            state (dict): State returned by the get_state method of the earlier iterator. Its 'epoch' and 'row',
+                the number of epochs and rows of the current epoch consumed, can be changed, e.g. to the position
+                of a training loop that sinks the data to a device.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of Dataset object
+            >>> iterator = data.create_dict_iterator()
+            >>> for _ in range(10):
+            >>>     next(iterator)
+            >>> state = iterator.get_state()
+            >>> # in another process, the same pipeline goes on from the 11th row
+            >>> data.set_resume_state(state)
+            >>> iterator = data.create_dict_iterator()
+        """
+        self.resume_state = state
+
+    @check_lock_free_connector
+    def set_lock_free_connector(self, lock_free=True):
+        """
+        Choose how the rows of this dataset are passed to the next operation. A lock free connector lets the
+        workers exchange the rows without taking locks and with fewer thread wakeups, which pays off for pipelines
+        with many small rows, e.g. text pipelines, at the cost of some cpu spent polling when the pipeline is idle.
+        The rows come in the same order with either connector.
+
+        Args:
+            lock_free (bool, optional): Whether the connector is lock free (default=True).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of Dataset object
+            >>> data = data.map(input_columns=["text"], operations=tokenizer, num_parallel_workers=8)
+            >>> data.set_lock_free_connector()
+        """
+        self.lock_free_connector = lock_free
+
     def reset(self):
         """Reset the dataset for next epoch."""
 
@@ -3286,12 +3338,16 @@ def _fill_worker_indices(workers, indices, idx):
     return idx
 
 
+# Rows each generator worker process may get ahead of the pipeline, as many as its index and result queues hold
+_SHARED_RING_SLOTS = 16
+
+
 class SamplerFn:
     """
     Multiprocessing or multithread generator function wrapper master process.
     """
 
-    def __init__(self, dataset, num_worker, multi_process):
+    def __init__(self, dataset, num_worker, multi_process, max_rowsize=None):
         self.workers = []
         self.num_worker = num_worker
         self.multi_process = multi_process
@@ -3300,15 +3356,22 @@ class SamplerFn:
             self.eof = multiprocessing.Event()
         else:
             self.eof = threading.Event()
+        # Rows of worker processes go through rings in shared memory, which only forked processes inherit
+        self.rings = None
+        if multi_process is True and max_rowsize is not None and multiprocessing.get_start_method() == "fork":
+            self.rings = [SharedRowRing(_SHARED_RING_SLOTS, max_rowsize * 1024 * 1024) for _ in range(num_worker)]
         # Create workers
-        for _ in range(num_worker):
+        for i in range(num_worker):
             if multi_process is True:
-                worker = _GeneratorWorkerMp(dataset, self.eof)
+                worker = _GeneratorWorkerMp(dataset, self.eof, self.rings[i] if self.rings else None)
                 worker.daemon = True
                 # When multi processes fork a subprocess, the lock of the main process is copied to the subprocess,
                 # which may cause deadlock. Therefore, the subprocess startup is performed in che initialization phase.
                 # In this phase, the main process is not locked.
                 worker.start()
+                # The pipeline then notices the worker exiting even before it pushed a row
+                if self.rings is not None:
+                    self.rings[i].set_producer(worker.pid)
             else:
                 worker = _GeneratorWorkerMt(dataset, self.eof)
                 worker.daemon = True
@@ -3318,6 +3381,24 @@ class SamplerFn:
         """
         The main process, start the child process or child thread, and fill the index queue.
         Get the result and return.
+        With shared rings, only hand the indices out, GeneratorOp reads the rows from the rings.
+        """
+        if self.rings is not None:
+            return self._dispatch(indices)
+        return self._fetch(indices)
+
+    def _dispatch(self, indices):
+        """
+        Hand the indices of an epoch out to the worker processes, worker i takes the indices at i, i + n, i + 2n...
+        """
+        for i, w in enumerate(self.workers):
+            if not w.is_alive():
+                raise Exception("Generator worker process exited unexpectedly.")
+            w.put_shard(indices[i::self.num_worker])
+
+    def _fetch(self, indices):
+        """
+        Fill the index queues and yield the results of the workers in order.
         """
         for w in self.workers:
             # Check whether the queue of the subprocess is empty.
@@ -3350,6 +3431,9 @@ class SamplerFn:
 
     def __del__(self):
         self.eof.set()
+        if self.rings is not None:
+            for ring in self.rings:
+                ring.close()
 
 
 def _generator_worker_loop(dataset, idx_queue, result_queue, eof):
@@ -3391,6 +3475,43 @@ def _generator_worker_loop(dataset, idx_queue, result_queue, eof):
         del result, idx
 
 
+def _generator_worker_ring_loop(dataset, idx_queue, ring, eof):
+    """
+    Multiprocess generator worker loop, push the rows of each epoch of indices to a shared ring in order.
+    """
+    while True:
+        # Fetch the indices of an epoch, block
+        try:
+            shard = idx_queue.get(timeout=1)
+        except KeyboardInterrupt:
+            raise Exception("Generator worker receives KeyboardInterrupt")
+        except queue.Empty:
+            if eof.is_set():
+                return
+            continue
+        if shard is None or eof.is_set():
+            return
+        for idx in shard:
+            try:
+                result = tuple([np.array(x, copy=False) for x in dataset[idx]])
+            except Exception:  # pylint: disable=broad-except
+                # Hand the exception over to the pipeline, which stops on it
+                ring.push_error("Generator worker process failed on index {}:\n{}".format(idx, traceback.format_exc()))
+                return
+            try:
+                pushed = ring.push_row(result)
+            except RuntimeError:
+                # The row is larger than a slot of the ring
+                ring.push_error("Generator worker process failed on index {}:\n{}".format(idx, traceback.format_exc()))
+                return
+            # A closed ring means the pipeline is gone
+            if not pushed:
+                return
+            del result
+        if not ring.push_eoe():
+            return
+
+
 class _GeneratorWorkerMt(threading.Thread):
     """
     Worker process for multithread Generator.
@@ -3428,10 +3549,20 @@ class _GeneratorWorkerMp(multiprocessing.Process):
     Worker process for multiprocess Generator.
     """
 
-    def __init__(self, dataset, eof):
+    def __init__(self, dataset, eof, ring=None):
         self.idx_queue = multiprocessing.Queue(16)
-        self.res_queue = multiprocessing.Queue(16)
-        super().__init__(target=_generator_worker_loop, args=(dataset, self.idx_queue, self.res_queue, eof))
+        if ring is not None:
+            self.res_queue = None
+            super().__init__(target=_generator_worker_ring_loop, args=(dataset, self.idx_queue, ring, eof))
+        else:
+            self.res_queue = multiprocessing.Queue(16)
+            super().__init__(target=_generator_worker_loop, args=(dataset, self.idx_queue, self.res_queue, eof))
+
+    def put_shard(self, indices):
+        """
+        Put the indices of an epoch to the worker index queue. Block with timeout.
+        """
+        self.idx_queue.put(indices, timeout=30)
 
     def put(self, item):
         """
@@ -3525,6 +3656,10 @@ class GeneratorDataset(MappableDataset):
             when num_shards is also specified. Random accessible input is required.
         python_multiprocessing (bool, optional): Parallelize Python operations with multiple worker process. This
             option could be beneficial if the Python operation is computational heavy (default=True).
+        max_rowsize (int, optional): Maximum size of a row in MB to pass the rows of worker processes to the
+            pipeline through shared memory, used when python_multiprocessing is True and num_parallel_workers is
+            greater than 1 (default=None, pass the rows through queues). Rows are then read in sampler order without
+            being pickled, unless they have a column that is not numeric. A larger row fails the pipeline.
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -3566,13 +3701,15 @@ class GeneratorDataset(MappableDataset):
     @check_generatordataset
     def __init__(self, source, column_names=None, column_types=None, schema=None, num_samples=None,
                  num_parallel_workers=1, shuffle=None, sampler=None, num_shards=None, shard_id=None,
-                 python_multiprocessing=True):
+                 python_multiprocessing=True, max_rowsize=None):
         super().__init__(num_parallel_workers)
         self.source = source
         self.sampler = _select_sampler(num_samples, sampler, shuffle, num_shards, shard_id)
         self.num_samples = num_samples
         self.num_shards = num_shards
         self.python_multiprocessing = python_multiprocessing
+        self.max_rowsize = max_rowsize
+        self.shared_rings = None
 
         if column_names is not None and not isinstance(column_names, list):
             column_names = [column_names]
@@ -3598,6 +3735,7 @@ class GeneratorDataset(MappableDataset):
         args["source"] = self.source
         args["column_names"] = self.column_names
         args["column_types"] = self.column_types
+        args["shared_rings"] = self.shared_rings
         return args
 
     def get_dataset_size(self):
@@ -3637,6 +3775,9 @@ class GeneratorDataset(MappableDataset):
         new_op.column_names = copy.deepcopy(self.column_names, memodict)
         new_op.num_samples = copy.deepcopy(self.num_samples, memodict)
         new_op.dataset_size = self.dataset_size
+        new_op.python_multiprocessing = self.python_multiprocessing
+        new_op.max_rowsize = self.max_rowsize
+        new_op.shared_rings = None
         new_op.sampler = copy.deepcopy(self.sampler)
         if new_op.sampler is not None and hasattr(self.source, "__getitem__"):
             if isinstance(new_op.sampler, (samplers.SequentialSampler, samplers.DistributedSampler,
@@ -3646,13 +3787,17 @@ class GeneratorDataset(MappableDataset):
                 sampler_instance.set_num_rows(len(self.source))
                 sampler_instance.initialize()
                 if new_op.num_parallel_workers > 1:
-                    sample_fn = SamplerFn(self.source, new_op.num_parallel_workers, self.python_multiprocessing)
+                    sample_fn = SamplerFn(self.source, new_op.num_parallel_workers, self.python_multiprocessing,
+                                          self.max_rowsize)
+                    new_op.shared_rings = sample_fn.rings
                     new_op.source = (lambda: _cpp_sampler_fn_mp(sampler_instance, sample_fn))
                 else:
                     new_op.source = (lambda: _cpp_sampler_fn(sampler_instance, self.source))
             else:
                 if new_op.num_parallel_workers > 1:
-                    sample_fn = SamplerFn(self.source, new_op.num_parallel_workers, self.python_multiprocessing)
+                    sample_fn = SamplerFn(self.source, new_op.num_parallel_workers, self.python_multiprocessing,
+                                          self.max_rowsize)
+                    new_op.shared_rings = sample_fn.rings
                     new_op.source = (lambda: _py_sampler_fn_mp(new_op.sampler, new_op.num_samples, sample_fn))
                 else:
                     new_op.source = (lambda: _py_sampler_fn(new_op.sampler, new_op.num_samples, self.source))
@@ -57,6 +57,10 @@ class GraphData:
         auto_shutdown (bool, optional): Valid when working_mode is set to 'server',
             when the number of connected clients reaches num_client and no client is being connected,
             the server automatically exits (default=True).
+        csr_storage (bool, optional): Keep the graph in compact arrays (compressed sparse rows of neighbors and
+            packed features) instead of one object per node and edge. It uses much less memory on large graphs and
+            samples neighbors in parallel, but only supports numeric features of a fixed shape per feature type. This
+            parameter is not valid when working_mode is set to 'client' (default=False).
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -68,7 +72,7 @@ class GraphData:
 
     @check_gnn_graphdata
     def __init__(self, dataset_file, num_parallel_workers=None, working_mode='local', hostname='127.0.0.1', port=50051,
-                 num_client=1, auto_shutdown=True):
+                 num_client=1, auto_shutdown=True, csr_storage=False):
         self._dataset_file = dataset_file
         self._working_mode = working_mode
         if num_parallel_workers is None:
@@ -78,12 +82,13 @@ class GraphData:
             self._graph_data.stop()
 
         if working_mode in ['local', 'client']:
-            self._graph_data = GraphDataClient(dataset_file, num_parallel_workers, working_mode, hostname, port)
+            self._graph_data = GraphDataClient(dataset_file, num_parallel_workers, working_mode, hostname, port,
+                                               csr_storage)
             atexit.register(stop)
 
         if working_mode == 'server':
             self._graph_data = GraphDataServer(
-                dataset_file, num_parallel_workers, hostname, port, num_client, auto_shutdown)
+                dataset_file, num_parallel_workers, hostname, port, num_client, auto_shutdown, csr_storage)
             atexit.register(stop)
             try:
                 while self._graph_data.is_stoped() is not True:
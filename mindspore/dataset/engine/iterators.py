@@ -16,6 +16,7 @@
 """
 from abc import abstractmethod
 import copy
+import json
 import weakref
 import numpy as np
 
@@ -86,6 +87,8 @@ class Iterator:
         self.output_numpy = output_numpy
         ITERATORS_LIST.append(weakref.ref(self))
         _unset_iterator_cleanup()
+        # the state to resume from only applies to this iterator, the next ones start over
+        resume_state = self.__take_resume_state(dataset)
         # create a copy of tree and work on it.
         self.dataset = copy.deepcopy(dataset)
         self.ori_dataset = dataset
@@ -110,6 +113,8 @@ class Iterator:
         root = self.__convert_node_postorder(self.dataset)
         self.depipeline.AssignRootNode(root)
         self.depipeline.PrepareTree(self.num_epochs)
+        if resume_state is not None:
+            self.depipeline.Resume(json.dumps(resume_state))
         self._index = 0
 
     def stop(self):
@@ -120,6 +125,18 @@ class Iterator:
         if hasattr(self, 'depipeline') and self.depipeline:
             del self.depipeline
 
+    def __take_resume_state(self, node):
+        """Find the state to resume from, set on any node of the tree, and clear it."""
+        state = getattr(node, "resume_state", None)
+        if state is not None:
+            node.resume_state = None
+            return state
+        for input_node in node.children:
+            state = self.__take_resume_state(input_node)
+            if state is not None:
+                return state
+        return None
+
     def __is_tree_node(self, node):
         """Check if a node is tree node."""
         if not node.children:
@@ -213,7 +230,10 @@ class Iterator:
     def __convert_node_postorder(self, node):
         self.check_node_type(node)
         op_type = self.__get_dataset_type(node)
-        c_nodes = self.depipeline.AddNodeToTree(op_type, node.get_args())
+        args = node.get_args()
+        if node.lock_free_connector:
+            args["lock_free_connector"] = True
+        c_nodes = self.depipeline.AddNodeToTree(op_type, args)
 
         for py_child in node.children:
             c_child = self.__convert_node_postorder(py_child)
@@ -295,6 +315,17 @@ class Iterator:
     def get_col_names(self):
         return self.depipeline.GetColumnNames()
 
+    def get_state(self):
+        """
+        Get what another iterator over the same pipeline needs to resume where this one is, see
+        Dataset.set_resume_state.
+
+        Returns:
+            dict, the number of epochs ('epoch') and rows of the current epoch ('row') consumed, and the seeds and
+            shuffle states of the operations ('ops').
+        """
+        return json.loads(self.depipeline.GetState())
+
     def __deepcopy__(self, memo):
         return self
 
@@ -19,6 +19,7 @@ SequentialSampler, SubsetRandomSampler, and WeightedRandomSampler.
 Users can also define a custom sampler by extending from the Sampler class.
 """
 
+import copy
 import numpy as np
 import mindspore._c_dataengine as cde
 import mindspore.dataset as ds
@@ -566,10 +567,17 @@ class WeightedRandomSampler(BuiltinSampler):
     """
     Samples the elements from [0, len(weights) - 1] randomly with the given weights (probabilities).
 
+    The weights can be changed while the dataset is iterated, e.g. from the training loop for curriculum learning
+    or hard example mining, with update_weights. A change takes O(log n) per element and applies to the elements
+    drawn after it, there is no need to build the dataset again.
+
     Args:
         weights (list[float]): A sequence of weights, not necessarily summing up to 1.
         num_samples (int, optional): Number of elements to sample (default=None, all elements).
         replacement (bool): If True, put the sample ID back for the next draw (default=True).
+        num_shards (int, optional): Number of shards to divide the elements into (default=None). Shard k samples
+            the elements i with i % num_shards == k only, in proportion to their weights.
+        shard_id (int, optional): Shard ID of the current shard within num_shards (default=None).
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -581,13 +589,19 @@ class WeightedRandomSampler(BuiltinSampler):
         >>> # creates a WeightedRandomSampler that will sample 4 elements without replacement
         >>> sampler = ds.WeightedRandomSampler(weights, 4)
         >>> data = ds.ImageFolderDataset(dataset_dir, num_parallel_workers=8, sampler=sampler)
+        >>>
+        >>> # after an epoch, make the first two elements more likely
+        >>> sampler.update_weights([0, 1], [2.0, 1.5])
 
     Raises:
         ValueError: If num_samples is not positive.
         ValueError: If replacement is not boolean.
+        ValueError: If only one of num_shards and shard_id is given.
+        ValueError: If num_shards is not positive or greater than the number of weights.
+        ValueError: If shard_id is smaller than 0 or not smaller than num_shards.
     """
 
-    def __init__(self, weights, num_samples=None, replacement=True):
+    def __init__(self, weights, num_samples=None, replacement=True, num_shards=None, shard_id=None):
         if not isinstance(weights, list):
             weights = [weights]
 
@@ -599,21 +613,86 @@ class WeightedRandomSampler(BuiltinSampler):
         if not isinstance(replacement, bool):
             raise ValueError("replacement should be a boolean value, but got replacement={}".format(replacement))
 
+        if (num_shards is None) != (shard_id is None):
+            raise ValueError("num_shards and shard_id should be given together.")
+        if num_shards is not None:
+            if num_shards <= 0 or num_shards > len(weights):
+                raise ValueError("num_shards should be a positive integer value not greater than the number of "
+                                 "weights, but got num_shards={}".format(num_shards))
+            if shard_id < 0 or shard_id >= num_shards:
+                raise ValueError("shard_id should be in range [0, {}], but got shard_id={}".format(num_shards - 1,
+                                                                                                 shard_id))
+            if num_samples is None:
+                num_samples = (len(weights) - shard_id + num_shards - 1) // num_shards
+
         self.weights = weights
         self.replacement = replacement
+        self.num_shards = num_shards
+        self.shard_id = shard_id
+        # The C++ samplers created from this one, shared by its copies, so that updates reach running pipelines.
+        # They are held weakly, a sampler goes away with its pipeline.
+        self._c_samplers = cde.WeightedRandomSamplerGroup()
         super().__init__(num_samples)
 
+    def __deepcopy__(self, memodict):
+        if id(self) in memodict:
+            return memodict[id(self)]
+        cls = self.__class__
+        new_sampler = cls.__new__(cls)
+        memodict[id(self)] = new_sampler
+        for name, value in self.__dict__.items():
+            if name != "_c_samplers":
+                setattr(new_sampler, name, copy.deepcopy(value, memodict))
+        new_sampler._c_samplers = self._c_samplers
+        return new_sampler
+
     def create(self):
         num_samples = self.num_samples if self.num_samples is not None else 0
-        c_sampler = cde.WeightedRandomSampler(num_samples, self.weights, self.replacement)
+        if self.num_shards is None:
+            c_sampler = cde.WeightedRandomSampler(num_samples, self.weights, self.replacement)
+        else:
+            c_sampler = cde.WeightedRandomSampler(num_samples, self.weights, self.replacement, self.num_shards,
+                                                  self.shard_id)
         c_child_sampler = self.create_child()
         c_sampler.add_child(c_child_sampler)
+        self._c_samplers.add(c_sampler)
         return c_sampler
 
+    def update_weights(self, indices, weights):
+        """
+        Change the weights of some elements, in the datasets already iterated with this sampler too.
+
+        Args:
+            indices (list[int]): The elements, in [0, len(weights) - 1].
+            weights (list[float]): Their new weights, not negative.
+
+        Raises:
+            ValueError: If indices and weights do not have the same length, an index is out of range or a weight is
+                negative.
+        """
+        if not isinstance(indices, list):
+            indices = [indices]
+        if not isinstance(weights, list):
+            weights = [weights]
+        if len(indices) != len(weights):
+            raise ValueError("indices and weights should have the same length, but got {} and {}".format(
+                len(indices), len(weights)))
+        for index, weight in zip(indices, weights):
+            if index < 0 or index >= len(self.weights):
+                raise ValueError("index should be in range [0, {}], but got index={}".format(len(self.weights) - 1,
+                                                                                           index))
+            if weight < 0:
+                raise ValueError("weights should not be negative, but got weight={}".format(weight))
+        for index, weight in zip(indices, weights):
+            self.weights[index] = weight
+        self._c_samplers.update_weights(indices, weights)
+
     def is_shuffled(self):
         return True
 
     def is_sharded(self):
+        if self.num_shards is not None and self.num_shards > 1:
+            return True
         if self.child_sampler is None:
             return False
 
@@ -131,7 +131,8 @@ def serialize_sampler(node_repr, val):
     if val is None:
         node_repr['sampler'] = None
     else:
-        node_repr['sampler'] = val.__dict__
+        # Private attributes, such as the C++ samplers a sampler created, are not part of its description
+        node_repr['sampler'] = {k: v for k, v in val.__dict__.items() if not k.startswith('_')}
         node_repr['sampler']['sampler_module'] = type(val).__module__
         node_repr['sampler']['sampler_name'] = type(val).__name__
 
@@ -399,7 +400,8 @@ def construct_sampler(in_sampler):
         elif sampler_name == 'SubsetRandomSampler':
             sampler = sampler_class(in_sampler['indices'])
         elif sampler_name == 'WeightedRandomSampler':
-            sampler = sampler_class(in_sampler['weights'], in_sampler['num_samples'], in_sampler.get('replacement'))
+            sampler = sampler_class(in_sampler['weights'], in_sampler['num_samples'], in_sampler.get('replacement'),
+                                    in_sampler.get('num_shards'), in_sampler.get('shard_id'))
         else:
             raise ValueError("Sampler type is unknown: " + sampler_name)
 
@@ -24,7 +24,7 @@ from functools import wraps
 import numpy as np
 from mindspore._c_expression import typing
 from ..core.validator_helpers import parse_user_args, type_check, type_check_list, check_value, \
-    INT32_MAX, check_valid_detype, check_dir, check_file, check_sampler_shuffle_shard_options, \
+    INT32_MAX, INT64_MAX, check_valid_detype, check_dir, check_file, check_sampler_shuffle_shard_options, \
     validate_dataset_param_value, check_padding_options, check_gnn_list_or_ndarray, check_num_parallel_workers, \
     check_columns, check_pos_int32, check_valid_str
 
@@ -371,6 +371,11 @@ def check_generatordataset(method):
         nreq_param_bool = ["shuffle"]
         validate_dataset_param_value(nreq_param_bool, param_dict, bool)
 
+        max_rowsize = param_dict.get("max_rowsize")
+        if max_rowsize is not None:
+            type_check(max_rowsize, (int,), "max_rowsize")
+            check_pos_int32(max_rowsize, "max_rowsize")
+
         num_shards = param_dict.get("num_shards")
         shard_id = param_dict.get("shard_id")
         if (num_shards is None) != (shard_id is None):
@@ -660,6 +665,42 @@ def check_repeat(method):
     return new_method
 
 
+def check_resume_state(method):
+    """check the input arguments of set_resume_state."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [state], _ = parse_user_args(method, *args, **kwargs)
+
+        type_check(state, (dict,), "state")
+        for key in ("epoch", "row", "ops"):
+            if key not in state:
+                raise ValueError("state should be a state returned by get_state of an iterator, missing '{}'."
+                                 .format(key))
+        type_check(state["epoch"], (int,), "state['epoch']")
+        type_check(state["row"], (int,), "state['row']")
+        check_value(state["epoch"], (0, INT32_MAX), "state['epoch']")
+        check_value(state["row"], (0, INT64_MAX), "state['row']")
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
+def check_lock_free_connector(method):
+    """check the input arguments of set_lock_free_connector."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [lock_free], _ = parse_user_args(method, *args, **kwargs)
+
+        type_check(lock_free, (bool,), "lock_free")
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
 def check_skip(method):
     """check the input arguments of skip."""
 
@@ -988,7 +1029,7 @@ def check_gnn_graphdata(method):
     @wraps(method)
     def new_method(self, *args, **kwargs):
         [dataset_file, num_parallel_workers, working_mode, hostname,
-         port, num_client, auto_shutdown], _ = parse_user_args(method, *args, **kwargs)
+         port, num_client, auto_shutdown, csr_storage], _ = parse_user_args(method, *args, **kwargs)
         check_file(dataset_file)
         if num_parallel_workers is not None:
             check_num_parallel_workers(num_parallel_workers)
@@ -1003,6 +1044,7 @@ def check_gnn_graphdata(method):
         type_check(num_client, (int,), "num_client")
         check_value(num_client, (1, 255), "num_client")
         type_check(auto_shutdown, (bool,), "auto_shutdown")
+        type_check(csr_storage, (bool,), "csr_storage")
         return method(self, *args, **kwargs)
 
     return new_method
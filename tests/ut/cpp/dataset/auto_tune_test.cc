@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <memory>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/engine/datasetops/source/random_data_op.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include "minddata/dataset/kernels/data/no_op.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestAutoTune : public UT::DatasetOpTesting {};
+
+// Tree: RandomDataOp -> MapOp(NoOp), prepared only
+// The tuning steps are fed the sizes of the output connector of the map, so that they do not depend on timing: a
+// connector seen both empty and full grows by steps up to kMaxQueueGrowth times its capacity, a steady one does not.
+TEST_F(MindDataTestAutoTune, TestGrowBurstyConnector) {
+  const int32_t kQueueSize = 2;
+  auto tree = std::make_shared<ExecutionTree>();
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  TensorShape label_shape({});
+  ASSERT_TRUE(
+    schema->AddColumn(ColDescriptor("label", DataType(DataType::DE_UINT32), TensorImpl::kFlexible, 0, &label_shape))
+      .IsOk());
+  std::shared_ptr<RandomDataOp> random_op;
+  ASSERT_TRUE(RandomDataOp::Builder()
+                .SetRowsPerBuffer(1)
+                .SetNumWorkers(1)
+                .SetDataSchema(std::move(schema))
+                .SetTotalRows(16)
+                .Build(&random_op)
+                .IsOk());
+  std::shared_ptr<MapOp> map_op;
+  ASSERT_TRUE(MapOp::Builder()
+                .SetInColNames({"label"})
+                .SetOutColNames({})
+                .SetTensorFuncs({std::make_shared<NoOp>()})
+                .SetNumWorkers(1)
+                .SetOpConnectorSize(kQueueSize)
+                .Build(&map_op)
+                .IsOk());
+  ASSERT_TRUE(tree->AssociateNode(random_op).IsOk());
+  ASSERT_TRUE(tree->AssociateNode(map_op).IsOk());
+  ASSERT_TRUE(map_op->AddChild(random_op).IsOk());
+  ASSERT_TRUE(tree->AssignRoot(map_op).IsOk());
+  ASSERT_TRUE(tree->Prepare().IsOk());
+  ASSERT_EQ(map_op->ConnectorCapacity(), kQueueSize);
+
+  AutoTune autotune(tree.get());
+  // Steady: never empty nor full
+  std::vector<int32_t> steady(AutoTune::kSamplesPerStep, 1);
+  ASSERT_TRUE(autotune.TuneWithSamples({{map_op->id(), steady}}).IsOk());
+  EXPECT_EQ(map_op->ConnectorCapacity(), kQueueSize);
+
+  // Bursty: empty in half of the samples, full at the current capacity in the other half
+  auto bursty = [&map_op]() {
+    std::vector<int32_t> sizes;
+    for (int32_t i = 0; i < AutoTune::kSamplesPerStep; i++) {
+      sizes.push_back(i % 2 == 0 ? 0 : map_op->ConnectorCapacity());
+    }
+    return sizes;
+  };
+  ASSERT_TRUE(autotune.TuneWithSamples({{map_op->id(), bursty()}}).IsOk());
+  EXPECT_EQ(map_op->ConnectorCapacity(), kQueueSize * 2);
+  ASSERT_TRUE(autotune.TuneWithSamples({{map_op->id(), bursty()}}).IsOk());
+  EXPECT_EQ(map_op->ConnectorCapacity(), kQueueSize * AutoTune::kMaxQueueGrowth);
+  ASSERT_TRUE(autotune.TuneWithSamples({{map_op->id(), bursty()}}).IsOk());
+  EXPECT_EQ(map_op->ConnectorCapacity(), kQueueSize * AutoTune::kMaxQueueGrowth);
+}
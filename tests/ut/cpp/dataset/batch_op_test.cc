@@ -373,3 +373,54 @@ TEST_F(MindDataTestBatchOp, TestSimpleBatchPadding) {
     EXPECT_TRUE(rc.IsOk());
   }
 }
+
+TEST_F(MindDataTestBatchOp, TestBatchRowsPadInPlace) {
+  // rows of shape [1, 3], [2, 1] and [3, 2] padded (and truncated) to [2, 2] with 7
+  std::vector<std::vector<int32_t>> data = {{1, 2, 3}, {4, 5}, {6, 7, 8, 9, 10, 11}};
+  std::vector<TensorShape> shapes = {TensorShape({1, 3}), TensorShape({2, 1}), TensorShape({3, 2})};
+  auto src = std::make_unique<TensorQTable>();
+  for (size_t i = 0; i < data.size(); i++) {
+    std::shared_ptr<Tensor> t;
+    ASSERT_TRUE(Tensor::CreateFromVector(data[i], shapes[i], &t).IsOk());
+    TensorRow row;
+    row.push_back(t);
+    src->push_back(row);
+  }
+  std::shared_ptr<Tensor> pad_value;
+  ASSERT_TRUE(Tensor::CreateScalar<float>(7, &pad_value).IsOk());
+  auto dest = std::make_unique<TensorQTable>();
+  std::vector<std::vector<dsize_t>> pad_shapes = {{2, 2}};
+  ASSERT_TRUE(BatchOp::BatchRows(&src, &dest, 3, pad_shapes, {pad_value}, 2).IsOk());
+
+  std::shared_ptr<Tensor> expected;
+  std::vector<int32_t> expected_data = {1, 2, 7, 7, 4, 7, 5, 7, 6, 7, 8, 9};
+  ASSERT_TRUE(Tensor::CreateFromVector(expected_data, TensorShape({3, 2, 2}), &expected).IsOk());
+  ASSERT_EQ(dest->size(), 1);
+  EXPECT_EQ(*expected, *(dest->front()[0]));
+}
+
+TEST_F(MindDataTestBatchOp, TestBatchRowsParallelCopy) {
+  // 64 rows of 256KB each, enough for the rows to be split among 4 copy threads
+  const int64_t num_rows = 64, row_len = 64 * 1024;
+  auto src = std::make_unique<TensorQTable>();
+  for (int64_t i = 0; i < num_rows; i++) {
+    std::vector<float> values(row_len, static_cast<float>(i));
+    std::shared_ptr<Tensor> t;
+    ASSERT_TRUE(Tensor::CreateFromVector(values, &t).IsOk());
+    TensorRow row;
+    row.push_back(t);
+    src->push_back(row);
+  }
+  auto dest = std::make_unique<TensorQTable>();
+  ASSERT_TRUE(BatchOp::BatchRows(&src, &dest, num_rows, {}, {}, 4).IsOk());
+  ASSERT_EQ(dest->size(), 1);
+  std::shared_ptr<Tensor> batch = dest->front()[0];
+  EXPECT_EQ(batch->shape(), TensorShape({num_rows, row_len}));
+  for (int64_t i = 0; i < num_rows; i++) {
+    float first = 0, last = 0;
+    ASSERT_TRUE(batch->GetItemAt<float>(&first, {i, 0}).IsOk());
+    ASSERT_TRUE(batch->GetItemAt<float>(&last, {i, row_len - 1}).IsOk());
+    EXPECT_EQ(first, static_cast<float>(i));
+    EXPECT_EQ(last, static_cast<float>(i));
+  }
+}
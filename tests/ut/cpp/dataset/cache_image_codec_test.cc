@@ -0,0 +1,132 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/cache/cache_image_codec.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCacheImageCodec : public UT::Common {
+ public:
+  MindDataTestCacheImageCodec() {}
+
+  // A smooth RGB gradient, chroma subsampling keeps it close
+  std::shared_ptr<Tensor> MakeImage(dsize_t height, dsize_t width) {
+    std::vector<uint8_t> pixels;
+    for (dsize_t i = 0; i < height; i++) {
+      for (dsize_t j = 0; j < width; j++) {
+        pixels.push_back(static_cast<uint8_t>(100 + i));
+        pixels.push_back(static_cast<uint8_t>(50 + j));
+        pixels.push_back(static_cast<uint8_t>(150));
+      }
+    }
+    std::shared_ptr<Tensor> image;
+    EXPECT_TRUE(Tensor::CreateFromVector(pixels, TensorShape({height, width, 3}), &image).IsOk());
+    return image;
+  }
+};
+
+TEST_F(MindDataTestCacheImageCodec, TestScale) {
+  std::shared_ptr<Tensor> label;
+  ASSERT_TRUE(Tensor::CreateScalar<int32_t>(7, &label).IsOk());
+  TensorRow row({MakeImage(40, 60), label});
+  CacheImageCodec codec({"image"}, 0.5f, false);
+  TensorRow encoded;
+  // The columns are not found yet
+  ASSERT_FALSE(codec.Encode(row, &encoded).IsOk());
+  ASSERT_FALSE(codec.SelectColumns({{"label", 1}}).IsOk());
+  ASSERT_TRUE(codec.SelectColumns({{"image", 0}, {"label", 1}}).IsOk());
+  ASSERT_TRUE(codec.Encode(row, &encoded).IsOk());
+  ASSERT_TRUE(CacheImageCodec::IsEncoded(encoded[0]));
+  ASSERT_FALSE(CacheImageCodec::IsEncoded(encoded[1]));
+  ASSERT_LT(encoded[0]->SizeInBytes(), row[0]->SizeInBytes());
+  // The input row is left as is
+  ASSERT_EQ(row[0]->shape(), TensorShape({40, 60, 3}));
+
+  ASSERT_TRUE(codec.Decode(&encoded).IsOk());
+  ASSERT_EQ(encoded[0]->shape(), TensorShape({20, 30, 3}));
+  ASSERT_EQ(encoded[1], label);
+  uint8_t pixel;
+  ASSERT_TRUE(encoded[0]->GetItemAt<uint8_t>(&pixel, {0, 0, 2}).IsOk());
+  ASSERT_EQ(pixel, 150);
+}
+
+TEST_F(MindDataTestCacheImageCodec, TestChromaSubsampling) {
+  // Odd dimensions are padded for YUV 4:2:0 and cropped back
+  std::shared_ptr<Tensor> image = MakeImage(15, 21);
+  TensorRow row({image});
+  CacheImageCodec codec({"image"}, 1.0f, true);
+  ASSERT_TRUE(codec.SelectColumns({{"image", 0}}).IsOk());
+  TensorRow encoded;
+  ASSERT_TRUE(codec.Encode(row, &encoded).IsOk());
+  ASSERT_TRUE(CacheImageCodec::IsEncoded(encoded[0]));
+  ASSERT_LT(encoded[0]->SizeInBytes(), image->SizeInBytes() * 3 / 4);
+
+  ASSERT_TRUE(codec.Decode(&encoded).IsOk());
+  ASSERT_EQ(encoded[0]->shape(), image->shape());
+  auto expected = image->begin<uint8_t>();
+  for (auto it = encoded[0]->begin<uint8_t>(); it != encoded[0]->end<uint8_t>(); ++it, ++expected) {
+    ASSERT_LE(std::abs(static_cast<int32_t>(*it) - static_cast<int32_t>(*expected)), 6);
+  }
+}
+
+TEST_F(MindDataTestCacheImageCodec, TestDisabled) {
+  std::shared_ptr<Tensor> gray;
+  ASSERT_TRUE(Tensor::CreateEmpty(TensorShape({8, 8}), DataType(DataType::DE_UINT8), &gray).IsOk());
+  TensorRow row({gray});
+  CacheImageCodec codec({"image"}, 1.0f, false);
+  ASSERT_FALSE(codec.enabled());
+  TensorRow encoded;
+  ASSERT_TRUE(codec.Encode(row, &encoded).IsOk());
+  ASSERT_EQ(encoded[0], gray);
+  // A row that was not encoded is fetched unchanged
+  ASSERT_TRUE(codec.Decode(&encoded).IsOk());
+  ASSERT_EQ(encoded[0], gray);
+}
+
+TEST_F(MindDataTestCacheImageCodec, TestSelectedColumns) {
+  // A uint8 mask of the shape of an image, which must keep every pixel
+  std::shared_ptr<Tensor> mask;
+  ASSERT_TRUE(Tensor::CreateEmpty(TensorShape({40, 60}), DataType(DataType::DE_UINT8), &mask).IsOk());
+  ASSERT_TRUE(mask->Fill<uint8_t>(1).IsOk());
+  std::unordered_map<std::string, int32_t> column_map = {{"mask", 0}, {"image", 1}};
+  TensorRow row({mask, MakeImage(40, 60)});
+  CacheImageCodec codec({"image"}, 0.5f, true);
+  ASSERT_TRUE(codec.SelectColumns(column_map).IsOk());
+  TensorRow encoded;
+  ASSERT_TRUE(codec.Encode(row, &encoded).IsOk());
+  ASSERT_EQ(encoded[0], mask);
+  ASSERT_TRUE(CacheImageCodec::IsEncoded(encoded[1]));
+  ASSERT_TRUE(codec.Decode(&encoded).IsOk());
+  ASSERT_EQ(encoded[0], mask);
+  ASSERT_EQ(encoded[1]->shape(), TensorShape({20, 30, 3}));
+
+  // A column selected but not an image is refused
+  CacheImageCodec mask_codec({"mask"}, 0.5f, false);
+  ASSERT_TRUE(mask_codec.SelectColumns({{"mask", 0}}).IsOk());
+  std::shared_ptr<Tensor> label;
+  ASSERT_TRUE(Tensor::CreateScalar<int32_t>(7, &label).IsOk());
+  TensorRow label_row({label});
+  ASSERT_FALSE(mask_codec.Encode(label_row, &encoded).IsOk());
+  // A row cached with other settings is refused rather than fetched half inflated
+  TensorRow plain_row({mask, MakeImage(40, 60)});
+  ASSERT_FALSE(codec.Decode(&plain_row).IsOk());
+}
@@ -13,7 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <string>
+#include <thread>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
 #include "minddata/dataset/engine/execution_tree.h"
@@ -143,6 +145,152 @@ TEST_F(MindDataTestCacheOp, DISABLED_TestCacheServer) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+// Rows fetched through the shared memory reference it in place. The block of a fetch is kept while its rows live and
+// freed for the next fetches once they are gone.
+TEST_F(MindDataTestCacheOp, DISABLED_TestZeroCopyFetch) {
+  Status rc;
+  CacheClient::Builder builder;
+  session_id_type env_session;
+  rc = GetSessionFromEnv(&env_session);
+  ASSERT_TRUE(rc.IsOk());
+  builder.SetSessionId(env_session).SetCacheMemSz(0).SetSpill(true);
+  std::shared_ptr<CacheClient> myClient;
+  rc = builder.Build(&myClient);
+  ASSERT_TRUE(rc.IsOk());
+  rc = myClient->CreateCache(1, true);
+  ASSERT_TRUE(rc.IsOk());
+
+  // Rows large enough for the server to send them back in the shared memory
+  const int32_t num_rows = 4;
+  std::vector<row_id_type> row_ids;
+  std::vector<std::shared_ptr<Tensor>> written;
+  for (int32_t i = 0; i < num_rows; i++) {
+    std::shared_ptr<Tensor> t;
+    rc = Tensor::CreateEmpty(TensorShape({64, 64, 3}), DataType(DataType::DE_FLOAT32), &t);
+    ASSERT_TRUE(rc.IsOk());
+    float value = static_cast<float>(i);
+    for (auto it = t->begin<float>(); it != t->end<float>(); ++it) {
+      *it = value;
+      value += 0.5;
+    }
+    TensorRow row;
+    row.push_back(t);
+    int64_t row_id;
+    rc = myClient->WriteRow(row, &row_id);
+    ASSERT_TRUE(rc.IsOk());
+    row_ids.push_back(row_id);
+    written.push_back(t);
+  }
+  rc = myClient->BuildPhaseDone();
+  ASSERT_TRUE(rc.IsOk());
+
+  // Offset in the shared memory of the data of the first row, -1 if it is not there
+  auto *base = static_cast<const unsigned char *>(myClient->SharedMemoryBaseAddr());
+  ASSERT_NE(base, nullptr);
+  // Bigger than any shared memory the server creates
+  const int64_t max_shared_memory_sz = int64_t(64) << 30;
+  auto offset_of = [base, max_shared_memory_sz](const TensorTable &tbl) -> int64_t {
+    int64_t offset = tbl.front().front()->GetBuffer() - base;
+    return offset >= 0 && offset < max_shared_memory_sz ? offset : -1;
+  };
+  auto check_rows = [&written, num_rows](const TensorTable &tbl) {
+    ASSERT_EQ(tbl.size(), num_rows);
+    for (int32_t i = 0; i < num_rows; i++) {
+      ASSERT_EQ(tbl[i].size(), 1);
+      EXPECT_EQ(*tbl[i].front(), *written[i]);
+    }
+  };
+
+  auto tbl1 = std::make_unique<TensorTable>();
+  rc = myClient->GetRows(row_ids, tbl1.get());
+  ASSERT_TRUE(rc.IsOk());
+  check_rows(*tbl1);
+  int64_t first_offset = offset_of(*tbl1);
+  ASSERT_NE(first_offset, -1);
+
+  // The first block is still held, the second fetch goes elsewhere
+  auto tbl2 = std::make_unique<TensorTable>();
+  rc = myClient->GetRows(row_ids, tbl2.get());
+  ASSERT_TRUE(rc.IsOk());
+  check_rows(*tbl2);
+  int64_t second_offset = offset_of(*tbl2);
+  ASSERT_NE(second_offset, -1);
+  EXPECT_NE(second_offset, first_offset);
+  check_rows(*tbl1);
+
+  // Once the rows are gone the blocks are freed, the server frees them asynchronously. A fetch then gets the space
+  // of the first block back.
+  tbl1.reset();
+  tbl2.reset();
+  bool reused = false;
+  for (int32_t attempt = 0; attempt < 100 && !reused; attempt++) {
+    TensorTable tbl;
+    rc = myClient->GetRows(row_ids, &tbl);
+    ASSERT_TRUE(rc.IsOk());
+    check_rows(tbl);
+    reused = offset_of(tbl) == first_offset;
+    if (!reused) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  EXPECT_TRUE(reused);
+
+  rc = myClient->DestroyCache();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+TEST_F(MindDataTestCacheOp, DISABLED_TestFetchedRowOutlivesClient) {
+  Status rc;
+  session_id_type env_session;
+  rc = GetSessionFromEnv(&env_session);
+  ASSERT_TRUE(rc.IsOk());
+  CacheClient::Builder builder;
+  builder.SetSessionId(env_session).SetCacheMemSz(0).SetSpill(true);
+
+  // Writes a row large enough for the server to send it back in the shared memory, and fetches it
+  std::shared_ptr<Tensor> written;
+  rc = Tensor::CreateEmpty(TensorShape({64, 64, 3}), DataType(DataType::DE_FLOAT32), &written);
+  ASSERT_TRUE(rc.IsOk());
+  float value = 0;
+  for (auto it = written->begin<float>(); it != written->end<float>(); ++it) {
+    *it = value;
+    value += 0.5;
+  }
+  auto fetch = [&builder, &written](uint32_t crc, std::shared_ptr<CacheClient> *client, TensorTable *tbl) {
+    ASSERT_TRUE(builder.Build(client).IsOk());
+    ASSERT_TRUE((*client)->CreateCache(crc, true).IsOk());
+    TensorRow row;
+    row.push_back(written);
+    int64_t row_id;
+    ASSERT_TRUE((*client)->WriteRow(row, &row_id).IsOk());
+    ASSERT_TRUE((*client)->BuildPhaseDone().IsOk());
+    ASSERT_TRUE((*client)->GetRows({row_id}, tbl).IsOk());
+    ASSERT_EQ(tbl->size(), 1);
+    EXPECT_EQ(*tbl->front().front(), *written);
+  };
+  std::shared_ptr<CacheClient> first_client;
+  TensorTable first_tbl;
+  fetch(1, &first_client, &first_tbl);
+  auto offset_of = [](const std::shared_ptr<CacheClient> &client, const TensorTable &tbl) {
+    return tbl.front().front()->GetBuffer() - static_cast<const unsigned char *>(client->SharedMemoryBaseAddr());
+  };
+  ASSERT_NE(first_client->SharedMemoryBaseAddr(), nullptr);
+  int64_t first_offset = offset_of(first_client, first_tbl);
+  ASSERT_TRUE(first_client->DestroyCache().IsOk());
+
+  // The row still reads the block once its client is stopped, then it frees the block
+  first_client.reset();
+  EXPECT_EQ(*first_tbl.front().front(), *written);
+  first_tbl.clear();
+
+  // The block was freed before clear() returned, so the fetch of another client gets its space back
+  std::shared_ptr<CacheClient> second_client;
+  TensorTable second_tbl;
+  fetch(2, &second_client, &second_tbl);
+  EXPECT_EQ(offset_of(second_client, second_tbl), first_offset);
+  ASSERT_TRUE(second_client->DestroyCache().IsOk());
+}
+
 TEST_F(MindDataTestCacheOp, DISABLED_TestConcurrencyRequest) {
   // Clear the rc of the master thread if any
   (void)TaskManager::GetMasterThreadRc();
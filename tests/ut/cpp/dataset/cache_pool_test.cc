@@ -0,0 +1,100 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/dataset/util/arena.h"
+#include "minddata/dataset/util/cache_pool.h"
+#include "common/common.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestCachePool : public UT::Common {
+ public:
+  MindDataTestCachePool() {}
+
+  // Fill a 1MB arena with rows of 64KB, twice as many as fit in memory
+  void InsertAndReadBack(CachePool::EvictionPolicy policy, CachePool::CacheStat *stat, int64_t *num_evicted) {
+    const int32_t num_rows = 32;
+    const size_t row_sz = 64 * 1024;
+    std::shared_ptr<Arena> arena;
+    Status rc = Arena::CreateArena(&arena, 1);
+    ASSERT_TRUE(rc.IsOk());
+    std::shared_ptr<MemoryPool> mp = arena;
+    auto cp = std::make_shared<CachePool>(CachePool::value_allocator(mp), true, "/tmp", policy);
+    rc = cp->ServiceStart();
+    ASSERT_TRUE(rc.IsOk());
+    std::vector<uint8_t> row(row_sz);
+    for (int32_t i = 0; i < num_rows; ++i) {
+      std::fill(row.begin(), row.end(), static_cast<uint8_t>(i));
+      rc = cp->Insert(i, {ReadableSlice(row.data(), row_sz)}, false);
+      ASSERT_TRUE(rc.IsOk());
+      // Keep using the first row, it is never the victim of LRU or LFU
+      WritableSlice dest(row.data(), row_sz);
+      rc = cp->Read(0, &dest);
+      ASSERT_TRUE(rc.IsOk());
+      ASSERT_EQ(row.front(), 0);
+    }
+    for (int32_t i = 0; i < num_rows; ++i) {
+      WritableSlice dest(row.data(), row_sz);
+      size_t bytes_read = 0;
+      rc = cp->Read(i, &dest, &bytes_read);
+      ASSERT_TRUE(rc.IsOk());
+      ASSERT_EQ(bytes_read, row_sz);
+      ASSERT_EQ(row.front(), i);
+      ASSERT_EQ(row.back(), i);
+    }
+    *stat = cp->GetStat();
+    *num_evicted = cp->GetNumEvicted();
+    MS_LOG(INFO) << "Rows in memory: " << stat->num_mem_cached << ", rows on disk: " << stat->num_disk_cached
+                 << ", rows evicted: " << *num_evicted << ".";
+    rc = cp->ServiceStop();
+    ASSERT_TRUE(rc.IsOk());
+  }
+};
+
+TEST_F(MindDataTestCachePool, TestNoEviction) {
+  CachePool::CacheStat stat{};
+  int64_t num_evicted = -1;
+  InsertAndReadBack(CachePool::EvictionPolicy::kNone, &stat, &num_evicted);
+  ASSERT_EQ(stat.num_mem_cached + stat.num_disk_cached, 32);
+  ASSERT_GT(stat.num_disk_cached, 0);
+  // Rows that don't fit go to disk directly
+  ASSERT_EQ(num_evicted, 0);
+}
+
+TEST_F(MindDataTestCachePool, TestLruEviction) {
+  CachePool::CacheStat stat{};
+  int64_t num_evicted = 0;
+  InsertAndReadBack(CachePool::EvictionPolicy::kLru, &stat, &num_evicted);
+  ASSERT_EQ(stat.num_mem_cached + stat.num_disk_cached, 32);
+  ASSERT_GT(num_evicted, 0);
+  ASSERT_EQ(stat.num_disk_cached, num_evicted);
+}
+
+TEST_F(MindDataTestCachePool, TestLfuEviction) {
+  CachePool::CacheStat stat{};
+  int64_t num_evicted = 0;
+  InsertAndReadBack(CachePool::EvictionPolicy::kLfu, &stat, &num_evicted);
+  ASSERT_EQ(stat.num_mem_cached + stat.num_disk_cached, 32);
+  ASSERT_GT(num_evicted, 0);
+  ASSERT_EQ(stat.num_disk_cached, num_evicted);
+}
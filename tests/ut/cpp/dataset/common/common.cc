@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "common.h"
+#include "minddata/dataset/core/client.h"
 
 namespace UT {
 #ifdef __cplusplus
@@ -29,6 +30,28 @@ void DatasetOpTesting::SetUp() {
   mindrecord_root_path_ = "data/mindrecord";
 }
 
+void DatasetOpTesting::ReadRows(const std::shared_ptr<mindspore::dataset::ExecutionTree> &tree,
+                                std::vector<mindspore::dataset::TensorRow> *rows) {
+  mindspore::dataset::DatasetIterator di(tree);
+  mindspore::dataset::TensorRow row;
+  ASSERT_TRUE(di.FetchNextTensorRow(&row).IsOk());
+  while (!row.empty()) {
+    rows->push_back(row);
+    ASSERT_TRUE(di.FetchNextTensorRow(&row).IsOk());
+  }
+}
+
+void DatasetOpTesting::ExpectRowsEqual(const std::vector<mindspore::dataset::TensorRow> &rows,
+                                       const std::vector<mindspore::dataset::TensorRow> &expected) {
+  ASSERT_EQ(rows.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(rows[i].size(), expected[i].size());
+    for (size_t j = 0; j < expected[i].size(); j++) {
+      EXPECT_EQ(*rows[i][j], *expected[i][j]);
+    }
+  }
+}
+
 #ifdef __cplusplus
 #if __cplusplus
 }
@@ -16,9 +16,19 @@
 #ifndef TESTS_DATASET_UT_CORE_COMMON_DE_UT_COMMON_H_
 #define TESTS_DATASET_UT_CORE_COMMON_DE_UT_COMMON_H_
 
+#include <memory>
+#include <string>
+#include <vector>
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
+namespace mindspore {
+namespace dataset {
+class ExecutionTree;
+class TensorRow;
+}  // namespace dataset
+}  // namespace mindspore
+
 namespace UT {
 class Common : public testing::Test {
  public:
@@ -34,6 +44,13 @@ class DatasetOpTesting : public Common {
     std::string mindrecord_root_path_;
     void SetUp() override;
 
+    // Read all the rows of a launched tree, in the order the tree gives them
+    void ReadRows(const std::shared_ptr<mindspore::dataset::ExecutionTree> &tree,
+                  std::vector<mindspore::dataset::TensorRow> *rows);
+
+    // Expect the rows to hold the same tensors as the expected ones, in the same order
+    void ExpectRowsEqual(const std::vector<mindspore::dataset::TensorRow> &rows,
+                         const std::vector<mindspore::dataset::TensorRow> &expected);
 };
 }  // namespace UT
 #endif  // TESTS_DATASET_UT_CORE_COMMON_DE_UT_COMMON_H_
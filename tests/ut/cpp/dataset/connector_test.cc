@@ -24,6 +24,7 @@
 
 #include "common/common.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/lock_free_db_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "utils/log_adapter.h"
 
@@ -123,6 +124,58 @@ TEST_F(MindDataTestConnector, Test2) {
 }
 
 
+// Test3: multiple producers, multiple consumers on a LockFreeDbConnector, which must keep the order of DbConnector:
+// the i-th buffer popped comes from producer i % num_producers and goes to consumer i % num_consumers.
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3: lock free connector.";
+  const int32_t num_producers = 4;
+  const int32_t num_consumers = 3;
+  const int32_t num_buffers = 1000;
+  LockFreeDbConnector conn(num_producers, num_consumers, 2);
+  TaskGroup vg;
+  ASSERT_TRUE(conn.Register(&vg).IsOk());
+  std::vector<std::vector<int32_t>> outputs(num_consumers);
+  for (int32_t p = 0; p < num_producers; p++) {
+    Status rc = vg.CreateAsyncTask("Lock free producer", [&conn, p]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int32_t id = p; id < num_buffers; id += num_producers) {
+        RETURN_IF_NOT_OK(conn.Add(p, std::make_unique<DataBuffer>(id, DataBuffer::kDeBFlagNone)));
+      }
+      // The producer whose turn comes after the last buffer sends the eof
+      if (num_buffers % num_producers == p) {
+        RETURN_IF_NOT_OK(conn.Add(p, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
+      }
+      return Status::OK();
+    });
+    ASSERT_TRUE(rc.IsOk());
+  }
+  for (int32_t c = 0; c < num_consumers; c++) {
+    Status rc = vg.CreateAsyncTask("Lock free consumer", [&conn, &outputs, c]() -> Status {
+      TaskManager::FindMe()->Post();
+      std::unique_ptr<DataBuffer> buffer;
+      RETURN_IF_NOT_OK(conn.PopWithRetry(c, &buffer));
+      while (!buffer->eof()) {
+        outputs[c].push_back(buffer->id());
+        RETURN_IF_NOT_OK(conn.PopWithRetry(c, &buffer));
+      }
+      return Status::OK();
+    });
+    ASSERT_TRUE(rc.IsOk());
+  }
+  ASSERT_TRUE(vg.join_all().IsOk());
+  ASSERT_TRUE(vg.GetTaskErrorIfAny().IsOk());
+  for (int32_t c = 0; c < num_consumers; c++) {
+    std::vector<int32_t> expected;
+    for (int32_t id = c; id < num_buffers; id += num_consumers) {
+      expected.push_back(id);
+    }
+    EXPECT_EQ(outputs[c], expected);
+  }
+  EXPECT_EQ(conn.size(), 0);
+  EXPECT_EQ(conn.capacity(), num_producers * 2);
+  EXPECT_TRUE(conn.Resize(8).IsOk());
+  EXPECT_TRUE(conn.Resize(9).IsError());
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
@@ -13,8 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -120,3 +125,68 @@ TEST_F(MindDataTestCSVOp, TestTotalRows) {
   ASSERT_EQ(total_rows, 8);
   files.clear();
 }
+
+TEST_F(MindDataTestCSVOp, TestCSVLargeFile) {
+  // A file of several chunks, with line breaks in quoted fields, is parsed in parallel and keeps its row order
+  char dir_template[] = "/tmp/csv_op_test_XXXXXX";
+  ASSERT_NE(mkdtemp(dir_template), nullptr);
+  std::string dataset_path = std::string(dir_template) + "/large.csv";
+  // the file and its directory are removed even when an assertion fails
+  struct TempFile {
+    std::string dir;
+    std::string path;
+    ~TempFile() {
+      (void)std::remove(path.c_str());
+      (void)rmdir(dir.c_str());
+    }
+  } temp_file{dir_template, dataset_path};
+  const int32_t num_rows = 200000;
+  {
+    std::ofstream ofs(dataset_path, std::ofstream::out | std::ofstream::binary);
+    for (int32_t i = 0; i < num_rows; i++) {
+      ofs << i << ",\"multi\nline, \"\"quoted\"\"\"," << (i % 2 == 0 ? "text\r\n" : "text\n");
+    }
+  }
+
+  std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list;
+  column_default_list.push_back(std::make_shared<CsvOp::Record<int>>(CsvOp::INT, 0));
+  column_default_list.push_back(std::make_shared<CsvOp::Record<std::string>>(CsvOp::STRING, ""));
+  column_default_list.push_back(std::make_shared<CsvOp::Record<std::string>>(CsvOp::STRING, ""));
+  std::shared_ptr<CsvOp> op;
+  CsvOp::Builder builder;
+  builder.SetCsvFilesList({dataset_path})
+    .SetRowsPerBuffer(100)
+    .SetNumWorkers(1)
+    .SetShuffleFiles(false)
+    .SetOpConnectorSize(2)
+    .SetFieldDelim(',')
+    .SetColumDefault(column_default_list)
+    .SetColumName({"col1", "col2", "col3"});
+  ASSERT_TRUE(builder.Build(&op).IsOk());
+
+  auto tree = std::make_shared<ExecutionTree>();
+  ASSERT_TRUE(tree->AssociateNode(op).IsOk());
+  ASSERT_TRUE(tree->AssignRoot(op).IsOk());
+  ASSERT_TRUE(tree->Prepare().IsOk());
+  ASSERT_TRUE(tree->Launch().IsOk());
+
+  DatasetIterator di(tree);
+  TensorRow tensor_list;
+  ASSERT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  int32_t row_count = 0;
+  while (!tensor_list.empty()) {
+    int32_t id = 0;
+    ASSERT_TRUE(tensor_list[0]->GetItemAt(&id, {}).IsOk());
+    ASSERT_EQ(id, row_count);
+    std::string_view text;
+    ASSERT_TRUE(tensor_list[1]->GetItemAt(&text, {}).IsOk());
+    ASSERT_EQ(text, "multi\nline, \"quoted\"");
+    ASSERT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, num_rows);
+
+  int64_t total_rows = 0;
+  ASSERT_TRUE(CsvOp::CountAllFileRows({dataset_path}, false, &total_rows).IsOk());
+  ASSERT_EQ(total_rows, num_rows);
+}
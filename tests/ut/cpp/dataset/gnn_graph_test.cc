@@ -266,3 +266,85 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestCsrStorage) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph(path, 1);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  GraphDataImpl csr_graph(path, 4, false, true);
+  s = csr_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<NodeIdType> node_list;
+  for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+    node_list.push_back(*itr);
+  }
+
+  // The neighbors and the features are the same in both storages
+  std::shared_ptr<Tensor> neighbors, csr_neighbors;
+  s = graph.GetAllNeighbors(node_list, meta_info.node_type[1], &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  s = csr_graph.GetAllNeighbors(node_list, meta_info.node_type[1], &csr_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(neighbors->ToString(), csr_neighbors->ToString());
+
+  TensorRow features, csr_features;
+  s = graph.GetNodeFeature(nodes, meta_info.node_feature_type, &features);
+  EXPECT_TRUE(s.IsOk());
+  s = csr_graph.GetNodeFeature(nodes, meta_info.node_feature_type, &csr_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(features.size(), csr_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_EQ(features[i]->ToString(), csr_features[i]->ToString());
+  }
+
+  std::shared_ptr<Tensor> edges;
+  s = graph.GetAllEdges(meta_info.edge_type[0], &edges);
+  EXPECT_TRUE(s.IsOk());
+  TensorRow edge_features, csr_edge_features;
+  s = graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &edge_features);
+  EXPECT_TRUE(s.IsOk());
+  s = csr_graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &csr_edge_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(edge_features.size(), csr_edge_features.size());
+  for (size_t i = 0; i < edge_features.size(); ++i) {
+    EXPECT_EQ(edge_features[i]->ToString(), csr_edge_features[i]->ToString());
+  }
+
+  // Sampled neighbors are real neighbors, or -1 for a node without any
+  std::shared_ptr<Tensor> samples;
+  s = csr_graph.GetSampledNeighbors(node_list, {3}, {meta_info.node_type[1]}, &samples);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(samples->shape().ToString(), "<" + std::to_string(node_list.size()) + ",4>");
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    std::vector<NodeIdType> all;
+    s = csr_graph.GetAllNeighbors({node_list[i]}, meta_info.node_type[1], &neighbors);
+    EXPECT_TRUE(s.IsOk());
+    for (auto itr = neighbors->begin<NodeIdType>(); itr != neighbors->end<NodeIdType>(); ++itr) {
+      all.push_back(*itr);
+    }
+    all.erase(all.begin());
+    NodeIdType value = 0;
+    EXPECT_TRUE(samples->GetItemAt(&value, {static_cast<dsize_t>(i), 0}).IsOk());
+    EXPECT_EQ(value, node_list[i]);
+    for (dsize_t j = 1; j < 4; ++j) {
+      EXPECT_TRUE(samples->GetItemAt(&value, {static_cast<dsize_t>(i), j}).IsOk());
+      EXPECT_TRUE(all.empty() ? value == -1 : std::find(all.begin(), all.end(), value) != all.end());
+    }
+  }
+  s = csr_graph.GetSampledNeighbors({301}, {10}, {meta_info.node_type[1]}, &samples);
+  EXPECT_TRUE(s.ToString().find("Invalid node id:301") != std::string::npos);
+
+  std::shared_ptr<Tensor> walk_path;
+  s = csr_graph.RandomWalk(node_list, {meta_info.node_type[1], meta_info.node_type[0]}, 2.0, 0.5, -1, &walk_path);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(walk_path->shape().ToString(), "<" + std::to_string(node_list.size()) + ",3>");
+}
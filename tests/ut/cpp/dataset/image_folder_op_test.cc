@@ -442,3 +442,33 @@ TEST_F(MindDataTestImageFolderSampler, TestImageFolderSharding2) {
     EXPECT_TRUE(i == 11);
   }
 }
+
+TEST_F(MindDataTestImageFolderSampler, TestResumeImageFolderWithRepeat) {
+  int32_t original_seed = GlobalContext::config_manager()->seed();
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  // A first run reshuffles every pass
+  GlobalContext::config_manager()->set_seed(1);
+  std::shared_ptr<Sampler> sampler = std::make_shared<RandomSampler>(0, false, true);
+  auto tree = Build({ImageFolder(16, 2, 32, folder_path, false, std::move(sampler)), Repeat(2)});
+  ASSERT_TRUE(tree->Prepare().IsOk());
+  nlohmann::json state;
+  ASSERT_TRUE(tree->SaveState(&state).IsOk());
+  ASSERT_TRUE(tree->Launch().IsOk());
+  std::vector<TensorRow> expected;
+  ReadRows(tree, &expected);
+  ASSERT_EQ(expected.size(), 88u);
+
+  // Another run with another seed resumes at the 50th row, in the second pass
+  GlobalContext::config_manager()->set_seed(2);
+  sampler = std::make_shared<RandomSampler>(0, false, true);
+  tree = Build({ImageFolder(16, 2, 32, folder_path, false, std::move(sampler)), Repeat(2)});
+  ASSERT_TRUE(tree->Prepare().IsOk());
+  int64_t rows_to_drop = -1;
+  ASSERT_TRUE(tree->Resume(state, 0, 50, &rows_to_drop).IsOk());
+  EXPECT_EQ(rows_to_drop, 0);
+  ASSERT_TRUE(tree->Launch().IsOk());
+  std::vector<TensorRow> resumed;
+  ReadRows(tree, &resumed);
+  ExpectRowsEqual(resumed, std::vector<TensorRow>(expected.begin() + 50, expected.end()));
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
@@ -34,6 +34,25 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::LogStream;
 
 class MindDataTestMindRecordOp : public UT::DatasetOpTesting {
+ public:
+  // Launch a tree of a single MindRecordOp reading the imagenet dataset in file order
+  std::shared_ptr<ExecutionTree> LaunchImageNetTree() {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::vector<std::string> column_list = {"file_name", "label", "data"};
+    std::shared_ptr<MindRecordOp> my_mindrecord_op;
+    MindRecordOp::Builder builder;
+    builder.SetDatasetFile({mindrecord_root_path_ + "/testMindDataSet/testImageNetData/imagenet.mindrecord0"})
+        .SetLoadDataset(true)
+        .SetRowsPerBuffer(3)
+        .SetNumMindRecordWorkers(4)
+        .SetColumnsToLoad(column_list);
+    EXPECT_TRUE(builder.Build(&my_mindrecord_op).IsOk());
+    EXPECT_TRUE(my_tree->AssociateNode(my_mindrecord_op).IsOk());
+    EXPECT_TRUE(my_tree->AssignRoot(my_mindrecord_op).IsOk());
+    EXPECT_TRUE(my_tree->Prepare().IsOk());
+    EXPECT_TRUE(my_tree->Launch().IsOk());
+    return my_tree;
+  }
 };
 
 TEST_F(MindDataTestMindRecordOp, TestMindRecordBasic) {
@@ -521,3 +540,51 @@ TEST_F(MindDataTestMindRecordOp, TestMindRecordInvalidColumnList) {
   ASSERT_TRUE(rc.IsError());
   ASSERT_TRUE(rc.ToString().find_first_of("illegal column list") != std::string::npos);
 }
+
+TEST_F(MindDataTestMindRecordOp, TestMindRecordMmapRead) {
+  // single MindRecord op and nothing else, files read through memory mapping
+  //
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordMmapRead";
+
+  bool original_mmap = GlobalContext::config_manager()->enable_mindrecord_mmap();
+
+  std::vector<TensorRow> stream_rows;
+  GlobalContext::config_manager()->set_enable_mindrecord_mmap(false);
+  ReadRows(LaunchImageNetTree(), &stream_rows);
+
+  std::vector<TensorRow> mmap_rows;
+  GlobalContext::config_manager()->set_enable_mindrecord_mmap(true);
+  ReadRows(LaunchImageNetTree(), &mmap_rows);
+
+  GlobalContext::config_manager()->set_enable_mindrecord_mmap(original_mmap);
+
+  // Rows read in place have to match the copied ones
+  ASSERT_EQ(stream_rows.size(), 10);
+  ExpectRowsEqual(mmap_rows, stream_rows);
+}
+
+TEST_F(MindDataTestMindRecordOp, TestMindRecordPrefetch) {
+  // single MindRecord op and nothing else, rows read ahead by io threads
+  //
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordPrefetch";
+
+  int32_t original_prefetch_size = GlobalContext::config_manager()->mindrecord_prefetch_size();
+
+  std::vector<TensorRow> expected_rows;
+  GlobalContext::config_manager()->set_mindrecord_prefetch_size(0);
+  ReadRows(LaunchImageNetTree(), &expected_rows);
+
+  // A window smaller than the dataset makes the io threads wait for the workers
+  std::vector<TensorRow> prefetched_rows;
+  GlobalContext::config_manager()->set_mindrecord_prefetch_size(4);
+  ReadRows(LaunchImageNetTree(), &prefetched_rows);
+
+  GlobalContext::config_manager()->set_mindrecord_prefetch_size(original_prefetch_size);
+
+  ASSERT_EQ(expected_rows.size(), 10);
+  ExpectRowsEqual(prefetched_rows, expected_rows);
+}
@@ -15,6 +15,7 @@
  */
 #include "common/common.h"
 #include "common/cvop_common.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/kernels/image/normalize_op.h"
 #include "minddata/dataset/core/cv_tensor.h"
 #include "utils/log_adapter.h"
@@ -55,3 +56,37 @@ TEST_F(MindDataTestNormalizeOP, TestOp) {
   cv::FileStorage file(output_filename, cv::FileStorage::WRITE);
   file << "imageData" << cv_output_image;
 }
+
+// NormalizeHwcToChw must give the same values as Normalize followed by HwcToChw, on the single pass uint8 path and
+// on the fallback of the other types.
+TEST_F(MindDataTestNormalizeOP, TestNormalizeHwcToChwMatchesUnfused) {
+  MS_LOG(INFO) << "Doing TestNormalizeOp::TestNormalizeHwcToChwMatchesUnfused.";
+  std::shared_ptr<Tensor> mean;
+  std::shared_ptr<Tensor> std;
+  ASSERT_TRUE(Tensor::CreateFromVector<float>({121.0, 115.0, 100.0}, &mean).IsOk());
+  ASSERT_TRUE(Tensor::CreateFromVector<float>({70.0, 68.0, 71.0}, &std).IsOk());
+
+  std::shared_ptr<CVTensor> float_input;
+  cv::Mat float_image;
+  CVTensor::AsCVTensor(input_tensor_)->mat().convertTo(float_image, CV_32F);
+  ASSERT_TRUE(CVTensor::CreateFromMat(float_image, &float_input).IsOk());
+  ASSERT_EQ(input_tensor_->type(), DataType(DataType::DE_UINT8));
+
+  for (const std::shared_ptr<Tensor> &input : {input_tensor_, std::static_pointer_cast<Tensor>(float_input)}) {
+    for (bool hwc_to_chw : {true, false}) {
+      std::shared_ptr<Tensor> expected;
+      ASSERT_TRUE(Normalize(input, &expected, mean, std).IsOk());
+      if (hwc_to_chw) {
+        ASSERT_TRUE(HwcToChw(expected, &expected).IsOk());
+      }
+      std::shared_ptr<Tensor> fused;
+      ASSERT_TRUE(NormalizeHwcToChw(input, &fused, mean, std, hwc_to_chw).IsOk());
+      ASSERT_EQ(fused->type(), DataType(DataType::DE_FLOAT32));
+      ASSERT_EQ(fused->shape(), expected->shape());
+      auto expected_it = expected->begin<float>();
+      for (auto it = fused->begin<float>(); it != fused->end<float>(); ++it, ++expected_it) {
+        ASSERT_NEAR(*it, *expected_it, 1e-5);
+      }
+    }
+  }
+}
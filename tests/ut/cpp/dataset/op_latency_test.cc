@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/perf/critical_path.h"
+#include "minddata/dataset/engine/perf/op_latency.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestOpLatency : public UT::Common {
+ public:
+  MindDataTestOpLatency() {}
+};
+
+TEST_F(MindDataTestOpLatency, TestHistogram) {
+  LatencyHistogram histogram;
+  for (int64_t us = 1; us <= 100; us++) {
+    histogram.Add(us);
+  }
+  histogram.Add(-5);
+  EXPECT_EQ(histogram.count(), 101);
+  EXPECT_EQ(histogram.total_us(), 5050);
+  EXPECT_EQ(histogram.max_us(), 100);
+  // 50 lies in [32, 64), 99 and 100 in [64, 128) which is capped by the longest duration
+  EXPECT_EQ(histogram.Percentile(50), 63);
+  EXPECT_EQ(histogram.Percentile(99), 100);
+  EXPECT_EQ(histogram.Percentile(0), 0);
+}
+
+TEST_F(MindDataTestOpLatency, TestComputeExcludesWaits) {
+  OpLatency latency(1, 1);
+  // The first output starts the compute interval of the thread
+  latency.RecordOutput(0, 0, 10, true);
+  latency.RecordInput(0, 20, 50);
+  latency.RecordIdle(60, 70);
+  latency.RecordOutput(0, 100, 105, true);
+  // 100 - 10 less 30us waiting on input and 10us idle
+  EXPECT_EQ(latency.Histogram(OpLatency::kCompute, 0).count(), 1);
+  EXPECT_EQ(latency.Histogram(OpLatency::kCompute, 0).total_us(), 50);
+  EXPECT_EQ(latency.Histogram(OpLatency::kWaitInput, 0).total_us(), 30);
+  EXPECT_EQ(latency.Histogram(OpLatency::kWaitOutput, 0).total_us(), 15);
+  // An eoe ends the interval, the wait for the next epoch is not compute
+  latency.RecordOutput(0, 200, 201, false);
+  latency.RecordOutput(0, 5000, 5001, true);
+  EXPECT_EQ(latency.Histogram(OpLatency::kCompute, 0).count(), 1);
+  latency.RecordOutput(0, 5011, 5012, true);
+  EXPECT_EQ(latency.Histogram(OpLatency::kCompute, 0).total_us(), 60);
+}
+
+TEST_F(MindDataTestOpLatency, TestCriticalPath) {
+  // Batch(3) <- Map(2) <- ImageFolder(1), with Map computing for the longest time per worker
+  std::vector<CriticalPath::OpTimes> ops(3);
+  ops[0] = {3, "BatchOp", {2}, 4, true, 4000, 20000, 1000, 100};
+  ops[1] = {2, "MapOp", {1}, 2, true, 60000, 100, 2000, 100};
+  ops[2] = {1, "ImageFolderOp", {}, 4, true, 8000, 0, 50000, 100};
+  CriticalPath critical_path(ops, 3, 16);
+  EXPECT_TRUE(critical_path.Analyze().IsOk());
+  EXPECT_EQ(critical_path.bottleneck(), 2);
+  EXPECT_EQ(critical_path.path(), std::vector<int32_t>({3, 2, 1}));
+  // 30ms per worker against 2ms for ImageFolder, capped by the 6 spare cpus
+  EXPECT_EQ(critical_path.suggested_workers(), 8);
+
+  // A root that waits on its consumer longer than any op computes leaves nothing to tune
+  ops[0].wait_output_us = 200000;
+  CriticalPath consumer_bound(ops, 3, 16);
+  EXPECT_TRUE(consumer_bound.Analyze().IsOk());
+  EXPECT_EQ(consumer_bound.bottleneck(), -1);
+  EXPECT_TRUE(consumer_bound.path().empty());
+}
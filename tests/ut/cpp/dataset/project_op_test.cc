@@ -98,3 +98,71 @@ TEST_F(MindDataTestProjectOp, TestProjectProject) {
 
   ASSERT_EQ(row_count, 12);
 }
+
+TEST_F(MindDataTestProjectOp, TestProjectPushdown) {
+  // Start with an empty execution tree
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path;
+  dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  TFReaderOp::Builder builder;
+  builder.SetDatasetFilesList({dataset_path})
+    .SetRowsPerBuffer(16)
+    .SetWorkerConnectorSize(16)
+    .SetNumWorkers(16);
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {});
+  builder.SetDataSchema(std::move(schema));
+  Status rc = builder.Build(&my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  // ProjectOp, the columns are asked for in a different order than the schema has them
+  std::vector<std::string> columns_to_project = {"col_2d", "col_sint16", "col_float"};
+  std::shared_ptr<ProjectOp> my_project_op = std::make_shared<ProjectOp>(columns_to_project);
+  rc = my_tree->AssociateNode(my_project_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  // Set children/root layout.
+  rc = my_project_op->AddChild(my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_project_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  // The projection is pushed down by the optional optimizations
+  rc = my_tree->SetOptimize(true);
+  ASSERT_TRUE(rc.IsOk());
+
+  MS_LOG(INFO) << "Launching tree and begin iteration.";
+  rc = my_tree->Prepare();
+  ASSERT_TRUE(rc.IsOk());
+
+  // The reader only loads the projected columns now
+  ASSERT_EQ(my_tfreader_op->column_name_id_map().size(), columns_to_project.size());
+
+  rc = my_tree->Launch();
+  ASSERT_TRUE(rc.IsOk());
+
+  // Start the loop of reading tensors from our pipeline
+  DatasetIterator di(my_tree);
+  TensorMap tensor_map;
+  rc = di.GetNextAsMap(&tensor_map);
+  ASSERT_TRUE(rc.IsOk());
+
+  int row_count = 0;
+  while (!tensor_map.empty()) {
+    ASSERT_EQ(tensor_map.size(), columns_to_project.size());
+    ASSERT_EQ(tensor_map["col_2d"]->type(), DataType(DataType::DE_INT64));
+    ASSERT_EQ(tensor_map["col_sint16"]->type(), DataType(DataType::DE_INT16));
+    ASSERT_EQ(tensor_map["col_float"]->type(), DataType(DataType::DE_FLOAT32));
+
+    rc = di.GetNextAsMap(&tensor_map);
+    ASSERT_TRUE(rc.IsOk());
+    row_count++;
+  }
+
+  ASSERT_EQ(row_count, 12);
+}
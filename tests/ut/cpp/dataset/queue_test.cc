@@ -177,3 +177,33 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, TestResize) {
+  Queue<std::unique_ptr<int>> que(3);
+  // Wrap the queue around so that the resize has to reorder the elements.
+  for (int i = 0; i < 5; i++) {
+    Status rc = que.Add(std::make_unique<int>(i));
+    ASSERT_TRUE(rc.IsOk());
+    if (i < 2) {
+      std::unique_ptr<int> v;
+      rc = que.PopFront(&v);
+      ASSERT_TRUE(rc.IsOk());
+    }
+  }
+  ASSERT_EQ(que.size(), 3);
+  // Can not shrink below the number of elements in the queue.
+  Status rc = que.Resize(2);
+  ASSERT_TRUE(rc.IsError());
+  rc = que.Resize(6);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.capacity(), 6);
+  rc = que.Add(std::make_unique<int>(5));
+  ASSERT_TRUE(rc.IsOk());
+  for (int i = 2; i < 6; i++) {
+    std::unique_ptr<int> v;
+    rc = que.PopFront(&v);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(*v, i);
+  }
+  ASSERT_TRUE(que.empty());
+}
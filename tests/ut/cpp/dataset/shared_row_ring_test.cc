@@ -0,0 +1,116 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/datasetops/source/shared_row_ring.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestSharedRowRing : public UT::Common {
+ public:
+  MindDataTestSharedRowRing() {}
+};
+
+TEST_F(MindDataTestSharedRowRing, TestForkedProducer) {
+  const int32_t num_rows = 100;
+  std::shared_ptr<SharedRowRing> ring;
+  ASSERT_TRUE(SharedRowRing::CreateSharedRowRing(4, 1024, &ring).IsOk());
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    // The worker process pushes more rows than the ring holds, it waits for the consumer to keep up
+    for (int32_t i = 0; i < num_rows; i++) {
+      int32_t ints[2] = {i, -i};
+      double scalar = i * 0.5;
+      std::vector<SharedRowRing::ColumnView> columns(2);
+      columns[0] = {DataType(DataType::DE_INT32), {2}, ints, sizeof(ints)};
+      columns[1] = {DataType(DataType::DE_FLOAT64), {}, &scalar, sizeof(scalar)};
+      if (ring->PushRow(columns).IsError()) {
+        _exit(1);
+      }
+    }
+    bool ok = ring->PushPayload(SharedRowRing::SlotKind::kError, "worker failed").IsOk() && ring->PushEoe().IsOk();
+    _exit(ok ? 0 : 1);
+  }
+  SharedRowRing::SlotKind kind;
+  TensorRow row;
+  std::string payload;
+  for (int32_t i = 0; i < num_rows; i++) {
+    ASSERT_TRUE(ring->Pop(&kind, &row, &payload).IsOk());
+    ASSERT_EQ(kind, SharedRowRing::SlotKind::kRow);
+    ASSERT_EQ(row.size(), 2);
+    EXPECT_EQ(row[0]->shape(), TensorShape({2}));
+    EXPECT_EQ(row[0]->type(), DataType(DataType::DE_INT32));
+    int32_t value = 0;
+    ASSERT_TRUE(row[0]->GetItemAt(&value, {1}).IsOk());
+    EXPECT_EQ(value, -i);
+    EXPECT_EQ(row[1]->shape(), TensorShape::CreateScalar());
+    double scalar = 0;
+    ASSERT_TRUE(row[1]->GetItemAt(&scalar, {}).IsOk());
+    EXPECT_EQ(scalar, i * 0.5);
+  }
+  ASSERT_TRUE(ring->Pop(&kind, &row, &payload).IsOk());
+  EXPECT_EQ(kind, SharedRowRing::SlotKind::kError);
+  EXPECT_EQ(payload, "worker failed");
+  ASSERT_TRUE(ring->Pop(&kind, &row, &payload).IsOk());
+  EXPECT_EQ(kind, SharedRowRing::SlotKind::kEoe);
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+TEST_F(MindDataTestSharedRowRing, TestProducerExitsBeforePush) {
+  std::shared_ptr<SharedRowRing> ring;
+  ASSERT_TRUE(SharedRowRing::CreateSharedRowRing(4, 1024, &ring).IsOk());
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    // The worker is killed before it pushes anything
+    pause();
+    _exit(0);
+  }
+  ring->SetProducer(pid);
+  ASSERT_EQ(kill(pid, SIGKILL), 0);
+  SharedRowRing::SlotKind kind;
+  TensorRow row;
+  std::string payload;
+  Status rc = ring->Pop(&kind, &row, &payload);
+  EXPECT_TRUE(rc.IsError());
+  EXPECT_NE(rc.ToString().find("exited unexpectedly"), std::string::npos);
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+}
+
+TEST_F(MindDataTestSharedRowRing, TestRowTooLarge) {
+  std::shared_ptr<SharedRowRing> ring;
+  ASSERT_TRUE(SharedRowRing::CreateSharedRowRing(2, 256, &ring).IsOk());
+  std::vector<uint8_t> data(1024);
+  std::vector<SharedRowRing::ColumnView> columns = {{DataType(DataType::DE_UINT8), {1024}, data.data(), 1024}};
+  EXPECT_TRUE(ring->PushRow(columns).IsError());
+  EXPECT_EQ(ring->size(), 0);
+  // A producer waiting on a full ring gives up once the ring is closed
+  ASSERT_TRUE(ring->PushEoe().IsOk());
+  ASSERT_TRUE(ring->PushEoe().IsOk());
+  ring->Close();
+  EXPECT_TRUE(ring->PushEoe().IsInterrupted());
+}
@@ -14,8 +14,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/util/job_pool.h"
+#include "minddata/dataset/util/numa.h"
 #include "minddata/dataset/util/task_manager.h"
 
 using namespace mindspore::dataset;
@@ -83,3 +88,48 @@ TEST_F(MindDataTestTaskManager, Test2) {
   // Now we test the async Join
   ASSERT_TRUE(vg.join_all(Task::WaitFlag::kNonBlocking).IsOk());
 }
+
+TEST_F(MindDataTestTaskManager, TestNumaNode) {
+  // Threads of a group bound to a NUMA node only run on the cpus of that node
+  (void)TaskManager::GetMasterThreadRc();
+  // A single node is reported when the NUMA sysfs is missing too, nothing to bind to then
+  if (Numa::NumNodes() <= 1) {
+    MS_LOG(INFO) << "-- ATTN -- No NUMA nodes to bind to. Skip this case. -----------------";
+    return;
+  }
+  int32_t node = Numa::NumNodes() - 1;
+  TaskGroup vg;
+  vg.set_numa_node(node);
+  int32_t cur_node = -2;
+  Status rc = vg.CreateAsyncTask("Numa bound thread", [&cur_node]() -> Status {
+    TaskManager::FindMe()->Post();
+    cur_node = Numa::CurrentNode();
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_TRUE(vg.join_all().IsOk());
+  // The node can't be found on some platforms
+  if (cur_node != -1) {
+    EXPECT_EQ(cur_node, node);
+  }
+  NumaStat stat;
+  EXPECT_TRUE(Numa::GetNodeStat(node, &stat).IsOk());
+}
+
+TEST_F(MindDataTestTaskManager, TestJobPool) {
+  (void)TaskManager::GetMasterThreadRc();
+  JobPool pool;
+  std::vector<int32_t> runs(100, 0);
+  std::function<void(size_t)> func = [&runs](size_t i) { ++runs[i]; };
+  // the calling thread runs every item until the threads are launched
+  pool.ForEach(runs.size(), func);
+  TaskGroup vg;
+  ASSERT_TRUE(pool.Launch(&vg, 3, "Job pool thread").IsOk());
+  EXPECT_EQ(pool.NumThreads(), 3);
+  pool.ForEach(runs.size(), func);
+  pool.ForEach(1, func);
+  EXPECT_EQ(runs[0], 3);
+  EXPECT_TRUE(std::all_of(runs.begin() + 1, runs.end(), [](int32_t n) { return n == 2; }));
+  ASSERT_TRUE(pool.Stop().IsOk());
+  ASSERT_TRUE(vg.join_all().IsOk());
+}
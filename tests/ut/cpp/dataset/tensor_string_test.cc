@@ -171,3 +171,18 @@ TEST_F(MindDataTestStringTensorDE, Iterator) {
     index += 2;
   }
 }
+
+TEST_F(MindDataTestStringTensorDE, FromViews) {
+  // Views into one buffer, none of them null-terminated
+  std::string buffer = "abcdefghiklmno";
+  std::vector<std::string_view> views{std::string_view(buffer.data(), 3), std::string_view(buffer.data() + 3, 4),
+                                      std::string_view(buffer.data() + 7, 0), std::string_view(buffer.data() + 7, 7)};
+  std::shared_ptr<Tensor> t;
+  ASSERT_TRUE(Tensor::CreateFromVector(views, TensorShape({2, 2}), &t).IsOk());
+  std::shared_ptr<Tensor> expected;
+  ASSERT_TRUE(Tensor::CreateFromVector(std::vector<std::string>{"abc", "defg", "", "hiklmno"}, TensorShape({2, 2}),
+                                       &expected)
+                .IsOk());
+  ASSERT_EQ(t->SizeInBytes(), expected->SizeInBytes());
+  ASSERT_EQ(memcmp(t->GetBuffer(), expected->GetBuffer(), t->SizeInBytes()), 0);
+}
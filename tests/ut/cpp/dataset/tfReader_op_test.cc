@@ -19,6 +19,7 @@
 
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 #include "common/common.h"
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
@@ -731,3 +732,73 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderInvalidFiles) {
   rc = builder.Build(&my_tfreader_op);
   ASSERT_TRUE(!rc.IsOk());
 }
+
+namespace {
+// Writes the protobuf wire format by hand, to build a serialized Example
+std::string Varint(uint64_t value) {
+  std::string out;
+  for (; value >= 0x80; value >>= 7) out += static_cast<char>((value & 0x7F) | 0x80);
+  return out + static_cast<char>(value);
+}
+
+std::string Field(uint32_t field, const std::string &data) {
+  return Varint(field << 3 | 2) + Varint(data.size()) + data;
+}
+
+std::string MapEntry(const std::string &key, const std::string &feature) {
+  return Field(1, Field(1, key) + Field(2, feature));
+}
+}  // namespace
+
+TEST_F(MindDataTestTFReaderOp, TestTFExampleParser) {
+  // int64 values are packed, floats are packed fixed32 and bytes are one field per value
+  std::string int_feature = Field(3, Field(1, Varint(300) + Varint(static_cast<uint64_t>(-1))));
+  float float_values[] = {1.5, -2.0};
+  std::string float_data(reinterpret_cast<char *>(float_values), sizeof(float_values));
+  std::string float_feature = Field(2, Field(1, float_data));
+  std::string bytes_feature = Field(1, Field(1, "ab") + Field(1, "xyz"));
+  std::string record = Field(1, MapEntry("bytes", bytes_feature) + MapEntry("floats", float_feature) +
+                                  MapEntry("ints", int_feature) + MapEntry("skipped", int_feature));
+
+  TFExampleParser parser({"ints", "floats", "bytes", "missing"});
+  std::vector<TFExampleParser::Feature> features;
+  ASSERT_TRUE(parser.Parse(record, &features).IsOk());
+  ASSERT_EQ(features.size(), 4);
+  EXPECT_TRUE(features[0].found && features[1].found && features[2].found);
+  EXPECT_FALSE(features[3].found);
+
+  int64_t count = 0;
+  int64_t max_bytes = 0;
+  ASSERT_TRUE(TFExampleParser::CountValues(features[0], &count, &max_bytes).IsOk());
+  ASSERT_EQ(count, 2);
+  std::vector<int64_t> ints(count);
+  ASSERT_TRUE(TFExampleParser::GetInts(features[0], ints.data(), count).IsOk());
+  EXPECT_EQ(ints, std::vector<int64_t>({300, -1}));
+
+  ASSERT_TRUE(TFExampleParser::CountValues(features[1], &count, &max_bytes).IsOk());
+  ASSERT_EQ(count, 2);
+  std::vector<float> floats(count);
+  ASSERT_TRUE(TFExampleParser::GetFloats(features[1], floats.data(), count).IsOk());
+  EXPECT_EQ(floats, std::vector<float>({1.5, -2.0}));
+
+  ASSERT_TRUE(TFExampleParser::CountValues(features[2], &count, &max_bytes).IsOk());
+  EXPECT_EQ(count, 2);
+  EXPECT_EQ(max_bytes, 3);
+  std::vector<std::string_view> bytes;
+  ASSERT_TRUE(TFExampleParser::GetBytes(features[2], &bytes).IsOk());
+  ASSERT_EQ(bytes.size(), 2);
+  EXPECT_EQ(bytes[1], "xyz");
+
+  // a fixed shape smaller than the list keeps its first values, a larger one is rejected
+  std::vector<int64_t> first_int(1);
+  ASSERT_TRUE(TFExampleParser::GetInts(features[0], first_int.data(), 1).IsOk());
+  EXPECT_EQ(first_int[0], 300);
+  std::vector<float> first_float(1);
+  ASSERT_TRUE(TFExampleParser::GetFloats(features[1], first_float.data(), 1).IsOk());
+  EXPECT_EQ(first_float[0], 1.5);
+  std::vector<int64_t> more_ints(3);
+  EXPECT_FALSE(TFExampleParser::GetInts(features[0], more_ints.data(), 3).IsOk());
+
+  // a truncated record is rejected
+  EXPECT_FALSE(parser.Parse(std::string_view(record).substr(0, record.size() - 1), &features).IsOk());
+}
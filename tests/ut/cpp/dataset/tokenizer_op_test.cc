@@ -18,7 +18,9 @@
 #include <string_view>
 
 #include "common/common.h"
+#include "minddata/dataset/text/double_array_trie.h"
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/bert_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/case_fold_op.h"
 #include "minddata/dataset/text/kernels/normalize_utf8_op.h"
 #include "minddata/dataset/text/kernels/regex_replace_op.h"
@@ -26,6 +28,8 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
+#include "minddata/dataset/text/vocab.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +362,98 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestDoubleArrayTrie) {
+  MS_LOG(INFO) << "Doing TestDoubleArrayTrie.";
+  DoubleArrayTrie trie({"ab", "a", "abc", "b", "ab", "\xe4\xb8\xad"});
+  auto walk = [&trie](const std::string &word, int32_t *state) {
+    *state = DoubleArrayTrie::kRoot;
+    for (auto c : word) {
+      if (!trie.Next(state, static_cast<uint8_t>(c))) return false;
+    }
+    return true;
+  };
+  int32_t state = 0;
+  for (const std::string &key : {"a", "ab", "abc", "b", "\xe4\xb8\xad"}) {
+    EXPECT_TRUE(walk(key, &state));
+    EXPECT_TRUE(trie.IsKey(state));
+  }
+  // a prefix of a key is a state but not a key
+  EXPECT_TRUE(walk("\xe4\xb8", &state));
+  EXPECT_FALSE(trie.IsKey(state));
+  EXPECT_FALSE(walk("abd", &state));
+  EXPECT_FALSE(walk("c", &state));
+  EXPECT_FALSE(trie.IsKey(DoubleArrayTrie::kRoot));
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector({"my", "favor", "##ite", "dur", "##ing", "##in", "中", "##国"}, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", true));
+
+  std::vector<TensorRow> input(2);
+  std::shared_ptr<Tensor> words, starts;
+  Tensor::CreateFromVector(std::vector<std::string>{"my", "favorite", "during", "durex", "中国"}, &words);
+  Tensor::CreateFromVector(std::vector<uint32_t>{0, 3, 12, 19, 25}, &starts);
+  input[0] = TensorRow(0, {words, starts, starts});
+  Tensor::CreateFromVector(std::vector<std::string>{}, &words);
+  Tensor::CreateFromVector(std::vector<uint32_t>{}, &starts);
+  input[1] = TensorRow(1, {words, starts, starts});
+
+  std::vector<TensorRow> output;
+  s = op->BatchCompute(input, &output);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(output.size(), 2);
+  // durex matches dur but not the rest, so the whole word is unknown
+  std::vector<std::string> expect = {"my", "favor", "##ite", "dur", "##ing", "[UNK]", "中", "##国"};
+  std::vector<uint32_t> expect_start = {0, 3, 8, 12, 15, 19, 25, 28};
+  std::vector<uint32_t> expect_limit = {2, 8, 11, 15, 18, 24, 28, 31};
+  ASSERT_EQ(output[0].size(), 3);
+  ASSERT_EQ(output[0][0]->Size(), expect.size());
+  ASSERT_EQ(output[0][1]->Size(), expect.size());
+  for (dsize_t i = 0; i < expect.size(); i++) {
+    CheckEqual(output[0][0], {i}, expect[i]);
+    uint32_t start = 0, limit = 0;
+    EXPECT_TRUE(output[0][1]->GetItemAt(&start, {i}).IsOk());
+    EXPECT_TRUE(output[0][2]->GetItemAt(&limit, {i}).IsOk());
+    EXPECT_EQ(start, expect_start[i]);
+    EXPECT_EQ(limit, expect_limit[i]);
+  }
+  // an empty row gives one empty token
+  ASSERT_EQ(output[1][0]->Size(), 1);
+  CheckEqual(output[1][0], {0}, "");
+
+  // the batch gives the same rows as one by one
+  TensorRow single;
+  s = op->Compute(input[0], &single);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(single[0]->ToString(), output[0][0]->ToString());
+}
+
+TEST_F(MindDataTestTokenizerOp, TestBertTokenizerBatch) {
+  MS_LOG(INFO) << "Doing TestBertTokenizerBatch.";
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector({"my", "favor", "##ite", "book", "is", "."}, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::unique_ptr<BertTokenizerOp> op(new BertTokenizerOp(vocab));
+  std::vector<TensorRow> input;
+  for (const std::string &line : {"My favorite book is.", "book"}) {
+    std::shared_ptr<Tensor> t;
+    Tensor::CreateScalar<std::string>(line, &t);
+    input.push_back(TensorRow(0, {t}));
+  }
+  std::vector<TensorRow> output;
+  s = op->BatchCompute(input, &output);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(output.size(), 2);
+  std::vector<std::string> expect = {"my", "favor", "##ite", "book", "is", "."};
+  ASSERT_EQ(output[0][0]->Size(), expect.size());
+  for (dsize_t i = 0; i < expect.size(); i++) {
+    CheckEqual(output[0][0], {i}, expect[i]);
+  }
+  ASSERT_EQ(output[1][0]->Size(), 1);
+  CheckEqual(output[1][0], {0}, "book");
+}
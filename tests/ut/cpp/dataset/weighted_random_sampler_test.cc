@@ -285,3 +285,103 @@ TEST_F(MindDataTestWeightedRandomSampler, TestResetNoReplacement) {
   ASSERT_EQ(m_sampler.GetNextSample(&db), Status::OK());
   ASSERT_EQ(db->eoe(), true);
 }
+
+TEST_F(MindDataTestWeightedRandomSampler, TestUpdateWeights) {
+  uint64_t num_samples = 200;
+  uint64_t total_samples = 100;
+  std::vector<double> weights(total_samples, 1.0);
+
+  WeightedRandomSampler m_sampler(num_samples, weights, true);
+  DummyRandomAccessOp dummyRandomAccessOp(total_samples);
+  m_sampler.HandshakeRandomAccessOp(&dummyRandomAccessOp);
+
+  // Only ids 3 and 7 keep a weight, the others can no longer be drawn
+  std::vector<int64_t> ids;
+  for (int64_t i = 0; i < total_samples; i++) {
+    ids.push_back(i);
+  }
+  std::vector<double> new_weights(total_samples, 0.0);
+  new_weights[3] = 1.0;
+  new_weights[7] = 3.0;
+  ASSERT_TRUE(m_sampler.UpdateWeights(ids, new_weights).IsOk());
+  ASSERT_TRUE(m_sampler.UpdateWeights({static_cast<int64_t>(total_samples)}, {1.0}).IsError());
+  ASSERT_TRUE(m_sampler.UpdateWeights({0}, {-1.0}).IsError());
+
+  std::unique_ptr<DataBuffer> db;
+  TensorRow row;
+  std::vector<uint64_t> freq(total_samples, 0);
+  ASSERT_EQ(m_sampler.GetNextSample(&db), Status::OK());
+  db->PopRow(&row);
+  for (auto it = row[0]->begin<int64_t>(); it != row[0]->end<int64_t>(); it++) {
+    freq[*it]++;
+  }
+  ASSERT_EQ(freq[3] + freq[7], num_samples);
+  ASSERT_GT(freq[7], freq[3]);
+}
+
+TEST_F(MindDataTestWeightedRandomSampler, TestGroup) {
+  uint64_t num_samples = 50;
+  uint64_t total_samples = 10;
+  std::vector<double> weights(total_samples, 1.0);
+  WeightedRandomSamplerGroup group;
+  auto sampler = std::make_shared<WeightedRandomSampler>(num_samples, weights, true);
+  DummyRandomAccessOp dummyRandomAccessOp(total_samples);
+  sampler->HandshakeRandomAccessOp(&dummyRandomAccessOp);
+  group.Add(sampler);
+  {
+    // A sampler released with its pipeline leaves the group
+    auto released = std::make_shared<WeightedRandomSampler>(num_samples, weights, true);
+    group.Add(released);
+    ASSERT_EQ(group.size(), 2);
+  }
+  ASSERT_EQ(group.size(), 1);
+
+  // The update reaches the sampler in use
+  std::vector<int64_t> ids;
+  for (int64_t i = 0; i < total_samples; i++) {
+    ids.push_back(i);
+  }
+  std::vector<double> new_weights(total_samples, 0.0);
+  new_weights[5] = 1.0;
+  ASSERT_TRUE(group.UpdateWeights(ids, new_weights).IsOk());
+  ASSERT_TRUE(group.UpdateWeights({0}, {-1.0}).IsError());
+
+  std::unique_ptr<DataBuffer> db;
+  TensorRow row;
+  ASSERT_EQ(sampler->GetNextSample(&db), Status::OK());
+  db->PopRow(&row);
+  for (auto it = row[0]->begin<int64_t>(); it != row[0]->end<int64_t>(); it++) {
+    ASSERT_EQ(*it, 5);
+  }
+}
+
+TEST_F(MindDataTestWeightedRandomSampler, TestShards) {
+  uint64_t total_samples = 10;
+  int64_t num_shards = 3;
+  std::vector<double> weights(total_samples, 1.0);
+  weights[4] = 0.0;
+
+  // Without replacement, each shard draws each of its ids once, the ids of zero weight last
+  for (int64_t shard_id = 0; shard_id < num_shards; shard_id++) {
+    WeightedRandomSampler m_sampler(0, weights, false, std::numeric_limits<int64_t>::max(), num_shards, shard_id);
+    DummyRandomAccessOp dummyRandomAccessOp(total_samples);
+    m_sampler.HandshakeRandomAccessOp(&dummyRandomAccessOp);
+
+    std::unique_ptr<DataBuffer> db;
+    TensorRow row;
+    std::vector<int64_t> out;
+    ASSERT_EQ(m_sampler.GetNextSample(&db), Status::OK());
+    db->PopRow(&row);
+    for (auto it = row[0]->begin<int64_t>(); it != row[0]->end<int64_t>(); it++) {
+      ASSERT_EQ(*it % num_shards, shard_id);
+      out.push_back(*it);
+    }
+    ASSERT_EQ(out.size(), (total_samples - shard_id + num_shards - 1) / num_shards);
+    ASSERT_EQ(std::unordered_set<int64_t>(out.begin(), out.end()).size(), out.size());
+    if (shard_id == 1) {
+      ASSERT_EQ(out.back(), 4);
+    }
+    ASSERT_EQ(m_sampler.GetNextSample(&db), Status::OK());
+    ASSERT_EQ(db->eoe(), true);
+  }
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "base/core_ops.h"
+#include "backend/session/kernel_graph.h"
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUKernelScheduler : public UT::Common {
+ public:
+  TestCPUKernelScheduler() = default;
+
+  void SetUp() override {
+    graph_ = std::make_shared<session::KernelGraph>();
+    auto x = graph_->add_parameter();
+    // a and b read x, c adds them, e is independent and d waits for it through a Depend
+    auto a = NewKernel({NewValueNode(prim::kPrimRelu), x});
+    auto b = NewKernel({NewValueNode(prim::kPrimRelu), x});
+    auto c = NewKernel({NewValueNode(prim::kPrimTensorAdd), a, b});
+    auto e = NewKernel({NewValueNode(prim::kPrimRelu), x});
+    auto depend = std::make_shared<CNode>(std::vector<AnfNodePtr>{NewValueNode(prim::kPrimDepend), c, e}, graph_);
+    auto d = NewKernel({NewValueNode(prim::kPrimRelu), depend});
+    graph_->set_return(std::make_shared<CNode>(std::vector<AnfNodePtr>{NewValueNode(prim::kPrimReturn), d}, graph_));
+    kernels_ = {a, b, c, e, d};
+  }
+
+  CNodePtr NewKernel(const std::vector<AnfNodePtr> &inputs) { return std::make_shared<CNode>(inputs, graph_); }
+
+  std::shared_ptr<session::KernelGraph> graph_;
+  std::vector<CNodePtr> kernels_;
+};
+
+TEST_F(TestCPUKernelScheduler, test_dependencies) {
+  CPUKernelScheduler scheduler;
+  scheduler.Init(graph_.get(), kernels_, {});
+  EXPECT_TRUE(scheduler.IsScheduled(kernels_));
+  EXPECT_EQ(scheduler.successors(0), std::vector<size_t>({2}));
+  EXPECT_EQ(scheduler.successors(1), std::vector<size_t>({2}));
+  EXPECT_EQ(scheduler.successors(2), std::vector<size_t>({4}));
+  EXPECT_EQ(scheduler.successors(3), std::vector<size_t>({4}));
+  EXPECT_TRUE(scheduler.successors(4).empty());
+
+  // b reusing the memory of a waits for it
+  scheduler.Init(graph_.get(), kernels_, {{kernels_[0], kernels_[1]}});
+  EXPECT_EQ(scheduler.successors(0), std::vector<size_t>({1, 2}));
+}
+
+TEST_F(TestCPUKernelScheduler, test_run_in_dependency_order) {
+  CPUKernelScheduler scheduler;
+  scheduler.Init(graph_.get(), kernels_, {});
+  for (size_t inter_op_threads : {1, 2, 8}) {
+    std::mutex mutex;
+    std::map<CNodePtr, size_t> finished;
+    scheduler.Run(inter_op_threads, [&mutex, &finished](const CNodePtr &kernel) {
+      std::lock_guard<std::mutex> lock(mutex);
+      EXPECT_EQ(finished.count(kernel), 0);
+      size_t order = finished.size();
+      finished[kernel] = order;
+    });
+    ASSERT_EQ(finished.size(), kernels_.size());
+    EXPECT_LT(finished[kernels_[0]], finished[kernels_[2]]);
+    EXPECT_LT(finished[kernels_[1]], finished[kernels_[2]]);
+    EXPECT_LT(finished[kernels_[2]], finished[kernels_[4]]);
+    EXPECT_LT(finished[kernels_[3]], finished[kernels_[4]]);
+  }
+}
+
+TEST_F(TestCPUKernelScheduler, test_launch_failure) {
+  CPUKernelScheduler scheduler;
+  scheduler.Init(graph_.get(), kernels_, {});
+  auto failing = kernels_[2];
+  EXPECT_THROW(scheduler.Run(4,
+                             [&failing](const CNodePtr &kernel) {
+                               if (kernel == failing) {
+                                 throw std::runtime_error("launch failed");
+                               }
+                             }),
+               std::runtime_error);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
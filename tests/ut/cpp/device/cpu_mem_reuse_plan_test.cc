@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <set>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/cpu_mem_reuse_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUMemReusePlan : public UT::Common {
+ public:
+  TestCPUMemReusePlan() = default;
+};
+
+TEST_F(TestCPUMemReusePlan, test_chain_reuses_memory) {
+  // a -> b -> c -> d: each block is read by the next step only
+  std::vector<MemBlock> blocks = {{1024, 0, 1, 0}, {1024, 1, 2, 0}, {1024, 2, 3, 0}, {1024, 3, 3, 0}};
+  size_t total_size = PackMemBlocks(&blocks);
+  EXPECT_EQ(total_size, 2048);
+  EXPECT_EQ(blocks[0].offset, blocks[2].offset);
+  EXPECT_EQ(blocks[1].offset, blocks[3].offset);
+  EXPECT_NE(blocks[0].offset, blocks[1].offset);
+}
+
+TEST_F(TestCPUMemReusePlan, test_live_blocks_never_overlap) {
+  std::vector<MemBlock> blocks = {{100, 0, 5, 0}, {4096, 1, 2, 0}, {10, 2, 2, 0}, {3000, 3, 4, 0},
+                                  {500, 4, 6, 0}, {0, 5, 5, 0},    {64, 0, 6, 0}, {2048, 6, 6, 0}};
+  size_t total_size = PackMemBlocks(&blocks);
+  EXPECT_LT(total_size, 100 + 4096 + 10 + 3000 + 500 + 64 + 2048);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    EXPECT_EQ(blocks[i].offset % kMemAlignSize, 0);
+    EXPECT_LE(blocks[i].offset + blocks[i].size, total_size);
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      bool same_time = blocks[i].first_use <= blocks[j].last_use && blocks[j].first_use <= blocks[i].last_use;
+      bool same_place = blocks[i].offset < blocks[j].offset + blocks[j].size &&
+                        blocks[j].offset < blocks[i].offset + blocks[i].size;
+      EXPECT_FALSE(same_time && same_place) << "blocks " << i << " and " << j << " overlap";
+    }
+  }
+}
+
+TEST_F(TestCPUMemReusePlan, test_reuse_steps) {
+  // a -> b -> c, the output of c is written over the output of a, which a and b use
+  std::vector<MemBlock> blocks = {{1024, 0, 1, 0}, {1024, 1, 2, 0}, {1024, 2, 2, 0}};
+  std::vector<std::vector<size_t>> block_steps = {{0, 1}, {1, 2}, {2}};
+  (void)PackMemBlocks(&blocks);
+  ASSERT_EQ(blocks[0].offset, blocks[2].offset);
+  std::set<std::pair<size_t, size_t>> expected = {{0, 2}, {1, 2}};
+  EXPECT_EQ(MemReuseSteps(blocks, block_steps), expected);
+
+  // Blocks of disjoint memory add no step
+  blocks = {{1024, 0, 1, 0}, {1024, 1, 2, 1024}, {1024, 2, 2, 2048}};
+  EXPECT_TRUE(MemReuseSteps(blocks, block_steps).empty());
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
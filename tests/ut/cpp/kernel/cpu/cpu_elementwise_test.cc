@@ -0,0 +1,161 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_elementwise_internal.h"
+
+namespace mindspore {
+namespace kernel {
+class CPUElementwiseTest : public UT::Common {
+ public:
+  CPUElementwiseTest() = default;
+
+  void TearDown() override { SetElementwiseIsa(SimdIsa::kAvx512); }
+
+  // The instruction sets to test, each one up to the one the CPU supports
+  std::vector<SimdIsa> IsasToTest() {
+    std::vector<SimdIsa> isas;
+    for (auto isa : {SimdIsa::kScalar, SimdIsa::kAvx2, SimdIsa::kAvx512}) {
+      if (isa <= SupportedElementwiseIsa()) {
+        isas.push_back(isa);
+      }
+    }
+    return isas;
+  }
+
+  // Check every op against the element the output index maps to in each input
+  template <typename T>
+  void CheckBinary(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1,
+                   const std::vector<size_t> &out_shape) {
+    std::vector<T> in0(NumElements(shape0));
+    std::vector<T> in1(NumElements(shape1));
+    for (size_t i = 0; i < in0.size(); ++i) {
+      in0[i] = static_cast<T>(i % 13 + 1);
+    }
+    for (size_t i = 0; i < in1.size(); ++i) {
+      in1[i] = static_cast<T>(i % 7 + 1);
+    }
+    std::vector<T> out(NumElements(out_shape));
+    BinaryBroadcast broadcast;
+    broadcast.Init(shape0, shape1, out_shape);
+    for (auto op : {ADD, SUB, MUL, DIV}) {
+      ElementwiseBinary<T>(op, broadcast, in0.data(), in1.data(), out.data());
+      for (size_t i = 0; i < out.size(); ++i) {
+        T a = in0[InputIndex(shape0, out_shape, i)];
+        T b = in1[InputIndex(shape1, out_shape, i)];
+        T expect = op == ADD ? a + b : op == SUB ? a - b : op == MUL ? a * b : a / b;
+        ASSERT_EQ(out[i], expect) << "op " << op << " at " << i;
+      }
+    }
+  }
+
+  static size_t NumElements(const std::vector<size_t> &shape) {
+    size_t num = 1;
+    for (auto dim : shape) {
+      num *= dim;
+    }
+    return num;
+  }
+
+  static size_t InputIndex(const std::vector<size_t> &shape, const std::vector<size_t> &out_shape, size_t index) {
+    size_t input_index = 0;
+    size_t stride = 1;
+    for (size_t i = shape.size(); i > 0; --i) {
+      size_t out_dim = out_shape[out_shape.size() - shape.size() + i - 1];
+      size_t pos = index % out_dim;
+      index /= out_dim;
+      if (shape[i - 1] > 1) {
+        input_index += pos * stride;
+      }
+      stride *= shape[i - 1];
+    }
+    return input_index;
+  }
+};
+
+TEST_F(CPUElementwiseTest, BroadcastMergesDims) {
+  BinaryBroadcast broadcast;
+  broadcast.Init({2, 3, 4}, {2, 3, 4}, {2, 3, 4});
+  EXPECT_EQ(broadcast.dims(), std::vector<size_t>({24}));
+  broadcast.Init({2, 3, 4}, {}, {2, 3, 4});
+  EXPECT_EQ(broadcast.dims(), std::vector<size_t>({24}));
+  EXPECT_EQ(broadcast.strides1(), std::vector<size_t>({0}));
+  broadcast.Init({2, 3, 4}, {4}, {2, 3, 4});
+  EXPECT_EQ(broadcast.dims(), std::vector<size_t>({6, 4}));
+  EXPECT_EQ(broadcast.strides0(), std::vector<size_t>({4, 1}));
+  EXPECT_EQ(broadcast.strides1(), std::vector<size_t>({0, 1}));
+  broadcast.Init({2, 3, 4}, {2, 3, 1}, {2, 3, 4});
+  EXPECT_EQ(broadcast.dims(), std::vector<size_t>({6, 4}));
+  EXPECT_EQ(broadcast.strides1(), std::vector<size_t>({1, 0}));
+  EXPECT_EQ(broadcast.num_elements(), 24);
+  EXPECT_ANY_THROW(broadcast.Init({2, 3}, {3, 3}, {2, 3}));
+}
+
+TEST_F(CPUElementwiseTest, BinaryMatchesReference) {
+  for (auto isa : IsasToTest()) {
+    SetElementwiseIsa(isa);
+    // Same shape, scalars, rows, columns, both inputs broadcast and rows shorter than a vector
+    std::vector<std::vector<std::vector<size_t>>> cases = {
+      {{1037}, {1037}, {1037}},       {{1037}, {}, {1037}},          {{}, {1037}, {1037}},
+      {{33, 129}, {129}, {33, 129}},  {{33, 129}, {33, 1}, {33, 129}}, {{33, 1}, {1, 129}, {33, 129}},
+      {{5, 1, 7, 9}, {3, 7, 1}, {5, 3, 7, 9}}, {{300, 3}, {300, 1}, {300, 3}}, {{}, {}, {}}};
+    for (const auto &shapes : cases) {
+      CheckBinary<float>(shapes[0], shapes[1], shapes[2]);
+      CheckBinary<int>(shapes[0], shapes[1], shapes[2]);
+      CheckBinary<int64_t>(shapes[0], shapes[1], shapes[2]);
+    }
+  }
+}
+
+TEST_F(CPUElementwiseTest, DivideByZeroThrows) {
+  for (auto isa : IsasToTest()) {
+    SetElementwiseIsa(isa);
+    BinaryBroadcast broadcast;
+    broadcast.Init({3000}, {3000}, {3000});
+    std::vector<float> in0(3000, 1);
+    std::vector<float> in1(3000, 2);
+    std::vector<float> out(3000);
+    in1[2999] = 0;
+    EXPECT_ANY_THROW(ElementwiseBinary<float>(DIV, broadcast, in0.data(), in1.data(), out.data()));
+    std::vector<int> int_in0(3000, 1);
+    std::vector<int> int_in1(3000, 2);
+    std::vector<int> int_out(3000);
+    int_in1[1000] = 0;
+    EXPECT_ANY_THROW(ElementwiseBinary<int>(DIV, broadcast, int_in0.data(), int_in1.data(), int_out.data()));
+  }
+}
+
+TEST_F(CPUElementwiseTest, UnaryChain) {
+  for (auto isa : IsasToTest()) {
+    SetElementwiseIsa(isa);
+    std::vector<float> in(5001);
+    for (size_t i = 0; i < in.size(); ++i) {
+      in[i] = static_cast<float>(i) * 0.37f - 3;
+    }
+    std::vector<float> out(in.size());
+    ElementwiseUnary<float>({SQUARE, SQRT}, in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+      ASSERT_NEAR(out[i], std::fabs(in[i]), 1e-5f * std::fabs(in[i]));
+    }
+    std::vector<int> int_in(999, 3);
+    std::vector<int> int_out(int_in.size());
+    ElementwiseUnary<int>({SQUARE, SQUARE}, int_in.data(), int_out.data(), int_in.size());
+    EXPECT_EQ(int_out, std::vector<int>(int_in.size(), 81));
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
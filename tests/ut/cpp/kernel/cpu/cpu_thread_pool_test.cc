@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+class CPUThreadPoolTest : public UT::Common {
+ public:
+  CPUThreadPoolTest() = default;
+};
+
+TEST_F(CPUThreadPoolTest, ParallelForCoversRange) {
+  auto &pool = CPUThreadPool::GetInstance();
+  EXPECT_GE(pool.num_threads(), 1);
+  EXPECT_LE(pool.num_threads(), CPUThreadPool::AvailableCpuNum());
+  const size_t total = 100003;
+  std::vector<int> visits(total, 0);
+  pool.ParallelFor(
+    total,
+    [&visits](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        visits[i]++;
+      }
+    },
+    kMinGrainSize);
+  for (size_t i = 0; i < total; ++i) {
+    EXPECT_EQ(visits[i], 1);
+  }
+}
+
+TEST_F(CPUThreadPoolTest, NestedAndConcurrentCalls) {
+  auto &pool = CPUThreadPool::GetInstance();
+  std::atomic<size_t> sum{0};
+  // Several threads run nested loops at once, as kernels of concurrent graphs would
+  std::vector<std::thread> callers;
+  for (size_t c = 0; c < 4; ++c) {
+    callers.emplace_back([&pool, &sum]() {
+      pool.ParallelFor(16, [&pool, &sum](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+          pool.ParallelFor(100, [&sum](size_t s, size_t e) { sum += e - s; });
+        }
+      });
+    });
+  }
+  for (auto &caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(sum.load(), 4 * 16 * 100);
+}
+
+TEST_F(CPUThreadPoolTest, IntraOpThreadsLimit) {
+  auto &pool = CPUThreadPool::GetInstance();
+  // A single intra op thread runs the whole range on the calling thread
+  pool.set_intra_op_threads(1);
+  size_t calls = 0;
+  pool.ParallelFor(100000, [&calls](size_t start, size_t end) { calls++; }, kMinGrainSize);
+  EXPECT_EQ(calls, 1);
+  // RunAll is not limited
+  std::vector<int> runs(8, 0);
+  pool.RunAll(runs.size(), [&runs](size_t i) { runs[i]++; });
+  EXPECT_EQ(runs, std::vector<int>(8, 1));
+  pool.set_intra_op_threads(0);
+}
+
+TEST_F(CPUThreadPoolTest, ExceptionIsRethrown) {
+  auto &pool = CPUThreadPool::GetInstance();
+  EXPECT_THROW(pool.ParallelFor(64,
+                                [](size_t start, size_t end) {
+                                  if (start <= 40 && 40 < end) {
+                                    throw std::runtime_error("range failed");
+                                  }
+                                }),
+               std::runtime_error);
+  // The pool keeps working afterwards
+  std::atomic<size_t> count{0};
+  pool.ParallelFor(64, [&count](size_t start, size_t end) { count += end - start; });
+  EXPECT_EQ(count.load(), 64);
+}
+}  // namespace kernel
+}  // namespace mindspore
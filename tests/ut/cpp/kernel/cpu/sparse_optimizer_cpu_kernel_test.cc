@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <map>
+#include <random>
 #include <vector>
 #include "common/common_test.h"
 #include "backend/kernel_compiler/cpu/sparse_optimizer_cpu_kernel.h"
@@ -130,5 +132,93 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
     EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
   }
 }
+
+TEST_F(CommonUtilTest, SortReduceSparseGradient) {
+  std::vector<int> indices{3, 0, 3, 1, 0, 3};
+  std::vector<float> grad;
+  for (int i = 0; i < 6 * 2; i++) {
+    grad.push_back(i);
+  }
+  std::vector<int> unique_indices(6);
+  std::vector<float> summed_grad(12);
+  std::vector<int> tmp_indices(6);
+  std::vector<float> tmp_grad(12);
+  SparseGradient<int> unique_grad({summed_grad.data(), unique_indices.data(), 6});
+  SparseGradient<int> workspace_grad({tmp_grad.data(), tmp_indices.data(), 6});
+  SparseGradient<int> input_grad({grad.data(), indices.data(), 6});
+
+  ReduceSparseGradientParam<int> param;
+  param.input_grad_ = &input_grad;
+  param.workspace_grad_ = &workspace_grad;
+  param.output_grad_ = &unique_grad;
+  param.max_index_ = 6;
+  param.value_stride_ = 2;
+  param.use_sort_reduce_ = true;
+  SparseOptimizerCPUKernel::BucketReduceSparseGradient(param);
+
+  // The last index of a partition is kept too
+  EXPECT_EQ(unique_grad.indices_size_, 3);
+  std::vector<int> expect_indices({0, 1, 3});
+  for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+    EXPECT_EQ(unique_grad.indices_[i], expect_indices[i]);
+  }
+  std::vector<int> expect_value({10, 12, 6, 7, 14, 17});
+  for (size_t i = 0; i < unique_grad.indices_size_ * 2; ++i) {
+    EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
+  }
+}
+
+TEST_F(CommonUtilTest, BucketReduceSparseGradientMatchesMap) {
+  // Many indices over a few partitions and segments, some of them out of range
+  const size_t indices_size = 50000;
+  const size_t stride = 5;
+  const size_t max_index = 3000;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> index_dist(-10, max_index + 10);
+  std::vector<int64_t> indices(indices_size);
+  std::vector<float> grad(indices_size * stride);
+  std::map<int64_t, std::vector<float>> expect;
+  for (size_t i = 0; i < indices_size; ++i) {
+    indices[i] = index_dist(rng);
+    for (size_t j = 0; j < stride; ++j) {
+      grad[i * stride + j] = static_cast<float>((i + j) % 8);
+    }
+    if (indices[i] < 0 || indices[i] >= static_cast<int64_t>(max_index)) {
+      continue;
+    }
+    auto &row = expect[indices[i]];
+    row.resize(stride, 0);
+    for (size_t j = 0; j < stride; ++j) {
+      row[j] += grad[i * stride + j];
+    }
+  }
+
+  for (bool use_sort_reduce : {false, true}) {
+    std::vector<int64_t> unique_indices(indices_size);
+    std::vector<float> summed_grad(indices_size * stride);
+    std::vector<int64_t> tmp_indices(indices_size);
+    std::vector<float> tmp_grad(indices_size * stride);
+    SparseGradient<int64_t> unique_grad({summed_grad.data(), unique_indices.data(), indices_size});
+    SparseGradient<int64_t> workspace_grad({tmp_grad.data(), tmp_indices.data(), indices_size});
+    SparseGradient<int64_t> input_grad({grad.data(), indices.data(), indices_size});
+    ReduceSparseGradientParam<int64_t> param;
+    param.input_grad_ = &input_grad;
+    param.workspace_grad_ = &workspace_grad;
+    param.output_grad_ = &unique_grad;
+    param.max_index_ = max_index;
+    param.value_stride_ = stride;
+    param.use_sort_reduce_ = use_sort_reduce;
+    SparseOptimizerCPUKernel::BucketReduceSparseGradient(param);
+
+    ASSERT_EQ(unique_grad.indices_size_, expect.size());
+    for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+      auto iter = expect.find(unique_grad.indices_[i]);
+      ASSERT_TRUE(iter != expect.end());
+      for (size_t j = 0; j < stride; ++j) {
+        EXPECT_EQ(unique_grad.value_[i * stride + j], iter->second[j]);
+      }
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
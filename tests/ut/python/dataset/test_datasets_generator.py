@@ -12,11 +12,15 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
+import signal
+
 import numpy as np
 import pytest
 
 import mindspore.common.dtype as mstype
 import mindspore.dataset as ds
+import mindspore.dataset.text as text
 from mindspore import log as logger
 
 
@@ -725,6 +729,136 @@ def test_generator_dataset_size_5():
     assert data_size == num_rows
 
 
+class RingDataset:
+    """
+    Random accessible source whose rows have a numeric column of a varying shape, and optionally a string column,
+    a row too large for the shared rings, an error or a worker process killed
+    """
+    def __init__(self, with_string=False, large_index=-1, error_index=-1, kill_index=-1):
+        self.with_string = with_string
+        self.large_index = large_index
+        self.error_index = error_index
+        self.kill_index = kill_index
+
+    def __getitem__(self, item):
+        if item == self.kill_index:
+            os.kill(os.getpid(), signal.SIGKILL)
+        if item == self.error_index:
+            raise ValueError("Bad index {}".format(item))
+        size = 1024 * 1024 if item == self.large_index else item % 5 + 1
+        row = (np.array([item]), np.full((size, 3), item, np.float32))
+        if self.with_string:
+            row += (np.array("row {}".format(item)),)
+        return row
+
+    def __len__(self):
+        return 64
+
+
+def test_generator_shared_ring_order():
+    """
+    Test the rows of several worker processes come in sampler order through the shared rings, epoch after epoch
+    """
+    logger.info("Test Generator MP shared rings : order of the rows")
+
+    num_epochs = 3
+    data1 = ds.GeneratorDataset(RingDataset(), ["index", "data"], num_parallel_workers=4, shuffle=False,
+                                python_multiprocessing=True, max_rowsize=6)
+    iterator = data1.create_tuple_iterator(num_epochs=num_epochs, output_numpy=True)
+    for _ in range(num_epochs):
+        num_rows = 0
+        for item in iterator:
+            np.testing.assert_array_equal(item[0], np.array([num_rows]))
+            np.testing.assert_array_equal(item[1], np.full((num_rows % 5 + 1, 3), num_rows, np.float32))
+            num_rows += 1
+        assert num_rows == 64
+
+    # with a sampler, the order is the one of a single worker
+    original_seed = ds.config.get_seed()
+    sampler = ds.SubsetRandomSampler(list(range(64)))
+    ds.config.set_seed(1)
+    data1 = ds.GeneratorDataset(RingDataset(), ["index", "data"], num_parallel_workers=1, sampler=sampler)
+    expected = [item[0][0] for item in data1.create_tuple_iterator(num_epochs=1, output_numpy=True)]
+    ds.config.set_seed(1)
+    data2 = ds.GeneratorDataset(RingDataset(), ["index", "data"], num_parallel_workers=4, sampler=sampler,
+                                python_multiprocessing=True, max_rowsize=6)
+    indices = [item[0][0] for item in data2.create_tuple_iterator(num_epochs=1, output_numpy=True)]
+    assert indices == expected
+    ds.config.set_seed(original_seed)
+
+
+def test_generator_shared_ring_pickled():
+    """
+    Test the rows with a string column are pickled into the shared rings and keep their order
+    """
+    logger.info("Test Generator MP shared rings : pickled rows")
+
+    data1 = ds.GeneratorDataset(RingDataset(with_string=True), ["index", "data", "name"], num_parallel_workers=4,
+                                shuffle=False, python_multiprocessing=True, max_rowsize=6)
+    num_rows = 0
+    for item in data1.create_tuple_iterator(num_epochs=1, output_numpy=True):
+        np.testing.assert_array_equal(item[0], np.array([num_rows]))
+        np.testing.assert_array_equal(item[1], np.full((num_rows % 5 + 1, 3), num_rows, np.float32))
+        assert text.to_str(item[2]) == "row {}".format(num_rows)
+        num_rows += 1
+    assert num_rows == 64
+
+
+def test_generator_shared_ring_large_row():
+    """
+    Test a row larger than max_rowsize, which fits in no slot of the shared rings, is reported
+    """
+    logger.info("Test Generator MP shared rings : row larger than max_rowsize")
+
+    # 12MB of float32
+    data1 = ds.GeneratorDataset(RingDataset(large_index=10), ["index", "data"], num_parallel_workers=4,
+                                shuffle=False, python_multiprocessing=True, max_rowsize=1)
+    with pytest.raises(RuntimeError) as info:
+        for _ in data1.create_tuple_iterator(num_epochs=1, output_numpy=True):
+            pass
+    assert "max_rowsize" in str(info.value)
+
+    # by default the rows go through the queues, whatever their size
+    data2 = ds.GeneratorDataset(RingDataset(large_index=10), ["index", "data"], num_parallel_workers=4,
+                                shuffle=False, python_multiprocessing=True)
+    num_rows = 0
+    for _ in data2.create_tuple_iterator(num_epochs=1, output_numpy=True):
+        num_rows += 1
+    assert num_rows == 64
+
+
+def test_generator_shared_ring_error():
+    """
+    Test an exception raised in a worker process reaches the iterator through the shared rings
+    """
+    logger.info("Test Generator MP shared rings : exception of a worker")
+
+    data1 = ds.GeneratorDataset(RingDataset(error_index=10), ["index", "data"], num_parallel_workers=4,
+                                shuffle=False, python_multiprocessing=True, max_rowsize=6)
+    num_rows = 0
+    with pytest.raises(RuntimeError) as info:
+        for _ in data1.create_tuple_iterator(num_epochs=1, output_numpy=True):
+            num_rows += 1
+    assert "Bad index 10" in str(info.value)
+    # the rows before it are in order, the pipeline may stop before they all reach the iterator
+    assert num_rows <= 10
+
+
+def test_generator_shared_ring_worker_killed():
+    """
+    Test a worker process killed before it pushes any row into its shared ring stops the pipeline
+    """
+    logger.info("Test Generator MP shared rings : worker killed before its first row")
+
+    # index 0 is the first one of worker 0
+    data1 = ds.GeneratorDataset(RingDataset(kill_index=0), ["index", "data"], num_parallel_workers=4,
+                                shuffle=False, python_multiprocessing=True, max_rowsize=6)
+    with pytest.raises(RuntimeError) as info:
+        for _ in data1.create_tuple_iterator(num_epochs=1, output_numpy=True):
+            pass
+    assert "exited unexpectedly" in str(info.value)
+
+
 def manual_test_generator_keyboard_interrupt():
     """
     Test keyboard_interrupt
@@ -779,3 +913,8 @@ if __name__ == "__main__":
     test_generator_dataset_size_3()
     test_generator_dataset_size_4()
     test_generator_dataset_size_5()
+    test_generator_shared_ring_order()
+    test_generator_shared_ring_pickled()
+    test_generator_shared_ring_large_row()
+    test_generator_shared_ring_error()
+    test_generator_shared_ring_worker_killed()
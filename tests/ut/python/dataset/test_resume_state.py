@@ -0,0 +1,77 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""
+Test resuming a pipeline from the state of an earlier iterator
+"""
+import numpy as np
+import mindspore.dataset as ds
+from mindspore import log as logger
+
+# Note: 44 images in 4 classes
+DATA_DIR = "../data/dataset/testPK/data"
+SEED = 5
+
+
+def build_pipeline():
+    ds.config.set_seed(SEED)
+    data = ds.ImageFolderDataset(DATA_DIR, shuffle=True, num_parallel_workers=1)
+    data = data.shuffle(buffer_size=10)
+    return data.repeat(2)
+
+
+def read_rows(data):
+    ds.config.set_seed(SEED)
+    return list(data.create_dict_iterator(num_epochs=1, output_numpy=True))
+
+
+def assert_rows_equal(rows, expected):
+    assert len(rows) == len(expected)
+    for row, expected_row in zip(rows, expected):
+        np.testing.assert_array_equal(row["image"], expected_row["image"])
+        np.testing.assert_array_equal(row["label"], expected_row["label"])
+
+
+def test_resume_shuffle_repeat():
+    """
+    Test resuming in the second pass of a shuffled and repeated pipeline: the rows left come in the same order
+    """
+    logger.info("test_resume_shuffle_repeat")
+    original_seed = ds.config.get_seed()
+    expected = read_rows(build_pipeline())
+    assert len(expected) == 88
+
+    # stop in the second pass
+    num_read = 44 + 7
+    ds.config.set_seed(SEED)
+    iterator = build_pipeline().create_dict_iterator(num_epochs=1, output_numpy=True)
+    for _ in range(num_read):
+        next(iterator)
+    state = iterator.get_state()
+    iterator.stop()
+
+    data = build_pipeline()
+    data.set_resume_state(state)
+    # a different seed, the state brings back the ones of the earlier run
+    ds.config.set_seed(SEED + 1)
+    rows = list(data.create_dict_iterator(num_epochs=1, output_numpy=True))
+    assert_rows_equal(rows, expected[num_read:])
+
+    # the state only applies to the iterator right after it is set
+    assert_rows_equal(read_rows(data), expected)
+    ds.config.set_seed(original_seed)
+
+
+if __name__ == '__main__':
+    test_resume_shuffle_repeat()